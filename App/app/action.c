@@ -44,6 +44,12 @@
 #ifdef ENABLE_REGA
     #include "app/rega.h"
 #endif
+#ifdef ENABLE_SCAN_STATS
+    #include "app/scanstats.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "app/scanjournal.h"
+#endif
 
 #if defined(ENABLE_FMRADIO)
 static void ACTION_Scan_FM(bool bRestart);
@@ -125,6 +131,12 @@ void (*action_opt_table[])(void) = {
     [ACTION_OPT_REGA_ALARM] = &ACTION_RegaAlarm,
     [ACTION_OPT_REGA_TEST] = &ACTION_RegaTest,
 #endif
+#ifdef ENABLE_SCAN_STATS
+    [ACTION_OPT_SCAN_STATS] = &ACTION_ScanStats,
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    [ACTION_OPT_SCAN_JOURNAL] = &ACTION_ScanJournal,
+#endif
 };
 
 static_assert(ARRAY_SIZE(action_opt_table) == ACTION_OPT_LEN);
@@ -484,6 +496,28 @@ void ACTION_BlminTmpOff(void)
 }
 #endif
 
+#ifdef ENABLE_SCAN_STATS
+void ACTION_ScanStats(void)
+{
+    if (gScanStateDir != SCAN_OFF)
+        CHFRSCANNER_Stop();
+
+    gScanStatsCursor      = 0;
+    gRequestDisplayScreen = DISPLAY_SCAN_STATS;
+}
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+void ACTION_ScanJournal(void)
+{
+    if (gScanStateDir != SCAN_OFF)
+        CHFRSCANNER_Stop();
+
+    gScanJournalCursor    = 0;
+    gRequestDisplayScreen = DISPLAY_SCAN_JOURNAL;
+}
+#endif
+
 #ifdef ENABLE_FEAT_N7SIX
 void ACTION_Update(void)
 {
@@ -35,6 +35,13 @@ void ACTION_SwitchDemodul(void);
     void ACTION_BlminTmpOff(void);
 #endif
 
+#ifdef ENABLE_SCAN_STATS
+    void ACTION_ScanStats(void);
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    void ACTION_ScanJournal(void);
+#endif
+
 #ifdef ENABLE_FEAT_N7SIX
     void ACTION_RxMode(void);
     void ACTION_MainOnly(void);
@@ -34,9 +34,24 @@
     #include "app/fm.h"
 #endif
 #include "app/generic.h"
+#ifdef ENABLE_PRIORITY_LOOKBACK
+    #include "app/lookback.h"
+#endif
 #include "app/main.h"
 #include "app/menu.h"
+#ifdef ENABLE_DUAL_WATCH_SWAP
+    #include "app/rxdelta.h"
+#endif
 #include "app/scanner.h"
+#ifdef ENABLE_SCAN_DWELL
+    #include "app/scandwell.h"
+#endif
+#ifdef ENABLE_SCAN_STATS
+    #include "app/scanstats.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "app/scanjournal.h"
+#endif
 #if defined(ENABLE_UART) || defined(ENABLE_USB)
     #include "app/uart.h"
     #include "scheduler.h"
@@ -56,6 +71,9 @@
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    #include "driver/systick.h"
+#endif
 #include "dtmf.h"
 #include "external/printf/printf.h"
 #include "frequencies.h"
@@ -72,6 +90,9 @@
 #include "ui/inputbox.h"
 #include "ui/main.h"
 #include "ui/menu.h"
+#ifdef ENABLE_UI_PROFILER
+    #include "ui/profiler.h"
+#endif
 #include "ui/status.h"
 #include "ui/ui.h"
 
@@ -98,6 +119,13 @@ void (*ProcessKeysFunctions[])(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 #ifdef ENABLE_AIRCOPY
     [DISPLAY_AIRCOPY] = &AIRCOPY_ProcessKeys,
 #endif
+
+#ifdef ENABLE_SCAN_STATS
+    [DISPLAY_SCAN_STATS] = &SCANSTATS_ProcessKeys,
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    [DISPLAY_SCAN_JOURNAL] = &SCANJOURNAL_ProcessKeys,
+#endif
 };
 
 #ifdef ENABLE_REGA
@@ -525,9 +553,20 @@ void APP_StartListening(FUNCTION_Type_t function)
         BACKLIGHT_TurnOn();
     }
 
-    if (gScanStateDir != SCAN_OFF)
+    if (gScanStateDir != SCAN_OFF) {
         CHFRSCANNER_Found();
 
+#ifdef ENABLE_SCAN_JOURNAL
+        if (function == FUNCTION_RECEIVE)
+            SCANJOURNAL_Open(gRxVfo);
+#endif
+    }
+
+#ifdef ENABLE_SCAN_STATS
+    if (function == FUNCTION_RECEIVE)
+        SCANSTATS_Open(gRxVfo);
+#endif
+
 #ifdef ENABLE_NOAA
     if (IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE) && gIsNoaaMode) {
         gRxVfo->CHANNEL_SAVE        = gNoaaChannel + NOAA_CHANNEL_FIRST;
@@ -614,6 +653,27 @@ uint32_t APP_SetFrequencyByStep(VFO_Info_t *pInfo, int8_t direction)
     }
 #endif
 
+#ifdef ENABLE_DUAL_WATCH_SWAP
+static bool DualwatchSwapRegisters(void)
+{
+    // the image is taken from the VFO at the swap, so an edit on either side
+    // can never leave a stale one behind, and the chip only gets the
+    // registers the two VFOs differ in
+#ifdef ENABLE_NOAA
+    if (gIsNoaaMode)
+        return false;
+#endif
+
+    // registers are only known to match while the radio sits in RX
+    if (gCurrentFunction != FUNCTION_FOREGROUND && gCurrentFunction != FUNCTION_INCOMING)
+        return false;
+
+    RxSetup_t Image;
+    RXDELTA_GetSetup(&Image, gRxVfo);
+    return RXDELTA_Load(&Image, false);
+}
+#endif
+
 static void DualwatchAlternate(void)
 {
     #ifdef ENABLE_NOAA
@@ -642,7 +702,10 @@ static void DualwatchAlternate(void)
         }
     }
 
-    RADIO_SetupRegisters(false);
+#ifdef ENABLE_DUAL_WATCH_SWAP
+    if (!DualwatchSwapRegisters())
+#endif
+        RADIO_SetupRegisters(false);
 
     #ifdef ENABLE_NOAA
         gDualWatchCountdown_10ms = gIsNoaaMode ? dual_watch_count_noaa_10ms : dual_watch_count_toggle_10ms;
@@ -706,7 +769,7 @@ static void CheckRadioInterrupts(void)
                         gDTMF_RX_live[len++]  = c;
                         gDTMF_RX_live[len]    = 0;
                         gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  // time till we delete it
-                        gUpdateDisplay        = true;
+                        UI_MAIN_Invalidate(MAIN_WIDGET_CENTER);
                     }
 
 #ifdef ENABLE_DTMF_CALLING
@@ -1008,6 +1071,18 @@ void APP_Update(void)
         return;
 #endif
 
+#ifdef ENABLE_SCAN_DWELL
+    SCANDWELL_Poll();
+#endif
+
+#ifdef ENABLE_PRIORITY_LOOKBACK
+    LOOKBACK_Poll();
+#endif
+
+#ifdef ENABLE_FAST_CAPTURE
+    SCANNER_Poll();
+#endif
+
 #ifdef ENABLE_VOICE
     if (!SCANNER_IsScanning() && gScanStateDir != SCAN_OFF && gScheduleScanListen && !gPttIsPressed && gVoiceWriteIndex == 0)
 #else
@@ -1396,17 +1471,35 @@ void APP_TimeSlice10ms(void)
     bool gUpdateDisplayCurrent = gUpdateDisplay;
     bool gUpdateStatusCurrent  = gUpdateStatus;
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    const uint32_t UiStart = SYSTICK_GetUs();
+#endif
+
     if (gUpdateDisplayCurrent) {
         gUpdateDisplay = false;
         GUI_DisplayScreen();
     }
+#ifdef ENABLE_UI_WIDGETS
+    else if (gMainWidgets) {
+        gUpdateDisplayCurrent = true;  // for the screenshot below
+        UI_MAIN_UpdateWidgets();
+    }
+#endif
 
     if (gUpdateStatusCurrent) {
         UI_DisplayStatus();
     }
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    UI_AddLoad(SYSTICK_GetUs() - UiStart);
+#endif
+
     #ifdef ENABLE_FEAT_N7SIX_SCREENSHOT
-    if (gUpdateDisplayCurrent || gUpdateStatusCurrent) {
+    if (gUpdateDisplayCurrent || gUpdateStatusCurrent
+        #ifdef ENABLE_SCREENSHOT_USB
+            || SCREENSHOT_IsPending()
+        #endif
+    ) {
         getScreenShot(false);
     }
     #endif
@@ -1542,6 +1635,13 @@ void APP_TimeSlice500ms(void)
     gNextTimeslice_500ms = false;
     bool exit_menu = false;
 
+#ifdef ENABLE_SCAN_STATS
+    SCANSTATS_TimeSlice500ms();
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    SCANJOURNAL_TimeSlice500ms();
+#endif
+
     // Skipped authentic device check
 
     if (gKeypadLocked > 0)
@@ -1580,7 +1680,7 @@ void APP_TimeSlice500ms(void)
                 if (gDTMF_RX_live[0] != 0)
                 {
                     memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
-                    gUpdateDisplay   = true;
+                    UI_MAIN_Invalidate(MAIN_WIDGET_CENTER);
                 }
             }
         }
@@ -1705,7 +1805,7 @@ void APP_TimeSlice500ms(void)
             gUpdateStatus = true;
         #ifdef ENABLE_SHOW_CHARGE_LEVEL
             if (gChargingWithTypeC)
-                gUpdateDisplay = true;
+                UI_MAIN_Invalidate(MAIN_WIDGET_CENTER);
         #endif
     }
 
@@ -1791,6 +1891,12 @@ void APP_TimeSlice500ms(void)
     BATTERY_TimeSlice500ms();
     SCANNER_TimeSlice500ms();
     UI_MAIN_TimeSlice500ms();
+#ifdef ENABLE_UI_WIDGETS
+    UI_STATUS_TimeSlice500ms();
+#endif
+#ifdef ENABLE_UI_PROFILER
+    PROFILER_TimeSlice500ms();
+#endif
 
 #ifdef ENABLE_DTMF_CALLING
     if (gCurrentFunction != FUNCTION_TRANSMIT) {
@@ -1926,7 +2032,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
             if (gDTMF_RX_live[0] != 0) {
                 memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
                 gDTMF_RX_live_timeout = 0;
-                gUpdateDisplay        = true;
+                UI_MAIN_Invalidate(MAIN_WIDGET_CENTER);
             }
 
             // cancel user input
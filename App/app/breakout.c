@@ -192,6 +192,7 @@ void drawScore()
 {
     // Clean status line
     memset(gStatusLine,  0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
 
     // Level
     sprintf(str, "Level %02u", levelCountBreackout);
@@ -314,9 +315,11 @@ void drawWall() {
 
                 BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, true);
                 memcpy(gFrameBuffer[brick[i].y / 8] + brick[i].x, BITMAP_blockOn, sizeof(BITMAP_blockOn));
+                ST7565_MarkDirty(gFrameBuffer[brick[i].y / 8] + brick[i].x, sizeof(BITMAP_blockOn));
                 ST7565_BlitLine(brick[i].y / 8);
                 playBeep(600);
                 memcpy(gFrameBuffer[brick[i].y / 8] + brick[i].x, BITMAP_blockEmpty, sizeof(BITMAP_blockEmpty));
+                ST7565_MarkDirty(gFrameBuffer[brick[i].y / 8] + brick[i].x, sizeof(BITMAP_blockEmpty));
                 ST7565_BlitLine(brick[i].y / 8);
                 BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, false);
 
@@ -330,6 +333,7 @@ void drawWall() {
 
             if (brick[i].destroy == false) {
                 memcpy(gFrameBuffer[brick[i].y / 8] + brick[i].x, BITMAP_block[(brick[i].s + blockAnim)  % 4], sizeof(BITMAP_block[(brick[i].s + blockAnim)  % 4]));
+                ST7565_MarkDirty(gFrameBuffer[brick[i].y / 8] + brick[i].x, sizeof(BITMAP_block[0]));
             }
         }
     }
@@ -394,10 +398,7 @@ static void OnKeyDown(uint8_t key)
     if(wasPaused == true && isPaused == false)
     {
         // Clear the pause text
-        for(uint8_t i = 0; i < 8; i++)
-        {
-            UI_DrawLineBuffer(gFrameBuffer, 32, 32 + i, 96, 32 + i, false);
-        }
+        UI_FillRectangleBuffer(gFrameBuffer, 32, 32, 96, 39, false);
     }
 }
 
@@ -472,6 +473,7 @@ void APP_RunBreakout(void) {
         initRacket();
         initBall();
         memset(gStatusLine,  0, sizeof(gStatusLine));
+        ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
         isInitialized = true;
 
         while(isInitialized)
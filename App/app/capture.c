@@ -0,0 +1,175 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "app/capture.h"
+#include "driver/bk4819.h"
+#include "driver/systick.h"
+
+// The counter gate, REG_32 <15:14> = 0
+#define CAPTURE_GATE_US 200000
+
+static uint32_t Readings[CAPTURE_READINGS];
+static uint32_t Stamps[CAPTURE_READINGS];
+static uint8_t  Count;
+static uint8_t  Next;
+
+static CaptureResult_t Last;
+
+static uint32_t Distance(uint32_t a, uint32_t b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+static uint32_t Median(void)
+{
+    uint32_t Sorted[CAPTURE_READINGS];
+
+    for (unsigned int i = 0; i < Count; i++) {
+        const uint32_t Value = Readings[i];
+        unsigned int   j     = i;
+
+        for (; j > 0 && Sorted[j - 1] > Value; j--)
+            Sorted[j] = Sorted[j - 1];
+        Sorted[j] = Value;
+    }
+
+    return Sorted[Count / 2];
+}
+
+static void Restart(void)
+{
+    BK4819_DisableFrequencyScan();
+    BK4819_EnableFrequencyScan();
+}
+
+static uint16_t RssiAt(uint32_t Frequency)
+{
+    BK4819_SetFrequency(Frequency);
+    BK4819_PickRXFilterPathBasedOnFrequency(Frequency);
+
+    const uint16_t Reg = BK4819_ReadRegister(BK4819_REG_30);
+    BK4819_WriteRegister(BK4819_REG_30, 0);
+    BK4819_WriteRegister(BK4819_REG_30, Reg);
+
+    SYSTICK_DelayUs(CAPTURE_SWEEP_SETTLE_US);
+    return BK4819_GetRSSI();
+}
+
+// RSSI weighted centre of the points within 3dB of the peak, and the
+// height of the peak over the lowest point
+static uint32_t Sweep(uint32_t Centre, uint16_t *pProminence)
+{
+    const uint32_t First = Centre - (CAPTURE_SWEEP_POINTS / 2) * CAPTURE_SWEEP_STEP;
+    uint16_t       Rssi[CAPTURE_SWEEP_POINTS];
+    uint16_t       Peak  = 0;
+    uint16_t       Floor = UINT16_MAX;
+
+    BK4819_DisableFrequencyScan();
+
+    // the narrowest filter, or the RSSI is flat across the sweep
+    const uint16_t Reg43 = BK4819_ReadRegister(BK4819_REG_43);
+    BK4819_SetFilterBandwidth(BK4819_FILTER_BW_NARROWER, false);
+
+    for (unsigned int i = 0; i < CAPTURE_SWEEP_POINTS; i++) {
+        Rssi[i] = RssiAt(First + i * CAPTURE_SWEEP_STEP);
+        if (Rssi[i] > Peak)
+            Peak = Rssi[i];
+        if (Rssi[i] < Floor)
+            Floor = Rssi[i];
+    }
+
+    BK4819_WriteRegister(BK4819_REG_43, Reg43);
+
+    *pProminence = Peak - Floor;
+
+    const uint16_t Cut = (Peak > 6) ? Peak - 6 : 0;   // 0.5dB/step
+    uint32_t Sum    = 0;
+    uint32_t Weight = 0;
+
+    for (unsigned int i = 0; i < CAPTURE_SWEEP_POINTS; i++) {
+        if (Rssi[i] <= Cut)
+            continue;
+        Sum    += (Rssi[i] - Cut) * i;
+        Weight += Rssi[i] - Cut;
+    }
+
+    if (!Weight)
+        return Centre;
+
+    return First + (Sum * CAPTURE_SWEEP_STEP + Weight / 2) / Weight;
+}
+
+void CAPTURE_Start(void)
+{
+    Count = 0;
+    Next  = 0;
+    Restart();
+}
+
+bool CAPTURE_Poll(CaptureResult_t *pResult)
+{
+    uint32_t Reading;
+
+    if (!BK4819_GetFrequencyScanResult(&Reading))
+        return false;
+
+    const uint32_t Now = SYSTICK_GetUs();
+    Restart();
+
+    Readings[Next] = Reading;
+    Stamps[Next]   = Now;
+    Next = (Next + 1) % CAPTURE_READINGS;
+    if (Count < CAPTURE_READINGS)
+        Count++;
+
+    if (Count < CAPTURE_AGREE)
+        return false;
+
+    const uint32_t Centre = Median();
+    uint8_t        Agree  = 0;
+    uint32_t       Oldest = Now;
+
+    for (unsigned int i = 0; i < Count; i++) {
+        if (Distance(Readings[i], Centre) >= CAPTURE_TOLERANCE)
+            continue;
+        Agree++;
+        if ((int32_t)(Stamps[i] - Oldest) < 0)
+            Oldest = Stamps[i];
+    }
+
+    if (Agree < CAPTURE_AGREE)
+        return false;
+
+    uint16_t Prominence;
+    const uint32_t Frequency = Sweep(Centre, &Prominence);
+
+    // share of the readings behind the lock, scaled down when the sweep
+    // shows no clear peak (20dB and over counts in full)
+    if (Prominence > 40)
+        Prominence = 40;
+
+    Last.Frequency  = Frequency;
+    Last.LockMs     = (SYSTICK_GetUs() - Oldest + CAPTURE_GATE_US) / 1000;
+    Last.Confidence = (Agree * 100u * Prominence) / (Count * 40u);
+
+    Count = 0;
+    *pResult = Last;
+    return true;
+}
+
+const CaptureResult_t *CAPTURE_GetLast(void)
+{
+    return &Last;
+}
@@ -0,0 +1,55 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_CAPTURE_H
+#define APP_CAPTURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Frequency counter readings kept, and how many of them must lie within
+// CAPTURE_TOLERANCE (10 Hz) of their median for a lock
+#ifndef CAPTURE_READINGS
+    #define CAPTURE_READINGS 5
+#endif
+#define CAPTURE_AGREE     3
+#define CAPTURE_TOLERANCE 100
+
+// Fine sweep around the consensus, RSSI read at each point
+#define CAPTURE_SWEEP_STEP      100     // 10 Hz
+#define CAPTURE_SWEEP_POINTS    11
+#define CAPTURE_SWEEP_SETTLE_US 1500
+
+typedef struct
+{
+    uint32_t Frequency;     // 10 Hz
+    uint32_t LockMs;        // first agreeing reading to lock
+    uint8_t  Confidence;    // 0 ~ 100
+} CaptureResult_t;
+
+// RF frequency capture for the scanner. The BK4819 frequency counter is
+// restarted as soon as a reading is out, instead of once per scan delay,
+// and a lock needs a majority of the recent readings around their median
+// rather than an unbroken run. The consensus is then refined by an RSSI
+// sweep a few kHz either side of it.
+
+void CAPTURE_Start(void);
+
+// called from the main loop, true once pResult holds a lock
+bool CAPTURE_Poll(CaptureResult_t *pResult);
+
+const CaptureResult_t *CAPTURE_GetLast(void);
+
+#endif
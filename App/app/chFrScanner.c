@@ -4,6 +4,22 @@
 #include "functions.h"
 #include "misc.h"
 #include "settings.h"
+#include "ui/main.h"
+#ifdef ENABLE_SCAN_PLAN
+    #include "app/scanplan.h"
+#endif
+#ifdef ENABLE_SCAN_FASTHOP
+    #include "app/scanhop.h"
+#endif
+#ifdef ENABLE_SCAN_DWELL
+    #include "app/scandwell.h"
+#endif
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    #include "app/scanranges.h"
+#endif
+#ifdef ENABLE_PRIORITY_LOOKBACK
+    #include "app/lookback.h"
+#endif
 //#include "debugging.h"
 
 int8_t            gScanStateDir;
@@ -49,6 +65,12 @@ void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_directi
 
     gNextMrChannel   = gRxVfo->CHANNEL_SAVE;
     currentScanList = SCAN_NEXT_CHAN_SCANLIST1;
+#ifdef ENABLE_SCAN_PLAN
+    SCANPLAN_Reset(gNextMrChannel);
+#endif
+#ifdef ENABLE_SCAN_FASTHOP
+    SCANHOP_Reset();
+#endif
     gScanStateDir    = scan_direction;
 
     if (IS_MR_CHANNEL(gNextMrChannel))
@@ -57,6 +79,9 @@ void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_directi
             initialFrqOrChan = gRxVfo->CHANNEL_SAVE;
             lastFoundFrqOrChan = initialFrqOrChan;
         }
+#ifdef ENABLE_PRIORITY_LOOKBACK
+        LOOKBACK_Begin();
+#endif
         NextMemChannel();
     }
     else
@@ -64,6 +89,10 @@ void CHFRSCANNER_Start(const bool storeBackupSettings, const int8_t scan_directi
         if (storeBackupSettings) {
             initialFrqOrChan = gRxVfo->freq_config_RX.Frequency;
             lastFoundFrqOrChan = initialFrqOrChan;
+#ifdef ENABLE_MULTI_SCAN_RANGES
+            if (SCANRANGES_IsActive())
+                SCANRANGES_Begin(gRxVfo);
+#endif
         }
         NextFreqChannel();
     }
@@ -175,6 +204,9 @@ void CHFRSCANNER_Found(void)
 #endif
 
     if (IS_MR_CHANNEL(gRxVfo->CHANNEL_SAVE)) { //memory scan
+#ifdef ENABLE_SCAN_FASTHOP
+        SCANHOP_Complete();
+#endif
         lastFoundFrqOrChan = gRxVfo->CHANNEL_SAVE;
     }
     else { // frequency scan
@@ -208,6 +240,9 @@ void CHFRSCANNER_Stop(void)
     }
     else {
         gRxVfo->freq_config_RX.Frequency = chFr;
+#ifdef ENABLE_MULTI_SCAN_RANGES
+        SCANRANGES_End(gRxVfo, channelChanged ? chFr : 0);
+#endif
         RADIO_ApplyOffset(gRxVfo);
         RADIO_ConfigureSquelchAndOutputPower(gRxVfo);
         if(channelChanged) {
@@ -226,6 +261,11 @@ void CHFRSCANNER_Stop(void)
 
 static void NextFreqChannel(void)
 {
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    if (SCANRANGES_IsActive())
+        SCANRANGES_Next(gRxVfo, gScanStateDir);
+    else
+#endif
 #ifdef ENABLE_SCAN_RANGES
     if(gScanRangeStart) {
         gRxVfo->freq_config_RX.Frequency = APP_SetFreqByStepAndLimits(gRxVfo, gScanStateDir, gScanRangeStart, gScanRangeStop);
@@ -244,9 +284,47 @@ static void NextFreqChannel(void)
     gScanPauseDelayIn_10ms = scan_pause_delay_in_6_10ms;
 #endif
 
-    gUpdateDisplay     = true;
+#ifdef ENABLE_SCAN_DWELL
+    SCANDWELL_Start();
+#endif
+
+    // the band number sits beside the frequency
+    UI_MAIN_Invalidate(MAIN_WIDGET_FREQ(gEeprom.RX_VFO) | MAIN_WIDGET_CHANNEL(gEeprom.RX_VFO));
 }
 
+#ifdef ENABLE_SCAN_PLAN
+static void NextMemChannel(void)
+{
+    const unsigned int prev_chan = gNextMrChannel;
+
+    gNextMrChannel = SCANPLAN_Next(gScanStateDir);
+
+    if (gNextMrChannel != prev_chan)
+    {
+#ifdef ENABLE_SCAN_FASTHOP
+        SCANHOP_Tune(gNextMrChannel);
+#else
+        gEeprom.MrChannel[    gEeprom.RX_VFO] = gNextMrChannel;
+        gEeprom.ScreenChannel[gEeprom.RX_VFO] = gNextMrChannel;
+
+        RADIO_ConfigureChannel(gEeprom.RX_VFO, VFO_CONFIGURE_RELOAD);
+        RADIO_SetupRegisters(true);
+#endif
+
+        UI_MAIN_Invalidate(MAIN_WIDGET_VFO(gEeprom.RX_VFO));
+    }
+
+#ifdef ENABLE_FASTER_CHANNEL_SCAN
+    gScanPauseDelayIn_10ms = 9;  // 90ms .. <= ~60ms it misses signals (squelch response and/or PLL lock time) ?
+#else
+    gScanPauseDelayIn_10ms = scan_pause_delay_in_3_10ms;
+#endif
+
+#ifdef ENABLE_SCAN_DWELL
+    SCANDWELL_Start();
+#endif
+}
+#else
 static void NextMemChannel(void)
 {
     static unsigned int prev_mr_chan = 0;
@@ -354,7 +432,7 @@ static void NextMemChannel(void)
         RADIO_ConfigureChannel(gEeprom.RX_VFO, VFO_CONFIGURE_RELOAD);
         RADIO_SetupRegisters(true);
 
-        gUpdateDisplay = true;
+        UI_MAIN_Invalidate(MAIN_WIDGET_VFO(gEeprom.RX_VFO));
     }
 
 #ifdef ENABLE_FASTER_CHANNEL_SCAN
@@ -363,7 +441,12 @@ static void NextMemChannel(void)
     gScanPauseDelayIn_10ms = scan_pause_delay_in_3_10ms;
 #endif
 
+#ifdef ENABLE_SCAN_DWELL
+    SCANDWELL_Start();
+#endif
+
     if (enabled)
         if (++currentScanList >= SCAN_NEXT_NUM)
             currentScanList = SCAN_NEXT_CHAN_SCANLIST1;  // back round we go
 }
+#endif
@@ -0,0 +1,249 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/chFrScanner.h"
+#include "app/lookback.h"
+#include "app/rxdelta.h"
+#include "app/scanner.h"
+#include "audio.h"
+#include "driver/bk4819.h"
+#include "driver/systick.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+static struct {
+    uint8_t   Channel;
+    RxSetup_t Setup;
+} Priority[2];
+
+static uint8_t         PriorityCount;
+static uint32_t        SinceUs;
+static bool            Waiting;     // a lookback is due LOOKBACK_PERIOD_MS after SinceUs
+static LookbackStats_t Stats;
+
+// Busy waits on purpose: tuned away, the chip's squelch interrupts belong
+// to the priority channel and nothing else may run and act on them
+static void Settle(void)
+{
+    const uint32_t Start = SYSTICK_GetUs();
+    while (SYSTICK_GetUs() - Start < LOOKBACK_SETTLE_US)
+        ;
+}
+
+// Same test as the squelch open thresholds of the channel
+static bool HasSignal(const RxSetup_t *pSetup)
+{
+    return BK4819_GetRSSI()             >= pSetup->Squelch[0]
+        && BK4819_GetExNoiceIndicator() <= pSetup->Squelch[2]
+        && BK4819_GetGlitchIndicator()  <= pSetup->Squelch[5];
+}
+
+static void DropInterrupts(void)
+{
+    while (BK4819_ReadRegister(BK4819_REG_0C) & 1u)
+        BK4819_WriteRegister(BK4819_REG_02, 0);
+}
+
+static bool IsPriority(uint8_t Channel)
+{
+    for (unsigned int i = 0; i < PriorityCount; i++)
+        if (Priority[i].Channel == Channel)
+            return true;
+    return false;
+}
+
+static bool IsDue(void)
+{
+    const bool Holding = gCurrentFunction == FUNCTION_RECEIVE
+        || (gScanPauseMode && gCurrentFunction == FUNCTION_FOREGROUND);
+
+    if (!PriorityCount
+        || gScanStateDir == SCAN_OFF
+        || !IS_MR_CHANNEL(gNextMrChannel)
+        || !Holding
+        || gPttIsPressed
+        || SCANNER_IsScanning()
+        || IsPriority(gRxVfo->CHANNEL_SAVE))
+    {
+        Waiting = false;
+        return false;
+    }
+
+    // the first look comes a full period after the scanner stopped on a channel
+    const uint32_t Now = SYSTICK_GetUs();
+    if (!Waiting) {
+        Waiting = true;
+        SinceUs = Now;
+        return false;
+    }
+
+    if (Now - SinceUs < LOOKBACK_PERIOD_MS * 1000u)
+        return false;
+
+    SinceUs = Now;
+    return true;
+}
+
+static void SwitchTo(uint8_t Channel)
+{
+    const unsigned int vfo = gEeprom.RX_VFO;
+
+    gEeprom.MrChannel[vfo]     = Channel;
+    gEeprom.ScreenChannel[vfo] = Channel;
+    gNextMrChannel             = Channel;
+
+    RADIO_ConfigureChannel(vfo, VFO_CONFIGURE_RELOAD);
+    RADIO_SetupRegisters(true);
+
+    // give the squelch time to open, the scanner takes it from there
+    gScanPauseMode         = false;
+    gRxReceptionMode       = RX_MODE_NONE;
+    gScanPauseDelayIn_10ms = scan_pause_delay_in_3_10ms;
+    gScheduleScanListen    = false;
+    gUpdateDisplay         = true;
+
+    Stats.Switches++;
+}
+
+void LOOKBACK_Begin(void)
+{
+    const uint8_t      List = gEeprom.SCAN_LIST_DEFAULT;
+    const unsigned int vfo  = gEeprom.RX_VFO;
+
+    PriorityCount = 0;
+    Waiting       = false;
+
+    if (List < 1 || List > 3 || !gEeprom.SCAN_LIST_ENABLED[List - 1])
+        return;
+
+    const uint8_t Channels[2] = {
+        gEeprom.SCANLIST_PRIORITY_CH1[List - 1],
+        gEeprom.SCANLIST_PRIORITY_CH2[List - 1],
+    };
+
+    // the setups are taken once per scan, through the VFO the scan is
+    // about to reconfigure anyway
+    const uint8_t MrChannel     = gEeprom.MrChannel[vfo];
+    const uint8_t ScreenChannel = gEeprom.ScreenChannel[vfo];
+
+    for (unsigned int i = 0; i < ARRAY_SIZE(Channels); i++) {
+        const uint8_t Channel = Channels[i];
+        if (!RADIO_CheckValidChannel(Channel, false, List) || IsPriority(Channel))
+            continue;
+
+        gEeprom.MrChannel[vfo]     = Channel;
+        gEeprom.ScreenChannel[vfo] = Channel;
+        RADIO_ConfigureChannel(vfo, VFO_CONFIGURE_RELOAD);
+
+        Priority[PriorityCount].Channel = Channel;
+        RXDELTA_GetSetup(&Priority[PriorityCount].Setup, gRxVfo);
+        PriorityCount++;
+    }
+
+    if (PriorityCount) {
+        gEeprom.MrChannel[vfo]     = MrChannel;
+        gEeprom.ScreenChannel[vfo] = ScreenChannel;
+        RADIO_ConfigureChannel(vfo, VFO_CONFIGURE_RELOAD);
+    }
+}
+
+void LOOKBACK_Invalidate(void)
+{
+    PriorityCount = 0;
+}
+
+void LOOKBACK_Poll(void)
+{
+    if (!IsDue())
+        return;
+
+    const uint32_t Start = SYSTICK_GetUs();
+    const bool     Receiving = gCurrentFunction == FUNCTION_RECEIVE;
+
+    RxSetup_t Home;
+    RXDELTA_GetSetup(&Home, gRxVfo);
+
+    AUDIO_AudioPathOff();
+
+    bool Moved = false;
+    int  Found = -1;
+    for (unsigned int i = 0; i < PriorityCount && Found < 0; i++) {
+        // only frequency, filter and squelch move, the tone setup stays
+        RxSetup_t Look  = Priority[i].Setup;
+        Look.CodeType   = Home.CodeType;
+        Look.Code       = Home.Code;
+        Look.Scrambling = Home.Scrambling;
+        Look.Compander  = Home.Compander;
+
+        if (!RXDELTA_Write(&Look)) {
+            Stats.Skipped++;
+            continue;
+        }
+
+        Moved = true;
+        Settle();
+
+        if (HasSignal(&Look))
+            Found = i;
+    }
+
+    if (!Moved) {
+        if (Receiving && gEnableSpeaker)
+            AUDIO_AudioPathOn();
+        return;
+    }
+
+    if (Found >= 0) {
+        SwitchTo(Priority[Found].Channel);
+    }
+    else {
+        RXDELTA_Write(&Home);
+
+        if (Receiving) {
+            Settle();
+
+            // what the squelch did while away is noise, unless the held
+            // channel went quiet in the meantime
+            if (HasSignal(&Home))
+                DropInterrupts();
+
+            // RXDELTA_Write kept the AF mode across any squelch rewrite
+            if (gEnableSpeaker)
+                AUDIO_AudioPathOn();
+        }
+    }
+
+    const uint32_t Gap = SYSTICK_GetUs() - Start;
+
+    Stats.Looks++;
+    Stats.LastGapUs   = Gap;
+    Stats.TotalGapUs += Gap;
+    if (Gap > Stats.MaxGapUs)
+        Stats.MaxGapUs = Gap;
+}
+
+const LookbackStats_t *LOOKBACK_GetStats(void)
+{
+    return &Stats;
+}
+
+void LOOKBACK_ClearStats(void)
+{
+    memset(&Stats, 0, sizeof(Stats));
+}
@@ -0,0 +1,59 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_LOOKBACK_H
+#define APP_LOOKBACK_H
+
+#include <stdint.h>
+
+// Time between two looks at the priority channels while the scanner holds
+// a channel, and the time given to each of them to show a signal. A look
+// holds up the main loop: one settle per priority channel and one more on
+// the way back, 15 ms with two priority channels and the defaults, plus
+// some 20 register accesses per tuning at 60 to 80 us each over the bit
+// banged SPI, about 20 ms in all. The 10 ms time slices that fall due
+// meanwhile run once, late, so countdowns lose a tick or two per look.
+// MaxGapUs in the stats is the measured figure.
+#ifndef LOOKBACK_PERIOD_MS
+    #define LOOKBACK_PERIOD_MS 2000
+#endif
+#ifndef LOOKBACK_SETTLE_US
+    #define LOOKBACK_SETTLE_US 5000
+#endif
+
+typedef struct
+{
+    uint32_t Looks;         // lookbacks done
+    uint32_t Switches;      // lookbacks that found a priority channel busy
+    uint32_t Skipped;       // priority channels passed over, other modulation
+    uint32_t LastGapUs;     // audio muted by the last lookback
+    uint32_t MaxGapUs;
+    uint32_t TotalGapUs;
+} LookbackStats_t;
+
+// Priority channel lookback. While a memory scan is parked on a channel,
+// receiving or paused on a find, the priority channels of the scan list are
+// tuned for a few milliseconds every LOOKBACK_PERIOD_MS with the register
+// delta path. A priority channel that reads as carrying a signal takes over
+// at once; otherwise the held channel is tuned back and its audio resumes.
+
+void LOOKBACK_Begin(void);
+void LOOKBACK_Invalidate(void);
+void LOOKBACK_Poll(void);
+
+const LookbackStats_t *LOOKBACK_GetStats(void);
+void                   LOOKBACK_ClearStats(void);
+
+#endif
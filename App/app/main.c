@@ -25,7 +25,16 @@
 #endif
 #include "app/generic.h"
 #include "app/main.h"
+#ifdef ENABLE_RX_DELTA
+    #include "app/rxdelta.h"
+#endif
 #include "app/scanner.h"
+#ifdef ENABLE_SCAN_PLAN
+    #include "app/scanplan.h"
+#endif
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    #include "app/scanranges.h"
+#endif
 
 #ifdef ENABLE_SPECTRUM
 #include "app/spectrum.h"
@@ -54,6 +63,15 @@ static void toggle_chan_scanlist(void)
         return;
 
     if(!IS_MR_CHANNEL(gTxVfo->CHANNEL_SAVE)) {
+#ifdef ENABLE_MULTI_SCAN_RANGES
+        // off -> VFO pair range -> stored ranges -> off
+        if (SCANRANGES_IsActive()) {
+            SCANRANGES_Deactivate();
+            return;
+        }
+        if (gScanRangeStart && SCANRANGES_Activate())
+            return;
+#endif
 #ifdef ENABLE_SCAN_RANGES
         uint32_t vfo1_freq = gTxVfo->pRX->Frequency;
         uint32_t vfo2_freq = gEeprom.VfoInfo[!gEeprom.TX_VFO].freq_config_RX.Frequency;
@@ -81,6 +99,9 @@ static void toggle_chan_scanlist(void)
     if(gMR_ChannelExclude[gTxVfo->CHANNEL_SAVE] == true)
     {
         gMR_ChannelExclude[gTxVfo->CHANNEL_SAVE] = false;
+#ifdef ENABLE_SCAN_PLAN
+        SCANPLAN_Invalidate();
+#endif
         return;
     }
 
@@ -693,6 +714,9 @@ static void MAIN_Key_MENU(bool bKeyPressed, bool bKeyHeld)
                 if(FUNCTION_IsRx() || gScanPauseDelayIn_10ms > 9)
                 {
                     gMR_ChannelExclude[gTxVfo->CHANNEL_SAVE] = true;
+#ifdef ENABLE_SCAN_PLAN
+                    SCANPLAN_Invalidate();
+#endif
 
                     gVfoConfigureMode = VFO_CONFIGURE;
                     gFlagResetVfos    = true;
@@ -910,6 +934,9 @@ static void MAIN_Key_UP_DOWN(bool bKeyPressed, bool bKeyHeld, int8_t Direction)
                 gTxVfo->freq_config_RX.Frequency = frequency;
                 BK4819_SetFrequency(frequency);
                 BK4819_RX_TurnOn();
+#ifdef ENABLE_RX_DELTA
+                RXDELTA_Invalidate();   // retuned behind RADIO_SetupRegisters
+#endif
                 gRequestSaveChannel = 1;
                 return;
             }
@@ -22,6 +22,9 @@
 #include "app/dtmf.h"
 #include "app/generic.h"
 #include "app/menu.h"
+#ifdef ENABLE_RX_DELTA
+    #include "app/rxdelta.h"
+#endif
 #include "app/scanner.h"
 #include "audio.h"
 #include "board.h"
@@ -461,6 +464,10 @@ void MENU_AcceptSetting(void)
         if (gSubMenuSelection > Max) gSubMenuSelection = Max;
     }
 
+#ifdef ENABLE_RX_DELTA
+    RXDELTA_Invalidate();   // mic gain, VOX and the like only go in with a full setup
+#endif
+
     switch (UI_MENU_GetCurrentMenuId())
     {
         default:
@@ -0,0 +1,152 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/rxdelta.h"
+#include "audio.h"
+#include "driver/bk4819.h"
+#include "functions.h"
+#include "misc.h"
+#include "settings.h"
+
+static RxSetup_t Loaded;            // what the BK4819 is programmed with
+static bool      LoadedValid;
+static uint16_t  LoadedOtherInterrupts;
+
+// Same choices as RADIO_SetupRegisters
+void RXDELTA_GetSetup(RxSetup_t *pSetup, const VFO_Info_t *pVfo)
+{
+    BK4819_FilterBandwidth_t Filter = pVfo->CHANNEL_BANDWIDTH;
+
+#ifdef ENABLE_FEAT_N7SIX_NARROWER
+    if (Filter == BK4819_FILTER_BW_NARROW && gSetting_set_nfm == 1)
+        Filter = BK4819_FILTER_BW_NARROWER;
+#endif
+    if (Filter > BK4819_FILTER_BW_NARROWER)
+        Filter = BK4819_FILTER_BW_WIDE;
+    if (pVfo->Modulation == MODULATION_AM)
+        Filter = BK4819_FILTER_BW_AM;
+
+    const bool fm = pVfo->Modulation == MODULATION_FM;
+
+    memset(pSetup, 0, sizeof(*pSetup));
+    pSetup->Frequency  = pVfo->pRX->Frequency;
+    pSetup->Squelch[0] = pVfo->SquelchOpenRSSIThresh;
+    pSetup->Squelch[1] = pVfo->SquelchCloseRSSIThresh;
+    pSetup->Squelch[2] = pVfo->SquelchOpenNoiseThresh;
+    pSetup->Squelch[3] = pVfo->SquelchCloseNoiseThresh;
+    pSetup->Squelch[4] = pVfo->SquelchCloseGlitchThresh;
+    pSetup->Squelch[5] = pVfo->SquelchOpenGlitchThresh;
+    pSetup->Filter     = Filter;
+    pSetup->Modulation = pVfo->Modulation;
+    pSetup->CodeType   = fm ? pVfo->pRX->CodeType : CODE_TYPE_OFF;
+    pSetup->Code       = fm ? pVfo->pRX->Code : 0;
+    pSetup->Scrambling = fm ? pVfo->SCRAMBLING_TYPE : 0;
+    pSetup->Compander  = (fm && pVfo->Compander >= 2) ? pVfo->Compander : 0;
+}
+
+bool RXDELTA_Write(const RxSetup_t *pNext)
+{
+    if (!LoadedValid || pNext->Modulation != Loaded.Modulation)
+        return false;
+
+    if (pNext->Filter != Loaded.Filter) {
+#ifdef ENABLE_AM_FIX
+        BK4819_SetFilterBandwidth(pNext->Filter, true);
+#else
+        BK4819_SetFilterBandwidth(pNext->Filter, pNext->Filter == BK4819_FILTER_BW_AM);
+#endif
+    }
+
+    // drop what the last setup left pending, no need to wait for more
+    if (BK4819_ReadRegister(BK4819_REG_0C) & 1u)
+        BK4819_WriteRegister(BK4819_REG_02, 0);
+
+    const bool retune = pNext->Frequency != Loaded.Frequency;
+    if (retune)
+        BK4819_SetFrequency(pNext->Frequency);
+
+    if (memcmp(pNext->Squelch, Loaded.Squelch, sizeof(Loaded.Squelch)) != 0) {
+        // the squelch setup mutes the AF, keep what RADIO_SetModulation chose
+        const uint16_t Af = BK4819_ReadRegister(BK4819_REG_47);
+        BK4819_SetupSquelch(
+            pNext->Squelch[0], pNext->Squelch[1],
+            pNext->Squelch[2], pNext->Squelch[3],
+            pNext->Squelch[4], pNext->Squelch[5]);   // turns RX back on
+        BK4819_WriteRegister(BK4819_REG_47, Af);
+    }
+    else if (retune) {
+        BK4819_RX_TurnOn();    // PLL/VCO calibration for the new frequency
+    }
+
+    if (retune && (pNext->Frequency < 28000000) != (Loaded.Frequency < 28000000))
+        BK4819_PickRXFilterPathBasedOnFrequency(pNext->Frequency);
+
+    if (pNext->CodeType   != Loaded.CodeType ||
+        pNext->Code       != Loaded.Code     ||
+        pNext->Scrambling != Loaded.Scrambling)
+    {
+        BK4819_WriteRegister(BK4819_REG_3F, RADIO_SetupRxCodes() | LoadedOtherInterrupts);
+    }
+
+    if (pNext->Compander != Loaded.Compander)
+        BK4819_SetCompander(pNext->Compander);
+
+    Loaded = *pNext;
+
+    return true;
+}
+
+bool RXDELTA_Load(const RxSetup_t *pNext, bool switchToForeground)
+{
+    if (!LoadedValid || pNext->Modulation != Loaded.Modulation)
+        return false;
+
+    AUDIO_AudioPathOff();
+    gEnableSpeaker = false;
+
+    RXDELTA_Write(pNext);
+
+#ifdef ENABLE_VOX
+    // the power save wakeup turns VOX on whatever the modulation
+    if (!(LoadedOtherInterrupts & BK4819_REG_3F_VOX_FOUND))
+        BK4819_DisableVox();
+#endif
+
+    FUNCTION_Init();
+
+    if (switchToForeground)
+        FUNCTION_Select(FUNCTION_FOREGROUND);
+
+    return true;
+}
+
+void RXDELTA_Invalidate(void)
+{
+    LoadedValid = false;
+}
+
+void RXDELTA_RegistersLoaded(uint16_t OtherInterrupts)
+{
+    RXDELTA_GetSetup(&Loaded, gRxVfo);
+    LoadedOtherInterrupts = OtherInterrupts;
+    LoadedValid = true;
+
+#ifdef ENABLE_NOAA
+    if (IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE))
+        LoadedValid = false;
+#endif
+}
@@ -0,0 +1,65 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_RXDELTA_H
+#define APP_RXDELTA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "radio.h"
+
+// The part of the RX setup that changes from one channel or VFO to the next
+typedef struct
+{
+    uint32_t Frequency;
+    uint8_t  Squelch[6];
+    uint8_t  Filter;
+    uint8_t  Modulation;
+    uint8_t  CodeType;
+    uint8_t  Code;
+    uint8_t  Scrambling;
+    uint8_t  Compander;
+} RxSetup_t;
+
+// Shadow of what RADIO_SetupRegisters last programmed into the BK4819, so a
+// retune only writes the registers that differ. Used by the fast memory scan
+// hop, the dual watch swap and the priority lookback.
+//
+// Only the RxSetup_t part is ever rewritten. The rest of the RX setup is
+// assumed to be as the last RADIO_SetupRegisters left it: AF gain (REG_48),
+// mic gain (REG_7D), VOX, AGC, DTMF and the other interrupts in REG_3F. The
+// AF mode in REG_47 is kept across a squelch rewrite. Whatever writes those
+// registers behind RADIO_SetupRegisters, other than with the values it would
+// write itself, calls RXDELTA_Invalidate: the menu, the TX setup, the
+// spectrum and the frequency step keys.
+
+void RXDELTA_GetSetup(RxSetup_t *pSetup, const VFO_Info_t *pVfo);
+
+// Writes only what differs from the loaded setup, gRxVfo must already be the
+// VFO of pNext. False when the change touches the parts RADIO_SetupRegisters
+// sets up once per modulation, nothing is written then.
+bool RXDELTA_Load(const RxSetup_t *pNext, bool switchToForeground);
+
+// Register part of RXDELTA_Load alone, audio and receive state are left as
+// they are. For a short look at another channel and back.
+bool RXDELTA_Write(const RxSetup_t *pNext);
+
+void RXDELTA_Invalidate(void);
+
+// called by RADIO_SetupRegisters once the whole RX setup is written
+void RXDELTA_RegistersLoaded(uint16_t OtherInterrupts);
+
+#endif
@@ -0,0 +1,151 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/chFrScanner.h"
+#include "app/scandwell.h"
+#include "driver/bk4819.h"
+#include "driver/py25q16.h"
+#include "driver/systick.h"
+#include "frequencies.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+
+#define SCAN_DWELL_MAGIC 0x4C574453 // "SDWL"
+
+// A channel is empty when all three readings are on the empty side of both
+// these limits and the squelch open thresholds of the channel, so it is
+// never dropped on readings that would have opened the squelch. These are
+// the limits until others are stored over UART.
+static const DwellThresholds_t Defaults[BAND_N_ELEM] =
+{
+    [BAND1_50MHz]  = { 90, 60, 120 },   // more man made noise down here
+    [BAND2_108MHz] = { 80, 50, 100 },
+    [BAND3_137MHz] = { 80, 50, 100 },
+    [BAND4_174MHz] = { 76, 50, 100 },
+    [BAND5_350MHz] = { 76, 50, 100 },
+    [BAND6_400MHz] = { 72, 45,  90 },
+    [BAND7_470MHz] = { 72, 45,  90 },
+};
+
+typedef struct
+{
+    uint32_t          Magic;
+    DwellThresholds_t Bands[BAND_N_ELEM];
+} Store_t;
+
+static Store_t Store;
+
+static enum {
+    DWELL_IDLE,
+    DWELL_SETTLE,
+    DWELL_CONFIRM,
+} State;
+
+static uint32_t SinceUs;
+
+static bool IsEmpty(void)
+{
+    const VFO_Info_t *pVfo = gRxVfo;
+    const DwellThresholds_t *t = &Store.Bands[FREQUENCY_GetBand(pVfo->pRX->Frequency)];
+
+    uint16_t RssiBelow   = t->RssiBelow;
+    uint8_t  NoiseAbove  = t->NoiseAbove;
+    uint8_t  GlitchAbove = t->GlitchAbove;
+
+    if (RssiBelow > pVfo->SquelchOpenRSSIThresh)
+        RssiBelow = pVfo->SquelchOpenRSSIThresh;
+    if (NoiseAbove < pVfo->SquelchOpenNoiseThresh)
+        NoiseAbove = pVfo->SquelchOpenNoiseThresh;
+    if (GlitchAbove < pVfo->SquelchOpenGlitchThresh)
+        GlitchAbove = pVfo->SquelchOpenGlitchThresh;
+
+    return BK4819_GetRSSI()            <  RssiBelow
+        && BK4819_GetExNoiceIndicator() > NoiseAbove
+        && BK4819_GetGlitchIndicator()  > GlitchAbove;
+}
+
+static bool IsValid(const DwellThresholds_t *pThresholds)
+{
+    for (unsigned int i = 0; i < BAND_N_ELEM; i++)
+        if (pThresholds[i].NoiseAbove > 127)
+            return false;
+    return true;
+}
+
+void SCANDWELL_Init(void)
+{
+    PY25Q16_ReadBuffer(SCAN_DWELL_FLASH_ADDR, &Store, sizeof(Store));
+
+    if (Store.Magic != SCAN_DWELL_MAGIC || !IsValid(Store.Bands))
+        memcpy(Store.Bands, Defaults, sizeof(Store.Bands));
+}
+
+const DwellThresholds_t *SCANDWELL_GetThresholds(void)
+{
+    return Store.Bands;
+}
+
+bool SCANDWELL_SetThresholds(const DwellThresholds_t *pThresholds)
+{
+    if (!IsValid(pThresholds))
+        return false;
+
+    Store.Magic = SCAN_DWELL_MAGIC;
+    memcpy(Store.Bands, pThresholds, sizeof(Store.Bands));
+
+    PY25Q16_WriteBuffer(SCAN_DWELL_FLASH_ADDR, &Store, sizeof(Store), false);
+    return true;
+}
+
+void SCANDWELL_Start(void)
+{
+    // the noise indicators mean nothing outside FM
+    State   = (gRxVfo->Modulation == MODULATION_FM) ? DWELL_SETTLE : DWELL_IDLE;
+    SinceUs = SYSTICK_GetUs();
+}
+
+void SCANDWELL_Poll(void)
+{
+    if (State == DWELL_IDLE)
+        return;
+
+    // squelch opened, paused on a find or scan over: full evaluation
+    if (gScanStateDir == SCAN_OFF || gScanPauseMode || gCurrentFunction != FUNCTION_FOREGROUND) {
+        State = DWELL_IDLE;
+        return;
+    }
+
+    const uint32_t Now = SYSTICK_GetUs();
+    if (Now - SinceUs < ((State == DWELL_SETTLE) ? SCAN_DWELL_SETTLE_US : SCAN_DWELL_CONFIRM_US))
+        return;
+
+    if (!IsEmpty()) {
+        State = DWELL_IDLE;
+        return;
+    }
+
+    if (State == DWELL_SETTLE) {
+        State   = DWELL_CONFIRM;
+        SinceUs = Now;
+        return;
+    }
+
+    State = DWELL_IDLE;
+    gScanPauseDelayIn_10ms = 0;
+    gScheduleScanListen    = true;
+}
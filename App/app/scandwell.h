@@ -0,0 +1,55 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANDWELL_H
+#define APP_SCANDWELL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "frequencies.h"
+
+// SPI flash sector holding the thresholds set over UART
+#define SCAN_DWELL_FLASH_ADDR 0x127000
+
+// Time after a hop before the first look at the channel, and between the
+// two looks that must both find it empty before the dwell is cut short
+#ifndef SCAN_DWELL_SETTLE_US
+    #define SCAN_DWELL_SETTLE_US  10000
+#endif
+#ifndef SCAN_DWELL_CONFIRM_US
+    #define SCAN_DWELL_CONFIRM_US  4000
+#endif
+
+typedef struct
+{
+    uint8_t RssiBelow;      // 0.5dB/step, same scale as REG_67
+    uint8_t NoiseAbove;     // ex-noise, 0 ~ 127
+    uint8_t GlitchAbove;    // 0 ~ 255
+} DwellThresholds_t;
+
+// Adaptive scan dwell. Shortly after a hop the RSSI, ex-noise and glitch
+// indicators are read; a channel that is clearly empty is left at once,
+// anything else keeps the full dwell and the usual squelch evaluation.
+
+void SCANDWELL_Init(void);
+void SCANDWELL_Start(void);
+void SCANDWELL_Poll(void);
+
+// the limits of every band, BAND_N_ELEM entries
+const DwellThresholds_t *SCANDWELL_GetThresholds(void);
+bool                     SCANDWELL_SetThresholds(const DwellThresholds_t *pThresholds);
+
+#endif
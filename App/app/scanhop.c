@@ -0,0 +1,262 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "app/rxdelta.h"
+#include "app/scanhop.h"
+#include "driver/systick.h"
+#include "frequencies.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+enum {
+    FLAG_REVERSE     = 1u << 0,
+    FLAG_BUSY_LOCK   = 1u << 1,
+    FLAG_TX_LOCK     = 1u << 2,
+    FLAG_DTMF_DECODE = 1u << 3,
+    FLAG_SCANLIST1   = 1u << 4,
+    FLAG_SCANLIST2   = 1u << 5,
+    FLAG_SCANLIST3   = 1u << 6,
+    FLAG_TX_IS_RX    = 1u << 7,   // pTX points to the RX config (rescue ops)
+};
+
+// What RADIO_ConfigureChannel leaves in the VFO, less the name, the TX offset
+// and the TX power calibration, which SCANHOP_Complete fetches when needed.
+typedef struct
+{
+    uint32_t RxFrequency;
+    uint32_t TxFrequency;
+    uint8_t  RxCodeType;
+    uint8_t  RxCode;
+    uint8_t  TxCodeType;
+    uint8_t  TxCode;
+    uint8_t  Channel;
+    uint8_t  Band;
+    uint8_t  Step;
+    uint8_t  OffsetDirection;
+    uint8_t  Squelch[6];
+    uint8_t  Power;
+    uint8_t  Bandwidth;
+    uint8_t  Modulation;
+    uint8_t  Compander;
+    uint8_t  Scrambling;
+    uint8_t  PttId;
+    uint8_t  Flags;
+} Profile_t;
+
+static Profile_t Profiles[SCAN_HOP_PROFILES];
+static uint8_t   ProfileCount;
+static uint8_t   ProfileSquelch;    // squelch level the profiles were made with
+
+static bool      Partial;           // VFO restored from a profile
+
+static ScanhopStats_t Stats;
+static uint32_t       LastHopUs;
+static bool           Hopping;      // LastHopUs belongs to the running scan
+
+static Profile_t *FindProfile(uint8_t Channel)
+{
+    if (ProfileSquelch != gEeprom.SQUELCH_LEVEL) {
+        ProfileSquelch = gEeprom.SQUELCH_LEVEL;
+        ProfileCount = 0;
+    }
+
+    for (uint8_t i = 0; i < ProfileCount; i++) {
+        if (Profiles[i].Channel == Channel)
+            return &Profiles[i];
+    }
+
+    return NULL;
+}
+
+static void SaveProfile(const VFO_Info_t *pVfo)
+{
+    // first come first kept, so the priority channels and the start of the
+    // plan stay in RAM when the plan is longer than the table
+    if (ProfileCount >= SCAN_HOP_PROFILES)
+        return;
+
+    Profile_t *p = &Profiles[ProfileCount++];
+
+    p->RxFrequency     = pVfo->freq_config_RX.Frequency;
+    p->TxFrequency     = pVfo->freq_config_TX.Frequency;
+    p->RxCodeType      = pVfo->freq_config_RX.CodeType;
+    p->RxCode          = pVfo->freq_config_RX.Code;
+    p->TxCodeType      = pVfo->freq_config_TX.CodeType;
+    p->TxCode          = pVfo->freq_config_TX.Code;
+    p->Channel         = pVfo->CHANNEL_SAVE;
+    p->Band            = pVfo->Band;
+    p->Step            = pVfo->STEP_SETTING;
+    p->OffsetDirection = pVfo->TX_OFFSET_FREQUENCY_DIRECTION;
+    p->Squelch[0]      = pVfo->SquelchOpenRSSIThresh;
+    p->Squelch[1]      = pVfo->SquelchCloseRSSIThresh;
+    p->Squelch[2]      = pVfo->SquelchOpenNoiseThresh;
+    p->Squelch[3]      = pVfo->SquelchCloseNoiseThresh;
+    p->Squelch[4]      = pVfo->SquelchCloseGlitchThresh;
+    p->Squelch[5]      = pVfo->SquelchOpenGlitchThresh;
+    p->Power           = pVfo->OUTPUT_POWER;
+    p->Bandwidth       = pVfo->CHANNEL_BANDWIDTH;
+    p->Modulation      = pVfo->Modulation;
+    p->Compander       = pVfo->Compander;
+    p->Scrambling      = pVfo->SCRAMBLING_TYPE;
+    p->PttId           = pVfo->DTMF_PTT_ID_TX_MODE;
+
+    p->Flags = 0;
+    if (pVfo->FrequencyReverse)
+        p->Flags |= FLAG_REVERSE;
+    if (pVfo->BUSY_CHANNEL_LOCK)
+        p->Flags |= FLAG_BUSY_LOCK;
+    if (pVfo->TX_LOCK)
+        p->Flags |= FLAG_TX_LOCK;
+#ifdef ENABLE_DTMF_CALLING
+    if (pVfo->DTMF_DECODING_ENABLE)
+        p->Flags |= FLAG_DTMF_DECODE;
+#endif
+    if (pVfo->SCANLIST1_PARTICIPATION)
+        p->Flags |= FLAG_SCANLIST1;
+    if (pVfo->SCANLIST2_PARTICIPATION)
+        p->Flags |= FLAG_SCANLIST2;
+    if (pVfo->SCANLIST3_PARTICIPATION)
+        p->Flags |= FLAG_SCANLIST3;
+    if (pVfo->pTX == &pVfo->freq_config_RX && !pVfo->FrequencyReverse)
+        p->Flags |= FLAG_TX_IS_RX;
+}
+
+static void RestoreProfile(VFO_Info_t *pVfo, const Profile_t *p)
+{
+    pVfo->freq_config_RX.Frequency     = p->RxFrequency;
+    pVfo->freq_config_TX.Frequency     = p->TxFrequency;
+    pVfo->freq_config_RX.CodeType      = p->RxCodeType;
+    pVfo->freq_config_RX.Code          = p->RxCode;
+    pVfo->freq_config_TX.CodeType      = p->TxCodeType;
+    pVfo->freq_config_TX.Code          = p->TxCode;
+    pVfo->CHANNEL_SAVE                 = p->Channel;
+    pVfo->Band                         = p->Band;
+    pVfo->STEP_SETTING                 = p->Step;
+    pVfo->StepFrequency                = gStepFrequencyTable[p->Step];
+    pVfo->TX_OFFSET_FREQUENCY_DIRECTION = p->OffsetDirection;
+    pVfo->SquelchOpenRSSIThresh        = p->Squelch[0];
+    pVfo->SquelchCloseRSSIThresh       = p->Squelch[1];
+    pVfo->SquelchOpenNoiseThresh       = p->Squelch[2];
+    pVfo->SquelchCloseNoiseThresh      = p->Squelch[3];
+    pVfo->SquelchCloseGlitchThresh     = p->Squelch[4];
+    pVfo->SquelchOpenGlitchThresh      = p->Squelch[5];
+    pVfo->OUTPUT_POWER                 = p->Power;
+    pVfo->CHANNEL_BANDWIDTH            = p->Bandwidth;
+    pVfo->Modulation                   = p->Modulation;
+    pVfo->Compander                    = p->Compander;
+    pVfo->SCRAMBLING_TYPE              = p->Scrambling;
+    pVfo->DTMF_PTT_ID_TX_MODE          = p->PttId;
+
+    pVfo->FrequencyReverse        = !!(p->Flags & FLAG_REVERSE);
+    pVfo->BUSY_CHANNEL_LOCK       = !!(p->Flags & FLAG_BUSY_LOCK);
+    pVfo->TX_LOCK                 = !!(p->Flags & FLAG_TX_LOCK);
+#ifdef ENABLE_DTMF_CALLING
+    pVfo->DTMF_DECODING_ENABLE    = !!(p->Flags & FLAG_DTMF_DECODE);
+#endif
+    pVfo->SCANLIST1_PARTICIPATION = !!(p->Flags & FLAG_SCANLIST1);
+    pVfo->SCANLIST2_PARTICIPATION = !!(p->Flags & FLAG_SCANLIST2);
+    pVfo->SCANLIST3_PARTICIPATION = !!(p->Flags & FLAG_SCANLIST3);
+
+    if (!pVfo->FrequencyReverse) {
+        pVfo->pRX = &pVfo->freq_config_RX;
+        pVfo->pTX = (p->Flags & FLAG_TX_IS_RX) ? &pVfo->freq_config_RX : &pVfo->freq_config_TX;
+    }
+    else {
+        pVfo->pRX = &pVfo->freq_config_TX;
+        pVfo->pTX = &pVfo->freq_config_RX;
+    }
+
+    // pVfo->Name stays the last full load's, the screen reads the name from
+    // flash itself and nothing else looks at it before SCANHOP_Complete
+}
+
+void SCANHOP_Reset(void)
+{
+    ProfileCount = 0;
+    RXDELTA_Invalidate();
+    Partial = false;
+    Hopping = false;
+}
+
+void SCANHOP_Tune(uint8_t Channel)
+{
+    const unsigned int vfo = gEeprom.RX_VFO;
+    VFO_Info_t *pVfo = &gEeprom.VfoInfo[vfo];
+    const uint32_t Start = SYSTICK_GetUs();
+
+    if (Hopping && Start - LastHopUs < SCAN_HOP_IDLE_US) {
+        Stats.Intervals++;
+        Stats.IntervalUs += Start - LastHopUs;
+    }
+    LastHopUs = Start;
+    Hopping = true;
+
+    gEeprom.MrChannel[vfo]     = Channel;
+    gEeprom.ScreenChannel[vfo] = Channel;
+
+    const Profile_t *pProfile = FindProfile(Channel);
+    if (pProfile) {
+        RestoreProfile(pVfo, pProfile);
+        Partial = true;
+        Stats.Restored++;
+    }
+    else {
+        RADIO_ConfigureChannel(vfo, VFO_CONFIGURE_RELOAD);
+        Partial = false;
+        if (pVfo->CHANNEL_SAVE == Channel)
+            SaveProfile(pVfo);
+    }
+
+    // registers are only known to match while nothing else is going on
+    RxSetup_t Next;
+    RXDELTA_GetSetup(&Next, pVfo);
+    if ((gCurrentFunction != FUNCTION_FOREGROUND && gCurrentFunction != FUNCTION_INCOMING) ||
+        !RXDELTA_Load(&Next, true))
+    {
+        RADIO_SetupRegisters(true);
+        Stats.FullSetups++;
+    }
+
+    const uint32_t Elapsed = SYSTICK_GetUs() - Start;
+    Stats.Hops++;
+    Stats.TuneUs += Elapsed;
+    if (Elapsed > Stats.MaxTuneUs)
+        Stats.MaxTuneUs = Elapsed;
+}
+
+void SCANHOP_Complete(void)
+{
+    if (!Partial)
+        return;
+
+    Partial = false;
+    RADIO_ConfigureChannel(gEeprom.RX_VFO, VFO_CONFIGURE_RELOAD);
+}
+
+const ScanhopStats_t *SCANHOP_GetStats(void)
+{
+    return &Stats;
+}
+
+void SCANHOP_ClearStats(void)
+{
+    memset(&Stats, 0, sizeof(Stats));
+    Hopping = false;
+}
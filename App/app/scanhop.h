@@ -0,0 +1,55 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANHOP_H
+#define APP_SCANHOP_H
+
+#include <stdint.h>
+
+// Channels of the scan plan whose settings are kept in RAM
+#ifndef SCAN_HOP_PROFILES
+    #define SCAN_HOP_PROFILES 24
+#endif
+
+// A gap between two hops longer than this is a channel held by the scanner,
+// it is left out of the hop rate
+#ifndef SCAN_HOP_IDLE_US
+    #define SCAN_HOP_IDLE_US 500000
+#endif
+
+typedef struct
+{
+    uint32_t Hops;          // channels tuned
+    uint32_t Restored;      // from a RAM profile instead of flash
+    uint32_t FullSetups;    // RADIO_SetupRegisters instead of the register delta
+    uint32_t TuneUs;        // spent in SCANHOP_Tune
+    uint32_t MaxTuneUs;
+    uint32_t Intervals;     // hop to hop times counted in IntervalUs
+    uint32_t IntervalUs;    // channels per second = Intervals * 1e6 / IntervalUs
+} ScanhopStats_t;
+
+// Memory scan hop without a full radio reconfiguration. The VFO of a channel
+// already visited is restored from its RAM profile instead of being rebuilt
+// from flash, and only the BK4819 registers that differ from the channel
+// tuned before are written.
+
+void SCANHOP_Reset(void);
+void SCANHOP_Tune(uint8_t Channel);
+void SCANHOP_Complete(void);
+
+const ScanhopStats_t *SCANHOP_GetStats(void);
+void                  SCANHOP_ClearStats(void);
+
+#endif
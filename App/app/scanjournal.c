@@ -0,0 +1,459 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/chFrScanner.h"
+#include "app/generic.h"
+#include "app/scanjournal.h"
+#include "audio.h"
+#include "driver/bk4819.h"
+#include "driver/py25q16.h"
+#include "functions.h"
+#include "misc.h"
+#include "ui/ui.h"
+
+// Layout of the ring:
+//
+//   sector = SectorHeader_t, then entries back to back, 0xFF after the last one
+//
+// Sectors are filled in order and carry an increasing Seq, so the valid
+// ones always form a contiguous run ending at HeadSector.
+
+#define SECTOR_SIZE  0x1000
+#define SECTOR_MAGIC 0x4C4E524A // "JRNL"
+#define ENTRY_TAG    0x4A
+
+#define ENTRIES_PER_SECTOR ((SECTOR_SIZE - sizeof(SectorHeader_t)) / sizeof(ScanJournalEntry_t))
+#define PENDING_MAX        (2 * SCAN_JOURNAL_BATCH)
+
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Seq;
+    uint32_t FirstTime;
+    uint32_t Reserved;
+} SectorHeader_t;
+
+static uint16_t HeadSector;
+static uint32_t HeadSeq;
+static uint16_t HeadUsed;      // entries in the head sector
+static uint8_t  ValidSectors;
+static uint32_t WriteAddr;
+static uint8_t  ClearSectors;  // left to erase after a clear, one bit each
+
+static ScanJournalEntry_t Pending[PENDING_MAX];
+static uint8_t            PendingCount;
+static uint16_t           FlushCountdown_500ms;
+
+static ScanJournalEntry_t Current;
+static bool               IsOpen;
+static uint32_t           OpenTime_500ms;
+
+static uint32_t Clock;
+static bool     HalfSecond;
+
+uint16_t gScanJournalCursor;
+
+static inline uint32_t SectorAddr(uint16_t Index)
+{
+    return SCAN_JOURNAL_FLASH_ADDR + (uint32_t)Index * SECTOR_SIZE;
+}
+
+static uint8_t EntryCheck(const ScanJournalEntry_t *pEntry)
+{
+    const uint8_t *p   = (const uint8_t *)pEntry;
+    uint8_t        Sum = 0;
+
+    for (unsigned int i = 0; i < sizeof(*pEntry) - 1; i++)
+        Sum += p[i];
+
+    return ~Sum;
+}
+
+static bool EntryValid(const ScanJournalEntry_t *pEntry)
+{
+    return pEntry->Tag == ENTRY_TAG && pEntry->Check == EntryCheck(pEntry);
+}
+
+static bool ReadSectorHeader(uint16_t Index, SectorHeader_t *pHeader)
+{
+    PY25Q16_ReadBuffer(SectorAddr(Index), pHeader, sizeof(*pHeader));
+    return pHeader->Magic == SECTOR_MAGIC;
+}
+
+static bool SectorBlank(uint16_t Index)
+{
+    uint32_t Words[16];
+
+    for (uint32_t Offset = 0; Offset < SECTOR_SIZE; Offset += sizeof(Words)) {
+        PY25Q16_ReadBuffer(SectorAddr(Index) + Offset, Words, sizeof(Words));
+        for (unsigned int i = 0; i < ARRAY_SIZE(Words); i++)
+            if (Words[i] != 0xFFFFFFFF)
+                return false;
+    }
+
+    return true;
+}
+
+// Start the erase of the next cleared sector once the flash is free. A
+// power cut before the last one brings back the sectors not reached yet.
+static void EraseCleared(void)
+{
+    if (!ClearSectors || PY25Q16_IsBusy())
+        return;
+
+    for (uint16_t i = 0; i < SCAN_JOURNAL_FLASH_SECTORS; i++) {
+        if (ClearSectors & (1u << i)) {
+            ClearSectors &= ~(1u << i);
+            PY25Q16_SectorEraseAsync(SectorAddr(i));
+            return;
+        }
+    }
+}
+
+// Erase the sector after the head, giving up its (oldest) entries
+static void PrepareNextSector(void)
+{
+    SectorHeader_t Header;
+    const uint16_t Next = (HeadSector + 1) % SCAN_JOURNAL_FLASH_SECTORS;
+
+    if (ReadSectorHeader(Next, &Header) && ValidSectors)
+        ValidSectors--;
+
+    PY25Q16_SectorEraseAsync(SectorAddr(Next));
+}
+
+static void OpenSector(uint32_t Time)
+{
+    const SectorHeader_t Header = {
+        .Magic     = SECTOR_MAGIC,
+        .Seq       = ++HeadSeq,
+        .FirstTime = Time,
+        .Reserved  = 0xFFFFFFFF,
+    };
+
+    HeadSector = (HeadSector + 1) % SCAN_JOURNAL_FLASH_SECTORS;
+    HeadUsed   = 0;
+    if (ValidSectors < SCAN_JOURNAL_FLASH_SECTORS)
+        ValidSectors++;
+
+    PY25Q16_WriteBuffer(SectorAddr(HeadSector), &Header, sizeof(Header), true);
+    WriteAddr = SectorAddr(HeadSector) + sizeof(Header);
+}
+
+// Program the pending entries, the flash must not be busy erasing
+static void Flush(void)
+{
+    uint8_t Done   = 0;
+    bool    Opened = false;
+
+    while (Done < PendingCount) {
+        const uint32_t End = SectorAddr(HeadSector) + SECTOR_SIZE;
+
+        if (WriteAddr + sizeof(ScanJournalEntry_t) > End) {
+            // the next sector is erased ahead, but only one of them
+            if (Opened)
+                break;
+            OpenSector(Pending[Done].Time);
+            Opened = true;
+            continue;
+        }
+
+        uint8_t Size = PendingCount - Done;
+        if (Size > (End - WriteAddr) / sizeof(ScanJournalEntry_t))
+            Size = (End - WriteAddr) / sizeof(ScanJournalEntry_t);
+
+        PY25Q16_WriteBuffer(WriteAddr, &Pending[Done], Size * sizeof(ScanJournalEntry_t), true);
+
+        WriteAddr += Size * sizeof(ScanJournalEntry_t);
+        HeadUsed  += Size;
+        Done      += Size;
+    }
+
+    if (Opened)
+        PrepareNextSector();
+
+    PendingCount -= Done;
+    memmove(Pending, &Pending[Done], PendingCount * sizeof(ScanJournalEntry_t));
+    FlushCountdown_500ms = SCAN_JOURNAL_FLUSH_500ms;
+}
+
+static void UpdatePeak(void)
+{
+    const uint16_t Rssi = BK4819_GetRSSI() / 2;
+
+    if (Rssi > Current.PeakRssi)
+        Current.PeakRssi = (Rssi > UINT8_MAX) ? UINT8_MAX : Rssi;
+}
+
+static void Close(void)
+{
+    const uint32_t Duration = (OpenTime_500ms + 1) / 2;
+
+    IsOpen           = false;
+    Current.Duration = (Duration > UINT16_MAX) ? UINT16_MAX : Duration;
+    Current.Tag      = ENTRY_TAG;
+    Current.Check    = EntryCheck(&Current);
+
+    if (PendingCount == PENDING_MAX) {
+        // the flash has been out of reach for too long, the oldest goes
+        PendingCount--;
+        memmove(Pending, &Pending[1], PendingCount * sizeof(ScanJournalEntry_t));
+    }
+
+    if (PendingCount == 0)
+        FlushCountdown_500ms = SCAN_JOURNAL_FLUSH_500ms;
+
+    Pending[PendingCount++] = Current;
+}
+
+void SCANJOURNAL_Init(void)
+{
+    SectorHeader_t Header;
+    bool           Found  = false;
+    uint32_t       Newest = 0;
+
+    HeadSector   = SCAN_JOURNAL_FLASH_SECTORS - 1;
+    HeadSeq      = 0;
+    HeadUsed     = 0;
+    ValidSectors = 0;
+    ClearSectors = 0;
+    PendingCount = 0;
+    IsOpen       = false;
+
+    for (uint16_t i = 0; i < SCAN_JOURNAL_FLASH_SECTORS; i++) {
+        if (!ReadSectorHeader(i, &Header))
+            continue;
+
+        if (!Found || (int32_t)(Header.Seq - HeadSeq) > 0) {
+            Found      = true;
+            HeadSector = i;
+            HeadSeq    = Header.Seq;
+            Newest     = Header.FirstTime;
+        }
+    }
+
+    // the next entry opens a new sector unless the head has room left
+    WriteAddr = SectorAddr(HeadSector) + SECTOR_SIZE;
+
+    if (Found) {
+        // sectors older than the head count as long as their sequence
+        // numbers follow on without a gap
+        for (uint8_t Back = 0; Back < SCAN_JOURNAL_FLASH_SECTORS; Back++) {
+            const uint16_t Index = (HeadSector + SCAN_JOURNAL_FLASH_SECTORS - Back) % SCAN_JOURNAL_FLASH_SECTORS;
+            if (!ReadSectorHeader(Index, &Header) || Header.Seq != HeadSeq - Back)
+                break;
+            ValidSectors++;
+        }
+
+        ScanJournalEntry_t Entry;
+        uint32_t           Addr = SectorAddr(HeadSector) + sizeof(SectorHeader_t);
+        const uint32_t     End  = SectorAddr(HeadSector) + SECTOR_SIZE;
+
+        for (; Addr + sizeof(Entry) <= End; Addr += sizeof(Entry)) {
+            PY25Q16_ReadBuffer(Addr, &Entry, sizeof(Entry));
+            if (!EntryValid(&Entry))
+                break;
+            Newest = Entry.Time + Entry.Duration;
+            HeadUsed++;
+        }
+
+        // anything but erased flash after the last entry means an
+        // interrupted write, leave the rest of that sector alone
+        if (Addr + sizeof(Entry) <= End && Entry.Tag == 0xFF)
+            WriteAddr = Addr;
+    }
+
+    // keep the journal clock running from the last entry
+    Clock = Newest + 1;
+
+    // the erase ahead is usually done already from the last run
+    if (!SectorBlank((HeadSector + 1) % SCAN_JOURNAL_FLASH_SECTORS))
+        PrepareNextSector();
+}
+
+void SCANJOURNAL_Open(const VFO_Info_t *pInfo)
+{
+    if (IsOpen)
+        Close();
+
+    memset(&Current, 0, sizeof(Current));
+    Current.Time     = Clock;
+    Current.Key      = IS_MR_CHANNEL(pInfo->CHANNEL_SAVE) ? pInfo->CHANNEL_SAVE : pInfo->pRX->Frequency;
+    Current.CodeType = SCAN_JOURNAL_NO_CODE;
+
+    // with a code set the squelch only opens once it has been decoded
+    if (pInfo->pRX->CodeType != CODE_TYPE_OFF) {
+        Current.CodeType = pInfo->pRX->CodeType;
+        Current.Code     = pInfo->pRX->Code;
+    }
+
+    UpdatePeak();
+
+    IsOpen         = true;
+    OpenTime_500ms = 0;
+}
+
+void SCANJOURNAL_TimeSlice500ms(void)
+{
+    HalfSecond = !HalfSecond;
+    if (!HalfSecond)
+        Clock++;
+
+    if (IsOpen) {
+        if (gCurrentFunction == FUNCTION_RECEIVE) {
+            OpenTime_500ms++;
+            UpdatePeak();
+        } else {
+            Close();
+            if (gScreenToDisplay == DISPLAY_SCAN_JOURNAL)
+                gUpdateDisplay = true;
+        }
+    }
+
+    if (ClearSectors) {
+        // the entries wait in RAM until the whole ring is erased
+        if (gCurrentFunction != FUNCTION_TRANSMIT)
+            EraseCleared();
+        return;
+    }
+
+    if (PendingCount == 0)
+        return;
+
+    if (FlushCountdown_500ms)
+        FlushCountdown_500ms--;
+
+    if (PendingCount < SCAN_JOURNAL_BATCH && FlushCountdown_500ms)
+        return;
+
+    // nothing is written while a transmission is going on, and a running
+    // scan only waits for the flash while it is parked on a signal
+    if (gCurrentFunction == FUNCTION_TRANSMIT || PY25Q16_IsBusy())
+        return;
+
+    if (gScanStateDir != SCAN_OFF && gCurrentFunction != FUNCTION_RECEIVE && PendingCount < PENDING_MAX)
+        return;
+
+    Flush();
+}
+
+// Forget the entries at once, the sectors are erased from the time slice
+// one at a time in the background (~50 ms each)
+void SCANJOURNAL_Clear(void)
+{
+    ClearSectors = (1u << SCAN_JOURNAL_FLASH_SECTORS) - 1;
+    EraseCleared();
+
+    HeadSector         = SCAN_JOURNAL_FLASH_SECTORS - 1;
+    HeadUsed           = 0;
+    ValidSectors       = 0;
+    WriteAddr          = SectorAddr(HeadSector) + SECTOR_SIZE;
+    PendingCount       = 0;
+    IsOpen             = false;
+    gScanJournalCursor = 0;
+}
+
+uint32_t SCANJOURNAL_GetClock(void)
+{
+    return Clock;
+}
+
+uint16_t SCANJOURNAL_GetCount(void)
+{
+    uint16_t Count = PendingCount;
+
+    if (ValidSectors)
+        Count += HeadUsed + (ValidSectors - 1) * ENTRIES_PER_SECTOR;
+
+    return Count;
+}
+
+bool SCANJOURNAL_Get(uint16_t Index, ScanJournalEntry_t *pEntry)
+{
+    // newest first, the pending ones before anything in flash
+    if (Index < PendingCount) {
+        *pEntry = Pending[PendingCount - 1 - Index];
+        return true;
+    }
+
+    Index -= PendingCount;
+
+    uint16_t Sector = HeadSector;
+    uint16_t Slot;
+
+    if (Index < HeadUsed) {
+        Slot = HeadUsed - 1 - Index;
+    } else {
+        Index -= HeadUsed;
+
+        const uint16_t Back = 1 + Index / ENTRIES_PER_SECTOR;
+        if (Back >= ValidSectors)
+            return false;
+
+        Sector = (HeadSector + SCAN_JOURNAL_FLASH_SECTORS - Back) % SCAN_JOURNAL_FLASH_SECTORS;
+        Slot   = ENTRIES_PER_SECTOR - 1 - Index % ENTRIES_PER_SECTOR;
+    }
+
+    PY25Q16_ReadBuffer(SectorAddr(Sector) + sizeof(SectorHeader_t) + Slot * sizeof(ScanJournalEntry_t),
+                       pEntry, sizeof(*pEntry));
+
+    return EntryValid(pEntry);
+}
+
+void SCANJOURNAL_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+    if (Key == KEY_PTT) {
+        GENERIC_Key_PTT(bKeyPressed);
+        return;
+    }
+
+    if (!bKeyPressed)
+        return;
+
+    const uint16_t Count = SCANJOURNAL_GetCount();
+
+    switch (Key) {
+        case KEY_UP:
+        case KEY_DOWN:
+            if (Count) {
+                gScanJournalCursor = NUMBER_AddWithWraparound(gScanJournalCursor, (Key == KEY_UP) ? -1 : 1, 0, Count - 1);
+                gUpdateDisplay     = true;
+            }
+            return;
+
+        case KEY_STAR:
+            // hold to clear
+            if (bKeyHeld && Count) {
+                SCANJOURNAL_Clear();
+                gBeepToPlay    = BEEP_880HZ_60MS_DOUBLE_BEEP;
+                gUpdateDisplay = true;
+            }
+            return;
+
+        case KEY_EXIT:
+            if (!bKeyHeld) {
+                gBeepToPlay           = BEEP_1KHZ_60MS_OPTIONAL;
+                gRequestDisplayScreen = DISPLAY_MAIN;
+            }
+            return;
+
+        default:
+            if (!bKeyHeld)
+                gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+            return;
+    }
+}
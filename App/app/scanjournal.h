@@ -0,0 +1,73 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANJOURNAL_H
+#define APP_SCANJOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/keyboard.h"
+#include "radio.h"
+
+// Four SPI flash sectors, written as a ring
+#define SCAN_JOURNAL_FLASH_ADDR    0x123000
+#define SCAN_JOURNAL_FLASH_SECTORS 4
+
+// Entries held in RAM before they are written out together
+#ifndef SCAN_JOURNAL_BATCH
+    #define SCAN_JOURNAL_BATCH 8
+#endif
+
+// Longest time a closed entry waits in RAM for the rest of its batch
+#define SCAN_JOURNAL_FLUSH_500ms 120
+
+#define SCAN_JOURNAL_NO_CODE 0xFF
+
+typedef struct
+{
+    uint32_t Time;       // journal clock at squelch open, seconds
+    uint32_t Key;        // MR channel, or frequency (10 Hz)
+    uint16_t Duration;   // squelch open, seconds
+    uint8_t  PeakRssi;   // dBm + 160
+    uint8_t  CodeType;   // CODE_TYPE_* the squelch opened on, or SCAN_JOURNAL_NO_CODE
+    uint8_t  Code;
+    uint8_t  Padding;
+    uint8_t  Tag;
+    uint8_t  Check;
+} ScanJournalEntry_t;
+
+#define SCAN_JOURNAL_IS_CHANNEL(Key) ((Key) <= MR_CHANNEL_LAST)
+
+// Scan result journal. Every squelch opening while the scanner runs is
+// logged once it closes, newest first when read back. Entries collect in
+// RAM and go to flash in batches while the scanner is parked or off, so a
+// flash write never lands in the middle of a sweep. The sector after the
+// head is erased ahead of time and its entries, the oldest, are given up.
+
+extern uint16_t gScanJournalCursor;
+
+void SCANJOURNAL_Init(void);
+void SCANJOURNAL_Open(const VFO_Info_t *pInfo);
+void SCANJOURNAL_TimeSlice500ms(void);
+void SCANJOURNAL_Clear(void);
+
+uint32_t SCANJOURNAL_GetClock(void);
+uint16_t SCANJOURNAL_GetCount(void);
+bool     SCANJOURNAL_Get(uint16_t Index, ScanJournalEntry_t *pEntry);
+
+void SCANJOURNAL_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
+
+#endif
@@ -15,6 +15,9 @@
  */
 
 #include "app/app.h"
+#ifdef ENABLE_FAST_CAPTURE
+    #include "app/capture.h"
+#endif
 #include "app/dtmf.h"
 #include "app/generic.h"
 #include "app/menu.h"
@@ -343,6 +346,9 @@ void SCANNER_Start(bool singleFreq)
 
         BK4819_PickRXFilterPathBasedOnFrequency(gScanFrequency);
         BK4819_EnableFrequencyScan();
+#ifdef ENABLE_FAST_CAPTURE
+        CAPTURE_Start();
+#endif
 
         gUpdateStatus = true;
     }
@@ -384,6 +390,39 @@ void SCANNER_Stop(void)
     }
 }
 
+// RF frequency found, go on with the CTCSS/DCS scan on it
+static void FrequencyLocked(void)
+{
+    BK4819_SetScanFrequency(gScanFrequency);
+    gScanCssResultCode     = 0xFF;
+    gScanCssResultType     = 0xFF;
+    scanHitCount           = 0;
+    gScanUseCssResult      = false;
+    gScanProgressIndicator = 0;
+    gScanCssState          = SCAN_CSS_STATE_SCANNING;
+
+    if(!gCssBackgroundScan)
+        GUI_SelectNextDisplay(DISPLAY_SCANNER);
+
+    gUpdateStatus          = true;
+}
+
+#ifdef ENABLE_FAST_CAPTURE
+void SCANNER_Poll(void)
+{
+    if (!SCANNER_IsScanning() || gScannerSaveState != SCAN_SAVE_NO_PROMPT || gScanCssState != SCAN_CSS_STATE_OFF)
+        return;
+
+    CaptureResult_t Result;
+    if (!CAPTURE_Poll(&Result))
+        return;
+
+    gScanFrequency = Result.Frequency;
+    FrequencyLocked();
+    gScanDelay_10ms = scan_delay_10ms;
+}
+#endif
+
 void SCANNER_TimeSlice10ms(void)
 {
     if (!SCANNER_IsScanning())
@@ -400,6 +439,9 @@ void SCANNER_TimeSlice10ms(void)
 
     switch (gScanCssState) {
         case SCAN_CSS_STATE_OFF: {
+#ifdef ENABLE_FAST_CAPTURE
+            break;  // SCANNER_Poll
+#else
             // must be RF frequency scanning if we're here ?
             uint32_t result;
             if (!BK4819_GetFrequencyScanResult(&result))
@@ -421,23 +463,13 @@ void SCANNER_TimeSlice10ms(void)
                 BK4819_EnableFrequencyScan();
             }
             else {
-                BK4819_SetScanFrequency(gScanFrequency);
-                gScanCssResultCode     = 0xFF;
-                gScanCssResultType     = 0xFF;
-                scanHitCount           = 0;
-                gScanUseCssResult      = false;
-                gScanProgressIndicator = 0;
-                gScanCssState          = SCAN_CSS_STATE_SCANNING;
-
-                if(!gCssBackgroundScan)
-                    GUI_SelectNextDisplay(DISPLAY_SCANNER);
-
-                gUpdateStatus          = true;
+                FrequencyLocked();
             }
 
             gScanDelay_10ms = scan_delay_10ms;
             //gScanDelay_10ms = 1;   // 10ms
             break;
+#endif
         }
         case SCAN_CSS_STATE_SCANNING: {
             uint32_t cdcssFreq;
@@ -49,6 +49,9 @@ extern bool              gScanUseCssResult;
 void SCANNER_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 void SCANNER_Start(bool singleFreq);
 void SCANNER_Stop(void);
+#ifdef ENABLE_FAST_CAPTURE
+void SCANNER_Poll(void);
+#endif
 void SCANNER_TimeSlice10ms(void);
 void SCANNER_TimeSlice500ms(void);
 bool SCANNER_IsScanning(void);
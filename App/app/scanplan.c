@@ -0,0 +1,165 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "app/scanplan.h"
+#ifdef ENABLE_SCAN_FASTHOP
+    #include "app/scanhop.h"
+#endif
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+static struct
+{
+    uint8_t Channels[MR_CHANNEL_LAST + 1]; // eligible channels, ascending
+    uint8_t Count;
+    uint8_t Priority[2];
+    uint8_t PriorityCount;
+
+    // Position in Channels times two; odd means between two entries,
+    // which is where a scan starting on a non eligible channel begins.
+    int16_t Pos2;
+    uint8_t LastRegular;
+    uint8_t Phase;
+
+    // what the plan was built from, besides attributes and exclusions
+    bool    Valid;
+    uint8_t List;
+    bool    Enabled;
+    uint8_t Prio1;
+    uint8_t Prio2;
+} Plan;
+
+static bool ListEnabled(uint8_t List)
+{
+    return (List > 0 && List < 4) ? gEeprom.SCAN_LIST_ENABLED[List - 1] : true;
+}
+
+static uint8_t PriorityOf(const uint8_t *pTable, uint8_t List)
+{
+    return (List > 0 && List < 4) ? pTable[List - 1] : 0xFF;
+}
+
+static bool IsCurrent(void)
+{
+    const uint8_t List = gEeprom.SCAN_LIST_DEFAULT;
+
+    return Plan.Valid
+        && Plan.List == List
+        && Plan.Enabled == ListEnabled(List)
+        && Plan.Prio1 == PriorityOf(gEeprom.SCANLIST_PRIORITY_CH1, List)
+        && Plan.Prio2 == PriorityOf(gEeprom.SCANLIST_PRIORITY_CH2, List);
+}
+
+static void Build(void)
+{
+    const uint8_t List = gEeprom.SCAN_LIST_DEFAULT;
+
+    Plan.List = List;
+    Plan.Enabled = ListEnabled(List);
+    Plan.Prio1 = PriorityOf(gEeprom.SCANLIST_PRIORITY_CH1, List);
+    Plan.Prio2 = PriorityOf(gEeprom.SCANLIST_PRIORITY_CH2, List);
+
+    Plan.Count = 0;
+    for (uint8_t i = MR_CHANNEL_FIRST; IS_MR_CHANNEL(i); i++)
+    {
+        if (RADIO_CheckValidChannel(i, true, List))
+            Plan.Channels[Plan.Count++] = i;
+    }
+
+    // the priority channels are not required to be in the list
+    Plan.PriorityCount = 0;
+    if (Plan.Enabled)
+    {
+        if (RADIO_CheckValidChannel(Plan.Prio1, false, List))
+            Plan.Priority[Plan.PriorityCount++] = Plan.Prio1;
+        if (RADIO_CheckValidChannel(Plan.Prio2, false, List))
+            Plan.Priority[Plan.PriorityCount++] = Plan.Prio2;
+    }
+
+    // resume the regular sequence where it was
+    uint8_t Lo = 0;
+    while (Lo < Plan.Count && Plan.Channels[Lo] < Plan.LastRegular)
+        Lo++;
+
+    if (Lo < Plan.Count && Plan.Channels[Lo] == Plan.LastRegular)
+        Plan.Pos2 = 2 * Lo;
+    else
+        Plan.Pos2 = 2 * Lo - 1;
+
+    if (Plan.Phase > Plan.PriorityCount + SCAN_PRIORITY_RATIO)
+        Plan.Phase = 0;
+
+    Plan.Valid = true;
+}
+
+void SCANPLAN_Reset(uint8_t Channel)
+{
+    Plan.LastRegular = Channel;
+    Plan.Phase = 0;
+    Plan.Valid = false;
+}
+
+void SCANPLAN_Invalidate(void)
+{
+    Plan.Valid = false;
+#ifdef ENABLE_SCAN_FASTHOP
+    SCANHOP_Reset();    // the channel settings behind the profiles changed too
+#endif
+}
+
+// Channel to visit after the current one, a few compares at most
+uint8_t SCANPLAN_Next(int8_t Direction)
+{
+    if (!IsCurrent())
+        Build();
+
+    // priority channels first, then SCAN_PRIORITY_RATIO regular hops
+    if (Plan.Phase < Plan.PriorityCount)
+        return Plan.Priority[Plan.Phase++];
+
+    if (++Plan.Phase >= Plan.PriorityCount + SCAN_PRIORITY_RATIO)
+        Plan.Phase = 0;
+
+    if (Plan.Count == 0)
+        return MR_CHANNEL_FIRST;
+
+    const bool Between = Plan.Pos2 & 1;
+    int16_t Index;
+    if (Direction > 0)
+        Index = Between ? (Plan.Pos2 + 1) / 2 : Plan.Pos2 / 2 + 1;
+    else
+        Index = Between ? (Plan.Pos2 - 1) / 2 : Plan.Pos2 / 2 - 1;
+
+    if (Index >= Plan.Count)
+        Index = 0;
+    else if (Index < 0)
+        Index = Plan.Count - 1;
+
+    Plan.Pos2 = 2 * Index;
+    Plan.LastRegular = Plan.Channels[Index];
+
+    return Plan.LastRegular;
+}
+
+uint8_t SCANPLAN_GetCount(void)
+{
+    return Plan.Count;
+}
+
+const uint8_t *SCANPLAN_GetChannels(void)
+{
+    return Plan.Channels;
+}
@@ -0,0 +1,37 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANPLAN_H
+#define APP_SCANPLAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Regular channel hops between two visits of the priority channels
+#ifndef SCAN_PRIORITY_RATIO
+    #define SCAN_PRIORITY_RATIO 1
+#endif
+
+// The plan is the list of channels a memory scan visits, built once from
+// the scan list, the channel attributes and the exclusions, so that a hop
+// no longer has to search for the next eligible channel.
+
+void    SCANPLAN_Reset(uint8_t Channel);
+void    SCANPLAN_Invalidate(void);
+uint8_t SCANPLAN_Next(int8_t Direction);
+uint8_t SCANPLAN_GetCount(void);
+const uint8_t *SCANPLAN_GetChannels(void);
+
+#endif
@@ -0,0 +1,242 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/app.h"
+#include "app/chFrScanner.h"
+#include "app/scanranges.h"
+#include "driver/py25q16.h"
+#include "frequencies.h"
+
+#define SCAN_RANGES_MAGIC 0x474E5253 // "SRNG"
+
+typedef struct
+{
+    uint32_t    Magic;
+    uint8_t     Count;
+    uint8_t     Padding[3];
+    ScanRange_t Ranges[SCAN_RANGES_MAX];
+} Store_t;
+
+static Store_t  Store;
+
+static bool     Active;
+static uint32_t Shown;      // range start put on the main screen
+static bool     Begun;
+static uint8_t  Current;
+static int16_t  Credit[SCAN_RANGES_MAX];
+static uint32_t Position[SCAN_RANGES_MAX];
+
+// VFO settings from before the scan
+static struct {
+    uint8_t Modulation;
+    uint8_t Bandwidth;
+    uint8_t Step;
+} Saved;
+
+static bool IsValid(const ScanRange_t *pRange)
+{
+    return pRange->Start      <  pRange->Stop
+        && pRange->Start      >= frequencyBandTable[0].lower
+        && pRange->Stop       <= frequencyBandTable[BAND_N_ELEM - 1].upper
+        && pRange->Step       <  STEP_N_ELEM
+        && pRange->Modulation <  MODULATION_UKNOWN
+        && pRange->Bandwidth  <= BANDWIDTH_NARROW;
+}
+
+static void Apply(VFO_Info_t *pInfo, uint8_t Modulation, uint8_t Bandwidth, uint8_t Step)
+{
+    pInfo->Modulation        = Modulation;
+    pInfo->CHANNEL_BANDWIDTH = Bandwidth;
+    pInfo->STEP_SETTING      = Step;
+    pInfo->StepFrequency     = gStepFrequencyTable[Step];
+}
+
+static void Mirror(uint8_t Index)
+{
+    // the main screen shows the range being scanned
+    gScanRangeStart = Store.Ranges[Index].Start;
+    gScanRangeStop  = Store.Ranges[Index].Stop;
+    Shown           = gScanRangeStart;
+}
+
+static void Restart(void)
+{
+    for (unsigned int i = 0; i < Store.Count; i++) {
+        Credit[i]   = 0;
+        Position[i] = Store.Ranges[i].Stop;    // first hop up wraps to Start
+    }
+
+    Current = SCAN_RANGES_MAX;
+}
+
+static int FirstEnabled(void)
+{
+    for (unsigned int i = 0; i < Store.Count; i++)
+        if (Store.Ranges[i].Weight)
+            return i;
+    return -1;
+}
+
+void SCANRANGES_Init(void)
+{
+    PY25Q16_ReadBuffer(SCAN_RANGES_FLASH_ADDR, &Store, sizeof(Store));
+
+    if (Store.Magic != SCAN_RANGES_MAGIC || Store.Count > SCAN_RANGES_MAX) {
+        Store.Count = 0;
+        return;
+    }
+
+    // keep what is valid, in order
+    uint8_t Count = 0;
+    for (unsigned int i = 0; i < Store.Count; i++)
+        if (IsValid(&Store.Ranges[i]))
+            Store.Ranges[Count++] = Store.Ranges[i];
+    Store.Count = Count;
+}
+
+uint8_t SCANRANGES_GetCount(void)
+{
+    return Store.Count;
+}
+
+const ScanRange_t *SCANRANGES_Get(void)
+{
+    return Store.Ranges;
+}
+
+bool SCANRANGES_Set(const ScanRange_t *pRanges, uint8_t Count)
+{
+    if (Count > SCAN_RANGES_MAX)
+        return false;
+
+    for (unsigned int i = 0; i < Count; i++)
+        if (!IsValid(&pRanges[i]))
+            return false;
+
+    memset(&Store, 0xFF, sizeof(Store));
+    Store.Magic = SCAN_RANGES_MAGIC;
+    Store.Count = Count;
+    memcpy(Store.Ranges, pRanges, Count * sizeof(ScanRange_t));
+
+    PY25Q16_WriteBuffer(SCAN_RANGES_FLASH_ADDR, &Store, sizeof(Store), false);
+
+    // a running scan starts over on the new set
+    Restart();
+    if (Active && FirstEnabled() < 0)
+        SCANRANGES_Deactivate();
+
+    return true;
+}
+
+bool SCANRANGES_IsActive(void)
+{
+    // anything clearing or replacing the VFO range also ends the stored set
+    return Active && gScanRangeStart == Shown;
+}
+
+bool SCANRANGES_Activate(void)
+{
+    const int First = FirstEnabled();
+    if (First < 0)
+        return false;
+
+    Active = true;
+    Restart();
+    Mirror(First);
+    return true;
+}
+
+void SCANRANGES_Deactivate(void)
+{
+    if (!Active)
+        return;
+
+    Active          = false;
+    gScanRangeStart = 0;
+}
+
+void SCANRANGES_Begin(const VFO_Info_t *pInfo)
+{
+    Saved.Modulation = pInfo->Modulation;
+    Saved.Bandwidth  = pInfo->CHANNEL_BANDWIDTH;
+    Saved.Step       = pInfo->STEP_SETTING;
+
+    Restart();
+    Begun = true;
+}
+
+void SCANRANGES_Next(VFO_Info_t *pInfo, int8_t Direction)
+{
+    if (!Begun)
+        SCANRANGES_Begin(pInfo);
+
+    // smooth weighted round robin: every range earns its weight, the richest
+    // one hops and pays the total back, so heavy ranges are visited often
+    // without long runs on any one of them
+    int16_t  Total = 0;
+    uint8_t  Best  = SCAN_RANGES_MAX;
+
+    for (unsigned int i = 0; i < Store.Count; i++) {
+        const uint8_t Weight = Store.Ranges[i].Weight;
+        if (!Weight)
+            continue;
+
+        Credit[i] += Weight;
+        Total     += Weight;
+
+        if (Best == SCAN_RANGES_MAX || Credit[i] > Credit[Best])
+            Best = i;
+    }
+
+    if (Best == SCAN_RANGES_MAX) {
+        SCANRANGES_Deactivate();
+        return;
+    }
+
+    Credit[Best] -= Total;
+
+    const ScanRange_t *pRange = &Store.Ranges[Best];
+
+    if (Best != Current) {
+        Apply(pInfo, pRange->Modulation, pRange->Bandwidth, pRange->Step);
+        Mirror(Best);
+        Current = Best;
+    }
+
+    pInfo->freq_config_RX.Frequency = Position[Best];
+    Position[Best] = APP_SetFreqByStepAndLimits(pInfo, Direction, pRange->Start, pRange->Stop);
+    pInfo->freq_config_RX.Frequency = Position[Best];
+}
+
+void SCANRANGES_End(VFO_Info_t *pInfo, uint32_t Frequency)
+{
+    if (!Begun)
+        return;
+
+    Begun = false;
+
+    // a kept find takes the settings of its range
+    for (unsigned int i = 0; i < Store.Count; i++) {
+        const ScanRange_t *pRange = &Store.Ranges[i];
+        if (pRange->Weight && Frequency >= pRange->Start && Frequency <= pRange->Stop) {
+            Apply(pInfo, pRange->Modulation, pRange->Bandwidth, pRange->Step);
+            return;
+        }
+    }
+
+    Apply(pInfo, Saved.Modulation, Saved.Bandwidth, Saved.Step);
+}
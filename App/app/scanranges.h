@@ -0,0 +1,61 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANRANGES_H
+#define APP_SCANRANGES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "radio.h"
+
+#ifndef SCAN_RANGES_MAX
+    #define SCAN_RANGES_MAX 8
+#endif
+
+// SPI flash sector holding the range set
+#define SCAN_RANGES_FLASH_ADDR 0x120000
+
+typedef struct
+{
+    uint32_t Start;      // 10 Hz
+    uint32_t Stop;       // 10 Hz, inclusive
+    uint8_t  Step;       // STEP_Setting_t
+    uint8_t  Modulation; // ModulationMode_t
+    uint8_t  Bandwidth;  // BANDWIDTH_WIDE / BANDWIDTH_NARROW
+    uint8_t  Weight;     // hops per round against the other ranges, 0 = skipped
+} ScanRange_t;
+
+// Stored set of frequency ranges scanned in one pass. Each range keeps its
+// own position, step, modulation and bandwidth, and the hops are spread
+// over the ranges in proportion to their weights.
+
+void SCANRANGES_Init(void);
+
+uint8_t            SCANRANGES_GetCount(void);
+const ScanRange_t *SCANRANGES_Get(void);
+bool               SCANRANGES_Set(const ScanRange_t *pRanges, uint8_t Count);
+
+bool SCANRANGES_IsActive(void);
+bool SCANRANGES_Activate(void);
+void SCANRANGES_Deactivate(void);
+
+// scanner hooks, frequency mode only. End gives the VFO the settings of the
+// range holding Frequency, or back the ones from before the scan.
+void SCANRANGES_Begin(const VFO_Info_t *pInfo);
+void SCANRANGES_Next(VFO_Info_t *pInfo, int8_t Direction);
+void SCANRANGES_End(VFO_Info_t *pInfo, uint32_t Frequency);
+
+#endif
@@ -0,0 +1,262 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "app/generic.h"
+#include "app/scanstats.h"
+#include "audio.h"
+#include "driver/bk4819.h"
+#include "driver/crc.h"
+#include "driver/py25q16.h"
+#include "functions.h"
+#include "misc.h"
+#include "ui/ui.h"
+
+#define SCAN_STATS_MAGIC   0x54415453 // "STAT"
+#define SCAN_STATS_SECTOR  0x1000
+#define NO_ENTRY           0xFF
+
+typedef struct
+{
+    uint32_t   Magic;
+    uint32_t   Sequence;
+    uint32_t   Clock;
+    uint8_t    Count;
+    uint8_t    Padding;
+    uint16_t   Crc;
+    ScanStat_t Entries[SCAN_STATS_ENTRIES];
+} Store_t;
+
+static Store_t  Store;
+
+static uint8_t  Current = NO_ENTRY;  // entry of the squelch opened last
+static bool     HalfSecond;
+static bool     Dirty;
+static uint16_t CheckpointCountdown_500ms = SCAN_STATS_CHECKPOINT_500ms;
+
+uint8_t gScanStatsCursor;
+
+static uint16_t EntriesCrc(const Store_t *pStore)
+{
+    return CRC_Calculate(pStore->Entries, pStore->Count * sizeof(ScanStat_t));
+}
+
+static bool LoadSector(uint8_t Sector)
+{
+    const uint32_t Address = SCAN_STATS_FLASH_ADDR + Sector * SCAN_STATS_SECTOR;
+
+    PY25Q16_ReadBuffer(Address, &Store, sizeof(Store));
+
+    return Store.Magic == SCAN_STATS_MAGIC
+        && Store.Count <= SCAN_STATS_ENTRIES
+        && Store.Crc   == EntriesCrc(&Store);
+}
+
+static void Checkpoint(void)
+{
+    Store.Magic = SCAN_STATS_MAGIC;
+    Store.Sequence++;
+    Store.Crc   = EntriesCrc(&Store);
+
+    // even sequence numbers go to the first sector, so a failed write
+    // leaves the previous checkpoint in the other one
+    const uint32_t Address = SCAN_STATS_FLASH_ADDR + (Store.Sequence & 1) * SCAN_STATS_SECTOR;
+    PY25Q16_WriteBuffer(Address, &Store, sizeof(Store), false);
+
+    Dirty = false;
+}
+
+static void UpdatePeak(ScanStat_t *pEntry)
+{
+    const uint16_t Rssi = BK4819_GetRSSI() / 2;
+
+    if (Rssi > pEntry->PeakRssi)
+        pEntry->PeakRssi = (Rssi > UINT8_MAX) ? UINT8_MAX : Rssi;
+}
+
+static uint32_t GetKey(const VFO_Info_t *pInfo)
+{
+    if (IS_MR_CHANNEL(pInfo->CHANNEL_SAVE))
+        return pInfo->CHANNEL_SAVE;
+
+    const uint32_t Frequency = pInfo->pRX->Frequency;
+    return Frequency - (Frequency % SCAN_STATS_BIN);
+}
+
+static uint8_t FindOrAdd(uint32_t Key)
+{
+    uint8_t Victim = 0;
+
+    for (unsigned int i = 0; i < Store.Count; i++) {
+        const ScanStat_t *pEntry = &Store.Entries[i];
+        if (pEntry->Key == Key)
+            return i;
+
+        const ScanStat_t *pVictim = &Store.Entries[Victim];
+        if (pEntry->Hits < pVictim->Hits ||
+            (pEntry->Hits == pVictim->Hits && pEntry->LastHeard < pVictim->LastHeard))
+            Victim = i;
+    }
+
+    if (Store.Count < SCAN_STATS_ENTRIES)
+        Victim = Store.Count++;
+
+    memset(&Store.Entries[Victim], 0, sizeof(ScanStat_t));
+    Store.Entries[Victim].Key = Key;
+    return Victim;
+}
+
+void SCANSTATS_Init(void)
+{
+    // the newest checkpoint that reads back intact wins
+    uint32_t Sequence[2];
+
+    for (uint8_t Sector = 0; Sector < 2; Sector++)
+        PY25Q16_ReadBuffer(SCAN_STATS_FLASH_ADDR + Sector * SCAN_STATS_SECTOR + offsetof(Store_t, Sequence), &Sequence[Sector], sizeof(Sequence[0]));
+
+    const uint8_t Newest = (int32_t)(Sequence[1] - Sequence[0]) > 0;
+
+    if (LoadSector(Newest) || LoadSector(!Newest))
+        return;
+
+    memset(&Store, 0, sizeof(Store));
+}
+
+void SCANSTATS_Open(const VFO_Info_t *pInfo)
+{
+    Current = FindOrAdd(GetKey(pInfo));
+
+    ScanStat_t *pEntry = &Store.Entries[Current];
+    if (pEntry->Hits < UINT16_MAX)
+        pEntry->Hits++;
+    pEntry->LastHeard = Store.Clock;
+    UpdatePeak(pEntry);
+
+    Dirty = true;
+}
+
+void SCANSTATS_TimeSlice500ms(void)
+{
+    HalfSecond = !HalfSecond;
+    if (!HalfSecond)
+        Store.Clock++;
+
+    if (gCurrentFunction == FUNCTION_RECEIVE && Current != NO_ENTRY) {
+        ScanStat_t *pEntry = &Store.Entries[Current];
+
+        pEntry->OpenTime++;
+        pEntry->LastHeard = Store.Clock;
+        UpdatePeak(pEntry);
+
+        if (gScreenToDisplay == DISPLAY_SCAN_STATS)
+            gUpdateDisplay = true;
+    }
+
+    if (--CheckpointCountdown_500ms == 0) {
+        CheckpointCountdown_500ms = SCAN_STATS_CHECKPOINT_500ms;
+
+        // nothing is written while a transmission is going on
+        if (Dirty && gCurrentFunction != FUNCTION_TRANSMIT)
+            Checkpoint();
+    }
+}
+
+void SCANSTATS_Clear(void)
+{
+    Store.Count      = 0;
+    Current          = NO_ENTRY;
+    gScanStatsCursor = 0;
+    Checkpoint();
+}
+
+uint32_t SCANSTATS_GetClock(void)
+{
+    return Store.Clock;
+}
+
+uint8_t SCANSTATS_GetCount(void)
+{
+    return Store.Count;
+}
+
+const ScanStat_t *SCANSTATS_Get(void)
+{
+    return Store.Entries;
+}
+
+uint8_t SCANSTATS_Rank(uint8_t *pOrder)
+{
+    // insertion sort, most hits first, then longest open
+    for (unsigned int i = 0; i < Store.Count; i++) {
+        const ScanStat_t *pEntry = &Store.Entries[i];
+        unsigned int j = i;
+
+        for (; j > 0; j--) {
+            const ScanStat_t *pPrev = &Store.Entries[pOrder[j - 1]];
+            if (pPrev->Hits > pEntry->Hits ||
+                (pPrev->Hits == pEntry->Hits && pPrev->OpenTime >= pEntry->OpenTime))
+                break;
+            pOrder[j] = pOrder[j - 1];
+        }
+
+        pOrder[j] = i;
+    }
+
+    return Store.Count;
+}
+
+void SCANSTATS_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+    if (Key == KEY_PTT) {
+        GENERIC_Key_PTT(bKeyPressed);
+        return;
+    }
+
+    if (!bKeyPressed)
+        return;
+
+    switch (Key) {
+        case KEY_UP:
+        case KEY_DOWN:
+            if (Store.Count) {
+                gScanStatsCursor = NUMBER_AddWithWraparound(gScanStatsCursor, (Key == KEY_UP) ? -1 : 1, 0, Store.Count - 1);
+                gUpdateDisplay   = true;
+            }
+            return;
+
+        case KEY_STAR:
+            // hold to clear
+            if (bKeyHeld && Store.Count) {
+                SCANSTATS_Clear();
+                gBeepToPlay    = BEEP_880HZ_60MS_DOUBLE_BEEP;
+                gUpdateDisplay = true;
+            }
+            return;
+
+        case KEY_EXIT:
+            if (!bKeyHeld) {
+                gBeepToPlay           = BEEP_1KHZ_60MS_OPTIONAL;
+                gRequestDisplayScreen = DISPLAY_MAIN;
+            }
+            return;
+
+        default:
+            if (!bKeyHeld)
+                gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+            return;
+    }
+}
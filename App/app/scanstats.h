@@ -0,0 +1,71 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SCANSTATS_H
+#define APP_SCANSTATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/keyboard.h"
+#include "misc.h"
+#include "radio.h"
+
+// Channels and frequency bins tracked at once
+#ifndef SCAN_STATS_ENTRIES
+    #define SCAN_STATS_ENTRIES 16
+#endif
+
+// Two SPI flash sectors, checkpoints are written to them in turn
+#define SCAN_STATS_FLASH_ADDR 0x121000
+
+// Width of a frequency bin, 10 Hz
+#define SCAN_STATS_BIN 250
+
+// Time between checkpoints of a changed table
+#define SCAN_STATS_CHECKPOINT_500ms 1200
+
+typedef struct
+{
+    uint32_t Key;        // MR channel, or start of the frequency bin (10 Hz)
+    uint32_t LastHeard;  // recorder clock, seconds
+    uint32_t OpenTime;   // squelch open, 500 ms
+    uint16_t Hits;       // squelch openings
+    uint8_t  PeakRssi;   // dBm + 160
+    uint8_t  Padding;
+} ScanStat_t;
+
+#define SCAN_STATS_IS_CHANNEL(Key) ((Key) <= MR_CHANNEL_LAST)
+
+// Channel activity recorder. Every squelch opening counts a hit for the
+// memory channel or frequency bin, and the open time, last heard time and
+// peak RSSI are kept while it stays open. When the table is full the entry
+// with the fewest hits gives way.
+
+extern uint8_t gScanStatsCursor;
+
+void SCANSTATS_Init(void);
+void SCANSTATS_Open(const VFO_Info_t *pInfo);
+void SCANSTATS_TimeSlice500ms(void);
+void SCANSTATS_Clear(void);
+
+uint32_t          SCANSTATS_GetClock(void);
+uint8_t           SCANSTATS_GetCount(void);
+const ScanStat_t *SCANSTATS_Get(void);
+uint8_t           SCANSTATS_Rank(uint8_t *pOrder);
+
+void SCANSTATS_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
+
+#endif
@@ -24,6 +24,7 @@
 
 #include "driver/backlight.h"
 #include "frequencies.h"
+#include "helper/format.h"
 #include "ui/helper.h"
 #include "ui/main.h"
 
@@ -35,6 +36,22 @@
 #include "driver/py25q16.h"
 #endif
 
+#ifdef ENABLE_RX_DELTA
+#include "app/rxdelta.h"
+#endif
+
+#ifdef ENABLE_SPECTRUM_STREAM
+#include "app/spectrum_stream.h"
+#endif
+
+#ifdef ENABLE_SPECTRUM_REC
+#include "app/spectrum_rec.h"
+#endif
+
+#ifdef ENABLE_SPECTRUM_BENCH
+#include "app/spectrum_bench.h"
+#endif
+
 struct FrequencyBandInfo
 {
     uint32_t lower;
@@ -59,6 +76,9 @@ bool newScanStart = true;
 bool preventKeypress = true;
 bool audioState = true;
 bool lockAGC = false;
+#ifdef ENABLE_SPECTRUM_BENCH
+static bool benchInSweep; // only sweep bins count, not listening or still mode
+#endif
 
 State currentState = SPECTRUM, previousState = SPECTRUM;
 
@@ -230,19 +250,6 @@ static void SetRegMenuValue(uint8_t st, bool add)
     redrawScreen = true;
 }
 
-// GUI functions
-
-static void DrawVLine(int sy, int ey, int nx, bool fill)
-{
-    for (int i = sy; i <= ey; i++)
-    {
-        if (i < 56 && nx < 128)
-        {
-            PutPixel(nx, i, fill);
-        }
-    }
-}
-
 // Utility functions
 
 static KEY_Code_t GetKey()
@@ -309,6 +316,10 @@ static void RestoreRegisters(void)
         BK4819_WriteRegister(registers_to_save[i], registers_stack[i]);
     }
 
+#ifdef ENABLE_RX_DELTA
+    RXDELTA_Invalidate();   // only part of the RX setup is saved
+#endif
+
 #ifdef ENABLE_FEAT_F4HWN
     gVfoConfigureMode = VFO_CONFIGURE;
 #endif
@@ -429,6 +440,9 @@ static void TuneToPeak()
 
 static void DeInitSpectrum()
 {
+#ifdef ENABLE_SPECTRUM_REC
+    SPECREC_Flush();
+#endif
     SetF(initialFreq);
     RestoreRegisters();
     isInitialized = false;
@@ -441,13 +455,25 @@ uint8_t GetBWRegValueForScan()
 
 uint16_t GetRssi()
 {
+#ifdef ENABLE_SPECTRUM_BENCH
+    uint32_t stamp = SPECBENCH_Stamp();
+#endif
     // SYSTICK_DelayUs(800);
     // testing autodelay based on Glitch value
     while ((BK4819_ReadRegister(0x63) & 0b11111111) >= 255)
     {
         SYSTICK_DelayUs(100);
     }
+#ifdef ENABLE_SPECTRUM_BENCH
+    if (benchInSweep)
+        SPECBENCH_Add(SPECBENCH_SETTLE, stamp);
+    stamp = SPECBENCH_Stamp();
+#endif
     uint16_t rssi = BK4819_GetRSSI();
+#ifdef ENABLE_SPECTRUM_BENCH
+    if (benchInSweep)
+        SPECBENCH_Add(SPECBENCH_MEASURE, stamp);
+#endif
 #ifdef ENABLE_AM_FIX
     if (settings.modulationType == MODULATION_AM && gSetting_AM_fix)
         rssi += AM_fix_get_gain_diff() * 2;
@@ -1041,12 +1067,9 @@ static void UpdateSpectrumPeaks(uint16_t bars)
             }
 
             // Draw current value (solid bar)
-            if (rssi != RSSI_MAX_VALUE)
+            if (rssi != RSSI_MAX_VALUE && x > ox)
             {
-                for (uint8_t xx = ox; xx < x; xx++)
-                {
-                    DrawVLine(Rssi2Y(rssi), DrawingEndY, xx, true);
-                }
+                UI_FillRectangleBuffer(gFrameBuffer, ox, Rssi2Y(rssi), x - 1, DrawingEndY, true);
             }
             
             // Draw peak hold indicator (thin line at peak)
@@ -1081,7 +1104,7 @@ static void UpdateSpectrumPeaks(uint16_t bars)
             // Draw current value
             if (rssi != RSSI_MAX_VALUE)
             {
-                DrawVLine(Rssi2Y(rssi), DrawingEndY, x, true);
+                UI_DrawVLineBuffer(gFrameBuffer, x, Rssi2Y(rssi), DrawingEndY, true);
             }
             
             // Draw peak indicator
@@ -1192,7 +1215,9 @@ static void DrawStatus()
     sprintf(String, "%d/%d P:%d T:%d", settings.dbMin, settings.dbMax,
             Rssi2DBm(peak.rssi), Rssi2DBm(settings.rssiTriggerLevel));
 #else
-    sprintf(String, "%d/%d", settings.dbMin, settings.dbMax);
+    char *p = FORMAT_Signed(String, settings.dbMin, 0, ' ');
+    *p++ = '/';
+    FORMAT_Signed(p, settings.dbMax, 0, ' ');
 #endif
     GUI_DisplaySmallest(String, 0, 1, true, true);
 
@@ -1255,6 +1280,7 @@ static void ShowChannelName(uint32_t f)
     else
     {
         memset(&gStatusLine[36], 0, 100 - 28);
+        ST7565_MarkDirty(&gStatusLine[36], 100 - 28);
     }
     ST7565_BlitStatusLine();
 }
@@ -1262,7 +1288,7 @@ static void ShowChannelName(uint32_t f)
 
 static void DrawF(uint32_t f)
 {
-    sprintf(String, "%u.%05u", f / 100000, f % 100000);
+    FORMAT_Frequency(String, f, 0, ' ');
     UI_PrintStringSmallNormal(String, 8, 127, 0);
 
     sprintf(String, "%3s", gModulationStr[settings.modulationType]);
@@ -1283,35 +1309,36 @@ static void DrawNums()
 #ifdef ENABLE_SCAN_RANGES
         if (gScanRangeStart)
         {
-            sprintf(String, "%ux", GetStepsCountDisplay());
+            strcpy(FORMAT_Unsigned(String, GetStepsCountDisplay(), 0, ' '), "x");
         }
         else
 #endif
         {
-            sprintf(String, "%ux", GetStepsCount());
+            strcpy(FORMAT_Unsigned(String, GetStepsCount(), 0, ' '), "x");
         }
         GUI_DisplaySmallest(String, 0, 1, false, true);
-        sprintf(String, "%u.%02uk", GetScanStep() / 100, GetScanStep() % 100);
+        strcpy(FORMAT_Fixed(String, GetScanStep(), 2, 0, ' '), "k");
         GUI_DisplaySmallest(String, 0, 7, false, true);
     }
 
     if (IsCenterMode())
     {
-        sprintf(String, "%u.%05u \x7F%u.%02uk", currentFreq / 100000,
-                currentFreq % 100000, settings.frequencyChangeStep / 100,
-                settings.frequencyChangeStep % 100);
+        char *p = FORMAT_Frequency(String, currentFreq, 0, ' ');
+        *p++ = ' ';
+        *p++ = '\x7F';
+        strcpy(FORMAT_Fixed(p, settings.frequencyChangeStep, 2, 0, ' '), "k");
         GUI_DisplaySmallest(String, 36, 49, false, true);
     }
     else
     {
-        sprintf(String, "%u.%05u", GetFStart() / 100000, GetFStart() % 100000);
+        FORMAT_Frequency(String, GetFStart(), 0, ' ');
         GUI_DisplaySmallest(String, 0, 49, false, true);
 
-        sprintf(String, "\x7F%u.%02uk", settings.frequencyChangeStep / 100,
-                settings.frequencyChangeStep % 100);
+        String[0] = '\x7F';
+        strcpy(FORMAT_Fixed(String + 1, settings.frequencyChangeStep, 2, 0, ' '), "k");
         GUI_DisplaySmallest(String, 48, 49, false, true);
 
-        sprintf(String, "%u.%05u", GetFEnd() / 100000, GetFEnd() % 100000);
+        FORMAT_Frequency(String, GetFEnd(), 0, ' ');
         GUI_DisplaySmallest(String, 93, 49, false, true);
     }
 }
@@ -1371,6 +1398,176 @@ static void DrawArrow(uint8_t x)
     }
 }
 
+#ifdef ENABLE_SPECTRUM_BENCH
+// Walk every stepsCount / scanStepIndex pair once when the spectrum opens,
+// squelch held shut so the sweeps are never interrupted by listening
+static SpectrumSettings benchSavedSettings;
+
+static void BenchStart()
+{
+    benchSavedSettings = settings;
+    settings.stepsCount = STEPS_128;
+    settings.scanStepIndex = S_STEP_0_01kHz;
+    settings.rssiTriggerLevel = RSSI_MAX_VALUE - 1;
+    SPECBENCH_Start();
+    RelaunchScan();
+}
+
+static void BenchStop()
+{
+    if (!SPECBENCH_IsRunning())
+        return;
+
+    SPECBENCH_Stop();
+    settings = benchSavedSettings;
+}
+
+static void BenchNextSettings()
+{
+    if (settings.scanStepIndex < S_STEP_100_0kHz)
+    {
+        settings.scanStepIndex++;
+    }
+    else if (settings.stepsCount < STEPS_16)
+    {
+        settings.scanStepIndex = S_STEP_0_01kHz;
+        settings.stepsCount++;
+    }
+    else
+    {
+        BenchStop();
+    }
+
+    RelaunchScan();
+    ResetBlacklist();
+    newScanStart = true;
+    redrawScreen = true;
+}
+#endif
+
+#ifdef ENABLE_SPECTRUM_REC
+// Recorded waterfall, one pixel row per record interval, newest at the top
+#define HISTORY_ROWS       48
+#define HISTORY_Y          8
+#define HISTORY_10_MINUTES (10 * 60 * 100)
+
+static uint32_t historyTime; // recorder time of the top row
+
+static void EnterHistory()
+{
+    SPECREC_Flush();
+    historyTime = SPECREC_GetNewestTime();
+    SetState(HISTORY);
+}
+
+static void SeekHistory(int32_t delta)
+{
+    const uint32_t oldest = SPECREC_GetOldestTime();
+    const uint32_t newest = SPECREC_GetNewestTime();
+
+    if (delta < 0 && historyTime - oldest < (uint32_t)-delta)
+        historyTime = oldest;
+    else if (delta > 0 && newest - historyTime < (uint32_t)delta)
+        historyTime = newest;
+    else
+        historyTime += delta;
+
+    redrawScreen = true;
+}
+
+static void OnKeyDownHistory(uint8_t key)
+{
+    switch (key)
+    {
+    case KEY_UP:
+        SeekHistory(-HISTORY_ROWS * SPECREC_INTERVAL_10ms);
+        break;
+    case KEY_DOWN:
+        SeekHistory(HISTORY_ROWS * SPECREC_INTERVAL_10ms);
+        break;
+    case KEY_1:
+        SeekHistory(-HISTORY_10_MINUTES);
+        break;
+    case KEY_7:
+        SeekHistory(HISTORY_10_MINUTES);
+        break;
+    case KEY_STAR:
+        SPECREC_SetRecording(!SPECREC_IsRecording());
+        redrawScreen = true;
+        break;
+    case KEY_MENU:
+    case KEY_EXIT:
+        SetState(SPECTRUM);
+        newScanStart = true;
+        break;
+    default:
+        break;
+    }
+}
+
+static void RenderHistory()
+{
+    SPECREC_Sweep_t sweep;
+    uint32_t fStart = 0;
+    uint32_t fEnd = 0;
+    uint8_t topRow = HISTORY_ROWS;
+
+    const uint32_t span = (HISTORY_ROWS - 1) * SPECREC_INTERVAL_10ms;
+    uint32_t cursor = SPECREC_Seek(historyTime > span ? historyTime - span : 0);
+
+    while (SPECREC_Read(&cursor, &sweep) && sweep.Time <= historyTime)
+    {
+        const uint8_t row = (historyTime - sweep.Time) / SPECREC_INTERVAL_10ms;
+        if (row >= HISTORY_ROWS)
+            continue;
+
+        if (row < topRow)
+        {
+            topRow = row;
+            fStart = sweep.FStart;
+            fEnd = sweep.FStart + sweep.Step * sweep.Count;
+        }
+
+        const uint8_t y = HISTORY_Y + row;
+        for (uint8_t x = 0; x < 128; ++x)
+        {
+            const uint16_t rssi = sweep.Level[x * sweep.Count / 128] << 1;
+            if (rssi == 0)
+                continue;
+
+            int dbmin = settings.dbMin;
+            int dbmax = settings.dbMax;
+            if (dbmax <= dbmin)
+                dbmax = dbmin + 1;
+
+            int lev = (Rssi2DBm(rssi) - dbmin) * 15 / (dbmax - dbmin + 1);
+            if ((uint8_t)clamp(lev, 0, 15) > gBayer4x4[row & 3][x & 3])
+                gFrameBuffer[y >> 3][x] |= 1 << (y & 7);
+        }
+    }
+
+    const uint32_t age = (SPECREC_GetNewestTime() - historyTime) / 100;
+    char *p = String;
+    *p++ = '-';
+    p = FORMAT_Unsigned(p, age / 3600, 0, ' ');
+    *p++ = ':';
+    FORMAT_Time(p, age % 3600);
+    GUI_DisplaySmallest(String, 0, 1, false, true);
+    GUI_DisplaySmallest(SPECREC_IsRecording() ? "REC" : "---", 116, 1, false, true);
+
+    if (topRow == HISTORY_ROWS)
+    {
+        GUI_DisplaySmallest(SPECREC_IsEmpty() ? "NO RECORDING" : "NO DATA", 40, 25, false, true);
+        return;
+    }
+
+    FORMAT_Frequency(String, fStart, 0, ' ');
+    GUI_DisplaySmallest(String, 0, 58, false, true);
+    FORMAT_Frequency(String, fEnd, 0, ' ');
+    GUI_DisplaySmallest(String, 93, 58, false, true);
+}
+#endif
+
 static void OnKeyDown(uint8_t key)
 {
     switch (key)
@@ -1448,6 +1645,9 @@ static void OnKeyDown(uint8_t key)
         TuneToPeak();
         break;
     case KEY_MENU:
+#ifdef ENABLE_SPECTRUM_REC
+        EnterHistory();
+#endif
         break;
     case KEY_EXIT:
         if (menuState)
@@ -1455,6 +1655,9 @@ static void OnKeyDown(uint8_t key)
             menuState = 0;
             break;
         }
+#ifdef ENABLE_SPECTRUM_BENCH
+        BenchStop();
+#endif
 #ifdef ENABLE_FEAT_F4HWN_SPECTRUM
         SaveSettings();
 #endif
@@ -1617,6 +1820,7 @@ static void RenderFreqInput() { UI_PrintString(freqInputString, 2, 127, 0, 8); }
 static void RenderStatus()
 {
     memset(gStatusLine, 0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
     DrawStatus();
     ST7565_BlitStatusLine();
 }
@@ -1661,9 +1865,10 @@ static void RenderStill()
 
     int dbm = Rssi2DBm(scanInfo.rssi);
     uint8_t s = DBm2S(dbm);
-    sprintf(String, "S: %u", s);
+    strcpy(String, "S: ");
+    FORMAT_Unsigned(String + 3, s, 0, ' ');
     GUI_DisplaySmallest(String, 4, 25, false, true);
-    sprintf(String, "%d dBm", dbm);
+    strcpy(FORMAT_Signed(String, dbm, 0, ' '), " dBm");
     GUI_DisplaySmallest(String, 28, 25, false, true);
 
     if (!monitorMode)
@@ -1737,6 +1942,11 @@ static void Render()
     case STILL:
         RenderStill();
         break;
+#ifdef ENABLE_SPECTRUM_REC
+    case HISTORY:
+        RenderHistory();
+        break;
+#endif
     }
 
     ST7565_BlitFullScreen();
@@ -1773,6 +1983,11 @@ static bool HandleUserInput()
         case STILL:
             OnKeyDownStill(kbd.current);
             break;
+#ifdef ENABLE_SPECTRUM_REC
+        case HISTORY:
+            OnKeyDownHistory(kbd.current);
+            break;
+#endif
         }
     }
 
@@ -1787,8 +2002,17 @@ static void Scan()
 #endif
     )
     {
+#ifdef ENABLE_SPECTRUM_BENCH
+        const uint32_t stamp = SPECBENCH_Stamp();
+        SetF(scanInfo.f);
+        SPECBENCH_Add(SPECBENCH_TUNE, stamp);
+        benchInSweep = true;
+        Measure();
+        benchInSweep = false;
+#else
         SetF(scanInfo.f);
         Measure();
+#endif
         UpdateScanInfo();
     }
 }
@@ -1800,6 +2024,28 @@ static void NextScanStep()
     scanInfo.f += scanInfo.scanStep;
 }
 
+#if defined(ENABLE_SPECTRUM_STREAM) || defined(ENABLE_SPECTRUM_REC)
+static void ExportSweep()
+{
+    uint16_t steps = scanInfo.measurementsCount;
+    uint32_t step = scanInfo.scanStep;
+
+    // long scan ranges are folded into the 128 history bins
+    if (steps > ARRAY_SIZE(rssiHistory))
+    {
+        step = step * steps / ARRAY_SIZE(rssiHistory);
+        steps = ARRAY_SIZE(rssiHistory);
+    }
+
+#ifdef ENABLE_SPECTRUM_STREAM
+    SPECSTREAM_SendSweep(rssiHistory, steps, GetFStart(), step);
+#endif
+#ifdef ENABLE_SPECTRUM_REC
+    SPECREC_AddSweep(rssiHistory, steps, GetFStart(), step);
+#endif
+}
+#endif
+
 static void UpdateScan()
 {
     Scan();
@@ -1816,6 +2062,18 @@ static void UpdateScan()
 
     redrawScreen = true;
     preventKeypress = false;
+
+#if defined(ENABLE_SPECTRUM_STREAM) || defined(ENABLE_SPECTRUM_REC)
+    ExportSweep();
+#endif
+
+#ifdef ENABLE_SPECTRUM_BENCH
+    if (SPECBENCH_SweepDone(settings.stepsCount, settings.scanStepIndex, scanInfo.measurementsCount))
+    {
+        BenchNextSettings();
+        return;
+    }
+#endif
     
     UpdatePeakInfo();
     if (IsPeakOverLevel())
@@ -1936,6 +2194,9 @@ static void Tick()
     {
         HandleUserInput();
     }
+#ifdef ENABLE_SPECTRUM_REC
+    SPECREC_Tick();
+#endif
     if (newScanStart)
     {
         InitScan();
@@ -1964,7 +2225,13 @@ static void Tick()
     }
     if (redrawScreen)
     {
+#ifdef ENABLE_SPECTRUM_BENCH
+        const uint32_t stamp = SPECBENCH_Stamp();
+        Render();
+        SPECBENCH_Add(SPECBENCH_RENDER, stamp);
+#else
         Render();
+#endif
         // For screenshot
         #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
             getScreenShot(false);
@@ -2047,6 +2314,14 @@ void APP_RunSpectrum()
     waterfall_phase = 0;
     waterfall_scan_count = 0;
 
+#ifdef ENABLE_SPECTRUM_REC
+    SPECREC_Init();
+#endif
+
+#ifdef ENABLE_SPECTRUM_BENCH
+    BenchStart();
+#endif
+
     isInitialized = true;
 
     while (isInitialized)
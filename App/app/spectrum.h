@@ -99,8 +99,14 @@ static const uint16_t scanStepBWRegValues[] = {
     0b0110110001001000, // 6.25
     // 1250
     0b0111111100001000, // 6.25
+    // 1500
+    0b0011011000101000, // 25
+    // 2000
+    0b0011011000101000, // 25
     // 2500
     0b0011011000101000, // 25
+    // 5000
+    0b0011011000101000, // 25
     // 10000
     0b0011011000101000, // 25
 };
@@ -116,6 +122,9 @@ typedef enum State
     SPECTRUM,
     FREQ_INPUT,
     STILL,
+#ifdef ENABLE_SPECTRUM_REC
+    HISTORY,
+#endif
 } State;
 
 typedef enum StepsCount
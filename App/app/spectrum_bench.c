@@ -0,0 +1,115 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/spectrum_bench.h"
+#include "driver/uart.h"
+#include "external/printf/printf.h"
+#include "version.h"
+
+// Results go out on the UART as one JSON object per line:
+//
+//   {"bench":"spectrum","fw":"...","steps_count":1,"scan_step":12,"bins":64,
+//    "sweeps":4,"sweep_us":123456,"tune_us":210,"settle_us":900,
+//    "measure_us":35,"render_us":8500,"renders":4}
+//
+// tune/settle/measure are per measured bin, render is per call, sweep_us
+// is the wall time of a whole sweep including everything else the loop does.
+
+static bool     Running;
+static bool     WarmUp;
+static uint8_t  Sweeps;
+static uint32_t Start;
+static uint32_t Total[SPECBENCH_PHASES];
+static uint16_t Count[SPECBENCH_PHASES];
+
+static void Reset(void)
+{
+    Sweeps = 0;
+    memset(Total, 0, sizeof(Total));
+    memset(Count, 0, sizeof(Count));
+    Start = SPECBENCH_Stamp();
+}
+
+void SPECBENCH_Start(void)
+{
+    Running = true;
+    WarmUp = true;
+    Reset();
+}
+
+bool SPECBENCH_IsRunning(void)
+{
+    return Running;
+}
+
+void SPECBENCH_Add(SPECBENCH_Phase_t Phase, uint32_t Since)
+{
+    if (!Running)
+        return;
+
+    Total[Phase] += SPECBENCH_Stamp() - Since;
+    Count[Phase]++;
+}
+
+static uint32_t Average(SPECBENCH_Phase_t Phase)
+{
+    return Count[Phase] ? Total[Phase] / Count[Phase] : 0;
+}
+
+// Returns true once enough sweeps were measured for the current settings,
+// the caller then moves on to the next combination.
+bool SPECBENCH_SweepDone(uint8_t StepsCount, uint8_t ScanStepIndex, uint16_t Bins)
+{
+    if (!Running)
+        return false;
+
+    if (WarmUp)
+    {
+        WarmUp = false;
+        Reset();
+        return false;
+    }
+
+    if (++Sweeps < SPECBENCH_SWEEPS)
+        return false;
+
+    const uint32_t Elapsed = SPECBENCH_Stamp() - Start;
+    char Line[256];
+
+    const int Len = snprintf(Line, sizeof(Line),
+        "{\"bench\":\"spectrum\",\"fw\":\"%s\",\"steps_count\":%u,\"scan_step\":%u,"
+        "\"bins\":%u,\"sweeps\":%u,\"sweep_us\":%lu,\"tune_us\":%lu,\"settle_us\":%lu,"
+        "\"measure_us\":%lu,\"render_us\":%lu,\"renders\":%u}\r\n",
+        Version, StepsCount, ScanStepIndex,
+        Bins, Sweeps, (unsigned long)(Elapsed / Sweeps),
+        (unsigned long)Average(SPECBENCH_TUNE),
+        (unsigned long)Average(SPECBENCH_SETTLE),
+        (unsigned long)Average(SPECBENCH_MEASURE),
+        (unsigned long)Average(SPECBENCH_RENDER), Count[SPECBENCH_RENDER]);
+
+    UART_Send(Line, Len);
+
+    // next combination starts with a warm-up sweep too
+    WarmUp = true;
+    Reset();
+    return true;
+}
+
+void SPECBENCH_Stop(void)
+{
+    Running = false;
+}
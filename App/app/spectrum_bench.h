@@ -0,0 +1,48 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SPECTRUM_BENCH_H
+#define APP_SPECTRUM_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/systick.h"
+
+// sweeps measured for each stepsCount / scanStepIndex pair,
+// after one warm-up sweep that is not counted
+#define SPECBENCH_SWEEPS 4
+
+typedef enum
+{
+    SPECBENCH_TUNE,
+    SPECBENCH_SETTLE,
+    SPECBENCH_MEASURE,
+    SPECBENCH_RENDER,
+    SPECBENCH_PHASES
+} SPECBENCH_Phase_t;
+
+static inline uint32_t SPECBENCH_Stamp(void)
+{
+    return SYSTICK_GetUs();
+}
+
+void SPECBENCH_Start(void);
+bool SPECBENCH_IsRunning(void);
+void SPECBENCH_Add(SPECBENCH_Phase_t Phase, uint32_t Since);
+bool SPECBENCH_SweepDone(uint8_t StepsCount, uint8_t ScanStepIndex, uint16_t Bins);
+void SPECBENCH_Stop(void);
+
+#endif
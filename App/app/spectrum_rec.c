@@ -0,0 +1,539 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/spectrum_rec.h"
+#include "driver/py25q16.h"
+#include "scheduler.h"
+
+// Layout of the ring:
+//
+//   sector  = SectorHeader_t, then records back to back, 0xFF after the last one
+//   record  = RecordHeader_t, then Len bytes of compressed levels
+//
+// Sectors are filled in order and carry an increasing Seq, so the valid
+// ones always form a contiguous run ending at HeadSector. The sector after
+// the head is erased ahead of time, which keeps the erase off the sweep path,
+// but only once something is recorded: entering the spectrum costs no wear.
+//
+// Level compression, one token per bin, starting from level 0:
+//   0ddddddd   7 bit signed delta to the previous level
+//   10nnnnnn   n + 1 bins equal to the previous level
+//   11000000   followed by the absolute level
+
+#define SECTOR_SIZE 0x1000
+#define PAGE_SIZE   0x100
+#define RING_SIZE   0x200 // RAM staging, multiple of PAGE_SIZE
+
+#define SECTOR_MAGIC 0x43455253 // "SREC"
+#define RECORD_TAG   0x5A
+
+#define TOKEN_RUN 0x80
+#define TOKEN_ABS 0xC0
+
+#define MAX_BINS    128
+#define MAX_PAYLOAD (2 * MAX_BINS)
+
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Seq;
+    uint32_t FirstTime;
+    uint32_t Reserved;
+} SectorHeader_t;
+
+typedef struct
+{
+    uint8_t  Tag;
+    uint8_t  Count;
+    uint16_t Len;
+    uint32_t Time;
+    uint32_t FStart;
+    uint32_t Step;
+} RecordHeader_t;
+
+// [FlushAddr, WriteAddr) is staged in Ring at the same offset modulo RING_SIZE,
+// so a page never wraps around the end of the buffer.
+static uint8_t  Ring[RING_SIZE];
+static uint32_t WriteAddr;
+static uint32_t FlushAddr;
+
+static uint16_t HeadSector;
+static uint32_t HeadSeq;
+static uint16_t ValidSectors;
+static uint32_t ClockOffset;
+static uint32_t NewestTime;
+
+static bool Recording = false;   // off until asked for, * in the history view
+static bool Initialized;
+static bool SectorFull;
+static bool NextErased;         // the sector after the head is erased or erasing
+
+// max hold of the sweeps seen during the current interval
+static uint8_t  Acc[MAX_BINS];
+static uint8_t  AccCount;
+static uint32_t AccFStart;
+static uint32_t AccStep;
+static uint32_t AccTime;
+
+static uint8_t Payload[MAX_PAYLOAD];
+
+static inline uint32_t SectorAddr(uint16_t Index)
+{
+    return SPECREC_FLASH_BASE + (uint32_t)Index * SECTOR_SIZE;
+}
+
+static inline uint16_t SectorOf(uint32_t Addr)
+{
+    return (Addr - SPECREC_FLASH_BASE) / SECTOR_SIZE;
+}
+
+// Index of the sector Back positions older than the head
+static inline uint16_t SectorBack(uint16_t Back)
+{
+    return (HeadSector + SPECREC_FLASH_SECTORS - Back) % SPECREC_FLASH_SECTORS;
+}
+
+static inline uint32_t Now(void)
+{
+    return gGlobalSysTickCounter + ClockOffset;
+}
+
+static bool ReadSectorHeader(uint16_t Index, SectorHeader_t *pHeader)
+{
+    PY25Q16_ReadBuffer(SectorAddr(Index), pHeader, sizeof(*pHeader));
+    return pHeader->Magic == SECTOR_MAGIC;
+}
+
+static bool ReadRecordHeader(uint32_t Addr, uint32_t End, RecordHeader_t *pHeader)
+{
+    if (Addr + sizeof(*pHeader) > End)
+        return false;
+
+    PY25Q16_ReadBuffer(Addr, pHeader, sizeof(*pHeader));
+
+    return pHeader->Tag == RECORD_TAG
+        && pHeader->Count && pHeader->Count <= MAX_BINS
+        && pHeader->Len <= MAX_PAYLOAD
+        && Addr + sizeof(*pHeader) + pHeader->Len <= End;
+}
+
+static uint16_t Encode(const uint8_t *pLevel, uint8_t Count, uint8_t *pOut)
+{
+    uint8_t *p = pOut;
+    uint8_t prev = 0;
+
+    for (uint8_t i = 0; i < Count;)
+    {
+        const int16_t delta = pLevel[i] - prev;
+
+        if (delta == 0)
+        {
+            uint8_t run = 1;
+            while (i + run < Count && run < 64 && pLevel[i + run] == prev)
+                run++;
+            *p++ = TOKEN_RUN | (run - 1);
+            i += run;
+            continue;
+        }
+
+        if (delta >= -64 && delta <= 63)
+        {
+            *p++ = delta & 0x7F;
+        }
+        else
+        {
+            *p++ = TOKEN_ABS;
+            *p++ = pLevel[i];
+        }
+
+        prev = pLevel[i++];
+    }
+
+    return p - pOut;
+}
+
+static bool Decode(const uint8_t *pIn, uint16_t Len, uint8_t *pLevel, uint8_t Count)
+{
+    const uint8_t *pEnd = pIn + Len;
+    uint8_t prev = 0;
+    uint8_t n = 0;
+
+    while (pIn < pEnd && n < Count)
+    {
+        const uint8_t token = *pIn++;
+
+        if (token < TOKEN_RUN)
+        {
+            prev += (int8_t)(token << 1) >> 1;
+            pLevel[n++] = prev;
+        }
+        else if (token < TOKEN_ABS)
+        {
+            for (uint8_t run = (token & 0x3F) + 1; run && n < Count; run--)
+                pLevel[n++] = prev;
+        }
+        else
+        {
+            if (pIn == pEnd)
+                return false;
+            prev = *pIn++;
+            pLevel[n++] = prev;
+        }
+    }
+
+    return n == Count;
+}
+
+static void Stage(const void *pData, uint16_t Size)
+{
+    const uint8_t *p = pData;
+    while (Size--)
+        Ring[WriteAddr++ % RING_SIZE] = *p++;
+}
+
+static void Program(uint32_t Size)
+{
+    PY25Q16_WriteBuffer(FlushAddr, Ring + FlushAddr % RING_SIZE, Size, true);
+    FlushAddr += Size;
+}
+
+static void FlushRing(void)
+{
+    while (FlushAddr != WriteAddr)
+    {
+        uint32_t Size = PAGE_SIZE - FlushAddr % PAGE_SIZE;
+        if (Size > WriteAddr - FlushAddr)
+            Size = WriteAddr - FlushAddr;
+        Program(Size);
+    }
+}
+
+// Erase the sector after the head, giving up its (oldest) records
+static void PrepareNextSector(void)
+{
+    SectorHeader_t Header;
+    const uint16_t Next = (HeadSector + 1) % SPECREC_FLASH_SECTORS;
+
+    if (ReadSectorHeader(Next, &Header) && ValidSectors)
+        ValidSectors--;
+
+    PY25Q16_SectorEraseAsync(SectorAddr(Next));
+    NextErased = true;
+}
+
+static void OpenSector(uint32_t Time)
+{
+    const SectorHeader_t Header = {
+        .Magic = SECTOR_MAGIC,
+        .Seq = ++HeadSeq,
+        .FirstTime = Time,
+        .Reserved = 0xFFFFFFFF,
+    };
+
+    HeadSector = (HeadSector + 1) % SPECREC_FLASH_SECTORS;
+    ValidSectors++;
+
+    WriteAddr = FlushAddr = SectorAddr(HeadSector);
+    Stage(&Header, sizeof(Header));
+
+    PrepareNextSector();
+}
+
+// Stage the accumulated sweep, false if it has to wait for the flash
+static bool Emit(void)
+{
+    const RecordHeader_t Header = {
+        .Tag = RECORD_TAG,
+        .Count = AccCount,
+        .Len = Encode(Acc, AccCount, Payload),
+        .Time = AccTime,
+        .FStart = AccFStart,
+        .Step = AccStep,
+    };
+    const uint16_t Size = sizeof(Header) + Header.Len;
+
+    if (WriteAddr + Size > SectorAddr(HeadSector) + SECTOR_SIZE)
+    {
+        // a record never spans two sectors, start the next one once
+        // everything is programmed and its erase has completed
+        if (FlushAddr != WriteAddr || PY25Q16_IsBusy())
+        {
+            SectorFull = true;
+            return false;
+        }
+        SectorFull = false;
+        OpenSector(Header.Time);
+    }
+
+    if (RING_SIZE - (WriteAddr - FlushAddr) < Size)
+        return false;
+
+    Stage(&Header, sizeof(Header));
+    Stage(Payload, Header.Len);
+    NewestTime = Header.Time;
+
+    return true;
+}
+
+void SPECREC_Init(void)
+{
+    SectorHeader_t Header;
+    bool Found = false;
+
+    HeadSector = SPECREC_FLASH_SECTORS - 1;
+    HeadSeq = 0;
+    ValidSectors = 0;
+    NewestTime = 0;
+    AccCount = 0;
+    SectorFull = false;
+
+    for (uint16_t i = 0; i < SPECREC_FLASH_SECTORS; i++)
+    {
+        if (!ReadSectorHeader(i, &Header))
+            continue;
+
+        ValidSectors++;
+        if (!Found || (int32_t)(Header.Seq - HeadSeq) > 0)
+        {
+            Found = true;
+            HeadSector = i;
+            HeadSeq = Header.Seq;
+            NewestTime = Header.FirstTime;
+        }
+    }
+
+    // the next record opens a new sector unless the head has room left
+    WriteAddr = SectorAddr(HeadSector) + SECTOR_SIZE;
+
+    if (Found)
+    {
+        RecordHeader_t Record;
+        uint32_t Addr = SectorAddr(HeadSector) + sizeof(SectorHeader_t);
+        const uint32_t End = SectorAddr(HeadSector) + SECTOR_SIZE;
+
+        while (ReadRecordHeader(Addr, End, &Record))
+        {
+            NewestTime = Record.Time;
+            Addr += sizeof(Record) + Record.Len;
+        }
+
+        // anything but erased flash after the last record means an
+        // interrupted write, leave the rest of that sector alone
+        if (Addr < End)
+        {
+            PY25Q16_ReadBuffer(Addr, &Record.Tag, 1);
+            if (Record.Tag == 0xFF)
+                WriteAddr = Addr;
+        }
+    }
+
+    FlushAddr = WriteAddr;
+
+    // keep the recorder clock running from the last recorded sweep
+    ClockOffset = NewestTime + 1 - gGlobalSysTickCounter;
+
+    // the next sector is erased with the first recorded sweep
+    NextErased = false;
+
+    Initialized = true;
+}
+
+void SPECREC_AddSweep(const uint16_t *pRssi, uint8_t Count, uint32_t FStart, uint32_t Step)
+{
+    if (!Initialized || !Recording || Count == 0 || Count > MAX_BINS)
+        return;
+
+    if (AccCount && (Count != AccCount || FStart != AccFStart || Step != AccStep))
+    {
+        // span changed, close the record even if it is too early
+        Emit();
+        AccCount = 0;
+    }
+
+    if (!NextErased)
+        PrepareNextSector();
+
+    if (!AccCount)
+    {
+        AccCount = Count;
+        AccFStart = FStart;
+        AccStep = Step;
+        AccTime = Now();
+        memset(Acc, 0, sizeof(Acc));
+    }
+
+    for (uint8_t i = 0; i < Count; i++)
+    {
+        // 0xFFFF marks a blacklisted bin
+        const uint16_t Level = pRssi[i] == 0xFFFF ? 0 : pRssi[i] >> 1;
+        const uint8_t  Clamped = Level > 0xFF ? 0xFF : Level;
+        if (Acc[i] < Clamped)
+            Acc[i] = Clamped;
+    }
+
+    if (Now() - AccTime >= SPECREC_INTERVAL_10ms && Emit())
+        AccCount = 0;
+}
+
+void SPECREC_Tick(void)
+{
+    if (!Initialized || FlushAddr == WriteAddr || PY25Q16_IsBusy())
+        return;
+
+    // whole pages only, unless the sector is done and its tail is all
+    // that stands between the next record and a fresh sector
+    uint32_t Size = PAGE_SIZE - FlushAddr % PAGE_SIZE;
+    if (WriteAddr - FlushAddr < Size)
+    {
+        if (!SectorFull)
+            return;
+        Size = WriteAddr - FlushAddr;
+    }
+
+    Program(Size);
+}
+
+void SPECREC_Flush(void)
+{
+    if (!Initialized)
+        return;
+
+    FlushRing();
+
+    if (AccCount && Emit())
+        AccCount = 0;
+
+    FlushRing();
+}
+
+bool SPECREC_IsRecording(void)
+{
+    return Recording;
+}
+
+void SPECREC_SetRecording(bool Enable)
+{
+    if (!Enable)
+        SPECREC_Flush();
+
+    Recording = Enable;
+    AccCount = 0;
+}
+
+bool SPECREC_IsEmpty(void)
+{
+    return ValidSectors == 0;
+}
+
+static uint32_t FirstTimeOf(uint16_t Back)
+{
+    SectorHeader_t Header;
+    ReadSectorHeader(SectorBack(Back), &Header);
+    return Header.FirstTime;
+}
+
+uint32_t SPECREC_GetOldestTime(void)
+{
+    return ValidSectors ? FirstTimeOf(ValidSectors - 1) : 0;
+}
+
+uint32_t SPECREC_GetNewestTime(void)
+{
+    return NewestTime;
+}
+
+// Cursor of the first record at or after Time (the oldest one if Time is
+// before the start of the recording)
+uint32_t SPECREC_Seek(uint32_t Time)
+{
+    SPECREC_Sweep_t Sweep;
+    int16_t Lo = 0;
+    int16_t Hi = ValidSectors - 1;
+    int16_t Back = Hi;
+
+    if (ValidSectors == 0)
+        return FlushAddr;
+
+    // newest sector starting at or before Time
+    while (Lo <= Hi)
+    {
+        const int16_t Mid = (Lo + Hi) / 2;
+        if (FirstTimeOf(Mid) <= Time)
+        {
+            Back = Mid;
+            Hi = Mid - 1;
+        }
+        else
+        {
+            Lo = Mid + 1;
+        }
+    }
+
+    uint32_t Cursor = SectorAddr(SectorBack(Back)) + sizeof(SectorHeader_t);
+
+    for (;;)
+    {
+        const uint32_t Prev = Cursor;
+        if (!SPECREC_Read(&Cursor, &Sweep) || Sweep.Time >= Time)
+            return Prev;
+    }
+}
+
+bool SPECREC_Read(uint32_t *pCursor, SPECREC_Sweep_t *pSweep)
+{
+    RecordHeader_t Header;
+
+    if (ValidSectors == 0)
+        return false;
+
+    for (;;)
+    {
+        const uint32_t Addr = *pCursor;
+        // a cursor is never at the very start of a sector, only at its end
+        const uint16_t Sector = SectorOf(Addr - 1);
+        uint32_t       End = SectorAddr(Sector) + SECTOR_SIZE;
+
+        // staged records are not in flash yet, and a record is only
+        // read back once its last byte is programmed
+        if (Sector == HeadSector)
+        {
+            if (Addr >= FlushAddr)
+                return false;
+            End = FlushAddr;
+        }
+
+        if (ReadRecordHeader(Addr, End, &Header))
+        {
+            PY25Q16_ReadBuffer(Addr + sizeof(Header), Payload, Header.Len);
+            if (Decode(Payload, Header.Len, pSweep->Level, Header.Count))
+            {
+                pSweep->Time = Header.Time;
+                pSweep->FStart = Header.FStart;
+                pSweep->Step = Header.Step;
+                pSweep->Count = Header.Count;
+                *pCursor = Addr + sizeof(Header) + Header.Len;
+                return true;
+            }
+        }
+
+        // end of this sector, carry on with the next newer one
+        if (Sector == HeadSector)
+            return false;
+
+        *pCursor = SectorAddr((Sector + 1) % SPECREC_FLASH_SECTORS) + sizeof(SectorHeader_t);
+    }
+}
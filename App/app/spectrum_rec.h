@@ -0,0 +1,52 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SPECTRUM_REC_H
+#define APP_SPECTRUM_REC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Flash ring used by the sweep recorder (1 MB, 256 sectors)
+#define SPECREC_FLASH_BASE    0x020000
+#define SPECREC_FLASH_SECTORS 256
+
+// one record (max hold of all sweeps seen) per interval
+#define SPECREC_INTERVAL_10ms 100
+
+typedef struct
+{
+    uint32_t Time;    // recorder clock, 10 ms ticks
+    uint32_t FStart;  // 10 Hz
+    uint32_t Step;    // 10 Hz
+    uint8_t  Count;
+    uint8_t  Level[128]; // RSSI / 2
+} SPECREC_Sweep_t;
+
+void SPECREC_Init(void);
+void SPECREC_AddSweep(const uint16_t *pRssi, uint8_t Count, uint32_t FStart, uint32_t Step);
+void SPECREC_Tick(void);
+void SPECREC_Flush(void);
+
+bool SPECREC_IsRecording(void);
+void SPECREC_SetRecording(bool Enable);
+
+bool     SPECREC_IsEmpty(void);
+uint32_t SPECREC_GetOldestTime(void);
+uint32_t SPECREC_GetNewestTime(void);
+uint32_t SPECREC_Seek(uint32_t Time);
+bool     SPECREC_Read(uint32_t *pCursor, SPECREC_Sweep_t *pSweep);
+
+#endif
@@ -0,0 +1,103 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "app/spectrum_stream.h"
+#include "driver/vcp.h"
+#include "scheduler.h"
+
+#define HEADER_SIZE  5
+#define FIXED_SIZE   (2 + 4 + 4 + 4 + 1 + 2)
+#define MAX_BINS     128
+// worst case: every delta escaped, plus check byte and trailer
+#define MAX_FRAME    (HEADER_SIZE + FIXED_SIZE + (MAX_BINS - 1) * 3 + 1 + 1)
+
+#define DELTA_ESCAPE 0x80
+
+// Owned by the USB IN endpoint until the transfer completes,
+// so it is only rewritten once VCP_TxReady() says so.
+static uint8_t  Frame[MAX_FRAME];
+static uint16_t Seq;
+static uint16_t Dropped;
+
+static uint8_t *Put16(uint8_t *p, uint16_t v)
+{
+    *p++ = v >> 8;
+    *p++ = v;
+    return p;
+}
+
+static uint8_t *Put32(uint8_t *p, uint32_t v)
+{
+    p = Put16(p, v >> 16);
+    return Put16(p, v);
+}
+
+void SPECSTREAM_SendSweep(const uint16_t *pRssi, uint8_t Count, uint32_t FStart, uint32_t Step)
+{
+    if (Count == 0 || Count > MAX_BINS)
+        return;
+
+    const uint16_t seq = Seq++;
+
+    if (!VCP_TxReady())
+    {
+        // no host listening is not a drop, a busy endpoint is
+        if (VCP_IsOpen())
+            Dropped++;
+        return;
+    }
+
+    uint8_t *p = Frame + HEADER_SIZE;
+    p = Put16(p, seq);
+    p = Put32(p, gGlobalSysTickCounter * 10);
+    p = Put32(p, FStart);
+    p = Put32(p, Step);
+    *p++ = Count;
+    p = Put16(p, pRssi[0]);
+
+    for (uint8_t i = 1; i < Count; i++)
+    {
+        const int32_t delta = (int32_t)pRssi[i] - pRssi[i - 1];
+        if (delta >= -127 && delta <= 127)
+        {
+            *p++ = (uint8_t)(int8_t)delta;
+        }
+        else
+        {
+            *p++ = DELTA_ESCAPE;
+            p = Put16(p, pRssi[i]);
+        }
+    }
+
+    uint8_t check = 0;
+    for (const uint8_t *q = Frame + HEADER_SIZE; q < p; q++)
+        check ^= *q;
+    *p++ = check;
+
+    const uint16_t len = p - (Frame + HEADER_SIZE);
+    Frame[0] = 0xAA;
+    Frame[1] = 0x55;
+    Frame[2] = SPECSTREAM_TYPE_SWEEP;
+    Put16(Frame + 3, len);
+    *p++ = 0x0A;
+
+    if (!VCP_TrySendAsync(Frame, p - Frame))
+        Dropped++;
+}
+
+uint16_t SPECSTREAM_GetDropped(void)
+{
+    return Dropped;
+}
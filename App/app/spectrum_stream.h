@@ -0,0 +1,42 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef APP_SPECTRUM_STREAM_H
+#define APP_SPECTRUM_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Sweep frame, sent over USB CDC when the host asserts DTR.
+// Multi-byte fields are big endian, like the screenshot frames.
+//
+//   AA 55 03 lenHi lenLo  payload[len]  0A
+//
+// payload:
+//   u16 seq        incremented for every completed sweep, gaps = dropped
+//   u32 time       ms since boot (10 ms resolution)
+//   u32 fStart     frequency of bin 0, in 10 Hz
+//   u32 step       bin spacing, in 10 Hz
+//   u8  count      number of bins (1..128)
+//   u16 bin[0]     raw BK4819 RSSI
+//   bin[1..]       s8 delta to previous bin, or 0x80 + raw u16 if it does not fit
+//   u8  check      XOR of all preceding payload bytes
+
+#define SPECSTREAM_TYPE_SWEEP 0x03
+
+void SPECSTREAM_SendSweep(const uint16_t *pRssi, uint8_t Count, uint32_t FStart, uint32_t Step);
+uint16_t SPECSTREAM_GetDropped(void);
+
+#endif
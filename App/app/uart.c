@@ -23,6 +23,24 @@
 #ifdef ENABLE_FMRADIO
     #include "app/fm.h"
 #endif
+#ifdef ENABLE_PRIORITY_LOOKBACK
+    #include "app/lookback.h"
+#endif
+#ifdef ENABLE_SCAN_DWELL
+    #include "app/scandwell.h"
+#endif
+#ifdef ENABLE_SCAN_FASTHOP
+    #include "app/scanhop.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "app/scanjournal.h"
+#endif
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    #include "app/scanranges.h"
+#endif
+#ifdef ENABLE_SCAN_STATS
+    #include "app/scanstats.h"
+#endif
 #include "app/uart.h"
 #include "board.h"
 #include "py32f071_ll_dma.h"
@@ -32,11 +50,23 @@
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    #include "driver/st7565.h"
+    #include "ui/ui.h"
+#endif
+#ifdef ENABLE_UI_PROFILER
+    #include "ui/profiler.h"
+#endif
+#ifdef ENABLE_SCREENSHOT_USB
+    #include "screenshot.h"
+#endif
+
 #if defined(ENABLE_UART)
 #include "driver/uart.h"
 #endif
 
 #if defined(ENABLE_USB)
+#include "driver/systick.h"
 #include "driver/vcp.h"
 #endif
 
@@ -160,6 +190,203 @@ typedef struct {
 } CMD_052F_t;
 #endif
 
+#ifdef ENABLE_MULTI_SCAN_RANGES
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+} CMD_0540_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint8_t     Count;
+        uint8_t     Padding[3];
+        ScanRange_t Ranges[SCAN_RANGES_MAX];
+    } Data;
+} REPLY_0541_t;
+
+typedef struct {
+    Header_t    Header;
+    uint32_t    Timestamp;
+    uint8_t     Count;
+    uint8_t     Padding[3];
+    ScanRange_t Ranges[0];
+} CMD_0542_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        bool    bAccepted;
+        uint8_t Count;
+        uint8_t Padding[2];
+    } Data;
+} REPLY_0543_t;
+#endif
+
+#ifdef ENABLE_SCAN_STATS
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    uint8_t  Index;
+    bool     bClear;
+    uint8_t  Padding[2];
+} CMD_0544_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint32_t   Clock;
+        uint8_t    Count;
+        uint8_t    Index;
+        uint8_t    Padding[2];
+        ScanStat_t Entries[8];
+    } Data;
+} REPLY_0545_t;
+#endif
+
+#ifdef ENABLE_PRIORITY_LOOKBACK
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    bool     bClear;
+    uint8_t  Padding[3];
+} CMD_0546_t;
+
+typedef struct {
+    Header_t        Header;
+    LookbackStats_t Data;
+} REPLY_0547_t;
+#endif
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+} CMD_054A_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        ST7565_Stats_t Lcd;
+        uint32_t       UiUsPerSecond;
+    } Data;
+} REPLY_054B_t;
+
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    uint8_t  Prescaler;
+    uint8_t  Padding[3];
+} CMD_054C_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint8_t Prescaler;
+        uint8_t Padding[3];
+    } Data;
+} REPLY_054D_t;
+#endif
+
+#ifdef ENABLE_UI_PROFILER
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    uint8_t  Index;
+    bool     bClear;
+    uint8_t  Overlay;   // 0 off, 1 on, anything else leaves it
+    uint8_t  Padding;
+} CMD_054E_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint8_t Count;
+        uint8_t Index;
+        bool    bOverlay;
+        uint8_t Padding;
+        struct {
+            char           Name[4];
+            ProfilerSlot_t Slot;
+        } Entries[3];
+    } Data;
+} REPLY_054F_t;
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    uint16_t Index;
+    bool     bClear;
+    uint8_t  Padding;
+} CMD_0548_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint32_t           Clock;
+        uint16_t           Count;
+        uint16_t           Index;
+        ScanJournalEntry_t Entries[8];
+    } Data;
+} REPLY_0549_t;
+#endif
+
+#ifdef ENABLE_SCREENSHOT_USB
+typedef struct {
+    Header_t Header;
+    uint8_t  Interval;
+    uint8_t  Credits;
+    bool     bRefresh;
+    uint8_t  Padding;
+} CMD_0550_t;
+#endif
+
+#ifdef ENABLE_SCAN_FASTHOP
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+    bool     bClear;
+    uint8_t  Padding[3];
+} CMD_0552_t;
+
+typedef struct {
+    Header_t       Header;
+    ScanhopStats_t Data;
+} REPLY_0553_t;
+#endif
+
+#ifdef ENABLE_SCAN_DWELL
+typedef struct {
+    Header_t Header;
+    uint32_t Timestamp;
+} CMD_0554_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        DwellThresholds_t Bands[BAND_N_ELEM];
+        uint8_t           Padding;
+    } Data;
+} REPLY_0555_t;
+
+typedef struct {
+    Header_t          Header;
+    uint32_t          Timestamp;
+    DwellThresholds_t Bands[BAND_N_ELEM];
+    uint8_t           Padding;
+} CMD_0556_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        bool    bAccepted;
+        uint8_t Padding[3];
+    } Data;
+} REPLY_0557_t;
+#endif
+
 static const uint8_t Obfuscation[16] =
 {
     0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80
@@ -201,6 +428,17 @@ static void SendReply_VCP(void *pReply, uint16_t Size)
         return;
     }
 
+    // The last reply may still be queued or on the wire, 20 ms is plenty
+    // for a stream frame ahead of it. A host that stopped reading loses it.
+    for (uint8_t i = 0; VCP_IsSending(VCP_ReplyBuf); i++)
+    {
+        if (i == 200)
+        {
+            return;
+        }
+        SYSTICK_DelayUs(100);
+    }
+
     memcpy(VCP_ReplyBuf + sizeof(Header_t), pReply, Size);
 
     Header_t *pHeader = (Header_t *)VCP_ReplyBuf;
@@ -600,130 +838,656 @@ static void CMD_052F(uint32_t Port, const uint8_t *pBuffer)
 }
 #endif
 
-#ifdef ENABLE_UART_RW_BK_REGS
-static void CMD_0601_ReadBK4819Reg(uint32_t Port, const uint8_t *pBuffer)
+#ifdef ENABLE_MULTI_SCAN_RANGES
+// read scan ranges
+static void CMD_0540(uint32_t Port, const uint8_t *pBuffer)
 {
-    typedef struct  __attribute__((__packed__)) {
-        Header_t header;
-        uint8_t reg;
-    } CMD_0601_t;
+    const CMD_0540_t *pCmd = (const CMD_0540_t *)pBuffer;
+    REPLY_0541_t      Reply;
 
-    CMD_0601_t *cmd = (CMD_0601_t*) pBuffer;
+    uint32_t Timestamp = 0;
 
-    struct __attribute__((__packed__)) {
-        Header_t header;
-        struct __attribute__((__packed__)) {
-            uint8_t reg;
-            uint16_t value;
-        } data;
-    } reply;
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
 
-    reply.header.ID = 0x0601;
-    reply.header.Size = sizeof(reply.data);
-    reply.data.reg = cmd->reg;
-    reply.data.value = BK4819_ReadRegister(cmd->reg);
-    SendReply(Port, &reply, sizeof(reply));
-}
+    if (pCmd->Timestamp != Timestamp)
+        return;
 
-static void CMD_0602_WriteBK4819Reg(const uint8_t *pBuffer)
-{
-    typedef struct __attribute__((__packed__)) {
-        Header_t header;
-        uint8_t reg;
-        uint16_t value;
-    } CMD_0602_t;
+    gSerialConfigCountDown_500ms = 12; // 6 sec
 
-    CMD_0602_t *cmd = (CMD_0602_t*) pBuffer;
-    BK4819_WriteRegister(cmd->reg, cmd->value);
+    const uint8_t Count = SCANRANGES_GetCount();
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0541;
+    Reply.Header.Size = 4 + Count * sizeof(ScanRange_t);
+    Reply.Data.Count  = Count;
+    memcpy(Reply.Data.Ranges, SCANRANGES_Get(), Count * sizeof(ScanRange_t));
+
+    SendReply(Port, &Reply, sizeof(Reply.Header) + Reply.Header.Size);
 }
-#endif
 
-bool UART_IsCommandAvailable(uint32_t Port)
+// write scan ranges
+static void CMD_0542(uint32_t Port, const uint8_t *pBuffer)
 {
-    uint16_t Index;
-    uint16_t TailIndex;
-    uint16_t Size;
-    uint16_t Crc;
-    uint16_t CommandLength;
-    uint16_t DmaLength;
-    uint8_t *ReadBuf;
-    uint16_t ReadBufSize;
-    uint16_t *pReadPointer;
-    UART_Command_t *pUART_Command;
+    const CMD_0542_t *pCmd = (const CMD_0542_t *)pBuffer;
+    REPLY_0543_t      Reply;
 
-    if(0){}
+    uint32_t Timestamp = 0;
+
+    if(0) {}
 #if defined(ENABLE_UART)
     else if (Port == UART_PORT_UART)
     {
-        DmaLength = sizeof(UART_DMA_Buffer) - LL_DMA_GetDataLength(DMA1, DMA_CHANNEL);
-        ReadBuf = UART_DMA_Buffer;
-        ReadBufSize = sizeof(UART_DMA_Buffer);
-        pReadPointer = &gUART_WriteIndex;
-        pUART_Command = &UART_Command;
+        Timestamp = UART_Timestamp;
     }
 #endif
 #if defined(ENABLE_USB)
     else if (Port == UART_PORT_VCP)
     {
-        DmaLength = VCP_RxBufPointer;
-        ReadBuf = VCP_RxBuf;
-        ReadBufSize = sizeof(VCP_RxBuf);
-        pReadPointer = &VCP_ReadIndex;
-        pUART_Command = &VCP_Command;
+        Timestamp = VCP_Timestamp;
     }
 #endif
     else
     {
-        return false;
+        return;
     }
 
-    while (1)
-    {
-        if ((*pReadPointer) == DmaLength)
-            return false;
-
-        while ((*pReadPointer) != DmaLength && ReadBuf[*pReadPointer] != 0xABU)
-            *pReadPointer = DMA_INDEX((*pReadPointer), 1, ReadBufSize);
-
-        if ((*pReadPointer) == DmaLength)
-            return false;
+    if (pCmd->Timestamp != Timestamp)
+        return;
 
-        if ((*pReadPointer) < DmaLength)
-            CommandLength = DmaLength - (*pReadPointer);
-        else
-            CommandLength = (DmaLength + ReadBufSize) - (*pReadPointer);
+    gSerialConfigCountDown_500ms = 12; // 6 sec
 
-        if (CommandLength < 8)
-            return 0;
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0543;
+    Reply.Header.Size = sizeof(Reply.Data);
 
-        if (ReadBuf[DMA_INDEX(*pReadPointer, 1, ReadBufSize)] == 0xCD)
-            break;
+    const bool bIsLocked = bHasCustomAesKey ? gIsLocked : false;
 
-        *pReadPointer = DMA_INDEX(*pReadPointer, 1, ReadBufSize);
-    }
+    if (!bIsLocked && pCmd->Header.Size >= 8 + pCmd->Count * sizeof(ScanRange_t))
+        Reply.Data.bAccepted = SCANRANGES_Set(pCmd->Ranges, pCmd->Count);
 
-    Index = DMA_INDEX(*pReadPointer, 2, ReadBufSize);
-    Size  = (ReadBuf[DMA_INDEX(Index, 1, ReadBufSize)] << 8) | ReadBuf[Index];
+    Reply.Data.Count = SCANRANGES_GetCount();
 
-    if ((Size + 8u) > ReadBufSize)
-    {
-        *pReadPointer = DmaLength;
-        return false;
-    }
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
 
-    if (CommandLength < (Size + 8))
-        return false;
+#ifdef ENABLE_SCAN_STATS
+// read (and clear) channel activity, 8 entries from Index on
+static void CMD_0544(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0544_t *pCmd = (const CMD_0544_t *)pBuffer;
+    REPLY_0545_t      Reply;
 
-    Index     = DMA_INDEX(Index, 2, ReadBufSize);
-    TailIndex = DMA_INDEX(Index, Size + 2, ReadBufSize);
+    uint32_t Timestamp = 0;
 
-    if (ReadBuf[TailIndex] != 0xDC || ReadBuf[DMA_INDEX(TailIndex, 1, ReadBufSize)] != 0xBA)
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
     {
-        *pReadPointer = DmaLength;
-        return false;
+        Timestamp = UART_Timestamp;
     }
-
-    if (TailIndex < Index)
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    if (pCmd->bClear)
+        SCANSTATS_Clear();
+
+    const uint8_t Count = SCANSTATS_GetCount();
+    uint8_t       Size  = 0;
+
+    if (pCmd->Index < Count) {
+        Size = Count - pCmd->Index;
+        if (Size > ARRAY_SIZE(Reply.Data.Entries))
+            Size = ARRAY_SIZE(Reply.Data.Entries);
+    }
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0545;
+    Reply.Header.Size = 8 + Size * sizeof(ScanStat_t);
+    Reply.Data.Clock  = SCANSTATS_GetClock();
+    Reply.Data.Count  = Count;
+    Reply.Data.Index  = pCmd->Index;
+    memcpy(Reply.Data.Entries, SCANSTATS_Get() + pCmd->Index, Size * sizeof(ScanStat_t));
+
+    SendReply(Port, &Reply, sizeof(Reply.Header) + Reply.Header.Size);
+}
+#endif
+
+#ifdef ENABLE_PRIORITY_LOOKBACK
+// read (and clear) the priority lookback counters and audio gaps
+static void CMD_0546(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0546_t *pCmd = (const CMD_0546_t *)pBuffer;
+    REPLY_0547_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0547;
+    Reply.Header.Size = sizeof(Reply.Data);
+    Reply.Data        = *LOOKBACK_GetStats();
+
+    if (pCmd->bClear)
+        LOOKBACK_ClearStats();
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+// read (and clear) the scan journal, 8 entries from Index on, newest first
+static void CMD_0548(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0548_t *pCmd = (const CMD_0548_t *)pBuffer;
+    REPLY_0549_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    if (pCmd->bClear)
+        SCANJOURNAL_Clear();
+
+    const uint16_t Count = SCANJOURNAL_GetCount();
+    uint8_t        Size  = 0;
+
+    memset(&Reply, 0, sizeof(Reply));
+
+    // an entry that does not read back intact goes out zeroed
+    for (uint16_t Index = pCmd->Index; Index < Count && Size < ARRAY_SIZE(Reply.Data.Entries); Index++, Size++) {
+        if (!SCANJOURNAL_Get(Index, &Reply.Data.Entries[Size]))
+            memset(&Reply.Data.Entries[Size], 0, sizeof(ScanJournalEntry_t));
+    }
+
+    Reply.Header.ID   = 0x0549;
+    Reply.Header.Size = 8 + Size * sizeof(ScanJournalEntry_t);
+    Reply.Data.Clock  = SCANJOURNAL_GetClock();
+    Reply.Data.Count  = Count;
+    Reply.Data.Index  = pCmd->Index;
+
+    SendReply(Port, &Reply, sizeof(Reply.Header) + Reply.Header.Size);
+}
+#endif
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+// read the LCD transfer counters
+static void CMD_054A(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_054A_t *pCmd = (const CMD_054A_t *)pBuffer;
+    REPLY_054B_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x054B;
+    Reply.Header.Size = sizeof(Reply.Data);
+    ST7565_GetStats(&Reply.Data.Lcd);
+    Reply.Data.UiUsPerSecond = UI_GetLoad();
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
+// change the LCD SPI clock and redraw, until the next power cycle
+static void CMD_054C(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_054C_t *pCmd = (const CMD_054C_t *)pBuffer;
+    REPLY_054D_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID      = 0x054D;
+    Reply.Header.Size    = sizeof(Reply.Data);
+    Reply.Data.Prescaler = ST7565_SetPrescaler(pCmd->Prescaler);
+
+    gUpdateStatus  = true;
+    gUpdateDisplay = true;
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_UI_PROFILER
+// read (and clear) the UI frame time histograms, 3 slots from Index on
+static void CMD_054E(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_054E_t *pCmd = (const CMD_054E_t *)pBuffer;
+    REPLY_054F_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    if (pCmd->Overlay <= 1)
+        PROFILER_SetOverlay(pCmd->Overlay);
+
+    uint8_t Size = 0;
+
+    memset(&Reply, 0, sizeof(Reply));
+    for (uint8_t Slot = pCmd->Index; Slot < PROFILER_SLOTS && Size < ARRAY_SIZE(Reply.Data.Entries); Slot++, Size++) {
+        strncpy(Reply.Data.Entries[Size].Name, PROFILER_GetName(Slot), sizeof(Reply.Data.Entries[Size].Name));
+        Reply.Data.Entries[Size].Slot = PROFILER_Get()[Slot];
+    }
+
+    Reply.Header.ID     = 0x054F;
+    Reply.Header.Size   = 4 + Size * sizeof(Reply.Data.Entries[0]);
+    Reply.Data.Count    = PROFILER_SLOTS;
+    Reply.Data.Index    = pCmd->Index;
+    Reply.Data.bOverlay = PROFILER_GetOverlay();
+
+    if (pCmd->bClear)
+        PROFILER_Clear();
+
+    SendReply(Port, &Reply, sizeof(Reply.Header) + Reply.Header.Size);
+}
+#endif
+
+#ifdef ENABLE_SCREENSHOT_USB
+// pace the USB screenshot stream, no reply: the frames are the answer
+static void CMD_0550(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0550_t *pCmd = (const CMD_0550_t *)pBuffer;
+
+    if (Port != UART_PORT_VCP || pCmd->Interval == 0)
+        return;
+
+    SCREENSHOT_SetPacing(pCmd->Interval, pCmd->Credits, pCmd->bRefresh);
+}
+#endif
+
+#ifdef ENABLE_SCAN_FASTHOP
+// read (and clear) the memory scan hop counters and timings
+static void CMD_0552(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0552_t *pCmd = (const CMD_0552_t *)pBuffer;
+    REPLY_0553_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0553;
+    Reply.Header.Size = sizeof(Reply.Data);
+    Reply.Data        = *SCANHOP_GetStats();
+
+    if (pCmd->bClear)
+        SCANHOP_ClearStats();
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_SCAN_DWELL
+// read the adaptive dwell limits of every band
+static void CMD_0554(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0554_t *pCmd = (const CMD_0554_t *)pBuffer;
+    REPLY_0555_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0555;
+    Reply.Header.Size = sizeof(Reply.Data);
+    memcpy(Reply.Data.Bands, SCANDWELL_GetThresholds(), sizeof(Reply.Data.Bands));
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
+// write the adaptive dwell limits of every band
+static void CMD_0556(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0556_t *pCmd = (const CMD_0556_t *)pBuffer;
+    REPLY_0557_t      Reply;
+
+    uint32_t Timestamp = 0;
+
+    if(0) {}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        Timestamp = UART_Timestamp;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        Timestamp = VCP_Timestamp;
+    }
+#endif
+    else
+    {
+        return;
+    }
+
+    if (pCmd->Timestamp != Timestamp)
+        return;
+
+    gSerialConfigCountDown_500ms = 12; // 6 sec
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0557;
+    Reply.Header.Size = sizeof(Reply.Data);
+
+    const bool bIsLocked = bHasCustomAesKey ? gIsLocked : false;
+
+    if (!bIsLocked && pCmd->Header.Size >= 4 + sizeof(pCmd->Bands))
+        Reply.Data.bAccepted = SCANDWELL_SetThresholds(pCmd->Bands);
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_UART_RW_BK_REGS
+static void CMD_0601_ReadBK4819Reg(uint32_t Port, const uint8_t *pBuffer)
+{
+    typedef struct  __attribute__((__packed__)) {
+        Header_t header;
+        uint8_t reg;
+    } CMD_0601_t;
+
+    CMD_0601_t *cmd = (CMD_0601_t*) pBuffer;
+
+    struct __attribute__((__packed__)) {
+        Header_t header;
+        struct __attribute__((__packed__)) {
+            uint8_t reg;
+            uint16_t value;
+        } data;
+    } reply;
+
+    reply.header.ID = 0x0601;
+    reply.header.Size = sizeof(reply.data);
+    reply.data.reg = cmd->reg;
+    reply.data.value = BK4819_ReadRegister(cmd->reg);
+    SendReply(Port, &reply, sizeof(reply));
+}
+
+static void CMD_0602_WriteBK4819Reg(const uint8_t *pBuffer)
+{
+    typedef struct __attribute__((__packed__)) {
+        Header_t header;
+        uint8_t reg;
+        uint16_t value;
+    } CMD_0602_t;
+
+    CMD_0602_t *cmd = (CMD_0602_t*) pBuffer;
+    BK4819_WriteRegister(cmd->reg, cmd->value);
+}
+#endif
+
+bool UART_IsCommandAvailable(uint32_t Port)
+{
+    uint16_t Index;
+    uint16_t TailIndex;
+    uint16_t Size;
+    uint16_t Crc;
+    uint16_t CommandLength;
+    uint16_t DmaLength;
+    uint8_t *ReadBuf;
+    uint16_t ReadBufSize;
+    uint16_t *pReadPointer;
+    UART_Command_t *pUART_Command;
+
+    if(0){}
+#if defined(ENABLE_UART)
+    else if (Port == UART_PORT_UART)
+    {
+        DmaLength = sizeof(UART_DMA_Buffer) - LL_DMA_GetDataLength(DMA1, DMA_CHANNEL);
+        ReadBuf = UART_DMA_Buffer;
+        ReadBufSize = sizeof(UART_DMA_Buffer);
+        pReadPointer = &gUART_WriteIndex;
+        pUART_Command = &UART_Command;
+    }
+#endif
+#if defined(ENABLE_USB)
+    else if (Port == UART_PORT_VCP)
+    {
+        DmaLength = VCP_RxBufPointer;
+        ReadBuf = VCP_RxBuf;
+        ReadBufSize = sizeof(VCP_RxBuf);
+        pReadPointer = &VCP_ReadIndex;
+        pUART_Command = &VCP_Command;
+    }
+#endif
+    else
+    {
+        return false;
+    }
+
+    while (1)
+    {
+        if ((*pReadPointer) == DmaLength)
+            return false;
+
+        while ((*pReadPointer) != DmaLength && ReadBuf[*pReadPointer] != 0xABU)
+            *pReadPointer = DMA_INDEX((*pReadPointer), 1, ReadBufSize);
+
+        if ((*pReadPointer) == DmaLength)
+            return false;
+
+        if ((*pReadPointer) < DmaLength)
+            CommandLength = DmaLength - (*pReadPointer);
+        else
+            CommandLength = (DmaLength + ReadBufSize) - (*pReadPointer);
+
+        if (CommandLength < 8)
+            return 0;
+
+        if (ReadBuf[DMA_INDEX(*pReadPointer, 1, ReadBufSize)] == 0xCD)
+            break;
+
+        *pReadPointer = DMA_INDEX(*pReadPointer, 1, ReadBufSize);
+    }
+
+    Index = DMA_INDEX(*pReadPointer, 2, ReadBufSize);
+    Size  = (ReadBuf[DMA_INDEX(Index, 1, ReadBufSize)] << 8) | ReadBuf[Index];
+
+    if ((Size + 8u) > ReadBufSize)
+    {
+        *pReadPointer = DmaLength;
+        return false;
+    }
+
+    if (CommandLength < (Size + 8))
+        return false;
+
+    Index     = DMA_INDEX(Index, 2, ReadBufSize);
+    TailIndex = DMA_INDEX(Index, Size + 2, ReadBufSize);
+
+    if (ReadBuf[TailIndex] != 0xDC || ReadBuf[DMA_INDEX(TailIndex, 1, ReadBufSize)] != 0xBA)
+    {
+        *pReadPointer = DmaLength;
+        return false;
+    }
+
+    if (TailIndex < Index)
     {
         const uint16_t ChunkSize = ReadBufSize - Index;
         memcpy(pUART_Command->Buffer, ReadBuf + Index, ChunkSize);
@@ -826,6 +1590,9 @@ void UART_HandleCommand(uint32_t Port)
 #endif
 
         case 0x05DD: // reset
+            #ifdef ENABLE_UART_DMA_TX
+                UART_Flush();
+            #endif
             #if defined(ENABLE_OVERLAY)
                 overlay_FLASH_RebootToBootloader();
             #else
@@ -833,6 +1600,72 @@ void UART_HandleCommand(uint32_t Port)
             #endif
             break;
 
+#ifdef ENABLE_MULTI_SCAN_RANGES
+        case 0x0540:
+            CMD_0540(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x0542:
+            CMD_0542(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_SCAN_STATS
+        case 0x0544:
+            CMD_0544(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_PRIORITY_LOOKBACK
+        case 0x0546:
+            CMD_0546(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+        case 0x0548:
+            CMD_0548(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+        case 0x054A:
+            CMD_054A(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x054C:
+            CMD_054C(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_UI_PROFILER
+        case 0x054E:
+            CMD_054E(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_SCREENSHOT_USB
+        case 0x0550:
+            CMD_0550(Port, pUART_Command->Buffer);
+            return; // a viewer asking for frames must not lock them
+#endif
+
+#ifdef ENABLE_SCAN_FASTHOP
+        case 0x0552:
+            CMD_0552(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_SCAN_DWELL
+        case 0x0554:
+            CMD_0554(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x0556:
+            CMD_0556(Port, pUART_Command->Buffer);
+            break;
+#endif
+
 #ifdef ENABLE_UART_RW_BK_REGS
         case 0x0601:
             CMD_0601_ReadBK4819Reg(Port, pUART_Command->Buffer);
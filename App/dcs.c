@@ -66,48 +66,92 @@ uint32_t DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option)
     return Code;
 }
 
+// Index of Value in the ascending DCS_Options, or -1
+static int DCS_FindOption(uint16_t Value)
+{
+    int Lo = 0;
+    int Hi = ARRAY_SIZE(DCS_Options) - 1;
+
+    while (Lo <= Hi)
+    {
+        const int Mid = (Lo + Hi) / 2;
+        if (DCS_Options[Mid] == Value)
+            return Mid;
+        if (DCS_Options[Mid] < Value)
+            Lo = Mid + 1;
+        else
+            Hi = Mid - 1;
+    }
+
+    return -1;
+}
+
+static uint32_t DCS_Rotate(uint32_t Word, unsigned int Count)
+{
+    return Count ? ((Word >> Count) | (Word << (23 - Count))) & 0x7FFFFFU : Word;
+}
+
+// Searches the 23 rotations of the received word for a normal code word,
+// lowest rotation first. A code word has 100 in bits 11..9, so only the
+// rotations that bring such a pattern there are looked up.
 uint8_t DCS_GetCdcssCode(uint32_t Code)
 {
-    unsigned int i;
-    for (i = 0; i < 23; i++)
+    // The reading has 24 bits. A set bit 23 rules out the unrotated word
+    // and, as it rotates in, lands on bit 0 of the others.
+    uint32_t Word = Code & 0x7FFFFFU;
+    uint32_t First = 0;
+    if (Code & 0x800000U)
     {
-        uint32_t Shift;
-
-        if (((Code >> 9) & 0x7U) == 4)
-        {
-            unsigned int j;
-            for (j = 0; j < ARRAY_SIZE(DCS_Options); j++)
-                if (DCS_Options[j] == (Code & 0x1FF))
-                    if (DCS_GetGolayCodeWord(2, j) == Code)
-                        return j;
-        }
-
-        Shift = Code >> 1;
-        if (Code & 1U)
-            Shift |= 0x400000U;
-        Code = Shift;
+        Word |= 1U;
+        First = 1;
+    }
+
+    // bit p of Marks: bit p set, bits p-1 and p-2 clear (cyclic); bit i of
+    // Candidates: rotation i puts such a p at bit 11
+    const uint32_t Marks = Word & ~DCS_Rotate(Word, 22) & ~DCS_Rotate(Word, 21);
+    uint32_t Candidates = DCS_Rotate(Marks, 11) >> First;
+
+    for (unsigned int i = First; Candidates; i++, Candidates >>= 1)
+    {
+        if ((Candidates & 1U) == 0)
+            continue;
+
+        const uint32_t Rotated = DCS_Rotate(Word, i);
+        const int Option = DCS_FindOption(Rotated & 0x1FF);
+        if (Option >= 0 && DCS_CalculateGolay((Rotated & 0x1FF) + 0x800U) == Rotated)
+            return Option;
     }
 
     return 0xFF;
 }
 
+// Nearest CTCSS_Options entry, the lower one on a tie, 0xFF when it is 5Hz
+// away or more
 uint8_t DCS_GetCtcssCode(int Code)
 {
-    unsigned int i;
-    uint8_t      Result = 0xFF;
-    int          Smallest = ARRAY_SIZE(CTCSS_Options);
+    int Lo = 0;
+    int Hi = ARRAY_SIZE(CTCSS_Options);
+
+    // first entry not below Code
+    while (Lo < Hi)
+    {
+        const int Mid = (Lo + Hi) / 2;
+        if (CTCSS_Options[Mid] < Code)
+            Lo = Mid + 1;
+        else
+            Hi = Mid;
+    }
+
+    int Result = -1;
+    int Smallest = ARRAY_SIZE(CTCSS_Options);
 
-    for (i = 0; i < ARRAY_SIZE(CTCSS_Options); i++)
+    if (Lo > 0 && Code - CTCSS_Options[Lo - 1] < Smallest)
     {
-        int Delta = Code - CTCSS_Options[i];
-        if (Delta < 0)
-            Delta = -(Code - CTCSS_Options[i]);
-        if (Smallest > Delta)
-        {
-            Smallest = Delta;
-            Result   = i;
-        }
+        Result   = Lo - 1;
+        Smallest = Code - CTCSS_Options[Lo - 1];
     }
+    if (Lo < (int)ARRAY_SIZE(CTCSS_Options) && CTCSS_Options[Lo] - Code < Smallest)
+        Result = Lo;
 
-    return Result;
+    return (Result < 0) ? 0xFF : Result;
 }
@@ -24,6 +24,9 @@
 #include "py32f071_ll_dma.h"
 #include "driver/system.h"
 #include "driver/systick.h"
+#ifdef ENABLE_UART_DMA_TX
+    #include "driver/uart.h"
+#endif
 #include "external/printf/printf.h"
 
 // #define DEBUG
@@ -37,10 +40,17 @@
 #define SECTOR_SIZE 0x1000
 #define PAGE_SIZE 0x100
 
+// Erase time the flash gets between a resume and the next suspend, so that
+// reads in a tight loop cannot hold the erase off for good (tRS)
+#define ERASE_RESUME_US 100
+
 static uint32_t SectorCacheAddr = 0x1000000;
 static uint8_t SectorCache[SECTOR_SIZE];
 static uint8_t BlackHole[1];
 static volatile bool TC_Flag;
+static bool EraseInFlight;
+static uint32_t EraseAddr;
+static uint32_t ResumeUs;
 
 static inline void CS_Assert()
 {
@@ -217,6 +227,9 @@ static void WriteEnable();
 static void SectorErase(uint32_t Addr);
 static void SectorProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
 static void PageProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
+static void WaitEraseDone();
+static bool SuspendErase();
+static void ResumeErase();
 
 void PY25Q16_Init()
 {
@@ -224,11 +237,26 @@ void PY25Q16_Init()
     SPI_Init();
 }
 
+// A read of the sector being erased waits for the erase, a read elsewhere
+// suspends it for the time of the read.
 void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
 {
 #ifdef DEBUG
     printf("spi flash read: %06x %ld\n", Address, Size);
 #endif
+    bool Suspended = false;
+    if (EraseInFlight)
+    {
+        if (Address < EraseAddr + SECTOR_SIZE && EraseAddr < Address + Size)
+        {
+            WaitEraseDone();
+        }
+        else
+        {
+            Suspended = SuspendErase();
+        }
+    }
+
     CS_Assert();
 
     SPI_WriteByte(0x03); // Fast read
@@ -247,6 +275,11 @@ void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
     }
 
     CS_Release();
+
+    if (Suspended)
+    {
+        ResumeErase();
+    }
 }
 
 void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append)
@@ -254,6 +287,8 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
 #ifdef DEBUG
     printf("spi flash write: %06x %ld %d\n", Address, Size, Append);
 #endif
+    WaitEraseDone();
+
     uint32_t SecIndex = Address / SECTOR_SIZE;
     uint32_t SecAddr = SecIndex * SECTOR_SIZE;
     uint32_t SecOffset = Address % SECTOR_SIZE;
@@ -317,6 +352,8 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
 
 void PY25Q16_SectorErase(uint32_t Address)
 {
+    WaitEraseDone();
+
     Address -= (Address % SECTOR_SIZE);
     SectorErase(Address);
     if (SectorCacheAddr == Address)
@@ -325,6 +362,89 @@ void PY25Q16_SectorErase(uint32_t Address)
     }
 }
 
+// Start a sector erase and return without waiting for it (~50 ms).
+// Reads of other sectors suspend it, any other access waits for it.
+void PY25Q16_SectorEraseAsync(uint32_t Address)
+{
+    WaitEraseDone();
+
+    Address -= (Address % SECTOR_SIZE);
+#ifdef DEBUG
+    printf("spi flash sector erase async: %06x\n", Address);
+#endif
+    WriteEnable();
+    WaitWIP();
+
+    CS_Assert();
+    SPI_WriteByte(0x20);
+    WriteAddr(Address);
+    CS_Release();
+
+    EraseInFlight = true;
+    EraseAddr = Address;
+    ResumeUs = SYSTICK_GetUs();
+
+    if (SectorCacheAddr == Address)
+    {
+        memset(SectorCache, 0xff, SECTOR_SIZE);
+    }
+}
+
+bool PY25Q16_IsBusy()
+{
+    if (EraseInFlight && !(1 & ReadStatusReg(0)))
+    {
+        EraseInFlight = false;
+    }
+
+    return EraseInFlight;
+}
+
+static void WaitEraseDone()
+{
+    if (EraseInFlight)
+    {
+        WaitWIP();
+        EraseInFlight = false;
+    }
+}
+
+// Suspend the erase in flight (75h, tSUS up to 30 us). False when it is
+// already done, then there is nothing to resume.
+static bool SuspendErase()
+{
+    if (!(1 & ReadStatusReg(0)))
+    {
+        EraseInFlight = false;
+        return false;
+    }
+
+    while (SYSTICK_GetUs() - ResumeUs <= ERASE_RESUME_US)
+        ;
+
+    CS_Assert();
+    SPI_WriteByte(0x75);
+    CS_Release();
+    WaitWIP();
+
+    // SUS1 is only set if the erase had not finished in the meantime
+    if (!(0x80 & ReadStatusReg(1)))
+    {
+        EraseInFlight = false;
+        return false;
+    }
+
+    return true;
+}
+
+static void ResumeErase()
+{
+    CS_Assert();
+    SPI_WriteByte(0x7a);
+    CS_Release();
+    ResumeUs = SYSTICK_GetUs();
+}
+
 static inline void WriteAddr(uint32_t Addr)
 {
     SPI_WriteByte(0xff & (Addr >> 16));
@@ -466,4 +586,8 @@ void DMA1_Channel4_5_6_7_IRQHandler()
 
         TC_Flag = true;
     }
+
+#ifdef ENABLE_UART_DMA_TX
+    UART_TxIRQHandler();
+#endif
 }
@@ -24,5 +24,7 @@ void PY25Q16_Init();
 void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size);
 void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append);
 void PY25Q16_SectorErase(uint32_t Address);
+void PY25Q16_SectorEraseAsync(uint32_t Address);
+bool PY25Q16_IsBusy();
 
 #endif
@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 #include <stdio.h>     // NULL
+#include <string.h>
 
 #include "py32f071_ll_bus.h"
 #include "py32f071_ll_spi.h"
@@ -24,8 +25,20 @@
 #include "driver/st7565.h"
 #include "driver/system.h"
 #include "misc.h"
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    #include "driver/systick.h"
+    #include "scheduler.h"
+#endif
+#ifdef ENABLE_LCD_DMA
+    #include "py32f071_ll_dma.h"
+    #include "py32f071_ll_system.h"
+#endif
+#ifdef ENABLE_UI_PROFILER
+    #include "ui/profiler.h"
+#endif
 
 #define SPIx SPI1
+#define CHANNEL_TX LL_DMA_CHANNEL_1
 
 #define PIN_CS GPIO_MAKE_PIN(GPIOB, LL_GPIO_PIN_2)
 #define PIN_A0 GPIO_MAKE_PIN(GPIOA, LL_GPIO_PIN_6)
@@ -33,8 +46,159 @@
 uint8_t gStatusLine[LCD_WIDTH];
 uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+// Columns of each page changed since it was last sent, page 0 is the
+// status line and page 1 + n is gFrameBuffer[n]. A page is clean when
+// First > Last.
+#define PAGES (1 + FRAME_LINES)
+
+static uint8_t  DirtyFirst[PAGES];
+static uint8_t  DirtyLast[PAGES];
+
+static uint32_t BytesSent;
+static uint32_t RateStart;       // 10 ms ticks
+static uint32_t RateBytes;
+static uint32_t BytesPerSecond;
+
+static uint8_t  Prescaler = LCD_SPI_PRESCALER;
+static uint8_t  FramePages;      // pages queued by the blit in progress
+static uint32_t CallStart;       // us
+static uint32_t FrameStart;
+static uint32_t FrameUs;
+static uint32_t FrameMaxUs;
+static uint32_t CallUs;
+static bool     DirtyHeld;
+
+static void MarkPage(uint8_t Page, uint8_t First, uint8_t Last)
+{
+    if (First < DirtyFirst[Page])
+        DirtyFirst[Page] = First;
+    if (Last > DirtyLast[Page])
+        DirtyLast[Page] = Last;
+}
+
+void ST7565_MarkDirty(const void *pData, unsigned int Size)
+{
+    const uintptr_t Addr   = (uintptr_t)pData;
+    const uintptr_t Status = (uintptr_t)gStatusLine;
+    const uintptr_t Frame  = (uintptr_t)gFrameBuffer;
+    unsigned int    Offset;
+    unsigned int    End;
+
+    if (DirtyHeld)
+        return;
+
+    // anything outside the two buffers is somebody else's scratch memory
+    if (Addr - Status < LCD_WIDTH) {
+        Offset = Addr - Status;
+        End    = LCD_WIDTH;
+    } else if (Addr - Frame < sizeof(gFrameBuffer)) {
+        Offset = LCD_WIDTH + (Addr - Frame);
+        End    = PAGES * LCD_WIDTH;
+    } else {
+        return;
+    }
+
+    if (Size > End - Offset)
+        Size = End - Offset;
+
+    while (Size) {
+        const unsigned int Column = Offset % LCD_WIDTH;
+        unsigned int       Count  = LCD_WIDTH - Column;
+
+        if (Count > Size)
+            Count = Size;
+
+        MarkPage(Offset / LCD_WIDTH, Column, Column + Count - 1);
+
+        Offset += Count;
+        Size   -= Count;
+    }
+}
+
+void ST7565_HoldDirty(bool Hold)
+{
+    DirtyHeld = Hold;
+}
+
+void ST7565_MarkChanged(const void *pData, const uint8_t *pShown, unsigned int Size)
+{
+    const uint8_t *pNew  = pData;
+    unsigned int   First = 0;
+
+    while (First < Size && pNew[First] == pShown[First])
+        First++;
+    while (Size > First && pNew[Size - 1] == pShown[Size - 1])
+        Size--;
+
+    if (First < Size)
+        ST7565_MarkDirty(pNew + First, Size - First);
+}
+
+void ST7565_GetStats(ST7565_Stats_t *pStats)
+{
+    // averaged over the time since the previous read, once that is a
+    // second or more
+    const uint32_t Elapsed = gGlobalSysTickCounter - RateStart;
+
+    if (Elapsed >= 100) {
+        BytesPerSecond = (BytesSent - RateBytes) * 100 / Elapsed;
+        RateStart      = gGlobalSysTickCounter;
+        RateBytes      = BytesSent;
+    }
+
+    pStats->BytesSent      = BytesSent;
+    pStats->BytesPerSecond = BytesPerSecond;
+    pStats->FrameUs        = FrameUs;
+    pStats->FrameMaxUs     = FrameMaxUs;
+    pStats->CallUs         = CallUs;
+    pStats->Prescaler      = Prescaler;
+
+    FrameMaxUs = 0;
+}
+
+static void FrameDone(void)
+{
+    FrameUs = SYSTICK_GetUs() - FrameStart;
+    if (FrameUs > FrameMaxUs)
+        FrameMaxUs = FrameUs;
+}
+#endif
+
+#ifdef ENABLE_LCD_DMA
+// A blit is a queue of transfers sent by DMA one after the other, with A0
+// low for the column and page commands and high for the pixel data. The
+// pixels are copied into Frame when the blit is queued, so the UI draws
+// the next frame into gFrameBuffer while this one goes out; only the next
+// blit has to wait for it.
+typedef struct
+{
+    const uint8_t *pData;
+    uint8_t        Size;
+    bool           Data;
+} Transfer_t;
+
+static uint8_t          Frame[PAGES][LCD_WIDTH];
+static uint8_t          Commands[1 + 3 * PAGES];
+static Transfer_t       Queue[1 + 2 * PAGES];
+static uint8_t          CommandsLength;
+static uint8_t          QueueLength;
+static volatile uint8_t QueueHead;
+static volatile bool    Busy;
+
+static void WaitIdle(void)
+{
+    while (Busy)
+        ;
+}
+#endif
+
 static void SPI_Init()
 {
+#ifdef ENABLE_LCD_DMA
+    WaitIdle();
+#endif
+
     LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_SPI1);
     LL_IOP_GRP1_EnableClock(LL_IOP_GRP1_PERIPH_GPIOA);
 
@@ -68,14 +232,44 @@ static void SPI_Init()
     InitStruct.NSS = LL_SPI_NSS_SOFT;
     InitStruct.BitOrder = LL_SPI_MSB_FIRST;
     InitStruct.CRCCalculation = LL_SPI_CRCCALCULATION_DISABLE;
-    InitStruct.BaudRate = LL_SPI_BAUDRATEPRESCALER_DIV64;
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    InitStruct.BaudRate = (uint32_t)Prescaler << SPI_CR1_BR_Pos;
+#else
+    InitStruct.BaudRate = (uint32_t)LCD_SPI_PRESCALER << SPI_CR1_BR_Pos;
+#endif
     LL_SPI_Init(SPIx, &InitStruct);
 
+#ifdef ENABLE_LCD_DMA
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+    LL_SYSCFG_SetDMARemap(DMA1, CHANNEL_TX, LL_SYSCFG_DMA_MAP_SPI1_WR);
+
+    LL_DMA_ConfigTransfer(DMA1, CHANNEL_TX,                 //
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH //
+                              | LL_DMA_MODE_NORMAL          //
+                              | LL_DMA_PERIPH_NOINCREMENT   //
+                              | LL_DMA_MEMORY_INCREMENT     //
+                              | LL_DMA_PDATAALIGN_BYTE      //
+                              | LL_DMA_MDATAALIGN_BYTE      //
+                              | LL_DMA_PRIORITY_LOW         //
+    );
+    LL_DMA_SetPeriphAddress(DMA1, CHANNEL_TX, LL_SPI_DMA_GetRegAddr(SPIx));
+    LL_DMA_EnableIT_TC(DMA1, CHANNEL_TX);
+
+    NVIC_SetPriority(DMA1_Channel1_IRQn, 2);
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    LL_SPI_EnableDMAReq_TX(SPIx);
+#endif
+
     LL_SPI_Enable(SPIx);
 }
 
 static inline void CS_Assert()
 {
+#ifdef ENABLE_LCD_DMA
+    // whoever drives the panel directly waits for a queued blit first
+    WaitIdle();
+#endif
     GPIO_ResetOutputPin(PIN_CS);
 }
 
@@ -104,6 +298,10 @@ static uint8_t SPI_WriteByte(uint8_t Value)
     while (!LL_SPI_IsActiveFlag_RXNE(SPIx))
         ;
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    BytesSent++;
+#endif
+
     return LL_SPI_ReceiveData8(SPIx);
 }
 
@@ -116,11 +314,181 @@ static void DrawLine(uint8_t column, uint8_t line, const uint8_t * lineBuffer, u
     }
 }
 
+#ifdef ENABLE_LCD_DMA
+static void QueueTransfer(const uint8_t *pData, uint8_t Size, bool Data)
+{
+    Transfer_t *pTransfer = &Queue[QueueLength++];
+
+    pTransfer->pData = pData;
+    pTransfer->Size  = Size;
+    pTransfer->Data  = Data;
+}
+
+static uint8_t *QueueCommand(uint8_t Size)
+{
+    uint8_t *pCommand = &Commands[CommandsLength];
+
+    CommandsLength += Size;
+
+    // commands back to back go out in one transfer, A0 stays low
+    if (QueueLength && !Queue[QueueLength - 1].Data)
+        Queue[QueueLength - 1].Size += Size;
+    else
+        QueueTransfer(pCommand, Size, false);
+
+    return pCommand;
+}
+
+static void QueueLine(uint8_t Column, uint8_t Page, const uint8_t *pLine, uint8_t Size)
+{
+    uint8_t *pSelect = QueueCommand(3);
+
+    // same bytes as ST7565_SelectColumnAndLine
+    pSelect[0] = Page + 176;
+    pSelect[1] = (((Column + 4) >> 4) & 0x0F) | 0x10;
+    pSelect[2] = (Column + 4) & 0x0F;
+
+    memcpy(&Frame[Page][Column], pLine + Column, Size);
+    QueueTransfer(&Frame[Page][Column], Size, true);
+}
+
+static void StartTransfer(void)
+{
+    const Transfer_t *pTransfer = &Queue[QueueHead];
+
+    if (pTransfer->Data)
+        A0_Set();
+    else
+        A0_Reset();
+
+    LL_DMA_DisableChannel(DMA1, CHANNEL_TX);
+    LL_DMA_SetMemoryAddress(DMA1, CHANNEL_TX, (uint32_t)pTransfer->pData);
+    LL_DMA_SetDataLength(DMA1, CHANNEL_TX, pTransfer->Size);
+    LL_DMA_EnableChannel(DMA1, CHANNEL_TX);
+}
+
+void DMA1_Channel1_IRQHandler(void)
+{
+    if (!LL_DMA_IsActiveFlag_TC1(DMA1))
+        return;
+
+    LL_DMA_ClearFlag_TC1(DMA1);
+
+    // the DMA is done once the last byte is in the FIFO, A0 may only
+    // change after it has been shifted out. All seven DMA1 channels are
+    // taken, so there is none left to time this off the SPI1 receive side
+    // and the interrupt waits. That is the FIFO (4 bytes) and the shift
+    // register, 40 SPI clocks at most: 53 us at LCD_SPI_PRESCALER 5, 7 us
+    // at 2. A blit waits twice per page, the start line goes out with the
+    // first page select, so up to 0.85 ms for all 8 pages at 5.
+    while (LL_SPI_GetTxFIFOLevel(SPIx) != LL_SPI_TX_FIFO_EMPTY)
+        ;
+    while (LL_SPI_IsActiveFlag_BSY(SPIx))
+        ;
+
+    // nobody reads what the panel clocks back, throw it away so polled
+    // writes see RXNE for their own byte again
+    while (LL_SPI_GetRxFIFOLevel(SPIx) != LL_SPI_RX_FIFO_EMPTY)
+        LL_SPI_ReceiveData8(SPIx);
+    LL_SPI_ClearFlag_OVR(SPIx);
+
+    BytesSent += Queue[QueueHead].Size;
+
+    if (++QueueHead < QueueLength) {
+        StartTransfer();
+        return;
+    }
+
+    GPIO_SetOutputPin(PIN_CS);
+    FrameDone();
+    Busy = false;
+}
+#endif
+
+// Send the dirty span of a page, or all of it
+static void BlitPage(uint8_t Page, const uint8_t *pLine)
+{
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    const uint8_t First = DirtyFirst[Page];
+
+    if (First > DirtyLast[Page])
+        return;
+
+    #ifdef ENABLE_LCD_DMA
+        QueueLine(First, Page, pLine, DirtyLast[Page] - First + 1);
+    #else
+        DrawLine(First, Page, pLine + First, DirtyLast[Page] - First + 1);
+    #endif
+
+    DirtyFirst[Page] = UINT8_MAX;
+    DirtyLast[Page]  = 0;
+    FramePages++;
+#else
+    DrawLine(0, Page, pLine, LCD_WIDTH);
+#endif
+}
+
+// Start a blit with the display start line, either straight to the panel
+// or into the transfer queue
+static void BlitBegin(void)
+{
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    FramePages = 0;
+    CallStart  = SYSTICK_GetUs();
+#endif
+
+#ifdef ENABLE_LCD_DMA
+    WaitIdle();
+    CommandsLength = 0;
+    QueueLength    = 0;
+    QueueCommand(1)[0] = 0x40;
+#else
+    CS_Assert();
+    ST7565_WriteByte(0x40);
+
+    #ifdef ENABLE_LCD_DIRTY_SPANS
+        FrameStart = CallStart;
+    #endif
+#endif
+}
+
+static void BlitEnd(void)
+{
+#ifdef ENABLE_LCD_DMA
+    // nothing changed, the start line alone is not worth a transfer
+    if (FramePages) {
+        GPIO_ResetOutputPin(PIN_CS);
+        QueueHead  = 0;
+        FrameStart = SYSTICK_GetUs();
+        Busy       = true;
+        StartTransfer();
+    }
+#else
+    CS_Release();
+
+    #ifdef ENABLE_LCD_DIRTY_SPANS
+        if (FramePages)
+            FrameDone();
+    #endif
+#endif
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    if (FramePages)
+        CallUs = SYSTICK_GetUs() - CallStart;
+#endif
+}
+
 void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const uint8_t *pBitmap, const unsigned int Size)
 {
     CS_Assert();
     DrawLine(Column, Line, pBitmap, Size);
     CS_Release();
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    // the panel no longer shows the buffer there, the next blit puts it back
+    if (Size && Column < LCD_WIDTH && Line < PAGES)
+        MarkPage(Line, Column, (Column + Size > LCD_WIDTH) ? LCD_WIDTH - 1 : Column + Size - 1);
+#endif
 }
 
 
@@ -134,25 +502,34 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
 
     static void ST7565_BlitScreen(uint8_t line)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);
+#ifdef ENABLE_UI_PROFILER
+        const uint32_t        Start = PROFILER_Stamp();
+        const PROFILER_Slot_t Slot  = (line == 0) ? PROFILER_BLIT_STATUS :
+                                      (line <= FRAME_LINES) ? PROFILER_BLIT_LINE : PROFILER_BLIT_FULL;
+#endif
+
+        BlitBegin();
 
         if(line == 0)
         {
-            DrawLine(0, 0, gStatusLine, LCD_WIDTH);
+            BlitPage(0, gStatusLine);
         }
         else if(line <= FRAME_LINES)
         {
-            DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
+            BlitPage(line, gFrameBuffer[line - 1]);
         }
         else
         {
             for (line = 1; line <= FRAME_LINES; line++) {
-                DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
+                BlitPage(line, gFrameBuffer[line - 1]);
             }
         }
 
-        CS_Release();
+        BlitEnd();
+
+#ifdef ENABLE_UI_PROFILER
+        PROFILER_Add(Slot, Start);
+#endif
     }
 
     void ST7565_BlitFullScreen(void)
@@ -172,28 +549,43 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
 #else
     void ST7565_BlitFullScreen(void)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);
+#ifdef ENABLE_UI_PROFILER
+        const uint32_t Start = PROFILER_Stamp();
+#endif
+        BlitBegin();
         for (unsigned line = 0; line < FRAME_LINES; line++) {
-            DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
+            BlitPage(line+1, gFrameBuffer[line]);
         }
-        CS_Release();
+        BlitEnd();
+#ifdef ENABLE_UI_PROFILER
+        PROFILER_Add(PROFILER_BLIT_FULL, Start);
+#endif
     }
 
     void ST7565_BlitLine(unsigned line)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);    // start line ?
-        DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
-        CS_Release();
+#ifdef ENABLE_UI_PROFILER
+        const uint32_t Start = PROFILER_Stamp();
+#endif
+        BlitBegin();    // start line ?
+        BlitPage(line+1, gFrameBuffer[line]);
+        BlitEnd();
+#ifdef ENABLE_UI_PROFILER
+        PROFILER_Add(PROFILER_BLIT_LINE, Start);
+#endif
     }
 
     void ST7565_BlitStatusLine(void)
     {   // the top small text line on the display
-        CS_Assert();
-        ST7565_WriteByte(0x40);    // start line ?
-        DrawLine(0, 0, gStatusLine, LCD_WIDTH);
-        CS_Release();
+#ifdef ENABLE_UI_PROFILER
+        const uint32_t Start = PROFILER_Stamp();
+#endif
+        BlitBegin();    // start line ?
+        BlitPage(0, gStatusLine);
+        BlitEnd();
+#ifdef ENABLE_UI_PROFILER
+        PROFILER_Add(PROFILER_BLIT_STATUS, Start);
+#endif
     }
 #endif
 
@@ -205,7 +597,36 @@ void ST7565_FillScreen(uint8_t value)
         DrawLine(0, i, NULL, value);
     }
     CS_Release();
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    for (unsigned i = 0; i < PAGES; i++)
+        MarkPage(i, 0, LCD_WIDTH - 1);
+#endif
+}
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+uint8_t ST7565_SetPrescaler(uint8_t Value)
+{
+    if (Value > 7)
+        Value = 7;
+
+#ifdef ENABLE_LCD_DMA
+    // a queued blit finishes at the old clock
+    WaitIdle();
+#endif
+
+    LL_SPI_Disable(SPIx);
+    LL_SPI_SetBaudRatePrescaler(SPIx, (uint32_t)Value << SPI_CR1_BR_Pos);
+    LL_SPI_Enable(SPIx);
+
+    Prescaler = Value;
+
+    for (unsigned i = 0; i < PAGES; i++)
+        MarkPage(i, 0, LCD_WIDTH - 1);
+
+    return Value;
 }
+#endif
 
 // Software reset
 #define ST7565_CMD_SOFTWARE_RESET 0xE2 
@@ -320,6 +741,8 @@ uint8_t cmds[] = {
         for (uint8_t i = 56; i <= 120; i++) {
             gFrameBuffer[line][i] = (i <= filled) ? 0x2d : 0x21;
         }
+
+        ST7565_MarkDirty(&gFrameBuffer[line][54], 122 - 54 + 1);
     }
     //#endif
 #endif
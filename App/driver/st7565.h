@@ -24,6 +24,13 @@
 #define LCD_HEIGHT       64
 #define FRAME_LINES 7
 
+// SPI1 clock, 48 MHz / 2^(n + 1). 5 is the 750 kHz the firmware has always
+// used, not a measured limit of the panel; tools/lcd/lcd_prescaler.py finds
+// the fastest clean one on a radio.
+#ifndef LCD_SPI_PRESCALER
+    #define LCD_SPI_PRESCALER 5
+#endif
+
 extern uint8_t gStatusLine[LCD_WIDTH];
 extern uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
 
@@ -41,6 +48,39 @@ void ST7565_HardwareReset(void);
 void ST7565_SelectColumnAndLine(uint8_t Column, uint8_t Line);
 void ST7565_WriteByte(uint8_t Value);
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    typedef struct
+    {
+        uint32_t BytesSent;
+        uint32_t BytesPerSecond;
+        uint32_t FrameUs;        // last blit, first byte to last
+        uint32_t FrameMaxUs;     // since the previous read
+        uint32_t CallUs;         // time the last blit kept its caller
+        uint8_t  Prescaler;      // LCD_SPI_PRESCALER in use
+        uint8_t  Padding[3];
+    } ST7565_Stats_t;
+
+    // Blits only send what changed, so anything drawn into gStatusLine or
+    // gFrameBuffer without the helper.c primitives has to be marked here
+    void ST7565_MarkDirty(const void *pData, unsigned int Size);
+    void ST7565_GetStats(ST7565_Stats_t *pStats);
+
+    // For drawing over bytes the caller has kept a copy of: while held
+    // MarkDirty does nothing, after the release MarkChanged marks only the
+    // span that differs from the copy
+    void ST7565_HoldDirty(bool Hold);
+    void ST7565_MarkChanged(const void *pData, const uint8_t *pShown, unsigned int Size);
+
+    // Change the SPI clock and have the next blit send the whole screen,
+    // to find by eye how fast the panel can be driven. Returns the
+    // prescaler applied.
+    uint8_t ST7565_SetPrescaler(uint8_t Prescaler);
+#else
+    #define ST7565_MarkDirty(pData, Size) do {} while (0)
+    #define ST7565_HoldDirty(Hold) do {} while (0)
+    #define ST7565_MarkChanged(pData, pShown, Size) do {} while (0)
+#endif
+
 #ifdef ENABLE_FEAT_N7SIX
     #if defined(ENABLE_FEAT_N7SIX_CTR) || defined(ENABLE_FEAT_N7SIX_INV)
     void ST7565_ContrastAndInv(void);
@@ -17,6 +17,7 @@
 #include "py32f0xx.h"
 #include "systick.h"
 #include "misc.h"
+#include "scheduler.h"
 
 // 0x20000324
 static uint32_t gTickMultiplier;
@@ -49,3 +50,33 @@ void SYSTICK_DelayUs(uint32_t Delay)
         Previous = Current;
     } while (elapsed_ticks < ticks);
 }
+
+// Microseconds since boot, from the 10 ms tick count and the SysTick
+// down-counter. Wraps after about 71 minutes, use differences only.
+uint32_t SYSTICK_GetUs(void)
+{
+    uint32_t Ticks;
+    uint32_t Value;
+
+    do {
+        Ticks = gGlobalSysTickCounter;
+        Value = SysTick->VAL;
+    } while (Ticks != gGlobalSysTickCounter);
+
+    return Ticks * 10000 + (SysTick->LOAD - Value) / gTickMultiplier;
+}
+
+// Core clock cycles since boot, SysTick counts them down from LOAD every
+// 10 ms. Wraps after about 89 seconds, use differences only.
+uint32_t SYSTICK_GetCycles(void)
+{
+    uint32_t Ticks;
+    uint32_t Value;
+
+    do {
+        Ticks = gGlobalSysTickCounter;
+        Value = SysTick->VAL;
+    } while (Ticks != gGlobalSysTickCounter);
+
+    return Ticks * (SysTick->LOAD + 1) + SysTick->LOAD - Value;
+}
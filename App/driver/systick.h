@@ -21,6 +21,8 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_DelayUs(uint32_t Delay);
+uint32_t SYSTICK_GetUs(void);
+uint32_t SYSTICK_GetCycles(void);
 
 #endif
 
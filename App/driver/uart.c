@@ -30,6 +30,38 @@
 static bool UART_IsLogEnabled;
 uint8_t UART_DMA_Buffer[256];
 
+#ifdef ENABLE_UART_DMA_TX
+#define CHANNEL_TX LL_DMA_CHANNEL_6
+
+// The main loop copies into the ring at TxHead, the channel sends the run
+// at TxTail up to the head or the end of the ring, and its interrupt moves
+// the tail on and starts the next run.
+static uint8_t           TxRing[UART_TX_RING_SIZE];
+static volatile uint16_t TxHead;
+static volatile uint16_t TxTail;
+static volatile uint16_t TxRun;        // bytes on the channel, 0 when idle
+static uint32_t          TxDropped;
+
+static uint32_t TxFree(void)
+{
+    return (TxTail + UART_TX_RING_SIZE - TxHead - 1) % UART_TX_RING_SIZE;
+}
+
+// with the interrupt masked, or from it
+static void TxStart(void)
+{
+    if (TxRun || TxHead == TxTail)
+        return;
+
+    TxRun = ((TxHead > TxTail) ? TxHead : UART_TX_RING_SIZE) - TxTail;
+
+    LL_DMA_DisableChannel(DMA1, CHANNEL_TX);
+    LL_DMA_SetMemoryAddress(DMA1, CHANNEL_TX, (uint32_t)&TxRing[TxTail]);
+    LL_DMA_SetDataLength(DMA1, CHANNEL_TX, TxRun);
+    LL_DMA_EnableChannel(DMA1, CHANNEL_TX);
+}
+#endif
+
 void UART_Init(void)
 {
     // PA9 TX
@@ -80,6 +112,26 @@ void UART_Init(void)
 
     } while (0);
 
+#ifdef ENABLE_UART_DMA_TX
+    LL_DMA_DisableChannel(DMA1, CHANNEL_TX);
+    LL_SYSCFG_SetDMARemap(DMA1, CHANNEL_TX, LL_SYSCFG_DMA_MAP_USART1_WR);
+
+    LL_DMA_ConfigTransfer(DMA1, CHANNEL_TX,                 //
+                          LL_DMA_DIRECTION_MEMORY_TO_PERIPH //
+                              | LL_DMA_MODE_NORMAL          //
+                              | LL_DMA_PERIPH_NOINCREMENT   //
+                              | LL_DMA_MEMORY_INCREMENT     //
+                              | LL_DMA_PDATAALIGN_BYTE      //
+                              | LL_DMA_MDATAALIGN_BYTE      //
+                              | LL_DMA_PRIORITY_LOW         //
+    );
+    LL_DMA_SetPeriphAddress(DMA1, CHANNEL_TX, LL_USART_DMA_GetRegAddr(USARTx));
+    LL_DMA_EnableIT_TC(DMA1, CHANNEL_TX);
+
+    // priority is set by the flash driver, the interrupt is shared
+    NVIC_EnableIRQ(DMA1_Channel4_5_6_7_IRQn);
+#endif
+
     LL_APB1_GRP2_ForceReset(LL_APB1_GRP2_PERIPH_USART1);
     LL_APB1_GRP2_ReleaseReset(LL_APB1_GRP2_PERIPH_USART1);
 
@@ -96,6 +148,9 @@ void UART_Init(void)
         LL_USART_Init(USARTx, &USART_InitStruct);
 
         LL_USART_EnableDMAReq_RX(USARTx);
+#ifdef ENABLE_UART_DMA_TX
+        LL_USART_EnableDMAReq_TX(USARTx);
+#endif
 
     } while (0);
 
@@ -104,8 +159,83 @@ void UART_Init(void)
     LL_USART_TransmitData8(USARTx, 0);
 }
 
+#ifdef ENABLE_UART_DMA_TX
+bool UART_SendAsync(const void *pBuffer, uint32_t Size, UART_TxPriority_t Priority)
+{
+    const uint8_t *pData = (const uint8_t *)pBuffer;
+
+    if (Priority == UART_TX_STREAM && Size > UART_GetTxRoom(UART_TX_STREAM)) {
+        TxDropped += Size;
+        return false;
+    }
+
+    while (Size) {
+        uint32_t Chunk;
+
+        // a reply longer than the room waits for the channel to free some
+        while ((Chunk = TxFree()) == 0)
+            ;
+
+        if (Chunk > Size)
+            Chunk = Size;
+        if (Chunk > UART_TX_RING_SIZE - (uint32_t)TxHead)
+            Chunk = UART_TX_RING_SIZE - TxHead;
+
+        memcpy(&TxRing[TxHead], pData, Chunk);
+        pData += Chunk;
+        Size  -= Chunk;
+
+        const uint32_t Mask = __get_PRIMASK();
+        __disable_irq();
+        TxHead = (TxHead + Chunk) % UART_TX_RING_SIZE;
+        TxStart();
+        __set_PRIMASK(Mask);
+    }
+
+    return true;
+}
+
+uint32_t UART_GetTxRoom(UART_TxPriority_t Priority)
+{
+    const uint32_t Free = TxFree();
+
+    if (Priority == UART_TX_REPLY)
+        return Free;
+
+    return (Free > UART_TX_REPLY_ROOM) ? Free - UART_TX_REPLY_ROOM : 0;
+}
+
+uint32_t UART_GetTxDropped(void)
+{
+    return TxDropped;
+}
+
+void UART_Flush(void)
+{
+    while (TxRun)
+        ;
+    while (!LL_USART_IsActiveFlag_TC(USARTx))
+        ;
+}
+
+void UART_TxIRQHandler(void)
+{
+    if (!LL_DMA_IsActiveFlag_TC6(DMA1))
+        return;
+
+    LL_DMA_ClearFlag_TC6(DMA1);
+
+    TxTail = (TxTail + TxRun) % UART_TX_RING_SIZE;
+    TxRun  = 0;
+    TxStart();
+}
+#endif
+
 void UART_Send(const void *pBuffer, uint32_t Size)
 {
+#ifdef ENABLE_UART_DMA_TX
+    UART_SendAsync(pBuffer, Size, UART_TX_REPLY);
+#else
     const uint8_t *pData = (const uint8_t *)pBuffer;
     uint32_t i;
 
@@ -115,12 +245,17 @@ void UART_Send(const void *pBuffer, uint32_t Size)
             ;
         LL_USART_TransmitData8(USARTx, pData[i]);
     }
+#endif
 }
 
 void UART_LogSend(const void *pBuffer, uint32_t Size)
 {
     if (UART_IsLogEnabled) {
+#ifdef ENABLE_UART_DMA_TX
+        UART_SendAsync(pBuffer, Size, UART_TX_STREAM);
+#else
         UART_Send(pBuffer, Size);
+#endif
     }
 }
 
@@ -27,6 +27,31 @@ void UART_Init(void);
 void UART_Send(const void *pBuffer, uint32_t Size);
 void UART_LogSend(const void *pBuffer, uint32_t Size);
 
+#ifdef ENABLE_UART_DMA_TX
+    // Bytes queued for DMA, the ring holds one less
+    #ifndef UART_TX_RING_SIZE
+        #define UART_TX_RING_SIZE 512
+    #endif
+
+    // Room streams leave free, a protocol reply with its header and footer
+    #define UART_TX_REPLY_ROOM 160
+
+    typedef enum {
+        UART_TX_REPLY,      // waits for room, nothing is lost
+        UART_TX_STREAM,     // screenshots and logs, dropped whole when short of room
+    } UART_TxPriority_t;
+
+    // Everything sent goes through the ring in order and out by DMA, from
+    // the main loop only. UART_Send is UART_SendAsync for a reply.
+    bool     UART_SendAsync(const void *pBuffer, uint32_t Size, UART_TxPriority_t Priority);
+    uint32_t UART_GetTxRoom(UART_TxPriority_t Priority);
+    uint32_t UART_GetTxDropped(void);
+    void     UART_Flush(void);
+
+    // DMA channel 6 shares its interrupt with the SPI flash driver
+    void     UART_TxIRQHandler(void);
+#endif
+
 #ifdef ENABLE_FEAT_N7SIX_SCREENSHOT
     bool UART_IsCableConnected(void);
 #endif
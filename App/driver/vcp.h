@@ -17,6 +17,7 @@
 #ifndef _DRIVER_VCP_H
 #define _DRIVER_VCP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include "usb_config.h"
@@ -46,4 +47,24 @@ static inline void VCP_SendAsync(const uint8_t *Buf, uint32_t Size)
     cdc_acm_data_send_with_dtr_async(Buf, Size);
 }
 
+static inline bool VCP_IsOpen(void)
+{
+    return cdc_acm_dtr_asserted();
+}
+
+static inline bool VCP_TxReady(void)
+{
+    return cdc_acm_tx_ready();
+}
+
+static inline bool VCP_IsSending(const uint8_t *Buf)
+{
+    return cdc_acm_tx_holds(Buf);
+}
+
+static inline bool VCP_TrySendAsync(const uint8_t *Buf, uint32_t Size)
+{
+    return cdc_acm_data_send_with_dtr_try(Buf, Size);
+}
+
 #endif // _DRIVER_VCP_H
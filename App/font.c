@@ -16,6 +16,9 @@
 
 #include "font.h"
 
+// With ENABLE_PACKED_FONTS the text fonts come from font_packed.c instead,
+// tools/ui/font_pack.py generates it from these tables
+#ifndef ENABLE_PACKED_FONTS
 // removed last and middle column which was all 0x00
 // also the space char is not needed 
 const uint8_t gFontBig[95 - 1][16 - 2] =
@@ -214,6 +217,7 @@ const uint8_t gFontBig[95 - 1][16 - 2] =
     {0x08, 0x0C, 0x04, 0x0C, 0x08, 0x0C, 0x04, /*0x00,*/ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}     // '->'
 #endif
 };
+#endif
 
 #if 0
     // original font
@@ -283,6 +287,7 @@ const uint8_t gFontSmallDigits[11][7] =
     {0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00}     // '-'
 };
 */
+#ifndef ENABLE_PACKED_FONTS
 const uint8_t gFontSmall[95-1][6] =
 {
 //  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},    // ' '
@@ -652,3 +657,4 @@ const uint8_t gFontSmall[95-1][6] =
         // {0x18, 0x15, 0x10}, // 191 - questiondown
     };
 //#endif
+#endif
@@ -20,12 +20,40 @@
 #include <stdint.h>
 
 
-extern const uint8_t gFontBig[95 - 1][16 - 2];
 extern const uint8_t gFontBigDigits[11][26 - 6];
-extern const uint8_t gFont3x5[96][3];
-extern const uint8_t gFontSmall[95 - 1][6];
-#ifdef ENABLE_SMALL_BOLD
-    extern const uint8_t gFontSmallBold[95 - 1][6];
+
+#ifdef ENABLE_PACKED_FONTS
+    // Glyph columns in character order, Bits each, packed LSB first. With a
+    // column table every packed value is an index into it, otherwise it is
+    // the column itself with the top page in the low byte.
+    typedef struct {
+        const uint8_t *pStream;
+        const uint8_t *pColumns;
+        uint8_t        Bits;
+    } FontPacked_t;
+
+    extern const FontPacked_t gFontBigPacked;
+    extern const FontPacked_t gFont3x5Packed;
+    extern const FontPacked_t gFontSmallPacked;
+    #ifdef ENABLE_SMALL_BOLD
+        extern const FontPacked_t gFontSmallBoldPacked;
+    #endif
+#else
+    extern const uint8_t gFontBig[95 - 1][16 - 2];
+    extern const uint8_t gFont3x5[96][3];
+    extern const uint8_t gFontSmall[95 - 1][6];
+    #ifdef ENABLE_SMALL_BOLD
+        extern const uint8_t gFontSmallBold[95 - 1][6];
+    #endif
+#endif
+
+#ifdef ENABLE_PROPORTIONAL_FONT
+    // Ink of each small glyph, first lit column in the low nibble and the
+    // columns from there to the last lit one in the high nibble
+    extern const uint8_t gFontSmallMetrics[95 - 1];
+    #ifdef ENABLE_SMALL_BOLD
+        extern const uint8_t gFontSmallBoldMetrics[95 - 1];
+    #endif
 #endif
 
 #endif
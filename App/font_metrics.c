@@ -0,0 +1,42 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/ui/font_metrics.py from tools/misc/*.fon, do not edit
+
+#include "font.h"
+
+// gFontSmall: first ink column in the low nibble, ink width in the high one
+const uint8_t gFontSmallMetrics[94] =
+{
+    0x12, 0x31, 0x50, 0x50, 0x60, 0x60, 0x22, 0x31, 0x31, 0x41, 0x50, 0x31, 0x41, 0x22, 0x60, 0x60,
+    0x51, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x22, 0x31, 0x40, 0x50, 0x41, 0x50, 0x50,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x50, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x50, 0x60, 0x60, 0x60, 0x60, 0x50, 0x60, 0x31, 0x60, 0x32, 0x50, 0x60, 0x31,
+    0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x12, 0x40, 0x41, 0x22, 0x60, 0x50, 0x50, 0x50,
+    0x60, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x30, 0x12, 0x32, 0x50,
+};
+
+#ifdef ENABLE_SMALL_BOLD
+// gFontSmallBold: first ink column in the low nibble, ink width in the high one
+const uint8_t gFontSmallBoldMetrics[94] =
+{
+    0x22, 0x50, 0x50, 0x50, 0x60, 0x60, 0x22, 0x41, 0x41, 0x41, 0x60, 0x31, 0x41, 0x22, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x22, 0x31, 0x40, 0x50, 0x41, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x41, 0x60, 0x41, 0x60, 0x60, 0x31,
+    0x60, 0x60, 0x50, 0x60, 0x60, 0x50, 0x60, 0x60, 0x22, 0x50, 0x60, 0x31, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x50, 0x60, 0x50, 0x60, 0x60, 0x60, 0x60, 0x60, 0x50, 0x40, 0x12, 0x41, 0x50,
+};
+#endif
@@ -0,0 +1,193 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/ui/font_pack.py from the tables in font.c, do not edit
+
+#include <stddef.h>
+
+#include "font.h"
+
+// gFontBig: 658 columns as 8 bit indices into 161 distinct ones
+static const uint8_t FontBigStream[] =
+{
+    0x00, 0x00, 0x00, 0x76, 0x76, 0x00, 0x00, 0x00, 0x07, 0x0B, 0x00, 0x00, 0x0B, 0x07, 0x26, 0x8E,
+    0x8E, 0x26, 0x8E, 0x8E, 0x26, 0x33, 0x72, 0x5A, 0x96, 0x96, 0x84, 0x3D, 0x6E, 0x38, 0x29, 0x20,
+    0x19, 0x6F, 0x6E, 0x3E, 0x8B, 0x58, 0x5F, 0x43, 0x8B, 0x52, 0x00, 0x08, 0x0B, 0x07, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x2F, 0x47, 0x6B, 0x4A, 0x00, 0x00, 0x00, 0x4A, 0x6B, 0x47, 0x2F, 0x00, 0x00,
+    0x17, 0x28, 0x2E, 0x22, 0x2E, 0x28, 0x00, 0x17, 0x17, 0x2E, 0x2E, 0x17, 0x17, 0x00, 0x00, 0x90,
+    0x92, 0x77, 0x00, 0x00, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x00, 0x00, 0x00, 0x69, 0x69,
+    0x00, 0x00, 0x69, 0x35, 0x29, 0x20, 0x19, 0x13, 0x0E, 0x47, 0x8F, 0x4A, 0x4A, 0x4A, 0x8F, 0x47,
+    0x00, 0x4C, 0x4D, 0x8F, 0x8F, 0x49, 0x49, 0x6C, 0x79, 0x65, 0x62, 0x5D, 0x58, 0x50, 0x36, 0x79,
+    0x53, 0x53, 0x53, 0x8F, 0x42, 0x20, 0x22, 0x1F, 0x1E, 0x1D, 0x8F, 0x8F, 0x34, 0x70, 0x53, 0x53,
+    0x53, 0x89, 0x3F, 0x46, 0x8E, 0x54, 0x53, 0x53, 0x89, 0x3E, 0x02, 0x02, 0x78, 0x83, 0x24, 0x16,
+    0x0A, 0x42, 0x8F, 0x53, 0x53, 0x53, 0x8F, 0x42, 0x15, 0x60, 0x59, 0x59, 0x71, 0x48, 0x30, 0x00,
+    0x00, 0x00, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 0x49, 0x7B, 0x38, 0x00, 0x00, 0x00, 0x17, 0x22,
+    0x2B, 0x38, 0x6C, 0x4B, 0x27, 0x27, 0x27, 0x27, 0x27, 0x27, 0x27, 0x00, 0x4B, 0x6C, 0x38, 0x2B,
+    0x22, 0x17, 0x0F, 0x10, 0x02, 0x74, 0x75, 0x16, 0x0F, 0x46, 0x8E, 0x4B, 0x67, 0x67, 0x68, 0x25,
+    0x8E, 0x8F, 0x18, 0x18, 0x18, 0x8F, 0x8E, 0x8F, 0x8F, 0x53, 0x53, 0x53, 0x8F, 0x42, 0x47, 0x8F,
+    0x4A, 0x4A, 0x4A, 0x79, 0x36, 0x8F, 0x8F, 0x4A, 0x4A, 0x6B, 0x47, 0x2F, 0x8F, 0x8F, 0x53, 0x53,
+    0x53, 0x4A, 0x4A, 0x8F, 0x8F, 0x12, 0x12, 0x12, 0x02, 0x02, 0x47, 0x8F, 0x4A, 0x59, 0x59, 0x85,
+    0x41, 0x8F, 0x8F, 0x11, 0x11, 0x11, 0x8F, 0x8F, 0x00, 0x00, 0x4A, 0x8F, 0x8F, 0x4A, 0x00, 0x35,
+    0x77, 0x49, 0x4A, 0x8F, 0x48, 0x02, 0x8F, 0x8F, 0x23, 0x2A, 0x36, 0x6B, 0x4A, 0x8F, 0x8F, 0x49,
+    0x49, 0x49, 0x49, 0x49, 0x8F, 0x8F, 0x09, 0x14, 0x09, 0x8F, 0x8F, 0x8F, 0x8F, 0x13, 0x19, 0x20,
+    0x8F, 0x8F, 0x47, 0x8F, 0x4A, 0x4A, 0x4A, 0x8F, 0x47, 0x8F, 0x8F, 0x18, 0x18, 0x18, 0x1B, 0x15,
+    0x47, 0x8F, 0x4A, 0x6A, 0x6A, 0x93, 0x91, 0x8F, 0x8F, 0x21, 0x2D, 0x3A, 0x73, 0x57, 0x39, 0x7C,
+    0x53, 0x53, 0x53, 0x8A, 0x40, 0x00, 0x02, 0x02, 0x8F, 0x8F, 0x02, 0x02, 0x48, 0x8F, 0x49, 0x49,
+    0x49, 0x8F, 0x48, 0x16, 0x31, 0x82, 0x69, 0x82, 0x31, 0x16, 0x8F, 0x8F, 0x35, 0x2C, 0x35, 0x8F,
+    0x8F, 0x6B, 0x81, 0x2F, 0x19, 0x2F, 0x81, 0x6B, 0x00, 0x10, 0x16, 0x88, 0x88, 0x16, 0x10, 0x78,
+    0x7F, 0x62, 0x5D, 0x56, 0x51, 0x4E, 0x00, 0x00, 0x8F, 0x8F, 0x4A, 0x4A, 0x00, 0x0F, 0x14, 0x1A,
+    0x22, 0x2C, 0x3C, 0x77, 0x00, 0x00, 0x4A, 0x4A, 0x8F, 0x8F, 0x00, 0x05, 0x06, 0x03, 0x01, 0x03,
+    0x06, 0x05, 0x94, 0x94, 0x94, 0x94, 0x94, 0x94, 0x94, 0x00, 0x00, 0x01, 0x04, 0x02, 0x00, 0x00,
+    0x3C, 0x86, 0x5B, 0x5B, 0x5B, 0x8C, 0x88, 0x8F, 0x8F, 0x4F, 0x4F, 0x4F, 0x8C, 0x44, 0x44, 0x8C,
+    0x4F, 0x4F, 0x4F, 0x6F, 0x32, 0x44, 0x8C, 0x4F, 0x4F, 0x4F, 0x8F, 0x8F, 0x44, 0x8C, 0x61, 0x61,
+    0x61, 0x64, 0x22, 0x0C, 0x0C, 0x8E, 0x8F, 0x0D, 0x0D, 0x02, 0x44, 0x9D, 0x9C, 0x9C, 0x9C, 0x9F,
+    0x97, 0x8F, 0x8F, 0x0C, 0x0C, 0x0C, 0x8C, 0x88, 0x00, 0x00, 0x4F, 0x8D, 0x8D, 0x49, 0x00, 0x00,
+    0x95, 0x9E, 0x99, 0x9A, 0xA0, 0x98, 0x8F, 0x8F, 0x1C, 0x2C, 0x3B, 0x6F, 0x4F, 0x00, 0x00, 0x4A,
+    0x8F, 0x8F, 0x49, 0x00, 0x8C, 0x8C, 0x0C, 0x8C, 0x0C, 0x8C, 0x88, 0x8C, 0x8C, 0x0C, 0x0C, 0x0C,
+    0x8C, 0x88, 0x44, 0x8C, 0x4F, 0x4F, 0x4F, 0x8C, 0x44, 0x9F, 0x9F, 0x4F, 0x4F, 0x4F, 0x8C, 0x44,
+    0x44, 0x8C, 0x4F, 0x4F, 0x4F, 0x9F, 0x9F, 0x8C, 0x8C, 0x13, 0x0C, 0x0C, 0x0C, 0x0C, 0x5C, 0x64,
+    0x61, 0x61, 0x61, 0x80, 0x37, 0x0C, 0x0C, 0x48, 0x8F, 0x4F, 0x4F, 0x49, 0x45, 0x8C, 0x49, 0x49,
+    0x49, 0x8C, 0x8C, 0x1A, 0x2E, 0x7E, 0x69, 0x7E, 0x2E, 0x1A, 0x45, 0x8C, 0x49, 0x82, 0x49, 0x8C,
+    0x45, 0x6F, 0x7D, 0x2C, 0x1C, 0x2C, 0x7D, 0x6F, 0x45, 0x9D, 0x9B, 0x9B, 0x9B, 0x9F, 0x97, 0x6D,
+    0x7A, 0x66, 0x63, 0x5E, 0x55, 0x4F, 0x00, 0x00, 0x11, 0x47, 0x87, 0x4A, 0x4A, 0x00, 0x00, 0x00,
+    0x87, 0x87, 0x00, 0x00, 0x00, 0x4A, 0x4A, 0x87, 0x47, 0x11, 0x00, 0x05, 0x06, 0x02, 0x06, 0x05,
+    0x06, 0x02, 0x00, 0x00,
+};
+
+static const uint8_t FontBigColumns[] =
+{
+    0x00, 0x00, 0x03, 0x00, 0x04, 0x00, 0x06, 0x00, 0x07, 0x00, 0x08, 0x00, 0x0C, 0x00, 0x0F, 0x00,
+    0x10, 0x00, 0x18, 0x00, 0x1C, 0x00, 0x1F, 0x00, 0x20, 0x00, 0x24, 0x00, 0x30, 0x00, 0x38, 0x00,
+    0x3C, 0x00, 0x40, 0x00, 0x44, 0x00, 0x60, 0x00, 0x70, 0x00, 0x78, 0x00, 0x7C, 0x00, 0x80, 0x00,
+    0x84, 0x00, 0xC0, 0x00, 0xE0, 0x00, 0xFC, 0x00, 0x00, 0x01, 0x18, 0x01, 0x30, 0x01, 0x60, 0x01,
+    0x80, 0x01, 0x84, 0x01, 0xC0, 0x01, 0xE0, 0x01, 0xE4, 0x01, 0xF0, 0x01, 0x20, 0x02, 0x40, 0x02,
+    0xA0, 0x02, 0x00, 0x03, 0x30, 0x03, 0x60, 0x03, 0x80, 0x03, 0x84, 0x03, 0xE0, 0x03, 0xF0, 0x03,
+    0xF8, 0x03, 0xFC, 0x03, 0x40, 0x04, 0x70, 0x04, 0x7C, 0x04, 0x00, 0x06, 0x18, 0x06, 0x20, 0x06,
+    0x30, 0x06, 0x38, 0x06, 0x84, 0x06, 0xC0, 0x06, 0x00, 0x07, 0x10, 0x07, 0x80, 0x07, 0x84, 0x07,
+    0x88, 0x07, 0x98, 0x07, 0xB8, 0x07, 0xBC, 0x07, 0xC0, 0x07, 0xE0, 0x07, 0xF0, 0x07, 0xF8, 0x07,
+    0xFC, 0x07, 0x00, 0x08, 0x04, 0x08, 0x08, 0x08, 0x10, 0x08, 0x18, 0x08, 0x1C, 0x08, 0x20, 0x08,
+    0x38, 0x08, 0x3C, 0x08, 0x40, 0x08, 0x44, 0x08, 0x4C, 0x08, 0x60, 0x08, 0x64, 0x08, 0x78, 0x08,
+    0x7C, 0x08, 0x84, 0x08, 0x88, 0x08, 0xA0, 0x08, 0xC0, 0x08, 0xC4, 0x08, 0xE0, 0x08, 0xE4, 0x08,
+    0xFC, 0x08, 0x20, 0x09, 0x84, 0x09, 0xA0, 0x09, 0xE0, 0x09, 0x04, 0x0B, 0x20, 0x0B, 0xC8, 0x0B,
+    0xF8, 0x0B, 0x00, 0x0C, 0x04, 0x0C, 0x0C, 0x0C, 0x18, 0x0C, 0x20, 0x0C, 0x30, 0x0C, 0x60, 0x0C,
+    0x7C, 0x0C, 0x84, 0x0C, 0xF8, 0x0C, 0xFC, 0x0C, 0x84, 0x0D, 0xC4, 0x0D, 0xFC, 0x0D, 0x00, 0x0E,
+    0x04, 0x0E, 0x1C, 0x0E, 0x20, 0x0E, 0x30, 0x0E, 0x7C, 0x0E, 0xE0, 0x0E, 0x00, 0x0F, 0x04, 0x0F,
+    0x20, 0x0F, 0x3C, 0x0F, 0x80, 0x0F, 0x84, 0x0F, 0x98, 0x0F, 0x9C, 0x0F, 0xA0, 0x0F, 0xBC, 0x0F,
+    0xC0, 0x0F, 0xC4, 0x0F, 0xCC, 0x0F, 0xD8, 0x0F, 0xE0, 0x0F, 0xEC, 0x0F, 0xF8, 0x0F, 0xFC, 0x0F,
+    0x00, 0x10, 0xF8, 0x17, 0x00, 0x1E, 0xFC, 0x1F, 0x00, 0x20, 0x00, 0x30, 0x8E, 0x38, 0xE0, 0x3F,
+    0xEC, 0x3F, 0x00, 0x40, 0x20, 0x40, 0x00, 0x48, 0x20, 0x48, 0xE0, 0x4F, 0x00, 0x70, 0xE0, 0x7F,
+    0xEC, 0x7F,
+};
+
+const FontPacked_t gFontBigPacked = { FontBigStream, FontBigColumns, 8 };
+
+// gFont3x5: 288 columns of 6 bits
+static const uint8_t Font3x5Stream[] =
+{
+    0x00, 0x00, 0x00, 0x17, 0x30, 0x00, 0xC3, 0xA7, 0x7C, 0xCA, 0x57, 0x24, 0x84, 0xF4, 0x5C, 0x1C,
+    0x30, 0x00, 0x80, 0x13, 0x45, 0x0E, 0x50, 0x08, 0x05, 0xE1, 0x10, 0x10, 0x02, 0x10, 0x04, 0x01,
+    0x40, 0x00, 0x46, 0x0C, 0x5E, 0xF4, 0x08, 0x1F, 0x90, 0x55, 0x52, 0x54, 0x29, 0x07, 0xF1, 0x5D,
+    0x55, 0xE2, 0x55, 0x5D, 0x56, 0x0C, 0x5F, 0xF5, 0x5D, 0xD5, 0x03, 0x28, 0x00, 0xA4, 0x00, 0x84,
+    0x12, 0x29, 0x8A, 0x12, 0x29, 0x44, 0x50, 0x0D, 0x4E, 0x65, 0x79, 0x85, 0xF7, 0x55, 0x8A, 0x13,
+    0x45, 0x5F, 0xE4, 0x7C, 0x55, 0xF5, 0x15, 0x85, 0x53, 0x75, 0x1F, 0xF1, 0x45, 0x5F, 0x84, 0x40,
+    0xCF, 0x47, 0x6C, 0x1F, 0x04, 0x7D, 0xC6, 0xF7, 0x39, 0x9F, 0x13, 0x39, 0x5F, 0x21, 0x38, 0x99,
+    0xF7, 0x35, 0x96, 0x54, 0x25, 0xC1, 0x17, 0x3C, 0xD0, 0x77, 0x60, 0xC7, 0xC7, 0x7C, 0x1B, 0xB1,
+    0x0D, 0xDC, 0x90, 0x55, 0xD3, 0x17, 0x45, 0x02, 0x81, 0x44, 0xD1, 0x27, 0x04, 0x02, 0x04, 0x41,
+    0x81, 0x00, 0x68, 0x16, 0xF7, 0x49, 0x0C, 0x23, 0x49, 0x8C, 0xF4, 0x31, 0x9A, 0x45, 0x78, 0x05,
+    0xA3, 0x7A, 0x9F, 0xC0, 0x01, 0x1D, 0x00, 0x81, 0xDD, 0xC7, 0x48, 0xD1, 0x07, 0x79, 0x8E, 0xE7,
+    0x09, 0x1C, 0x23, 0x31, 0xBE, 0xC4, 0x30, 0x92, 0xCF, 0x09, 0x02, 0xE5, 0x29, 0xC2, 0x27, 0x39,
+    0x90, 0xE7, 0x60, 0x8E, 0xC7, 0x79, 0x12, 0x23, 0x19, 0xA8, 0xA7, 0x79, 0x16, 0xB1, 0x45, 0xC0,
+    0x06, 0x44, 0x1B, 0x21, 0x0C, 0x81, 0x74, 0x49, 0x00, 0x00,
+};
+
+const FontPacked_t gFont3x5Packed = { Font3x5Stream, NULL, 6 };
+
+// gFontSmall: 564 columns of 7 bits
+static const uint8_t FontSmallStream[] =
+{
+    0x00, 0x80, 0x17, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x03, 0x00, 0x40, 0xF1, 0x51, 0x7C, 0x14, 0x80,
+    0x29, 0xF9, 0x4F, 0xCA, 0x00, 0xE3, 0x09, 0x82, 0x20, 0x0E, 0xC3, 0x96, 0xCD, 0xAA, 0x08, 0x0A,
+    0x00, 0x1C, 0x0E, 0x00, 0x00, 0x80, 0x23, 0x0A, 0x02, 0x00, 0x80, 0xA0, 0x88, 0x03, 0x00, 0x00,
+    0x54, 0x1C, 0x8E, 0x0A, 0x80, 0x40, 0xF8, 0x10, 0x08, 0x00, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00,
+    0x04, 0x02, 0x81, 0x00, 0x00, 0x00, 0x60, 0x30, 0x00, 0x00, 0x04, 0x41, 0x10, 0x04, 0x81, 0x2F,
+    0x18, 0x0C, 0x06, 0x7D, 0x00, 0xA0, 0xF0, 0x0F, 0x04, 0x8A, 0xA3, 0xD1, 0x64, 0xD2, 0x28, 0x0A,
+    0x26, 0x93, 0x49, 0x1B, 0x86, 0x22, 0x89, 0xFC, 0x21, 0xA7, 0x62, 0xB1, 0x58, 0xCC, 0xF9, 0x92,
+    0xC9, 0x64, 0x52, 0x16, 0x08, 0xC4, 0x13, 0x85, 0x81, 0x2D, 0x99, 0x4C, 0x26, 0x6D, 0xC6, 0x64,
+    0x32, 0x99, 0xF2, 0x00, 0x00, 0x6C, 0x36, 0x00, 0x00, 0x00, 0xB2, 0x59, 0x00, 0x00, 0x82, 0x22,
+    0x0A, 0x02, 0x00, 0x14, 0x0A, 0x85, 0x42, 0x01, 0x00, 0x82, 0x22, 0x0A, 0x02, 0x20, 0x08, 0x44,
+    0x13, 0x06, 0x00, 0x4C, 0xA9, 0x94, 0xF2, 0x00, 0xFE, 0x44, 0x22, 0x91, 0xF0, 0xFF, 0x93, 0xC9,
+    0x64, 0xD2, 0xE6, 0x0B, 0x06, 0x83, 0x41, 0xD1, 0x3F, 0x18, 0x0C, 0x06, 0x7D, 0xFF, 0x64, 0x32,
+    0x99, 0x0C, 0xFE, 0x13, 0x89, 0x44, 0x22, 0xE0, 0x0B, 0x26, 0x93, 0x49, 0xDD, 0x1F, 0x81, 0x40,
+    0x20, 0xFE, 0xC1, 0xE0, 0x3F, 0x18, 0x04, 0x80, 0x82, 0xC1, 0x5F, 0x20, 0xF0, 0x47, 0x30, 0x24,
+    0x21, 0xE0, 0x1F, 0x08, 0x04, 0x02, 0x81, 0x7F, 0x01, 0x81, 0x20, 0xF8, 0xFF, 0x05, 0x04, 0x04,
+    0xE4, 0xEF, 0x0B, 0x06, 0x83, 0x41, 0xDF, 0x3F, 0x91, 0x48, 0x24, 0x0C, 0xBE, 0x60, 0x34, 0x1C,
+    0xF4, 0xFD, 0x13, 0x89, 0x4C, 0xCA, 0x68, 0x4A, 0x26, 0x93, 0x49, 0x59, 0x20, 0xF0, 0x0F, 0x04,
+    0x00, 0x3F, 0x20, 0x10, 0x08, 0xFC, 0x1D, 0x70, 0x40, 0x20, 0xEE, 0xF0, 0x03, 0xC2, 0x60, 0xC0,
+    0xDF, 0x98, 0x82, 0x40, 0x50, 0xC6, 0x07, 0x04, 0x1C, 0x71, 0x00, 0x84, 0xA3, 0xC9, 0xE2, 0x30,
+    0x08, 0xF8, 0x07, 0x83, 0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0xC0, 0x00, 0x40, 0x30, 0xF8, 0x07,
+    0x10, 0x04, 0x01, 0x01, 0x01, 0x00, 0x04, 0x02, 0x81, 0x40, 0x20, 0x60, 0x70, 0x30, 0x00, 0x00,
+    0x20, 0x2A, 0x95, 0x8A, 0x07, 0xFC, 0x89, 0x44, 0x22, 0x0E, 0x80, 0x23, 0x12, 0x89, 0x28, 0x00,
+    0x8E, 0x48, 0x24, 0xFE, 0x01, 0x38, 0x2A, 0x95, 0x8A, 0x04, 0xF0, 0x15, 0x0A, 0x85, 0x00, 0x80,
+    0xA5, 0x52, 0xA9, 0x3C, 0xC0, 0x9F, 0x40, 0x20, 0xE0, 0x01, 0x00, 0x80, 0x1E, 0x00, 0x00, 0x80,
+    0x80, 0xC0, 0x1E, 0x00, 0x00, 0xF8, 0x43, 0x50, 0x44, 0x00, 0x00, 0xF0, 0x03, 0x02, 0x00, 0x7C,
+    0x04, 0x04, 0x82, 0xE0, 0xF3, 0x09, 0x04, 0x02, 0x1E, 0x80, 0x23, 0x12, 0x89, 0x38, 0x00, 0x9F,
+    0x42, 0xA1, 0x20, 0x00, 0x08, 0x0A, 0x85, 0xC2, 0x07, 0xF2, 0x09, 0x04, 0x02, 0x02, 0x80, 0xA0,
+    0x52, 0xA9, 0x20, 0xC0, 0x8F, 0x48, 0x24, 0x02, 0x01, 0x3C, 0x20, 0x10, 0xC8, 0x03, 0x30, 0x60,
+    0x40, 0x18, 0x03, 0xC0, 0x03, 0xC2, 0x80, 0x3C, 0x00, 0x11, 0x05, 0x41, 0x11, 0x01, 0x0C, 0x28,
+    0x14, 0xCA, 0x03, 0x10, 0xC9, 0x54, 0x26, 0x11, 0x80, 0xB0, 0x05, 0x01, 0x00, 0x00, 0x00, 0xF0,
+    0x07, 0x00, 0x00, 0x00, 0x40, 0xD0, 0x86, 0x00, 0x10, 0x04, 0x04, 0x04, 0x01, 0x00, 0x00, 0x00,
+};
+
+const FontPacked_t gFontSmallPacked = { FontSmallStream, NULL, 7 };
+
+#ifdef ENABLE_SMALL_BOLD
+// gFontSmallBold: 564 columns of 7 bits
+static const uint8_t FontSmallBoldStream[] =
+{
+    0x00, 0x80, 0xD7, 0x0B, 0x00, 0x18, 0x0C, 0x00, 0x83, 0x01, 0x40, 0xF1, 0x51, 0x7C, 0x14, 0x80,
+    0x6B, 0xFD, 0x5F, 0xEB, 0x00, 0xE3, 0x19, 0x86, 0x61, 0x1E, 0xC3, 0x96, 0xCD, 0xAA, 0x08, 0x0A,
+    0x00, 0x1C, 0x0E, 0x00, 0x00, 0x80, 0xE3, 0x1B, 0x07, 0x01, 0x80, 0xE0, 0xD8, 0xC7, 0x01, 0x00,
+    0x54, 0x1C, 0x8E, 0x0A, 0x80, 0xC1, 0xF8, 0xFD, 0x18, 0x0C, 0x00, 0x08, 0x06, 0x01, 0x00, 0x00,
+    0x0C, 0x06, 0x83, 0x01, 0x00, 0x00, 0x60, 0x30, 0x00, 0x00, 0x86, 0x61, 0x18, 0x86, 0x81, 0xEF,
+    0x3F, 0x1E, 0xFF, 0x7D, 0x64, 0xF3, 0xFF, 0x0F, 0x06, 0x8B, 0xE7, 0xFB, 0xFD, 0xDB, 0x3C, 0x1E,
+    0xAF, 0xD7, 0x7F, 0x1B, 0x8E, 0x67, 0xFB, 0xFF, 0x61, 0xEF, 0xF7, 0x7A, 0xBD, 0x9F, 0xF9, 0xFE,
+    0xEB, 0xF5, 0x5E, 0x36, 0x18, 0xCC, 0xF7, 0x8F, 0x83, 0xED, 0xBF, 0x5E, 0xFF, 0x6D, 0x86, 0xF7,
+    0x7A, 0xFD, 0xF7, 0x01, 0x00, 0x6C, 0x36, 0x00, 0x00, 0x00, 0xB2, 0x59, 0x00, 0x00, 0x82, 0x22,
+    0x0A, 0x02, 0x00, 0x36, 0x9B, 0xCD, 0x66, 0x03, 0x00, 0x82, 0x22, 0x0A, 0x02, 0x60, 0x38, 0x4C,
+    0xB7, 0x1F, 0x07, 0x6C, 0xBF, 0xDE, 0xFF, 0x7D, 0xFE, 0xFF, 0x66, 0xF3, 0xF7, 0xFF, 0xFF, 0xEB,
+    0xF5, 0xDF, 0xE6, 0xFB, 0x8F, 0xC7, 0x63, 0xDB, 0xFF, 0x3F, 0x1E, 0xFF, 0x7D, 0xFF, 0xFF, 0x7A,
+    0xBD, 0x1E, 0xFF, 0xFF, 0x9B, 0xCD, 0x66, 0xE0, 0xFB, 0x8F, 0xD7, 0x7B, 0xDD, 0xFF, 0xCF, 0x60,
+    0xFC, 0xFF, 0xE3, 0xF1, 0xFF, 0x3F, 0x1E, 0xC3, 0xE6, 0xE3, 0xFF, 0x6F, 0xF0, 0xFF, 0x73, 0x6C,
+    0xE3, 0xE0, 0xFF, 0x0F, 0x06, 0x83, 0xC1, 0xFF, 0xBF, 0xC1, 0xF0, 0xFF, 0xFF, 0xFF, 0x0C, 0xCC,
+    0xFF, 0xEF, 0xFB, 0x8F, 0xC7, 0x7F, 0xDF, 0xFF, 0xBF, 0xD9, 0x7C, 0x1C, 0xBE, 0xFF, 0x78, 0xFE,
+    0xF7, 0xFF, 0xFF, 0x9B, 0xDD, 0xDF, 0x6C, 0x7E, 0xAF, 0xD7, 0xFB, 0xD9, 0x60, 0xF0, 0xFF, 0x0F,
+    0x06, 0xBF, 0x3F, 0x18, 0xFC, 0xFF, 0x7D, 0x7E, 0x60, 0xF0, 0xEF, 0xF3, 0xFB, 0xC3, 0x60, 0xFF,
+    0xDF, 0xF8, 0xCE, 0xE1, 0xDC, 0xC7, 0x87, 0x07, 0x1E, 0xFF, 0x38, 0x8C, 0xE7, 0xFB, 0xF7, 0x79,
+    0x0C, 0xF8, 0xFF, 0xC7, 0x63, 0x40, 0x40, 0x40, 0x40, 0x40, 0xC0, 0x80, 0xF1, 0xF8, 0xFF, 0x07,
+    0x30, 0x1C, 0x83, 0x81, 0x83, 0x01, 0x06, 0x83, 0xC1, 0x60, 0x30, 0x60, 0x70, 0x30, 0x00, 0x00,
+    0x20, 0xBB, 0xD5, 0xEA, 0xE7, 0xFD, 0xFF, 0x6C, 0x36, 0x1F, 0x87, 0xE3, 0xB3, 0xD9, 0x6C, 0x00,
+    0x8E, 0xCF, 0x66, 0xFF, 0xFF, 0x3C, 0xBF, 0xD5, 0xEA, 0x65, 0xF8, 0xFF, 0x9B, 0x8D, 0x00, 0xC0,
+    0xF0, 0x5A, 0xAD, 0x7E, 0xDE, 0xFF, 0xCF, 0x60, 0xF0, 0xF1, 0x00, 0x80, 0x5E, 0x0F, 0x00, 0xC0,
+    0xC0, 0xE0, 0x7E, 0x0F, 0xF0, 0xFF, 0x63, 0x78, 0x7E, 0x33, 0xE0, 0xF7, 0x07, 0x02, 0x00, 0x7C,
+    0x3E, 0x06, 0xC3, 0xE7, 0xF3, 0xF9, 0x0C, 0x06, 0x1F, 0xCF, 0xF3, 0x9B, 0xCD, 0x7E, 0x9E, 0xDF,
+    0x6F, 0xB3, 0xF9, 0x38, 0x1C, 0x9F, 0xCD, 0xEF, 0x07, 0xF3, 0xF9, 0x0C, 0x06, 0x06, 0xC0, 0xF4,
+    0x5A, 0xAD, 0x76, 0xD0, 0xEF, 0xCF, 0x66, 0x83, 0x01, 0x3C, 0x3E, 0x18, 0xCC, 0xE7, 0x31, 0x78,
+    0x70, 0x38, 0x8F, 0xC1, 0xE3, 0xC3, 0x60, 0x7C, 0x1E, 0x91, 0x8D, 0xC3, 0xB1, 0x89, 0x06, 0x37,
+    0x1A, 0xED, 0xF7, 0x99, 0xED, 0x7E, 0xB7, 0x19, 0x80, 0xF0, 0xDD, 0x83, 0x00, 0x00, 0x00, 0xF0,
+    0x07, 0x00, 0x00, 0x80, 0xE0, 0xDD, 0x87, 0x00, 0x30, 0x0C, 0x0C, 0x0C, 0x03, 0x00, 0x00, 0x00,
+};
+
+const FontPacked_t gFontSmallBoldPacked = { FontSmallBoldStream, NULL, 7 };
+#endif
@@ -0,0 +1,194 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "helper/format.h"
+
+#define MAX_DIGITS 10
+
+static const uint32_t Powers[MAX_DIGITS] = {
+    1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1
+};
+
+// the last Count digits of Value, zero filled
+static char *PutDigits(char *pString, uint32_t Value, unsigned int Count)
+{
+    for (const uint32_t *pPower = &Powers[MAX_DIGITS - Count]; pPower < &Powers[MAX_DIGITS]; pPower++) {
+        char Digit = '0';
+
+        while (Value >= *pPower) {
+            Value -= *pPower;
+            Digit++;
+        }
+
+        *pString++ = Digit;
+    }
+
+    return pString;
+}
+
+static unsigned int CountDigits(uint32_t Value)
+{
+    unsigned int Count = 1;
+
+    while (Count < MAX_DIGITS && Value >= Powers[MAX_DIGITS - 1 - Count])
+        Count++;
+
+    return Count;
+}
+
+static char *PutPadded(char *pString, uint32_t Value, unsigned int Width, char Pad)
+{
+    const unsigned int Count = CountDigits(Value);
+
+    for (; Width > Count; Width--)
+        *pString++ = Pad;
+
+    return PutDigits(pString, Value, Count);
+}
+
+char *FORMAT_Unsigned(char *pString, uint32_t Value, uint8_t Width, char Pad)
+{
+    pString  = PutPadded(pString, Value, Width, Pad);
+    *pString = 0;
+    return pString;
+}
+
+char *FORMAT_Signed(char *pString, int32_t Value, uint8_t Width, char Pad)
+{
+    const uint32_t Magnitude = (Value < 0) ? 0u - (uint32_t)Value : (uint32_t)Value;
+
+    if (Value < 0) {
+        if (Pad == '0') {
+            *pString++ = '-';
+            if (Width)
+                Width--;
+        } else {
+            for (unsigned int Count = CountDigits(Magnitude) + 1; Width > Count; Width--)
+                *pString++ = Pad;
+            *pString++ = '-';
+            Width      = 0;
+        }
+    }
+
+    return FORMAT_Unsigned(pString, Magnitude, Width, Pad);
+}
+
+char *FORMAT_Fixed(char *pString, uint32_t Value, uint8_t Decimals, uint8_t Width, char Pad)
+{
+    const unsigned int Point = MAX_DIGITS - Decimals;
+    char               Digits[MAX_DIGITS];
+    unsigned int       First = 0;
+
+    // the whole part without its leading zeros, one digit at least
+    PutDigits(Digits, Value, MAX_DIGITS);
+    while (First + 1 < Point && Digits[First] == '0')
+        First++;
+
+    for (unsigned int Count = Point - First; Width > Count; Width--)
+        *pString++ = Pad;
+
+    while (First < Point)
+        *pString++ = Digits[First++];
+
+    *pString++ = '.';
+    while (First < MAX_DIGITS)
+        *pString++ = Digits[First++];
+
+    *pString = 0;
+    return pString;
+}
+
+char *FORMAT_Channel(char *pString, uint16_t Number, uint8_t Width)
+{
+    *pString++ = 'C';
+    *pString++ = 'H';
+    *pString++ = '-';
+    return FORMAT_Unsigned(pString, Number, Width, '0');
+}
+
+char *FORMAT_Time(char *pString, uint16_t Seconds)
+{
+    uint16_t Minutes = 0;
+
+    while (Seconds >= 6000) {
+        Seconds -= 6000;
+        Minutes += 100;
+    }
+    while (Seconds >= 600) {
+        Seconds -= 600;
+        Minutes += 10;
+    }
+    while (Seconds >= 60) {
+        Seconds -= 60;
+        Minutes++;
+    }
+
+    pString    = PutPadded(pString, Minutes, 2, '0');
+    *pString++ = ':';
+    return FORMAT_Unsigned(pString, Seconds, 2, '0');
+}
+
+char *FORMAT_Duration(char *pString, uint32_t Seconds)
+{
+    char Unit = 's';
+
+    if (Seconds >= 24 * 60 * 60) {
+        Seconds /= 24 * 60 * 60;
+        Unit     = 'd';
+    } else if (Seconds >= 60 * 60) {
+        Seconds /= 60 * 60;
+        Unit     = 'h';
+    } else if (Seconds >= 60) {
+        Seconds /= 60;
+        Unit     = 'm';
+    }
+
+    pString    = PutPadded(pString, Seconds, 3, ' ');
+    *pString++ = Unit;
+    *pString   = 0;
+    return pString;
+}
+
+char *FORMAT_Octal(char *pString, uint32_t Value, uint8_t Width)
+{
+    unsigned int Count = 1;
+
+    while (Count < 11 && (Value >> (3 * Count)))
+        Count++;
+
+    for (; Width > Count; Width--)
+        *pString++ = '0';
+
+    while (Count--)
+        *pString++ = '0' + ((Value >> (3 * Count)) & 7);
+
+    *pString = 0;
+    return pString;
+}
+
+char *FORMAT_String(char *pString, const char *pSource, uint8_t Width)
+{
+    for (; *pSource; pSource++) {
+        *pString++ = *pSource;
+        if (Width)
+            Width--;
+    }
+
+    for (; Width; Width--)
+        *pString++ = ' ';
+
+    *pString = 0;
+    return pString;
+}
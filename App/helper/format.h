@@ -0,0 +1,59 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef HELPER_FORMAT_H
+#define HELPER_FORMAT_H
+
+#include <stdint.h>
+
+// Fixed format replacements for the sprintf calls the UI makes while it
+// redraws. The Cortex-M0+ has no divide instruction, so digits are found
+// by subtracting powers of ten instead of going through the printf parser
+// and the division helpers. Every formatter writes a terminated string
+// and returns a pointer to its terminator, so that calls can be chained.
+//
+// Width and Pad follow printf: the number takes at least Width characters
+// and Pad (' ' or '0') fills the front, "%03u" is Width 3 and Pad '0'.
+
+// "%*u"
+char *FORMAT_Unsigned(char *pString, uint32_t Value, uint8_t Width, char Pad);
+
+// "%*d", the sign counts towards Width and a zero Pad goes after it
+char *FORMAT_Signed(char *pString, int32_t Value, uint8_t Width, char Pad);
+
+// Fixed point Value with Decimals (1 to 9) places, "%*u.%0*u" of the
+// whole part and the rest. Width is that of the whole part.
+char *FORMAT_Fixed(char *pString, uint32_t Value, uint8_t Decimals, uint8_t Width, char Pad);
+
+// Frequency in 10 Hz units as MHz, 14550000 with Width 3 gives "145.50000"
+#define FORMAT_Frequency(pString, Frequency, Width, Pad) FORMAT_Fixed(pString, Frequency, 5, Width, Pad)
+
+// "CH-%0*u"
+char *FORMAT_Channel(char *pString, uint16_t Number, uint8_t Width);
+
+// Seconds as "%02u:%02u" of minutes and seconds
+char *FORMAT_Time(char *pString, uint16_t Seconds);
+
+// Seconds in the largest unit that fits, "%3us", "%3um", "%3uh" or "%3ud",
+// so 4 characters up to 999 days: " 59s", " 12m", "  3h", "  2d"
+char *FORMAT_Duration(char *pString, uint32_t Seconds);
+
+// "%0*o", DCS codes are "%03o"
+char *FORMAT_Octal(char *pString, uint32_t Value, uint8_t Width);
+
+// "%-*s"
+char *FORMAT_String(char *pString, const char *pSource, uint8_t Width);
+
+#endif
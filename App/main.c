@@ -42,6 +42,18 @@
 
 #include "app/app.h"
 #include "app/dtmf.h"
+#ifdef ENABLE_SCAN_DWELL
+    #include "app/scandwell.h"
+#endif
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    #include "app/scanranges.h"
+#endif
+#ifdef ENABLE_SCAN_STATS
+    #include "app/scanstats.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "app/scanjournal.h"
+#endif
 
 #include "driver/backlight.h"
 #include "driver/bk4819.h"
@@ -113,6 +125,19 @@ void Main(void)
     SETTINGS_WriteBuildOptions();
     SETTINGS_LoadCalibration();
 
+#ifdef ENABLE_MULTI_SCAN_RANGES
+    SCANRANGES_Init();
+#endif
+#ifdef ENABLE_SCAN_STATS
+    SCANSTATS_Init();
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    SCANJOURNAL_Init();
+#endif
+#ifdef ENABLE_SCAN_DWELL
+    SCANDWELL_Init();
+#endif
+
     RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
     RADIO_ConfigureChannel(1, VFO_CONFIGURE_RELOAD);
 
@@ -117,6 +117,18 @@ extern const uint16_t        NOAA_countdown_10ms;
 extern const uint16_t        NOAA_countdown_2_10ms;
 extern const uint16_t        NOAA_countdown_3_10ms;
 
+// Time on each VFO before dual watch toggles. The register delta swap keeps
+// the RX dead time of a toggle short, so the other VFO can come round sooner.
+// Going below the squelch response (roughly 20-60ms) only loses signals,
+// see tools/dual_watch/dual_watch_sim.py.
+#ifndef DUAL_WATCH_TOGGLE_10ms
+    #ifdef ENABLE_DUAL_WATCH_SWAP
+        #define DUAL_WATCH_TOGGLE_10ms (80 / 10)
+    #else
+        #define DUAL_WATCH_TOGGLE_10ms (100 / 10)
+    #endif
+#endif
+
 extern const uint16_t        dual_watch_count_after_tx_10ms;
 extern const uint16_t        dual_watch_count_after_rx_10ms;
 extern const uint16_t        dual_watch_count_after_1_10ms;
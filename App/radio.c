@@ -19,6 +19,9 @@
 
 #include "am_fix.h"
 #include "app/dtmf.h"
+#ifdef ENABLE_RX_DELTA
+    #include "app/rxdelta.h"
+#endif
 #ifdef ENABLE_FMRADIO
     #include "app/fm.h"
 #endif
@@ -682,6 +685,84 @@ void RADIO_SelectVfos(void)
     RADIO_SelectCurrentVfo();
 }
 
+uint16_t RADIO_SetupRxCodes(void)
+{
+    uint16_t InterruptMask = BK4819_REG_3F_SQUELCH_FOUND | BK4819_REG_3F_SQUELCH_LOST;
+
+    #ifdef ENABLE_NOAA
+        if (!IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE))
+    #endif
+    {
+        if (gRxVfo->Modulation == MODULATION_FM)
+        {   // FM
+            uint8_t CodeType = gRxVfo->pRX->CodeType;
+            uint8_t Code     = gRxVfo->pRX->Code;
+
+            switch (CodeType)
+            {
+                default:
+                case CODE_TYPE_OFF:
+                    BK4819_SetCTCSSFrequency(SQL_TONE);
+                    BK4819_SetTailDetection(SQL_TONE); // Default 550 = QS's 55Hz tone method
+
+                    InterruptMask = BK4819_REG_3F_CxCSS_TAIL | BK4819_REG_3F_SQUELCH_FOUND | BK4819_REG_3F_SQUELCH_LOST;
+                    break;
+
+                case CODE_TYPE_CONTINUOUS_TONE:
+                    BK4819_SetCTCSSFrequency(CTCSS_Options[Code]);
+
+                    //#ifndef ENABLE_CTCSS_TAIL_PHASE_SHIFT
+                    //    BK4819_SetTailDetection(550);       // QS's 55Hz tone method
+                    //#else
+                    //  BK4819_SetTailDetection(CTCSS_Options[Code]);
+                    //#endif
+
+                    InterruptMask = 0
+                        | BK4819_REG_3F_CxCSS_TAIL
+                        | BK4819_REG_3F_CTCSS_FOUND
+                        | BK4819_REG_3F_CTCSS_LOST
+                        | BK4819_REG_3F_SQUELCH_FOUND
+                        | BK4819_REG_3F_SQUELCH_LOST;
+
+                    break;
+
+                case CODE_TYPE_DIGITAL:
+                case CODE_TYPE_REVERSE_DIGITAL:
+                    BK4819_SetCDCSSCodeWord(DCS_GetGolayCodeWord(CodeType, Code));
+                    InterruptMask = 0
+                        | BK4819_REG_3F_CxCSS_TAIL
+                        | BK4819_REG_3F_CDCSS_FOUND
+                        | BK4819_REG_3F_CDCSS_LOST
+                        | BK4819_REG_3F_SQUELCH_FOUND
+                        | BK4819_REG_3F_SQUELCH_LOST;
+                    break;
+            }
+
+#ifndef ENABLE_FEAT_N7SIX
+            if (gRxVfo->SCRAMBLING_TYPE > 0 && gSetting_ScrambleEnable)
+                BK4819_EnableScramble(gRxVfo->SCRAMBLING_TYPE - 1);
+            else
+                BK4819_DisableScramble();
+#else
+                BK4819_DisableScramble();
+#endif
+        }
+    }
+    #ifdef ENABLE_NOAA
+        else
+        {
+            BK4819_SetCTCSSFrequency(2625);
+            InterruptMask = 0
+                | BK4819_REG_3F_CTCSS_FOUND
+                | BK4819_REG_3F_CTCSS_LOST
+                | BK4819_REG_3F_SQUELCH_FOUND
+                | BK4819_REG_3F_SQUELCH_LOST;
+        }
+    #endif
+
+    return InterruptMask;
+}
+
 void RADIO_SetupRegisters(bool switchToForeground)
 {
     BK4819_FilterBandwidth_t Bandwidth = gRxVfo->CHANNEL_BANDWIDTH;
@@ -771,78 +852,8 @@ void RADIO_SetupRegisters(bool switchToForeground)
         (gEeprom.DAC_GAIN    << 0));     // AF DAC Gain (after Gain-1 and Gain-2)
 
 
-    uint16_t InterruptMask = BK4819_REG_3F_SQUELCH_FOUND | BK4819_REG_3F_SQUELCH_LOST;
-
-    #ifdef ENABLE_NOAA
-        if (!IS_NOAA_CHANNEL(gRxVfo->CHANNEL_SAVE))
-    #endif
-    {
-        if (gRxVfo->Modulation == MODULATION_FM)
-        {   // FM
-            uint8_t CodeType = gRxVfo->pRX->CodeType;
-            uint8_t Code     = gRxVfo->pRX->Code;
-
-            switch (CodeType)
-            {
-                default:
-                case CODE_TYPE_OFF:
-                    BK4819_SetCTCSSFrequency(SQL_TONE);
-                    BK4819_SetTailDetection(SQL_TONE); // Default 550 = QS's 55Hz tone method
-
-                    InterruptMask = BK4819_REG_3F_CxCSS_TAIL | BK4819_REG_3F_SQUELCH_FOUND | BK4819_REG_3F_SQUELCH_LOST;
-                    break;
-
-                case CODE_TYPE_CONTINUOUS_TONE:
-                    BK4819_SetCTCSSFrequency(CTCSS_Options[Code]);
-
-                    //#ifndef ENABLE_CTCSS_TAIL_PHASE_SHIFT
-                    //    BK4819_SetTailDetection(550);       // QS's 55Hz tone method
-                    //#else
-                    //  BK4819_SetTailDetection(CTCSS_Options[Code]);
-                    //#endif
-
-                    InterruptMask = 0
-                        | BK4819_REG_3F_CxCSS_TAIL
-                        | BK4819_REG_3F_CTCSS_FOUND
-                        | BK4819_REG_3F_CTCSS_LOST
-                        | BK4819_REG_3F_SQUELCH_FOUND
-                        | BK4819_REG_3F_SQUELCH_LOST;
-
-                    break;
-
-                case CODE_TYPE_DIGITAL:
-                case CODE_TYPE_REVERSE_DIGITAL:
-                    BK4819_SetCDCSSCodeWord(DCS_GetGolayCodeWord(CodeType, Code));
-                    InterruptMask = 0
-                        | BK4819_REG_3F_CxCSS_TAIL
-                        | BK4819_REG_3F_CDCSS_FOUND
-                        | BK4819_REG_3F_CDCSS_LOST
-                        | BK4819_REG_3F_SQUELCH_FOUND
-                        | BK4819_REG_3F_SQUELCH_LOST;
-                    break;
-            }
-
-#ifndef ENABLE_FEAT_N7SIX
-            if (gRxVfo->SCRAMBLING_TYPE > 0 && gSetting_ScrambleEnable)
-                BK4819_EnableScramble(gRxVfo->SCRAMBLING_TYPE - 1);
-            else
-                BK4819_DisableScramble();
-#else
-                BK4819_DisableScramble();
-#endif
-        }
-    }
-    #ifdef ENABLE_NOAA
-        else
-        {
-            BK4819_SetCTCSSFrequency(2625);
-            InterruptMask = 0
-                | BK4819_REG_3F_CTCSS_FOUND
-                | BK4819_REG_3F_CTCSS_LOST
-                | BK4819_REG_3F_SQUELCH_FOUND
-                | BK4819_REG_3F_SQUELCH_LOST;
-        }
-    #endif
+    const uint16_t CodeMask = RADIO_SetupRxCodes();
+    uint16_t InterruptMask = CodeMask;
 
 #ifdef ENABLE_VOX
     if (gEeprom.VOX_SWITCH  && gCurrentVfo->Modulation == MODULATION_FM
@@ -870,6 +881,10 @@ void RADIO_SetupRegisters(bool switchToForeground)
 
     RADIO_SetupAGC(gRxVfo->Modulation == MODULATION_AM, false);
 
+#ifdef ENABLE_RX_DELTA
+    RXDELTA_RegistersLoaded(InterruptMask & ~CodeMask);
+#endif
+
     // enable/disable BK4819 selected interrupts
     BK4819_WriteRegister(BK4819_REG_3F, InterruptMask);
 
@@ -928,6 +943,10 @@ void RADIO_SetTxParameters(void)
 {
     BK4819_FilterBandwidth_t Bandwidth = gCurrentVfo->CHANNEL_BANDWIDTH;
 
+#ifdef ENABLE_RX_DELTA
+    RXDELTA_Invalidate();
+#endif
+
     #ifdef ENABLE_FEAT_N7SIX_NARROWER
         if(Bandwidth == BK4819_FILTER_BW_NARROW && gSetting_set_nfm == 1)
         {
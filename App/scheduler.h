@@ -18,6 +18,9 @@
 
 #include "py32f0xx.h"
 
+// 10 ms ticks since boot
+extern volatile uint32_t gGlobalSysTickCounter;
+
 static void inline SCHEDULER_Enable()
 {
     NVIC_EnableIRQ(SysTick_IRQn);
@@ -19,12 +19,167 @@
 #include "screenshot.h"
 #include "misc.h"
 
+#ifdef ENABLE_SCREENSHOT_USB
+    #include "driver/vcp.h"
+    #include "scheduler.h"
+#endif
+
 // RAM optimization: Only keep previousFrame static (1024 bytes)
-// Build currentFrame on-the-fly and send delta blocks immediately
+// Build currentFrame on-the-fly and send the changed blocks straight from it
 static uint8_t previousFrame[1024] = {0};
 static uint8_t forcedBlock = 0;
 static uint8_t keepAlive = 10;
 
+// Blocks a forced update or the keep-alive rotation still has to send, and
+// the block the next frame starts from
+static uint8_t owedBlocks[128 / 8] = {0};
+static uint8_t firstBlock = 0;
+
+#ifdef ENABLE_SCREENSHOT_USB
+// Owned by the USB IN endpoint from VCP_TrySendAsync() until the transfer
+// completes, so it is only rewritten once VCP_TxReady() says so.
+static uint8_t  usbFrame[SCREENSHOT_USB_FRAME];
+static uint8_t  usbSeq = 0;
+static uint8_t  usbInterval = 4;    // 10 ms ticks between frames
+static uint8_t  usbCredits = 0;     // frames left before the host has to ask again
+static uint32_t usbLastTick = 0;
+static bool     usbPending = false;
+
+void SCREENSHOT_SetPacing(uint8_t Interval, uint8_t Credits, bool bRefresh)
+{
+    usbInterval = Interval;
+    usbCredits  = Credits;
+    usbPending  = Credits > 0;  // answer the request even if nothing is drawn
+
+    if (bRefresh)
+        memset(owedBlocks, 0xFF, sizeof(owedBlocks));
+}
+
+bool SCREENSHOT_IsPending(void)
+{
+    return usbPending;
+}
+
+// Run length code Size bytes, NULL when they do not fit before pEnd
+static uint8_t *packRun(uint8_t *p, const uint8_t *pEnd, const uint8_t *pSrc, uint16_t Size)
+{
+    uint16_t i = 0;
+
+    while (i < Size) {
+        uint16_t repeat = 1;
+        while (i + repeat < Size && repeat < 0x7F + 3 && pSrc[i + repeat] == pSrc[i])
+            repeat++;
+
+        if (repeat >= 3) {
+            if (p + 2 > pEnd)
+                return NULL;
+            *p++ = 0x80 | (repeat - 3);
+            *p++ = pSrc[i];
+            i += repeat;
+            continue;
+        }
+
+        // Literals up to the next three equal bytes
+        uint16_t literal = 1;
+        while (i + literal < Size && literal < 0x7F + 1) {
+            const uint8_t *q = &pSrc[i + literal];
+            if (i + literal + 2 < Size && q[0] == q[1] && q[0] == q[2])
+                break;
+            literal++;
+        }
+
+        if (p + 1 + literal > pEnd)
+            return NULL;
+        *p++ = literal - 1;
+        memcpy(p, &pSrc[i], literal);
+        p += literal;
+        i += literal;
+    }
+
+    return p;
+}
+
+static void sendUsb(const uint8_t *currentFrame, const uint8_t *wanted)
+{
+    uint8_t       *p    = usbFrame + 5;
+    const uint8_t *pEnd = usbFrame + sizeof(usbFrame) - 2;  // check byte and trailer
+
+    *p++ = usbSeq;
+
+    // Runs of wanted blocks, starting where the last frame stopped. Blocks
+    // that do not fit stay changed or owed and go with the next frame.
+    uint8_t packed[128 / 8] = {0};
+    uint8_t block = firstBlock;
+    uint8_t scanned = 0;
+    while (scanned < 128) {
+        if (!((wanted[block / 8] >> (block % 8)) & 1u)) {
+            block = (block + 1) % 128;
+            scanned++;
+            continue;
+        }
+
+        uint8_t count = 1;
+        while (scanned + count < 128 && block + count < 128 &&
+               ((wanted[(block + count) / 8] >> ((block + count) % 8)) & 1u))
+            count++;
+
+        uint8_t *pNext = NULL;
+        while (count > 0 && p + 2 < pEnd) {
+            pNext = packRun(p + 2, pEnd, &currentFrame[block * 8], count * 8);
+            if (pNext)
+                break;
+            count /= 2;
+        }
+        if (!pNext)
+            break;
+
+        p[0] = block;
+        p[1] = count;
+        p = pNext;
+
+        for (uint8_t i = 0; i < count; i++, block++)
+            packed[block / 8] |= 1u << (block % 8);
+        block %= 128;
+        scanned += count;
+    }
+
+    uint8_t check = 0;
+    for (const uint8_t *q = usbFrame + 5; q < p; q++)
+        check ^= *q;
+    *p++ = check;
+
+    const uint16_t len = p - (usbFrame + 5);
+    usbFrame[0] = 0xAA;
+    usbFrame[1] = 0x55;
+    usbFrame[2] = SCREENSHOT_TYPE_RLE;
+    usbFrame[3] = len >> 8;
+    usbFrame[4] = len & 0xFF;
+    *p++ = 0x0A;
+
+    // The stored frame only moves on once the endpoint has taken the frame
+    if (!VCP_TrySendAsync(usbFrame, p - usbFrame)) {
+        if (VCP_IsOpen())
+            usbPending = true;  // a reply holds the endpoint, build it again
+        else
+            memset(owedBlocks, 0xFF, sizeof(owedBlocks));  // whoever opens the port next gets a full frame
+        return;
+    }
+
+    for (block = 0; block < 128; block++) {
+        if ((packed[block / 8] >> (block % 8)) & 1u) {
+            memcpy(&previousFrame[block * 8], &currentFrame[block * 8], 8); // Update stored frame
+            owedBlocks[block / 8] &= ~(1u << (block % 8));
+        }
+    }
+    firstBlock = (firstBlock + scanned) % 128;
+    usbSeq++;
+
+    usbLastTick = gGlobalSysTickCounter;
+    usbCredits--;
+    usbPending = usbCredits > 0 && scanned < 128;  // the rest as soon as allowed
+}
+#endif
+
 void getScreenShot(bool force)
 {
     static uint8_t currentFrame[1024];  // Reused static buffer
@@ -37,14 +192,31 @@ void getScreenShot(bool force)
         return;
     }
 
-    if (UART_IsCableConnected()) {
-        keepAlive = 10;
-    }
+#ifdef ENABLE_SCREENSHOT_USB
+    // With DTR up the host paces the frames, build one only when it can go
+    const bool usb = VCP_IsOpen();
+    if (usb) {
+        if (usbCredits == 0) {
+            usbPending = false;
+            return;
+        }
 
-    if (keepAlive > 0) {
-        if (--keepAlive == 0) return;
-    } else {
-        return;
+        if (!VCP_TxReady() || gGlobalSysTickCounter - usbLastTick < usbInterval) {
+            usbPending = true;
+            return;
+        }
+    } else
+#endif
+    {
+        if (UART_IsCableConnected()) {
+            keepAlive = 10;
+        }
+
+        if (keepAlive > 0) {
+            if (--keepAlive == 0) return;
+        } else {
+            return;
+        }
     }
 
     // ==== Build currentFrame (exact same logic as original) ====
@@ -83,31 +255,46 @@ void getScreenShot(bool force)
         return; // Frame size mismatch, abort
 
     // ==== Generate delta frame ====
-    uint16_t deltaLen = 0;
-    uint8_t deltaFrame[128 * 9];  // Worst case: all 128 blocks changed
+    uint8_t  wanted[128 / 8] = {0};
+    uint16_t blocks = 0;
+
+    if (force)
+        memset(owedBlocks, 0xFF, sizeof(owedBlocks));
+    owedBlocks[forcedBlock / 8] |= 1u << (forcedBlock % 8);
+    forcedBlock = (forcedBlock + 1) % 128;
 
     for (uint8_t block = 0; block < 128; block++) {
-        uint8_t *cur = &currentFrame[block * 8];
-        uint8_t *prev = &previousFrame[block * 8];
-
-        bool changed = memcmp(cur, prev, 8) != 0;
-        bool isForced = (block == forcedBlock);
-        bool fullUpdate = force;
-
-        if (changed || isForced || fullUpdate) {
-            deltaFrame[deltaLen++] = block;
-            memcpy(&deltaFrame[deltaLen], cur, 8);
-            deltaLen += 8;
-            memcpy(prev, cur, 8); // Update stored frame
+        bool owed = (owedBlocks[block / 8] >> (block % 8)) & 1u;
+        bool changed = memcmp(&currentFrame[block * 8], &previousFrame[block * 8], 8) != 0;
+
+        if (owed || changed) {
+            wanted[block / 8] |= 1u << (block % 8);
+            blocks++;
         }
     }
 
-    forcedBlock = (forcedBlock + 1) % 128;
-
-    if (deltaLen == 0)
+    if (blocks == 0)
         return; // No update needed
 
+#ifdef ENABLE_SCREENSHOT_USB
+    if (usb) {
+        sendUsb(currentFrame, wanted);
+        return;
+    }
+#endif
+
+#ifdef ENABLE_UART_DMA_TX
+    // Only what fits in the TX ring goes now, the other blocks stay changed
+    // or owed and go with the next frames
+    uint32_t room = UART_GetTxRoom(UART_TX_STREAM);
+    if (room < 5 + 9 + 1)
+        return;
+    if (blocks > (room - 5 - 1) / 9)
+        blocks = (room - 5 - 1) / 9;
+#endif
+
     // ==== Send frame ====
+    uint16_t deltaLen = blocks * 9;
     uint8_t header[5] = {
         0xAA, 0x55, 0x02,
         (uint8_t)(deltaLen >> 8),
@@ -115,7 +302,25 @@ void getScreenShot(bool force)
     };
 
     UART_Send(header, 5);
-    UART_Send(deltaFrame, deltaLen);
+
+    // Blocks go out one by one, starting after the last one sent so that a
+    // frame cut short does not starve the bottom of the screen
+    uint8_t block = firstBlock;
+    for (uint16_t sent = 0; sent < blocks; block = (block + 1) % 128) {
+        if (!((wanted[block / 8] >> (block % 8)) & 1u))
+            continue;
+
+        uint8_t entry[9];
+        entry[0] = block;
+        memcpy(&entry[1], &currentFrame[block * 8], 8);
+        UART_Send(entry, 9);
+
+        memcpy(&previousFrame[block * 8], &currentFrame[block * 8], 8); // Update stored frame
+        owedBlocks[block / 8] &= ~(1u << (block % 8));
+        sent++;
+    }
+    firstBlock = block;
+
     uint8_t end = 0x0A;
     UART_Send(&end, 1);
-}
\ No newline at end of file
+}
@@ -17,6 +17,38 @@
 #ifndef SCREENSHOT_H
 #define SCREENSHOT_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 void getScreenShot(bool force);
 
+#ifdef ENABLE_SCREENSHOT_USB
+    // While the host holds DTR the frames go to USB CDC instead of the UART,
+    // as run length coded delta frames. Multi-byte fields are big endian.
+    //
+    //   AA 55 04 lenHi lenLo  payload[len]  0A
+    //
+    // payload:
+    //   u8 seq         incremented for every frame, a gap means a lost frame
+    //   runs, each one:
+    //     u8 first     first 8 byte block of the run (0..127)
+    //     u8 count     consecutive blocks in the run (1..128)
+    //     packed       count * 8 bytes, control byte then data:
+    //                  0x00..0x7F  n + 1 literal bytes follow
+    //                  0x80..0xFF  next byte repeated (n & 0x7F) + 3 times
+    //   u8 check       XOR of all preceding payload bytes
+    //
+    // The host paces the stream with command 0x0550: each request sets the
+    // frame interval and how many frames may go out before the next one, so
+    // a viewer that stops reading stops the stream.
+    #define SCREENSHOT_TYPE_RLE 0x04
+
+    #ifndef SCREENSHOT_USB_FRAME
+        #define SCREENSHOT_USB_FRAME 512
+    #endif
+
+    void SCREENSHOT_SetPacing(uint8_t Interval, uint8_t Credits, bool bRefresh);
+    bool SCREENSHOT_IsPending(void);
+#endif
+
 #endif
\ No newline at end of file
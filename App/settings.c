@@ -21,6 +21,12 @@
 #ifdef ENABLE_FMRADIO
     #include "app/fm.h"
 #endif
+#ifdef ENABLE_PRIORITY_LOOKBACK
+    #include "app/lookback.h"
+#endif
+#ifdef ENABLE_SCAN_PLAN
+    #include "app/scanplan.h"
+#endif
 #include "driver/bk1080.h"
 #include "driver/bk4819.h"
 #include "driver/py25q16.h"
@@ -1041,6 +1047,12 @@ void SETTINGS_UpdateChannel(uint8_t channel, const VFO_Info_t *pVFO, bool keep,
         }
 
         gMR_ChannelAttributes[channel] = att;
+#ifdef ENABLE_SCAN_PLAN
+        SCANPLAN_Invalidate();
+#endif
+#ifdef ENABLE_PRIORITY_LOOKBACK
+        LOOKBACK_Invalidate();  // until the next scan start
+#endif
 
         if (IS_MR_CHANNEL(channel)) {   // it's a memory channel
             if (!keep) {
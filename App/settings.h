@@ -126,6 +126,12 @@ enum ACTION_OPT_t {
 #ifdef ENABLE_REGA
     ACTION_OPT_REGA_ALARM,
     ACTION_OPT_REGA_TEST,
+#endif
+#ifdef ENABLE_SCAN_STATS
+    ACTION_OPT_SCAN_STATS,
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    ACTION_OPT_SCAN_JOURNAL,
 #endif
     ACTION_OPT_LEN
 };
@@ -14,11 +14,12 @@
  *     limitations under the License.
  */
 
+#include <assert.h>
 #include <string.h>
 
 #include "driver/st7565.h"
-#include "external/printf/printf.h"
 #include "font.h"
+#include "helper/format.h"
 #include "ui/helper.h"
 #include "ui/inputbox.h"
 #include "misc.h"
@@ -33,7 +34,7 @@ void UI_GenerateChannelString(char *pString, const uint8_t Channel)
 
     if (gInputBoxIndex == 0)
     {
-        sprintf(pString, "CH-%02u", Channel + 1);
+        FORMAT_Channel(pString, Channel + 1, 2);
         return;
     }
 
@@ -57,93 +58,429 @@ void UI_GenerateChannelStringEx(char *pString, const bool bShowPrefix, const uin
 
     if (bShowPrefix) {
         // BUG here? Prefixed NULLs are allowed
-        sprintf(pString, "CH-%03u", ChannelNumber + 1);
+        FORMAT_Channel(pString, ChannelNumber + 1, 3);
     } else if (ChannelNumber == 0xFF) {
         strcpy(pString, "NULL");
     } else {
-        sprintf(pString, "%03u", ChannelNumber + 1);
+        FORMAT_Unsigned(pString, ChannelNumber + 1, 3, '0');
     }
 }
 
-void UI_PrintStringBuffer(const char *pString, uint8_t * buffer, uint32_t char_width, const uint8_t *font)
+#ifdef ENABLE_PACKED_FONTS
+const UI_Font_t gTextFontBig   = { NULL, &gFontBigPacked,   0, '!', '~',    14, 7, 2 };
+const UI_Font_t gTextFontSmall = { NULL, &gFontSmallPacked, 2, '!', '~',    6,  6, 1 };
+#ifdef ENABLE_SMALL_BOLD
+const UI_Font_t gTextFontSmallBold = { NULL, &gFontSmallBoldPacked, 1, '!', '~', 6, 6, 1 };
+#else
+const UI_Font_t gTextFontSmallBold = { NULL, &gFontSmallPacked,     2, '!', '~', 6, 6, 1 };
+#endif
+const UI_Font_t gTextFont3x5   = { NULL, &gFont3x5Packed,   3, ' ', '\x7F', 3,  3, 1 };
+#ifdef ENABLE_PROPORTIONAL_FONT
+// the same glyphs and cache slots as the fixed width fonts
+const UI_Font_t gTextFontSmallProp = { NULL, &gFontSmallPacked, 2, '!', '~', 6, 6, 1, gFontSmallMetrics };
+#ifdef ENABLE_SMALL_BOLD
+const UI_Font_t gTextFontSmallBoldProp = { NULL, &gFontSmallBoldPacked, 1, '!', '~', 6, 6, 1, gFontSmallBoldMetrics };
+#else
+const UI_Font_t gTextFontSmallBoldProp = { NULL, &gFontSmallPacked,     2, '!', '~', 6, 6, 1, gFontSmallMetrics };
+#endif
+#endif
+
+// Even at 64 slots (86% hits) text draws at 0.57x the speed of the plain
+// tables in tools/ui/text_bench.py, so no shipped preset packs its fonts
+#ifndef UI_GLYPH_CACHE_SIZE
+    #define UI_GLYPH_CACHE_SIZE 16
+#endif
+
+static_assert(UI_GLYPH_CACHE_SIZE >= 4 && (UI_GLYPH_CACHE_SIZE & (UI_GLYPH_CACHE_SIZE - 1)) == 0);
+
+// Direct mapped. A glyph goes to the slot of its index counted from the
+// font's own quarter of the cache, so the digits of the big and small fonts
+// land in different slots.
+typedef struct
 {
-    const size_t Length = strlen(pString);
-    const unsigned int char_spacing = char_width + 1;
-    for (size_t i = 0; i < Length; i++) {
-        const unsigned int index = pString[i] - ' ' - 1;
-        if (pString[i] > ' ' && pString[i] < 127) {
-            const uint32_t offset = i * char_spacing + 1;
-            memcpy(buffer + offset, font + index * char_width, char_width);
+    uint8_t Font;        // Id + 1, 0 while the slot is empty
+    uint8_t Index;
+    uint8_t Glyph[14];   // the big font, two pages of seven columns
+} GlyphCache_t;
+
+static GlyphCache_t GlyphCache[UI_GLYPH_CACHE_SIZE];
+static uint32_t     GlyphHits;
+static uint32_t     GlyphMisses;
+
+static void UnpackGlyph(const UI_Font_t *pFont, unsigned int Index, uint8_t *pGlyph)
+{
+    const FontPacked_t *pPacked = pFont->pPacked;
+    const unsigned int  Bits    = pPacked->Bits;
+    const unsigned int  Width   = pFont->Width;
+    const unsigned int  Pages   = pFont->Pages;
+    unsigned int        Offset  = Index * Width * Bits;
+
+    for (unsigned int x = 0; x < Width; x++, Offset += Bits) {
+        // the stream is padded, three bytes always hold a column
+        const uint8_t *p     = pPacked->pStream + Offset / 8;
+        unsigned int   Value = ((p[0] | p[1] << 8 | p[2] << 16) >> (Offset % 8)) & ((1u << Bits) - 1);
+
+        if (pPacked->pColumns) {
+            const uint8_t *pColumn = pPacked->pColumns + Value * Pages;
+
+            for (unsigned int Page = 0; Page < Pages; Page++)
+                pGlyph[Page * Width + x] = pColumn[Page];
+        } else {
+            for (unsigned int Page = 0; Page < Pages; Page++, Value >>= 8)
+                pGlyph[Page * Width + x] = Value;
         }
     }
 }
 
-void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width)
+static const uint8_t *GetGlyph(const UI_Font_t *pFont, unsigned int Index)
 {
-    size_t i;
-    size_t Length = strlen(pString);
+    if (!pFont->pPacked)
+        return pFont->pGlyphs + Index * pFont->Size;
 
-    if (End > Start)
-        Start += (((End - Start) - (Length * Width)) + 1) / 2;
+    const unsigned int Slot   = Index + pFont->Id * (UI_GLYPH_CACHE_SIZE / 4);
+    GlyphCache_t      *pEntry = &GlyphCache[Slot & (UI_GLYPH_CACHE_SIZE - 1)];
 
-    for (i = 0; i < Length; i++)
-    {
-        const unsigned int ofs   = (unsigned int)Start + (i * Width);
-        if (pString[i] > ' ' && pString[i] < 127)
-        {
-            const unsigned int index = pString[i] - ' ' - 1;
-            memcpy(gFrameBuffer[Line + 0] + ofs, &gFontBig[index][0], 7);
-            memcpy(gFrameBuffer[Line + 1] + ofs, &gFontBig[index][7], 7);
+    if (pEntry->Font == pFont->Id + 1 && pEntry->Index == Index) {
+        GlyphHits++;
+        return pEntry->Glyph;
+    }
+
+    GlyphMisses++;
+    UnpackGlyph(pFont, Index, pEntry->Glyph);
+    pEntry->Font  = pFont->Id + 1;
+    pEntry->Index = Index;
+    return pEntry->Glyph;
+}
+
+void UI_GetGlyphCacheStats(uint32_t *pHits, uint32_t *pMisses)
+{
+    *pHits   = GlyphHits;
+    *pMisses = GlyphMisses;
+}
+#else
+const UI_Font_t gTextFontBig   = { &gFontBig[0][0],   '!', '~',    sizeof(gFontBig[0]),   7, 2 };
+const UI_Font_t gTextFontSmall = { &gFontSmall[0][0], '!', '~',    sizeof(gFontSmall[0]), 6, 1 };
+#ifdef ENABLE_SMALL_BOLD
+const UI_Font_t gTextFontSmallBold = { &gFontSmallBold[0][0], '!', '~', sizeof(gFontSmallBold[0]), 6, 1 };
+#else
+const UI_Font_t gTextFontSmallBold = { &gFontSmall[0][0],     '!', '~', sizeof(gFontSmall[0]),     6, 1 };
+#endif
+const UI_Font_t gTextFont3x5   = { &gFont3x5[0][0],   ' ', '\x7F', sizeof(gFont3x5[0]),   3, 1 };
+#ifdef ENABLE_PROPORTIONAL_FONT
+const UI_Font_t gTextFontSmallProp = { &gFontSmall[0][0], '!', '~', sizeof(gFontSmall[0]), 6, 1, gFontSmallMetrics };
+#ifdef ENABLE_SMALL_BOLD
+const UI_Font_t gTextFontSmallBoldProp = { &gFontSmallBold[0][0], '!', '~', sizeof(gFontSmallBold[0]), 6, 1, gFontSmallBoldMetrics };
+#else
+const UI_Font_t gTextFontSmallBoldProp = { &gFontSmall[0][0],     '!', '~', sizeof(gFontSmall[0]),     6, 1, gFontSmallMetrics };
+#endif
+#endif
+
+static inline const uint8_t *GetGlyph(const UI_Font_t *pFont, unsigned int Index)
+{
+    return pFont->pGlyphs + Index * pFont->Size;
+}
+#endif
+
+static inline void PutByte(uint8_t *pByte, uint8_t Bits, uint8_t Mask, UI_TextMode_t Mode)
+{
+    if (Mode == UI_TEXT_OR)
+        *pByte |= Bits & Mask;
+    else if (Mode == UI_TEXT_CLEAR)
+        *pByte &= ~(Bits & Mask);
+    else
+        *pByte = (*pByte & ~Mask) | (Bits & Mask);
+}
+
+#ifdef ENABLE_PROPORTIONAL_FONT
+static inline const uint8_t *GetMetrics(const UI_Font_t *pFont)
+{
+    return pFont->pMetrics;
+}
+#else
+    // a constant, the proportional paths drop out
+    #define GetMetrics(pFont) ((const uint8_t *)NULL)
+#endif
+
+// Ink of a character of a proportional font, 0 outside the font where the
+// blank takes half a cell
+static inline uint8_t GetInk(const uint8_t *pMetrics, unsigned int Index, unsigned int Count)
+{
+    return (Index < Count) ? pMetrics[Index] : 0;
+}
+
+static inline unsigned int GetStep(uint8_t Ink, unsigned int Width, unsigned int Advance)
+{
+    return Ink ? (Ink >> 4) + Advance - Width : Advance / 2;
+}
+
+unsigned int UI_GetTextWidth(const UI_Font_t *pFont, const char *pString, uint8_t Advance)
+{
+    const uint8_t     *pMetrics = GetMetrics(pFont);
+    const uint8_t      Low      = pFont->First;
+    const unsigned int Count    = (uint8_t)pFont->Last - Low + 1;
+    unsigned int       Width    = 0;
+
+    if (!pMetrics) {
+        while (*pString++)
+            Width += Advance;
+        return Width;
+    }
+
+    for (; *pString; pString++)
+        Width += GetStep(GetInk(pMetrics, (uint8_t)(*pString - Low), Count), pFont->Width, Advance);
+
+    return Width;
+}
+
+int UI_DrawText(uint8_t (*pBuffer)[128], uint8_t Rows, const UI_Font_t *pFont, const char *pString, int X, uint8_t Y, uint8_t Advance, UI_TextMode_t Mode)
+{
+    // the buffer writes may alias the descriptor, keep its fields in registers
+    const uint8_t     *pMetrics = GetMetrics(pFont);
+    const uint8_t      Low      = pFont->First;
+    const unsigned int Count    = (uint8_t)pFont->Last - Low + 1;
+    const unsigned int Width    = pFont->Width;
+    const unsigned int Pages    = pFont->Pages;
+    const unsigned int Page     = Y / 8;
+    const unsigned int Shift    = Y % 8;
+    const bool         Inverse  = Mode == UI_TEXT_INVERSE;
+    const bool         Fast     = Mode == UI_TEXT_SET && Shift == 0 && Page + Pages <= Rows;
+    const uint8_t      LowMask  = 0xFF << Shift;
+    const uint8_t      HighMask = 0xFF >> (8 - Shift);
+    int                First    = LCD_WIDTH;
+    int                Last     = -1;
+
+    if (Fast && X >= 0) {
+        // the usual case, one bounds check for the run and whole glyph
+        // pages straight into the lines until one would cross the edge
+        uint8_t *pLine = pBuffer[Page];
+
+        if (!pMetrics) {
+            for (; *pString && X + (int)Width <= LCD_WIDTH; pString++, X += Advance) {
+                const unsigned int Index = (uint8_t)(*pString - Low);
+
+                if (Index >= Count)
+                    continue;
+
+                const uint8_t *pGlyph = GetGlyph(pFont, Index);
+
+                for (unsigned int p = 0; p < Pages; p++)
+                    memcpy(pLine + p * LCD_WIDTH + X, pGlyph + p * Width, Width);
+
+                if (First > X)
+                    First = X;
+                Last = X + Width - 1;
+            }
+        } else {
+            // proportional, only the ink columns of each glyph
+            for (; *pString; pString++) {
+                const unsigned int Index   = (uint8_t)(*pString - Low);
+                const uint8_t      Metrics = GetInk(pMetrics, Index, Count);
+                const unsigned int Ink     = Metrics >> 4;
+
+                if (X + (int)Ink > LCD_WIDTH)
+                    break;
+
+                if (Metrics) {
+                    const uint8_t *pGlyph = GetGlyph(pFont, Index) + (Metrics & 0x0F);
+
+                    for (unsigned int p = 0; p < Pages; p++)
+                        memcpy(pLine + p * LCD_WIDTH + X, pGlyph + p * Width, Ink);
+
+                    if (First > X)
+                        First = X;
+                    Last = X + Ink - 1;
+                }
+
+                X += GetStep(Metrics, Width, Advance);
+            }
+        }
+    }
+
+    // glyphs crossing an edge, shifted or merged, one column at a time
+    for (; *pString && X < LCD_WIDTH; pString++) {
+        const unsigned int Index  = (uint8_t)(*pString - Low);
+        const uint8_t     *pGlyph = NULL;
+        const int          Left   = X;
+        unsigned int       Ink    = Width;
+
+        if (pMetrics) {
+            const uint8_t Metrics = GetInk(pMetrics, Index, Count);
+
+            Ink = Metrics >> 4;
+            X  += GetStep(Metrics, Width, Advance);
+            if (Metrics)
+                pGlyph = GetGlyph(pFont, Index) + (Metrics & 0x0F);
+        } else {
+            X += Advance;
+            if (Index < Count)
+                pGlyph = GetGlyph(pFont, Index);
+        }
+
+        // inverse text lights the gaps and blanks as well
+        const int Span = Inverse ? X - Left : (int)Ink;
+
+        if (!pGlyph && !Inverse)
+            continue;
+
+        if (Left + Span <= 0)
+            continue;
+
+        const int From = (Left < 0) ? 0 : Left;
+        const int To   = (Left + Span > LCD_WIDTH) ? LCD_WIDTH : Left + Span;
+
+        if (From < First)
+            First = From;
+        Last = To - 1;
+
+        for (int x = From; x < To; x++) {
+            const unsigned int Column = x - Left;
+
+            for (unsigned int p = 0; p < Pages; p++) {
+                const unsigned int Row  = Page + p;
+                uint8_t            Bits = (pGlyph && Column < Ink) ? pGlyph[p * Width + Column] : 0;
+
+                if (Inverse)
+                    Bits = ~Bits;
+
+                if (Row < Rows)
+                    PutByte(&pBuffer[Row][x], Bits << Shift, LowMask, Mode);
+                if (Shift && Row + 1 < Rows)
+                    PutByte(&pBuffer[Row + 1][x], Bits >> (8 - Shift), HighMask, Mode);
+            }
         }
     }
+
+    if (Last >= First) {
+        const unsigned int End = Page + Pages + (Shift ? 1 : 0);
+
+        for (unsigned int Row = Page; Row < End && Row < Rows; Row++)
+            ST7565_MarkDirty(&pBuffer[Row][First], Last - First + 1);
+    }
+
+    return X;
+}
+
+static inline void CopyRun(uint8_t *pLine, const UI_Font_t *pFont, const char *pString, unsigned int Length, uint8_t Advance, unsigned int Width, unsigned int Pages)
+{
+    const uint8_t      Low   = pFont->First;
+    const unsigned int Count = (uint8_t)pFont->Last - Low + 1;
+
+    for (unsigned int i = 0; i < Length; i++, pLine += Advance) {
+        const unsigned int Index = (uint8_t)(pString[i] - Low);
+
+        if (Index >= Count)
+            continue;
+
+        const uint8_t *pGlyph = GetGlyph(pFont, Index);
+
+        for (unsigned int p = 0; p < Pages; p++)
+            memcpy(pLine + p * LCD_WIDTH, pGlyph + p * Width, Width);
+    }
 }
 
-void UI_PrintStringSmall(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t char_width, const uint8_t *font)
+// Fixed width text that fits on its line, one glyph after the other as
+// text was drawn before clipping. Most strings are short and need none of
+// the setup of UI_DrawText. Anything else is left to it, false.
+static bool DrawRun(uint8_t *pLine, const UI_Font_t *pFont, const char *pString, int X, uint8_t Advance)
 {
-    const size_t Length = strlen(pString);
-    const unsigned int char_spacing = char_width + 1;
+    const unsigned int Length = strlen(pString);
+    const unsigned int Width  = pFont->Width;
+
+    if (GetMetrics(pFont) || X < 0 || Length == 0 || X + (Length - 1) * Advance + Width > LCD_WIDTH)
+        return false;
+
+    const unsigned int Pages = pFont->Pages;
+
+    // a copy of a known size is a few moves where any other is a call
+    if (Width == 6 && Pages == 1)
+        CopyRun(pLine + X, pFont, pString, Length, Advance, 6, 1);
+    else if (Width == 7 && Pages == 2)
+        CopyRun(pLine + X, pFont, pString, Length, Advance, 7, 2);
+    else
+        CopyRun(pLine + X, pFont, pString, Length, Advance, Width, Pages);
+
+    for (unsigned int p = 0; p < Pages; p++)
+        ST7565_MarkDirty(pLine + p * LCD_WIDTH + X, (Length - 1) * Advance + Width);
 
-    if (End > Start) {
-        Start += (((End - Start) - Length * char_spacing) + 1) / 2;
+    return true;
+}
+
+// Starts past the end of a line carry on into the next one, the layout
+// code relies on that to reach the line below
+static void PrintLine(const char *pString, int Start, uint8_t Line, const UI_Font_t *pFont, uint8_t Advance)
+{
+    while (Start >= LCD_WIDTH) {
+        Start -= LCD_WIDTH;
+        Line++;
     }
 
-    UI_PrintStringBuffer(pString, gFrameBuffer[Line] + Start, char_width, font);
+    if (Line + pFont->Pages > FRAME_LINES || !DrawRun(gFrameBuffer[Line], pFont, pString, Start, Advance))
+        UI_DrawText(gFrameBuffer, FRAME_LINES, pFont, pString, Start, Line * 8, Advance, UI_TEXT_SET);
+}
+
+// pBuffer points into the status line, or at a line of its own
+static void PrintBuffer(const char *pString, uint8_t *pBuffer, const UI_Font_t *pFont)
+{
+    const uintptr_t Offset = (uintptr_t)pBuffer - (uintptr_t)gStatusLine;
+
+    uint8_t *pLine = (Offset < LCD_WIDTH) ? gStatusLine : pBuffer;
+    int      X     = (Offset < LCD_WIDTH) ? Offset + 1 : 1;
+
+    if (!DrawRun(pLine, pFont, pString, X, pFont->Width + 1))
+        UI_DrawText((uint8_t (*)[128])pLine, 1, pFont, pString, X, 0, pFont->Width + 1, UI_TEXT_SET);
 }
 
+void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width)
+{
+    int X = Start;
+
+    if (End > Start)
+        X += ((End - Start) - (int)UI_GetTextWidth(&gTextFontBig, pString, Width) + 1) / 2;
+
+    PrintLine(pString, X, Line, &gTextFontBig, Width);
+}
+
+static void PrintStringSmall(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, const UI_Font_t *pFont)
+{
+    const unsigned int Advance = pFont->Width + 1;
+    int                X       = Start;
+
+    if (End > Start)
+        X += ((End - Start) - (int)UI_GetTextWidth(pFont, pString, Advance) + 1) / 2;
+
+    PrintLine(pString, X + 1, Line, pFont, Advance);
+}
 
 void UI_PrintStringSmallNormal(const char *pString, uint8_t Start, uint8_t End, uint8_t Line)
 {
-    UI_PrintStringSmall(pString, Start, End, Line, ARRAY_SIZE(gFontSmall[0]), (const uint8_t *)gFontSmall);
+    PrintStringSmall(pString, Start, End, Line, &gTextFontSmall);
 }
 
 void UI_PrintStringSmallBold(const char *pString, uint8_t Start, uint8_t End, uint8_t Line)
 {
-#ifdef ENABLE_SMALL_BOLD
-    const uint8_t *font = (uint8_t *)gFontSmallBold;
-    const uint8_t char_width = ARRAY_SIZE(gFontSmallBold[0]);
-#else
-    const uint8_t *font = (uint8_t *)gFontSmall;
-    const uint8_t char_width = ARRAY_SIZE(gFontSmall[0]);
-#endif
+    PrintStringSmall(pString, Start, End, Line, &gTextFontSmallBold);
+}
 
-    UI_PrintStringSmall(pString, Start, End, Line, char_width, font);
+#ifdef ENABLE_PROPORTIONAL_FONT
+void UI_PrintStringSmallProp(const char *pString, uint8_t Start, uint8_t End, uint8_t Line)
+{
+    PrintStringSmall(pString, Start, End, Line, &gTextFontSmallProp);
+}
+
+void UI_PrintStringSmallPropBold(const char *pString, uint8_t Start, uint8_t End, uint8_t Line)
+{
+    PrintStringSmall(pString, Start, End, Line, &gTextFontSmallBoldProp);
 }
+#endif
 
 void UI_PrintStringSmallBufferNormal(const char *pString, uint8_t * buffer)
 {
-    UI_PrintStringBuffer(pString, buffer, ARRAY_SIZE(gFontSmall[0]), (uint8_t *)gFontSmall);
+    PrintBuffer(pString, buffer, &gTextFontSmall);
 }
 
 void UI_PrintStringSmallBufferBold(const char *pString, uint8_t * buffer)
 {
-#ifdef ENABLE_SMALL_BOLD
-    const uint8_t *font = (uint8_t *)gFontSmallBold;
-    const uint8_t char_width = ARRAY_SIZE(gFontSmallBold[0]);
-#else
-    const uint8_t *font = (uint8_t *)gFontSmall;
-    const uint8_t char_width = ARRAY_SIZE(gFontSmall[0]);
-#endif
-    UI_PrintStringBuffer(pString, buffer, char_width, font);
+    PrintBuffer(pString, buffer, &gTextFontSmallBold);
 }
 
 void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center)
@@ -179,6 +516,10 @@ void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center)
         pFb0 += char_width;
         pFb1 += char_width;
     }
+
+    // centring moves back over leading blanks, so take the rest of both lines
+    ST7565_MarkDirty(gFrameBuffer[Y] + X, LCD_WIDTH - X);
+    ST7565_MarkDirty(gFrameBuffer[Y + 1] + X, LCD_WIDTH - X);
 }
 
 /*
@@ -228,6 +569,8 @@ void UI_DrawPixelBuffer(uint8_t (*buffer)[128], uint8_t x, uint8_t y, bool black
         buffer[y/8][x] |= pattern;
     else
         buffer[y/8][x] &= ~pattern;
+
+    ST7565_MarkDirty(&buffer[y/8][x], 1);
 }
 
 static void sort(int16_t *a, int16_t *b)
@@ -272,55 +615,105 @@ static void sort(int16_t *a, int16_t *b)
 
     void GUI_DisplaySmallest(const char *pString, uint8_t x, uint8_t y,
                                     bool statusbar, bool fill) {
-      uint8_t c;
-      uint8_t pixels;
-      const uint8_t *p = (const uint8_t *)pString;
-
-      while ((c = *p++) && c != '\0') {
-        c -= 0x20;
-        for (int i = 0; i < 3; ++i) {
-          pixels = gFont3x5[c][i];
-          for (int j = 0; j < 6; ++j) {
-            if (pixels & 1) {
-              if (statusbar)
-                PutPixelStatus(x + i, y + j, fill);
-              else
-                PutPixel(x + i, y + j, fill);
-            }
-            pixels >>= 1;
-          }
-        }
-        x += 4;
-      }
+      const UI_TextMode_t Mode = fill ? UI_TEXT_OR : UI_TEXT_CLEAR;
+
+      if (statusbar)
+        UI_DrawText(&gStatusLine, 1, &gTextFont3x5, pString, x, y, 4, Mode);
+      else
+        UI_DrawText(gFrameBuffer, FRAME_LINES, &gTextFont3x5, pString, x, y, 4, Mode);
     }
 #endif
     
+// Sorts a pair of coordinates and clips them to 0..Size - 1, false when
+// nothing is left
+static bool ClipSpan(int16_t *a, int16_t *b, int16_t Size)
+{
+    sort(a, b);
+    if (*b < 0 || *a >= Size)
+        return false;
+    if (*a < 0)
+        *a = 0;
+    if (*b >= Size)
+        *b = Size - 1;
+    return true;
+}
+
+void UI_FillRectangleBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black)
+{
+    if (!ClipSpan(&x1, &x2, LCD_WIDTH) || !ClipSpan(&y1, &y2, FRAME_LINES * 8))
+        return;
+
+    const unsigned int Width = x2 - x1 + 1;
+    const unsigned int Last  = y2 / 8;
+
+    // one mask per page, the first and last pages may be partial, the ones
+    // between are whole bytes
+    for (unsigned int Page = y1 / 8; Page <= Last; Page++) {
+        uint8_t       *p    = &buffer[Page][x1];
+        const uint8_t  Mask = ((Page == (unsigned int)y1 / 8) ? 0xFF << (y1 % 8) : 0xFF) &
+                              ((Page == Last) ? 0xFF >> (7 - y2 % 8) : 0xFF);
+
+        if (Mask == 0xFF)
+            memset(p, black ? 0xFF : 0x00, Width);
+        else if (black)
+            for (unsigned int i = 0; i < Width; i++)
+                p[i] |= Mask;
+        else
+            for (unsigned int i = 0; i < Width; i++)
+                p[i] &= ~Mask;
+
+        ST7565_MarkDirty(p, Width);
+    }
+}
+
+void UI_DrawHLineBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t x2, int16_t y, bool black)
+{
+    UI_FillRectangleBuffer(buffer, x1, y, x2, y, black);
+}
+
+void UI_DrawVLineBuffer(uint8_t (*buffer)[128], int16_t x, int16_t y1, int16_t y2, bool black)
+{
+    UI_FillRectangleBuffer(buffer, x, y1, x, y2, black);
+}
+
 void UI_DrawLineBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black)
 {
-    if(x2==x1) {
-        sort(&y1, &y2);
-        for(int16_t i = y1; i <= y2; i++) {
-            UI_DrawPixelBuffer(buffer, x1, i, black);
-        }
-    } else {
-        const int multipl = 1000;
-        int a = (y2-y1)*multipl / (x2-x1);
-        int b = y1 - a * x1 / multipl;
+    if (x1 == x2 || y1 == y2) {
+        UI_FillRectangleBuffer(buffer, x1, y1, x2, y2, black);
+        return;
+    }
 
-        sort(&x1, &x2);
-        for(int i = x1; i<= x2; i++)
-        {
-            UI_DrawPixelBuffer(buffer, i, i*a/multipl +b, black);
+    // Bresenham for the sloped ones
+    const int dx = (x2 > x1) ? x2 - x1 : x1 - x2;
+    const int dy = (y2 > y1) ? y1 - y2 : y2 - y1;
+    const int sx = (x2 > x1) ? 1 : -1;
+    const int sy = (y2 > y1) ? 1 : -1;
+    int       err = dx + dy;
+
+    for (;;) {
+        if (x1 >= 0 && x1 < LCD_WIDTH && y1 >= 0 && y1 < FRAME_LINES * 8)
+            UI_DrawPixelBuffer(buffer, x1, y1, black);
+        if (x1 == x2 && y1 == y2)
+            break;
+
+        const int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x1 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y1 += sy;
         }
     }
 }
 
 void UI_DrawRectangleBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black)
 {
-    UI_DrawLineBuffer(buffer, x1,y1, x1,y2, black);
-    UI_DrawLineBuffer(buffer, x1,y1, x2,y1, black);
-    UI_DrawLineBuffer(buffer, x2,y1, x2,y2, black);
-    UI_DrawLineBuffer(buffer, x1,y2, x2,y2, black);
+    UI_DrawHLineBuffer(buffer, x1, x2, y1, black);
+    UI_DrawHLineBuffer(buffer, x1, x2, y2, black);
+    UI_DrawVLineBuffer(buffer, x1, y1, y2, black);
+    UI_DrawVLineBuffer(buffer, x2, y1, y2, black);
 }
 
 
@@ -349,4 +742,5 @@ void UI_DisplayPopup(const char *string)
 void UI_DisplayClear()
 {
     memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+    ST7565_MarkDirty(gFrameBuffer, sizeof(gFrameBuffer));
 }
@@ -20,11 +20,69 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "font.h"
+
+// A fixed width font, glyphs from First to Last. Each glyph is Pages runs
+// of Width column bytes, one run per 8 pixel page. With metrics the font is
+// proportional: only the ink of a glyph is drawn and the next one follows
+// after the gap of Advance - Width columns.
+typedef struct
+{
+    const uint8_t      *pGlyphs;
+#ifdef ENABLE_PACKED_FONTS
+    const FontPacked_t *pPacked;  // when set, glyphs are unpacked through the glyph cache
+    uint8_t             Id;       // tells the fonts apart in the cache, 0 to 3
+#endif
+    char           First;
+    char           Last;
+    uint8_t        Size;    // bytes per glyph
+    uint8_t        Width;   // columns per glyph
+    uint8_t        Pages;
+#ifdef ENABLE_PROPORTIONAL_FONT
+    const uint8_t *pMetrics;  // ink of each glyph as in font.h, NULL for fixed width
+#endif
+} UI_Font_t;
+
+typedef enum
+{
+    UI_TEXT_SET = 0,   // glyph columns replace what they cover, gaps and blanks are left alone
+    UI_TEXT_OR,        // only the lit pixels are drawn
+    UI_TEXT_CLEAR,     // the lit pixels are cleared
+    UI_TEXT_INVERSE    // every column of the run, gaps too, dark on light
+} UI_TextMode_t;
+
+extern const UI_Font_t gTextFontBig;
+extern const UI_Font_t gTextFontSmall;
+extern const UI_Font_t gTextFontSmallBold;  // gTextFontSmall without ENABLE_SMALL_BOLD
+extern const UI_Font_t gTextFont3x5;
+#ifdef ENABLE_PROPORTIONAL_FONT
+    extern const UI_Font_t gTextFontSmallProp;
+    extern const UI_Font_t gTextFontSmallBoldProp;
+#endif
+
+#ifdef ENABLE_PACKED_FONTS
+    // Glyphs served from the cache and unpacked into it since boot
+    void UI_GetGlyphCacheStats(uint32_t *pHits, uint32_t *pMisses);
+#endif
+
+// Columns UI_DrawText advances over pString, trailing gap included
+unsigned int UI_GetTextWidth(const UI_Font_t *pFont, const char *pString, uint8_t Advance);
+
+// Draws a run of text with its top left corner at column X and pixel row Y
+// of a buffer Rows pages deep, clipped to it. When Y is not on a page
+// boundary each column byte is split across two pages. Returns the column
+// after the run.
+int UI_DrawText(uint8_t (*pBuffer)[128], uint8_t Rows, const UI_Font_t *pFont, const char *pString, int X, uint8_t Y, uint8_t Advance, UI_TextMode_t Mode);
+
 void UI_GenerateChannelString(char *pString, const uint8_t Channel);
 void UI_GenerateChannelStringEx(char *pString, const bool bShowPrefix, const uint8_t ChannelNumber);
 void UI_PrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width);
 void UI_PrintStringSmallNormal(const char *pString, uint8_t Start, uint8_t End, uint8_t Line);
 void UI_PrintStringSmallBold(const char *pString, uint8_t Start, uint8_t End, uint8_t Line);
+#ifdef ENABLE_PROPORTIONAL_FONT
+    void UI_PrintStringSmallProp(const char *pString, uint8_t Start, uint8_t End, uint8_t Line);
+    void UI_PrintStringSmallPropBold(const char *pString, uint8_t Start, uint8_t End, uint8_t Line);
+#endif
 void UI_PrintStringSmallBufferNormal(const char *pString, uint8_t *buffer);
 void UI_PrintStringSmallBufferBold(const char *pString, uint8_t * buffer);
 void UI_DisplayFrequency(const char *string, uint8_t X, uint8_t Y, bool center);
@@ -38,8 +96,13 @@ void UI_DrawPixelBuffer(uint8_t (*buffer)[128], uint8_t x, uint8_t y, bool black
     void PutPixelStatus(uint8_t x, uint8_t y, bool fill);
     void GUI_DisplaySmallest(const char *pString, uint8_t x, uint8_t y, bool statusbar, bool fill);
 #endif
+// Lines and rectangles, ends included, clipped to the frame buffer.
+// Straight lines and fills go a page byte at a time.
+void UI_DrawHLineBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t x2, int16_t y, bool black);
+void UI_DrawVLineBuffer(uint8_t (*buffer)[128], int16_t x, int16_t y1, int16_t y2, bool black);
 void UI_DrawLineBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black);
 void UI_DrawRectangleBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black);
+void UI_FillRectangleBuffer(uint8_t (*buffer)[128], int16_t x1, int16_t y1, int16_t x2, int16_t y2, bool black);
 
 void UI_DisplayClear();
 
@@ -35,6 +35,7 @@ static void Render(void)
     char         String[7];
 
     memset(gStatusLine,  0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
     UI_DisplayClear();
 
     UI_PrintString("PASSWORD", 0, 127, 1, 10);
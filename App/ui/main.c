@@ -29,6 +29,7 @@
 #include "external/printf/printf.h"
 #include "functions.h"
 #include "helper/battery.h"
+#include "helper/format.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -44,6 +45,20 @@
 
 center_line_t center_line = CENTER_LINE_NONE;
 
+#ifdef ENABLE_UI_WIDGETS
+    uint16_t gMainWidgets;
+#endif
+
+// Channel names in the small font, proportional ones fit a full name
+// beside the tags
+#ifdef ENABLE_PROPORTIONAL_FONT
+    #define PrintNameSmallNormal UI_PrintStringSmallProp
+    #define PrintNameSmallBold   UI_PrintStringSmallPropBold
+#else
+    #define PrintNameSmallNormal UI_PrintStringSmallNormal
+    #define PrintNameSmallBold   UI_PrintStringSmallBold
+#endif
+
 #ifdef ENABLE_FEAT_N7SIX
     static int8_t RxBlink;
     static int8_t RxBlinkLed = 0;
@@ -81,6 +96,49 @@ const char *VfoStateStr[] = {
 
 // ***************************************************************************
 
+#ifdef ENABLE_UI_WIDGETS
+// Lines and columns of the frame buffer a widget draws in
+typedef struct {
+    uint8_t Line;
+    uint8_t Lines;
+    uint8_t Column;
+    uint8_t Width;
+} Region_t;
+
+// The frame buffer keeps what each widget last drew. A widget drawn again
+// starts from a cleared region. With pShown the old bytes are kept there
+// and only the columns that come out different are marked for the blit, so
+// a frequency or an S-meter reading that did not change sends nothing;
+// without it the whole region is marked. Dirty marking is held in between.
+static void BeginRedraw(const Region_t *pRegion, uint8_t *pShown)
+{
+    // whole lines follow each other in the frame buffer
+    const bool         Whole = pRegion->Width == LCD_WIDTH;
+    const unsigned int Lines = Whole ? 1 : pRegion->Lines;
+    const unsigned int Width = Whole ? pRegion->Lines * LCD_WIDTH : pRegion->Width;
+
+    for (unsigned int i = 0; i < Lines; i++) {
+        uint8_t *pLine = gFrameBuffer[pRegion->Line + i] + pRegion->Column;
+
+        if (pShown)
+            memcpy(pShown + i * Width, pLine, Width);
+        memset(pLine, 0, Width);
+    }
+}
+
+static void EndRedraw(const Region_t *pRegion, const uint8_t *pShown)
+{
+    // line by line, a change spread across both lines of the big digits
+    // should not drag in the ends of the lines
+    for (unsigned int i = 0; i < pRegion->Lines; i++) {
+        if (pShown)
+            ST7565_MarkChanged(gFrameBuffer[pRegion->Line + i] + pRegion->Column, pShown + i * pRegion->Width, pRegion->Width);
+        else
+            ST7565_MarkDirty(gFrameBuffer[pRegion->Line + i] + pRegion->Column, pRegion->Width);
+    }
+}
+#endif
+
 static void DrawSmallAntennaAndBars(uint8_t *p, unsigned int level)
 {
     if(level>6)
@@ -92,6 +150,8 @@ static void DrawSmallAntennaAndBars(uint8_t *p, unsigned int level)
         char bar = (0xff << (6-i)) & 0x7F;
         memset(p + 2 + i*3, bar, 2);
     }
+
+    ST7565_MarkDirty(p, 2 + 6*3 + 2);
 }
 #if defined ENABLE_AUDIO_BAR || defined ENABLE_RSSI_BAR
 
@@ -161,6 +221,8 @@ static void DrawLevelBar(uint8_t xpos, uint8_t line, uint8_t level, uint8_t bars
         }
 #endif
     }
+
+    ST7565_MarkDirty(p_line + xpos, level * 5);
 }
 #endif
 
@@ -229,6 +291,7 @@ void UI_DisplayAudioBar(void)
 
         uint8_t *p_line = gFrameBuffer[line];
         memset(p_line, 0, LCD_WIDTH);
+        ST7565_MarkDirty(p_line, LCD_WIDTH);
 
         DrawLevelBar(2, line, barsOld, 25);
 
@@ -282,6 +345,7 @@ void DisplayRSSIBar(const bool now)
             {
                 gFrameBuffer[RxLine][i] = 0x00;
             }
+            ST7565_MarkDirty(&gFrameBuffer[RxLine][8], 24 - 8);
             RxBlink = 1;
         }
         ST7565_BlitLine(RxLine);
@@ -289,7 +353,9 @@ void DisplayRSSIBar(const bool now)
 #else
     const unsigned int line = 3;
 #endif
+#if !defined(ENABLE_UI_WIDGETS) || !defined(ENABLE_FEAT_N7SIX)
     uint8_t           *p_line        = gFrameBuffer[line];
+#endif
     char               str[16];
 
 #ifndef ENABLE_FEAT_N7SIX
@@ -315,8 +381,25 @@ void DisplayRSSIBar(const bool now)
         )
         return;     // display is in use
 
-    if (now)
+#ifdef ENABLE_UI_WIDGETS
+    const Region_t Region = {line, 1, 0, LCD_WIDTH};
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    uint8_t        Shown[LCD_WIDTH];
+    uint8_t       *pShown = Shown;
+#else
+    uint8_t       *pShown = NULL;
+#endif
+
+    if (now) {
+        BeginRedraw(&Region, pShown);
+        ST7565_HoldDirty(true);
+    }
+#else
+    if (now) {
         memset(p_line, 0, LCD_WIDTH);
+        ST7565_MarkDirty(p_line, LCD_WIDTH);
+    }
+#endif
 
 #ifdef ENABLE_FEAT_N7SIX
     int16_t rssi_dBm =
@@ -361,12 +444,12 @@ void DisplayRSSIBar(const bool now)
 #ifdef ENABLE_FEAT_N7SIX
     if (gSetting_set_gui)
     {
-        sprintf(str, "%3d", -rssi_dBm);
+        FORMAT_Signed(str, -rssi_dBm, 3, ' ');
         UI_PrintStringSmallNormal(str, LCD_WIDTH + 8, 0, line - 1);
     }
     else
     {
-        sprintf(str, "% 4d %s", -rssi_dBm, "dBm");
+        strcpy(FORMAT_Signed(str, -rssi_dBm, 4, ' '), " dBm");
         if(isMainOnly())
             GUI_DisplaySmallest(str, 2, 41, false, true);
         else
@@ -374,27 +457,37 @@ void DisplayRSSIBar(const bool now)
     }
 
     if(overS9Bars == 0) {
-        sprintf(str, "S%d", s_level);
+        str[0] = 'S';
+        FORMAT_Unsigned(str + 1, s_level, 0, ' ');
     }
     else {
-        sprintf(str, "+%02d", overS9dBm);
+        str[0] = '+';
+        FORMAT_Unsigned(str + 1, overS9dBm, 2, '0');
     }
 
     UI_PrintStringSmallNormal(str, LCD_WIDTH + 38, 0, line - 1);
 #else
     if(overS9Bars == 0) {
-        sprintf(str, "% 4d S%d", -rssi_dBm, s_level);
+        char *p = strcpy(FORMAT_Signed(str, -rssi_dBm, 4, ' '), " S");
+        FORMAT_Unsigned(p + 2, s_level, 0, ' ');
     }
     else {
-        sprintf(str, "% 4d  %2d", -rssi_dBm, overS9dBm);
+        char *p = strcpy(FORMAT_Signed(str, -rssi_dBm, 4, ' '), "  ");
+        FORMAT_Unsigned(p + 2, overS9dBm, 2, ' ');
         memcpy(p_line + 2 + 7*5, &plus, ARRAY_SIZE(plus));
+        ST7565_MarkDirty(p_line + 2 + 7*5, ARRAY_SIZE(plus));
     }
 
     UI_PrintStringSmallNormal(str, 2, 0, line);
 #endif
     DrawLevelBar(bar_x, line, s_level + overS9Bars, 13);
-    if (now)
+    if (now) {
+#ifdef ENABLE_UI_WIDGETS
+        ST7565_HoldDirty(false);
+        EndRedraw(&Region, pShown);
+#endif
         ST7565_BlitLine(line);
+    }
 #else
     int16_t rssi = BK4819_GetRSSI();
     uint8_t Level;
@@ -412,8 +505,10 @@ void DisplayRSSIBar(const bool now)
     }
 
     uint8_t *pLine = (gEeprom.RX_VFO == 0)? gFrameBuffer[2] : gFrameBuffer[6];
-    if (now)
+    if (now) {
         memset(pLine, 0, 23);
+        ST7565_MarkDirty(pLine, 23);
+    }
     DrawSmallAntennaAndBars(pLine, Level);
     if (now)
         ST7565_BlitFullScreen();
@@ -426,6 +521,7 @@ void UI_MAIN_PrintAGC(bool now)
 {
     char buf[20];
     memset(gFrameBuffer[3], 0, 128);
+    ST7565_MarkDirty(gFrameBuffer[3], 128);
     union {
         struct {
             uint16_t _ : 5;
@@ -525,62 +621,39 @@ void UI_MAIN_TimeSlice500ms(void)
 
 // ***************************************************************************
 
-void UI_DisplayMain(void)
+static enum VfoState_t GetVfoState(unsigned int vfo_num)
 {
-    char               String[22];
+    enum VfoState_t state = VfoState[vfo_num];
 
-    center_line = CENTER_LINE_NONE;
-
-    // clear the screen
-    UI_DisplayClear();
-
-    if(gLowBattery && !gLowBatteryConfirmed) {
-        UI_DisplayPopup("LOW BATTERY");
-        ST7565_BlitFullScreen();
-        return;
-    }
+#ifdef ENABLE_ALARM
+    const unsigned int activeTxVFO = gRxVfoIsActive ? gEeprom.RX_VFO : gEeprom.TX_VFO;
 
-#ifndef ENABLE_FEAT_N7SIX
-    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
-    {   // tell user how to unlock the keyboard
-        UI_PrintString("Long press #", 0, LCD_WIDTH, 1, 8);
-        UI_PrintString("to unlock",    0, LCD_WIDTH, 3, 8);
-        ST7565_BlitFullScreen();
-        return;
+    if (gCurrentFunction == FUNCTION_TRANSMIT && gAlarmState == ALARM_STATE_SITE_ALARM) {
+        if (activeTxVFO == vfo_num)
+            state = VFO_STATE_ALARM;
     }
-#else
-    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
-    {   // tell user how to unlock the keyboard
-        uint8_t shift = 3;
-
-        /*
-        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, true);
-        SYSTEM_DelayMs(50);
-        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, false);
-        SYSTEM_DelayMs(50);
-        */
+#endif
 
-        if(isMainOnly())
-        {
-            shift = 5;
-        }
-        //memcpy(gFrameBuffer[shift] + 2, gFontKeyLock, sizeof(gFontKeyLock));
-        UI_PrintStringSmallBold("UNLOCK KEYBOARD", 12, 0, shift);
-        //memcpy(gFrameBuffer[shift] + 120, gFontKeyLock, sizeof(gFontKeyLock));
+    return state;
+}
 
-        /*
-        for (uint8_t i = 12; i < 116; i++)
-        {
-            gFrameBuffer[shift][i] ^= 0xFF;
-        }
-        */
-    }
-#endif
+// Draws the VFO widgets and the center line picked by Widgets, returns
+// false when the center line leaves the screen as it is
+static bool DrawWidgets(uint16_t Widgets)
+{
+    char               String[22];
 
     unsigned int activeTxVFO = gRxVfoIsActive ? gEeprom.RX_VFO : gEeprom.TX_VFO;
 
     for (unsigned int vfo_num = 0; vfo_num < 2; vfo_num++)
     {
+        if (!(Widgets & MAIN_WIDGET_VFO(vfo_num)))
+            continue;
+
+        const bool drawChannel = Widgets & MAIN_WIDGET_CHANNEL(vfo_num);
+        const bool drawName    = Widgets & MAIN_WIDGET_NAME(vfo_num);
+        const bool drawFreq    = Widgets & MAIN_WIDGET_FREQ(vfo_num);
+
 #ifdef ENABLE_FEAT_N7SIX
         const unsigned int line0 = 0;  // text screen line
         const unsigned int line1 = 4;
@@ -638,9 +711,9 @@ void UI_DisplayMain(void)
                     }
 
                     UI_PrintString("ScnRng", 5, 0, line + shift, 8);
-                    sprintf(String, "%3u.%05u", gScanRangeStart / 100000, gScanRangeStart % 100000);
+                    FORMAT_Frequency(String, gScanRangeStart, 3, ' ');
                     UI_PrintStringSmallNormal(String, 56, 0, line + shift);
-                    sprintf(String, "%3u.%05u", gScanRangeStop / 100000, gScanRangeStop % 100000);
+                    FORMAT_Frequency(String, gScanRangeStop, 3, ' ');
                     UI_PrintStringSmallNormal(String, 56, 0, line + shift + 1);
 
                     if (!isMainOnly())
@@ -652,9 +725,9 @@ void UI_DisplayMain(void)
                 }
 #else
                 UI_PrintString("ScnRng", 5, 0, line, 8);
-                sprintf(String, "%3u.%05u", gScanRangeStart / 100000, gScanRangeStart % 100000);
+                FORMAT_Frequency(String, gScanRangeStart, 3, ' ');
                 UI_PrintStringSmallNormal(String, 56, 0, line);
-                sprintf(String, "%3u.%05u", gScanRangeStop / 100000, gScanRangeStop % 100000);
+                FORMAT_Frequency(String, gScanRangeStop, 3, ' ');
                 UI_PrintStringSmallNormal(String, 56, 0, line + 1);
                 continue;
 #endif
@@ -723,10 +796,10 @@ void UI_DisplayMain(void)
             }
 
             // highlight the selected/used VFO with a marker
-            if (isMainVFO)
+            if (isMainVFO && drawChannel)
                 memcpy(p_line0 + 0, BITMAP_VFO_Default, sizeof(BITMAP_VFO_Default));
         }
-        else // active TX VFO
+        else if (drawChannel) // active TX VFO
         {   // highlight the selected/used VFO with a marker
             if (isMainVFO)
                 memcpy(p_line0 + 0, BITMAP_VFO_Default, sizeof(BITMAP_VFO_Default));
@@ -736,7 +809,7 @@ void UI_DisplayMain(void)
 
         uint32_t frequency = gEeprom.VfoInfo[vfo_num].pRX->Frequency;
 
-        if(TX_freq_check(frequency) != 0 && gEeprom.VfoInfo[vfo_num].TX_LOCK == true)
+        if(drawChannel && TX_freq_check(frequency) != 0 && gEeprom.VfoInfo[vfo_num].TX_LOCK == true)
         {
             if(isMainOnly())
                 memcpy(p_line0 + 14, BITMAP_VFO_Lock, sizeof(BITMAP_VFO_Lock));
@@ -756,7 +829,8 @@ void UI_DisplayMain(void)
                 if (activeTxVFO == vfo_num)
                 {   // show the TX symbol
                     mode = VFO_MODE_TX;
-                    UI_PrintStringSmallBold("TX", 8, 0, line);
+                    if (drawChannel)
+                        UI_PrintStringSmallBold("TX", 8, 0, line);
                 }
             }
         }
@@ -779,13 +853,14 @@ void UI_DisplayMain(void)
                     RxBlink = 0;
                 }
 #else
-                UI_PrintStringSmallBold("RX", 8, 0, line);
+                if (drawChannel)
+                    UI_PrintStringSmallBold("RX", 8, 0, line);
 #endif
             }
 #ifdef ENABLE_FEAT_N7SIX
             else
             {
-                if(RxOnVfofrequency == frequency && !isMainOnly())
+                if(RxOnVfofrequency == frequency && !isMainOnly() && drawChannel)
                 {
                     UI_PrintStringSmallNormal(">>", 8, 0, line);
                     //memcpy(p_line0 + 14, BITMAP_VFO_Default, sizeof(BITMAP_VFO_Default));
@@ -797,56 +872,58 @@ void UI_DisplayMain(void)
 #endif
         }
 
-        if (IS_MR_CHANNEL(gEeprom.ScreenChannel[vfo_num]))
-        {   // channel mode
-            const unsigned int x = 2;
-            const bool inputting = gInputBoxIndex != 0 && gEeprom.TX_VFO == vfo_num;
-            if (!inputting)
-                sprintf(String, "M%u", gEeprom.ScreenChannel[vfo_num] + 1);
-            else
-                sprintf(String, "M%.3s", INPUTBOX_GetAscii());  // show the input text
-            UI_PrintStringSmallNormal(String, x, 0, line + 1);
-        }
-        else if (IS_FREQ_CHANNEL(gEeprom.ScreenChannel[vfo_num]))
-        {   // frequency mode
-            // show the frequency band number
-            const unsigned int x = 2;
-            char * buf = gEeprom.VfoInfo[vfo_num].pRX->Frequency < _1GHz_in_KHz ? "" : "+";
-            sprintf(String, "F%u%s", 1 + gEeprom.ScreenChannel[vfo_num] - FREQ_CHANNEL_FIRST, buf);
-            UI_PrintStringSmallNormal(String, x, 0, line + 1);
-        }
-#ifdef ENABLE_NOAA
-        else
+        if (drawChannel)
         {
-            if (gInputBoxIndex == 0 || gEeprom.TX_VFO != vfo_num)
-            {   // channel number
-                sprintf(String, "N%u", 1 + gEeprom.ScreenChannel[vfo_num] - NOAA_CHANNEL_FIRST);
+            if (IS_MR_CHANNEL(gEeprom.ScreenChannel[vfo_num]))
+            {   // channel mode
+                const unsigned int x = 2;
+                const bool inputting = gInputBoxIndex != 0 && gEeprom.TX_VFO == vfo_num;
+                if (!inputting) {
+                    String[0] = 'M';
+                    FORMAT_Unsigned(String + 1, gEeprom.ScreenChannel[vfo_num] + 1, 0, ' ');
+                } else
+                    sprintf(String, "M%.3s", INPUTBOX_GetAscii());  // show the input text
+                UI_PrintStringSmallNormal(String, x, 0, line + 1);
+            }
+            else if (IS_FREQ_CHANNEL(gEeprom.ScreenChannel[vfo_num]))
+            {   // frequency mode
+                // show the frequency band number
+                const unsigned int x = 2;
+                char * buf = gEeprom.VfoInfo[vfo_num].pRX->Frequency < _1GHz_in_KHz ? "" : "+";
+                String[0] = 'F';
+                strcpy(FORMAT_Unsigned(String + 1, 1 + gEeprom.ScreenChannel[vfo_num] - FREQ_CHANNEL_FIRST, 0, ' '), buf);
+                UI_PrintStringSmallNormal(String, x, 0, line + 1);
             }
+#ifdef ENABLE_NOAA
             else
-            {   // user entering channel number
-                sprintf(String, "N%u%u", '0' + gInputBox[0], '0' + gInputBox[1]);
+            {
+                if (gInputBoxIndex == 0 || gEeprom.TX_VFO != vfo_num)
+                {   // channel number
+                    sprintf(String, "N%u", 1 + gEeprom.ScreenChannel[vfo_num] - NOAA_CHANNEL_FIRST);
+                }
+                else
+                {   // user entering channel number
+                    sprintf(String, "N%u%u", '0' + gInputBox[0], '0' + gInputBox[1]);
+                }
+                UI_PrintStringSmallNormal(String, 7, 0, line + 1);
             }
-            UI_PrintStringSmallNormal(String, 7, 0, line + 1);
-        }
 #endif
+        }
 
         // ************
 
-        enum VfoState_t state = VfoState[vfo_num];
+        const enum VfoState_t state = GetVfoState(vfo_num);
 
-#ifdef ENABLE_ALARM
-        if (gCurrentFunction == FUNCTION_TRANSMIT && gAlarmState == ALARM_STATE_SITE_ALARM) {
-            if (activeTxVFO == vfo_num)
-                state = VFO_STATE_ALARM;
-        }
-#endif
         if (state != VFO_STATE_NORMAL)
         {
-            if (state < ARRAY_SIZE(VfoStateStr))
+            if (state < ARRAY_SIZE(VfoStateStr) && drawFreq)
                 UI_PrintString(VfoStateStr[state], 31, 0, line, 8);
         }
         else if (gInputBoxIndex > 0 && IS_FREQ_CHANNEL(gEeprom.ScreenChannel[vfo_num]) && gEeprom.TX_VFO == vfo_num)
         {   // user entering a frequency
+            if (!drawFreq)
+                continue;
+
             const char * ascii = INPUTBOX_GetAscii();
             bool isGigaF = frequency>=_1GHz_in_KHz;
             sprintf(String, "%.*s.%.3s", 3 + isGigaF, ascii, ascii + 3 + isGigaF);
@@ -867,7 +944,7 @@ void UI_DisplayMain(void)
 
             continue;
         }
-        else
+        else if (drawName || drawFreq)
         {
             if (gCurrentFunction == FUNCTION_TRANSMIT)
             {   // transmitting
@@ -884,7 +961,7 @@ void UI_DisplayMain(void)
                 uint8_t countList = 0;
                 uint8_t shiftList = 0;
 
-                if(gMR_ChannelExclude[gEeprom.ScreenChannel[vfo_num]] == false)
+                if(drawName && gMR_ChannelExclude[gEeprom.ScreenChannel[vfo_num]] == false)
                 {
                     // show the scan list assigment symbols
                     const ChannelAttributes_t att = gMR_ChannelAttributes[gEeprom.ScreenChannel[vfo_num]];
@@ -915,7 +992,7 @@ void UI_DisplayMain(void)
                         }
                     }
                 }
-                else
+                else if (drawName)
                 {
                     memcpy(p_line0 + 127 - (1 * 6), BITMAP_ScanListE, sizeof(BITMAP_ScanListE));
                 }
@@ -930,7 +1007,7 @@ void UI_DisplayMain(void)
 // compander symbol
 #ifndef ENABLE_BIG_FREQ
     // Changed 'att.compander' to 'gEeprom.VfoInfo[vfo_num].Compander' to fix undefined error
-    if (gEeprom.VfoInfo[vfo_num].Compander)
+    if (gEeprom.VfoInfo[vfo_num].Compander && drawFreq)
         memcpy(p_line0 + 120 + LCD_WIDTH, BITMAP_compand, sizeof(BITMAP_compand));
 #else
     // TODO:  // find somewhere else to put the symbol
@@ -939,7 +1016,7 @@ void UI_DisplayMain(void)
                 switch (gEeprom.CHANNEL_DISPLAY_MODE)
                 {
                     case MDF_FREQUENCY: // show the channel frequency
-                        sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
+                        FORMAT_Frequency(String, frequency, 3, ' ');
 #ifdef ENABLE_BIG_FREQ
                         if(frequency < _1GHz_in_KHz) {
                             // show the remaining 2 small frequency digits
@@ -958,17 +1035,22 @@ void UI_DisplayMain(void)
                         break;
 
                     case MDF_CHANNEL:   // show the channel number
-                        sprintf(String, "CH-%03u", gEeprom.ScreenChannel[vfo_num] + 1);
+                        FORMAT_Channel(String, gEeprom.ScreenChannel[vfo_num] + 1, 3);
                         UI_PrintString(String, 32, 0, line, 8);
                         break;
 
                     case MDF_NAME:      // show the channel name
                     case MDF_NAME_FREQ: // show the channel name and frequency
 
-                        SETTINGS_FetchChannelName(String, gEeprom.ScreenChannel[vfo_num]);
-                        if (String[0] == 0)
-                        {   // no channel name, show the channel number instead
-                            sprintf(String, "CH-%03u", gEeprom.ScreenChannel[vfo_num] + 1);
+                        // a name in the big font takes the frequency lines too,
+                        // the two are then always drawn together
+                        if (drawName)
+                        {
+                            SETTINGS_FetchChannelName(String, gEeprom.ScreenChannel[vfo_num]);
+                            if (String[0] == 0)
+                            {   // no channel name, show the channel number instead
+                                FORMAT_Channel(String, gEeprom.ScreenChannel[vfo_num] + 1, 3);
+                            }
                         }
 
                         if (gEeprom.CHANNEL_DISPLAY_MODE == MDF_NAME) {
@@ -980,24 +1062,25 @@ void UI_DisplayMain(void)
                             {
                                 UI_PrintString(String, 32, 0, line, 8);
                             }
-                            else
+                            else if (drawName)
                             {
                                 if(activeTxVFO == vfo_num) {
-                                    UI_PrintStringSmallBold(String, 32 + 4, 0, line);
+                                    PrintNameSmallBold(String, 32 + 4, 0, line);
                                 }
                                 else
                                 {
-                                    UI_PrintStringSmallNormal(String, 32 + 4, 0, line);     
+                                    PrintNameSmallNormal(String, 32 + 4, 0, line);
                                 }
                             }
 #else
-                            UI_PrintStringSmallBold(String, 32 + 4, 0, line);
+                            if (drawName)
+                                PrintNameSmallBold(String, 32 + 4, 0, line);
 #endif
 
 #ifdef ENABLE_FEAT_N7SIX
                             if (isMainOnly())
                             {
-                                sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
+                                FORMAT_Frequency(String, frequency, 3, ' ');
                                 if(frequency < _1GHz_in_KHz) {
                                     // show the remaining 2 small frequency digits
                                     UI_PrintStringSmallNormal(String + 7, 113, 0, line + 4);
@@ -1011,14 +1094,16 @@ void UI_DisplayMain(void)
                                     UI_PrintString(String, 32, 0, line + 3, 8);
                                 }
                             }
-                            else
+                            else if (drawFreq)
                             {
-                                sprintf(String, "%03u.%05u", frequency / 100000, frequency % 100000);
+                                FORMAT_Frequency(String, frequency, 3, '0');
                                 UI_PrintStringSmallNormal(String, 32 + 4, 0, line + 1);
                             }
 #else                           // show the channel frequency below the channel number/name
-                            sprintf(String, "%03u.%05u", frequency / 100000, frequency % 100000);
-                            UI_PrintStringSmallNormal(String, 32 + 4, 0, line + 1);
+                            if (drawFreq) {
+                                FORMAT_Frequency(String, frequency, 3, '0');
+                                UI_PrintStringSmallNormal(String, 32 + 4, 0, line + 1);
+                            }
 #endif
                         }
 
@@ -1027,7 +1112,7 @@ void UI_DisplayMain(void)
             }
             else
             {   // frequency mode
-                sprintf(String, "%3u.%05u", frequency / 100000, frequency % 100000);
+                FORMAT_Frequency(String, frequency, 3, ' ');
 
 #ifdef ENABLE_BIG_FREQ
                 if(frequency < _1GHz_in_KHz) {
@@ -1057,6 +1142,9 @@ void UI_DisplayMain(void)
 
         // ************
 
+        if (!(Widgets & MAIN_WIDGET_TAGS(vfo_num)))
+            continue;
+
         {   // show the TX/RX level
             int8_t Level = -1;
 
@@ -1371,7 +1459,8 @@ void UI_DisplayMain(void)
            if (gMonitor) {
                 strcpy(String, "MONI");
            } else {
-                sprintf(String, "SQL%d", gEeprom.SQUELCH_LEVEL);
+                strcpy(String, "SQL");
+                FORMAT_Unsigned(String + 3, gEeprom.SQUELCH_LEVEL, 0, ' ');
            }
 
            if (gSetting_set_gui) {
@@ -1383,6 +1472,9 @@ void UI_DisplayMain(void)
 #endif
     }
 
+    if (!(Widgets & MAIN_WIDGET_CENTER))
+        return true;
+
 #ifdef ENABLE_AGC_SHOW_DATA
     center_line = CENTER_LINE_IN_USE;
     UI_MAIN_PrintAGC(false);
@@ -1409,7 +1501,7 @@ void UI_DisplayMain(void)
                 || gDTMF_CallState != DTMF_CALL_STATE_NONE
 #endif
                 )
-                return;
+                return false;
 
             center_line = CENTER_LINE_AM_FIX_DATA;
             AM_fix_print_data(gEeprom.RX_VFO, String);
@@ -1438,7 +1530,7 @@ void UI_DisplayMain(void)
                         || gDTMF_CallState != DTMF_CALL_STATE_NONE
 #endif
                         )
-                        return;
+                        return false;
 
                     center_line = CENTER_LINE_DTMF_DEC;
 
@@ -1465,7 +1557,7 @@ void UI_DisplayMain(void)
 
                     if (gScreenToDisplay != DISPLAY_MAIN ||
                         gDTMF_CallState != DTMF_CALL_STATE_NONE)
-                        return;
+                        return false;
 
                     center_line = CENTER_LINE_DTMF_DEC;
 
@@ -1482,7 +1574,7 @@ void UI_DisplayMain(void)
                     || gDTMF_CallState != DTMF_CALL_STATE_NONE
 #endif
                     )
-                    return;
+                    return false;
 
                 center_line = CENTER_LINE_CHARGE_DATA;
 
@@ -1495,6 +1587,62 @@ void UI_DisplayMain(void)
         }
     }
 
+    return true;
+}
+
+void UI_DisplayMain(void)
+{
+    center_line = CENTER_LINE_NONE;
+
+    // clear the screen
+    UI_DisplayClear();
+
+    if(gLowBattery && !gLowBatteryConfirmed) {
+        UI_DisplayPopup("LOW BATTERY");
+        ST7565_BlitFullScreen();
+        return;
+    }
+
+#ifndef ENABLE_FEAT_N7SIX
+    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
+    {   // tell user how to unlock the keyboard
+        UI_PrintString("Long press #", 0, LCD_WIDTH, 1, 8);
+        UI_PrintString("to unlock",    0, LCD_WIDTH, 3, 8);
+        ST7565_BlitFullScreen();
+        return;
+    }
+#else
+    if (gEeprom.KEY_LOCK && gKeypadLocked > 0)
+    {   // tell user how to unlock the keyboard
+        uint8_t shift = 3;
+
+        /*
+        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, true);
+        SYSTEM_DelayMs(50);
+        BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, false);
+        SYSTEM_DelayMs(50);
+        */
+
+        if(isMainOnly())
+        {
+            shift = 5;
+        }
+        //memcpy(gFrameBuffer[shift] + 2, gFontKeyLock, sizeof(gFontKeyLock));
+        UI_PrintStringSmallBold("UNLOCK KEYBOARD", 12, 0, shift);
+        //memcpy(gFrameBuffer[shift] + 120, gFontKeyLock, sizeof(gFontKeyLock));
+
+        /*
+        for (uint8_t i = 12; i < 116; i++)
+        {
+            gFrameBuffer[shift][i] ^= 0xFF;
+        }
+        */
+    }
+#endif
+
+    if (!DrawWidgets(MAIN_WIDGET_ALL))
+        return;
+
 #ifdef ENABLE_FEAT_N7SIX
     //#ifdef ENABLE_FEAT_N7SIX_RESCUE_OPS
     //if(gEeprom.MENU_LOCK == false)
@@ -1502,8 +1650,9 @@ void UI_DisplayMain(void)
     //#endif
     if (isMainOnly() && !gDTMF_InputMode)
     {
-        sprintf(String, "VFO %s", activeTxVFO ? "B" : "A");
-        UI_PrintStringSmallBold(String, 92, 0, 6);
+        const unsigned int activeTxVFO = gRxVfoIsActive ? gEeprom.RX_VFO : gEeprom.TX_VFO;
+
+        UI_PrintStringSmallBold(activeTxVFO ? "VFO B" : "VFO A", 92, 0, 6);
         for (uint8_t i = 92; i < 128; i++)
         {
             gFrameBuffer[6][i] ^= 0x7F;
@@ -1517,4 +1666,176 @@ void UI_DisplayMain(void)
     ST7565_BlitFullScreen();
 }
 
+#ifdef ENABLE_UI_WIDGETS
+static bool CanUpdateWidgets(void)
+{
+    // popups, the key lock hint, DTMF and the single VFO layout move things
+    // across the widget lines, those screens are always drawn whole
+    if ((gLowBattery && !gLowBatteryConfirmed) || (gEeprom.KEY_LOCK && gKeypadLocked > 0))
+        return false;
+
+    if (gDTMF_InputMode
+#ifdef ENABLE_DTMF_CALLING
+        || gDTMF_CallState != DTMF_CALL_STATE_NONE || gDTMF_IsTx
+#endif
+        )
+        return false;
+
+#ifdef ENABLE_FEAT_N7SIX
+    if (isMainOnly())
+        return false;
+#endif
+
+    return true;
+}
+
+// Regions of the widgets of VFO A, VFO B is four lines further down
+static const Region_t WidgetRegions[] = {
+    {0, 2,  0, 31},             // channel
+    {0, 1, 31, LCD_WIDTH - 31}, // name
+    {1, 1, 31, LCD_WIDTH - 31}, // frequency
+    {2, 1,  0, LCD_WIDTH},      // tags
+};
+
+#ifdef ENABLE_SCAN_RANGES
+// The VFO not in use shows the scan range of the other one across both
+// of its lines
+static bool ShowsScanRange(unsigned int vfo_num)
+{
+    const unsigned int activeTxVFO = gRxVfoIsActive ? gEeprom.RX_VFO : gEeprom.TX_VFO;
+
+#ifdef ENABLE_FEAT_N7SIX
+    return gScanRangeStart && vfo_num != activeTxVFO && IS_FREQ_CHANNEL(gEeprom.ScreenChannel[activeTxVFO]);
+#else
+    return gScanRangeStart && vfo_num != activeTxVFO;
+#endif
+}
+#endif
+
+// Name and frequency on lines of their own, otherwise the one text of the
+// big font takes both
+static bool SplitsName(unsigned int vfo_num)
+{
+    return IS_MR_CHANNEL(gEeprom.ScreenChannel[vfo_num]) &&
+           gEeprom.CHANNEL_DISPLAY_MODE == MDF_NAME_FREQ &&
+           GetVfoState(vfo_num) == VFO_STATE_NORMAL;
+}
+
+// The widgets drawn together with widget Index, and their region. Widgets
+// that fill whole lines together are drawn over those lines at once.
+static uint16_t GetGroup(unsigned int Index, uint16_t Widgets, Region_t *pRegion)
+{
+    if (Index == 8) {
+        *pRegion = (Region_t){3, 1, 0, LCD_WIDTH};
+        return MAIN_WIDGET_CENTER;
+    }
+
+    const unsigned int vfo_num = Index / 4;
+    const uint16_t     Field   = MAIN_WIDGET_NAME(vfo_num) | MAIN_WIDGET_FREQ(vfo_num);
+    const uint16_t     Top     = MAIN_WIDGET_CHANNEL(vfo_num) | Field;
+    uint16_t           Group   = 1u << Index;
+
+    *pRegion = WidgetRegions[Index % 4];
+
+#ifdef ENABLE_SCAN_RANGES
+    if (ShowsScanRange(vfo_num)) {
+        *pRegion = (Region_t){0, 2, 0, LCD_WIDTH};
+        Group    = MAIN_WIDGET_VFO(vfo_num);
+    }
+    else
+#endif
+    {
+        const bool Split = SplitsName(vfo_num);
+
+        Widgets &= MAIN_WIDGET_VFO(vfo_num);
+        if (!Split && (Widgets & Field))
+            Widgets |= Field;
+
+        if (Widgets == MAIN_WIDGET_VFO(vfo_num)) {
+            *pRegion = (Region_t){0, 3, 0, LCD_WIDTH};
+            Group    = Widgets;
+        }
+        else if ((Group & Top) && (Widgets & Top) == Top) {
+            *pRegion = (Region_t){0, 2, 0, LCD_WIDTH};
+            Group    = Top;
+        }
+        else if ((Group & Field) && !Split) {
+            *pRegion = (Region_t){0, 2, 31, LCD_WIDTH - 31};
+            Group    = Field;
+        }
+    }
+
+    pRegion->Line += vfo_num * 4;
+    return Group;
+}
+
+void UI_MAIN_Invalidate(uint16_t Widgets)
+{
+    if (gScreenToDisplay == DISPLAY_MAIN)
+        gMainWidgets |= Widgets;
+    else
+        gUpdateDisplay = true;
+}
+
+void UI_MAIN_UpdateWidgets(void)
+{
+    uint16_t     Widgets = gMainWidgets & MAIN_WIDGET_ALL;
+    uint16_t     Drawn   = 0;
+    Region_t     Region[9];
+    uint8_t     *pShown[9];
+    unsigned int Count   = 0;
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    // the old bytes of the first regions, later ones and a VFO drawn
+    // whole, which hardly leaves a column as it was, are sent whole
+    uint8_t      Shown[2 * LCD_WIDTH];
+    unsigned int Used    = 0;
+#endif
+
+    gMainWidgets = 0;
+
+    if (gScreenToDisplay != DISPLAY_MAIN)
+        return;
+
+    if (!CanUpdateWidgets()) {
+        UI_DisplayMain();
+        return;
+    }
+
+    for (unsigned int i = 0; Widgets; i++) {
+        if (!(Widgets & (1u << i)))
+            continue;
+
+        const uint16_t Group = GetGroup(i, Widgets, &Region[Count]);
+
+        Widgets &= ~Group;
+        Drawn   |= Group;
+
+        pShown[Count] = NULL;
+#ifdef ENABLE_LCD_DIRTY_SPANS
+        const unsigned int Size = Region[Count].Lines * Region[Count].Width;
+        if (Used + Size <= sizeof(Shown)) {
+            pShown[Count] = Shown + Used;
+            Used += Size;
+        }
+#endif
+        BeginRedraw(&Region[Count], pShown[Count]);
+        Count++;
+    }
+
+    if (Drawn & MAIN_WIDGET_CENTER)
+        center_line = CENTER_LINE_NONE;
+
+    // all of them in one pass, the settings of a VFO are looked at once
+    ST7565_HoldDirty(true);
+    const bool Shows = DrawWidgets(Drawn);
+    ST7565_HoldDirty(false);
+
+    for (unsigned int i = 0; i < Count; i++)
+        EndRedraw(&Region[i], pShown[i]);
+
+    if (Shows)
+        ST7565_BlitFullScreen();
+}
+#endif
+
 // ***************************************************************************
@@ -17,6 +17,7 @@
 
 #ifndef UI_MAIN_H
 #define UI_MAIN_H
+#include <stdbool.h>
 #include <stdint.h>
 
 enum center_line_t {
@@ -44,6 +45,26 @@ void UI_DisplayAudioBar(void);
 void UI_MAIN_TimeSlice500ms(void);
 void UI_DisplayMain(void);
 
+// Parts of the main screen that can be drawn again on their own, four for
+// each VFO and the center line between them
+#define MAIN_WIDGET_CHANNEL(n)  (1u << (4 * (n) + 0))  // VFO marker, channel number, RX/TX
+#define MAIN_WIDGET_NAME(n)     (1u << (4 * (n) + 1))  // channel name, scan lists
+#define MAIN_WIDGET_FREQ(n)     (1u << (4 * (n) + 2))  // frequency, channel number or state
+#define MAIN_WIDGET_TAGS(n)     (1u << (4 * (n) + 3))  // power and mode tags, signal bars
+#define MAIN_WIDGET_VFO(n)      (0x0Fu << (4 * (n)))
+#define MAIN_WIDGET_CENTER      (1u << 8)              // S-meter, live DTMF, charge level
+#define MAIN_WIDGET_ALL         (MAIN_WIDGET_VFO(0) | MAIN_WIDGET_VFO(1) | MAIN_WIDGET_CENTER)
+
+#ifdef ENABLE_UI_WIDGETS
+    // widgets waiting for UI_MAIN_UpdateWidgets, other screens use gUpdateDisplay
+    extern uint16_t gMainWidgets;
+
+    void UI_MAIN_Invalidate(uint16_t Widgets);
+    void UI_MAIN_UpdateWidgets(void);
+#else
+    #define UI_MAIN_Invalidate(Widgets) (gUpdateDisplay = true)
+#endif
+
 #ifdef ENABLE_AGC_SHOW_DATA
 void UI_MAIN_PrintAGC(bool force);
 #endif
@@ -463,6 +463,12 @@ const t_sidefunction gSubMenu_SIDEFUNCTIONS[] =
 #ifdef ENABLE_BLMIN_TMP_OFF
     {"BLMIN\nTMP OFF",  ACTION_OPT_BLMIN_TMP_OFF},      //BackLight Minimum Temporay OFF
 #endif
+#ifdef ENABLE_SCAN_STATS
+    {"ACTIVITY",        ACTION_OPT_SCAN_STATS},
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    {"SCAN\nJOURNAL",   ACTION_OPT_SCAN_JOURNAL},
+#endif
 #ifdef ENABLE_FEAT_N7SIX
     {"RX MODE",         ACTION_OPT_RXMODE},
     {"MAIN ONLY",       ACTION_OPT_MAINONLY},
@@ -0,0 +1,144 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "driver/st7565.h"
+#include "helper/format.h"
+#include "misc.h"
+#include "ui/helper.h"
+#include "ui/profiler.h"
+
+// SysTick runs from the 48 MHz core clock
+#define CYCLES_PER_100US 4800
+
+static const char Names[PROFILER_SLOTS][5] = {
+    [PROFILER_STATUS]      = "STAT",
+    [PROFILER_BLIT_FULL]   = "BFUL",
+    [PROFILER_BLIT_LINE]   = "BLIN",
+    [PROFILER_BLIT_STATUS] = "BSTA",
+
+    [PROFILER_SCREEN + DISPLAY_MAIN]    = "MAIN",
+    [PROFILER_SCREEN + DISPLAY_MENU]    = "MENU",
+    [PROFILER_SCREEN + DISPLAY_SCANNER] = "SCAN",
+#ifdef ENABLE_FMRADIO
+    [PROFILER_SCREEN + DISPLAY_FM] = "FM",
+#endif
+#ifdef ENABLE_AIRCOPY
+    [PROFILER_SCREEN + DISPLAY_AIRCOPY] = "COPY",
+#endif
+#ifdef ENABLE_SCAN_STATS
+    [PROFILER_SCREEN + DISPLAY_SCAN_STATS] = "SCST",
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    [PROFILER_SCREEN + DISPLAY_SCAN_JOURNAL] = "JRNL",
+#endif
+#ifdef ENABLE_REGA
+    [PROFILER_SCREEN + DISPLAY_REGA] = "REGA",
+#endif
+};
+
+static ProfilerSlot_t Slots[PROFILER_SLOTS];
+static bool           Overlay = true;
+
+void PROFILER_Add(PROFILER_Slot_t Slot, uint32_t Since)
+{
+    const uint32_t Cycles = PROFILER_Stamp() - Since;
+    unsigned int   Bucket = 0;
+
+    if (Slot >= PROFILER_SLOTS)
+        return;
+
+    ProfilerSlot_t *pSlot = &Slots[Slot];
+
+    for (uint32_t Bound = PROFILER_FIRST_BOUND; Cycles >= Bound && Bucket < PROFILER_BUCKETS - 1; Bound <<= 1)
+        Bucket++;
+
+    if (pSlot->Buckets[Bucket] != 0xFFFF)
+        pSlot->Buckets[Bucket]++;
+
+    pSlot->AvgCycles  = pSlot->Calls ? pSlot->AvgCycles - pSlot->AvgCycles / 8 + Cycles / 8 : Cycles;
+    pSlot->LastCycles = Cycles;
+    if (pSlot->MaxCycles < Cycles)
+        pSlot->MaxCycles = Cycles;
+    pSlot->Calls++;
+}
+
+void PROFILER_Clear(void)
+{
+    memset(Slots, 0, sizeof(Slots));
+}
+
+const ProfilerSlot_t *PROFILER_Get(void)
+{
+    return Slots;
+}
+
+const char *PROFILER_GetName(uint8_t Slot)
+{
+    return (Slot < PROFILER_SLOTS) ? Names[Slot] : "";
+}
+
+void PROFILER_SetOverlay(bool bOn)
+{
+    Overlay       = bOn;
+    gUpdateStatus = true;
+}
+
+bool PROFILER_GetOverlay(void)
+{
+    return Overlay;
+}
+
+// "MAIN 3.1/5.2ms", the running average and the worst of the screen with
+// the highest average, dark on light over the left of the status line
+void PROFILER_DrawOverlay(void)
+{
+    const ProfilerSlot_t *pSlowest = NULL;
+    uint8_t               Slowest  = 0;
+    char                  String[20];
+    char                 *p        = String;
+
+    if (!Overlay)
+        return;
+
+    for (uint8_t i = PROFILER_SCREEN; i < PROFILER_SLOTS; i++) {
+        if (Slots[i].Calls && (!pSlowest || Slots[i].AvgCycles > pSlowest->AvgCycles)) {
+            pSlowest = &Slots[i];
+            Slowest  = i;
+        }
+    }
+
+    if (!pSlowest)
+        return;
+
+    for (const char *pName = Names[Slowest]; *pName; )
+        *p++ = *pName++;
+    *p++ = ' ';
+    p = FORMAT_Fixed(p, pSlowest->AvgCycles / CYCLES_PER_100US, 1, 1, ' ');
+    *p++ = '/';
+    p = FORMAT_Fixed(p, pSlowest->MaxCycles / CYCLES_PER_100US, 1, 1, ' ');
+    strcpy(p, "ms");
+
+    memset(gStatusLine, 0, UI_GetTextWidth(&gTextFont3x5, String, 4) + 1);
+    UI_DrawText(&gStatusLine, 1, &gTextFont3x5, String, 0, 1, 4, UI_TEXT_INVERSE);
+}
+
+void PROFILER_TimeSlice500ms(void)
+{
+    // the averages move on every frame, the status line only when asked
+    if (Overlay)
+        gUpdateStatus = true;
+}
@@ -0,0 +1,70 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+#ifndef UI_PROFILER_H
+#define UI_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "driver/systick.h"
+#include "ui/ui.h"
+
+// Histogram of the cycles taken per call. Bucket 0 counts calls under
+// PROFILER_FIRST_BOUND cycles, each next one calls under twice the bound
+// of the one before, and the last one all the rest.
+#define PROFILER_BUCKETS     12
+#define PROFILER_FIRST_BOUND 1024u
+
+typedef enum
+{
+    PROFILER_STATUS = 0,    // UI_DisplayStatus, the status line blit included
+    PROFILER_BLIT_FULL,     // ST7565_BlitFullScreen
+    PROFILER_BLIT_LINE,     // ST7565_BlitLine
+    PROFILER_BLIT_STATUS,   // ST7565_BlitStatusLine
+    PROFILER_SCREEN,        // GUI_DisplayScreen, one slot per GUI_DisplayType_t
+    PROFILER_SLOTS = PROFILER_SCREEN + DISPLAY_N_ELEM
+} PROFILER_Slot_t;
+
+typedef struct
+{
+    uint32_t Calls;
+    uint32_t LastCycles;
+    uint32_t AvgCycles;     // running average, about the last 8 calls
+    uint32_t MaxCycles;
+    uint16_t Buckets[PROFILER_BUCKETS];  // stop at 0xFFFF
+} ProfilerSlot_t;
+
+// UI frame time profiler. The drawing and blit entry points take a stamp
+// on entry and add the cycles since to their slot on the way out, calls
+// nested in them count in their own slots as well. The slowest screen is
+// shown at the left of the status line while the overlay is on.
+
+static inline uint32_t PROFILER_Stamp(void)
+{
+    return SYSTICK_GetCycles();
+}
+
+void PROFILER_Add(PROFILER_Slot_t Slot, uint32_t Since);
+void PROFILER_Clear(void);
+
+const ProfilerSlot_t *PROFILER_Get(void);
+const char           *PROFILER_GetName(uint8_t Slot);
+
+void PROFILER_SetOverlay(bool bOn);
+bool PROFILER_GetOverlay(void);
+void PROFILER_DrawOverlay(void);
+void PROFILER_TimeSlice500ms(void);
+
+#endif
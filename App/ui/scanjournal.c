@@ -0,0 +1,116 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/scanjournal.h"
+#include "dcs.h"
+#include "driver/st7565.h"
+#include "helper/format.h"
+#include "misc.h"
+#include "ui/helper.h"
+#include "ui/scanjournal.h"
+
+#define ROWS (FRAME_LINES - 2)
+
+static void FormatKey(char *pString, uint32_t Key)
+{
+    if (SCAN_JOURNAL_IS_CHANNEL(Key))
+        FORMAT_Channel(pString, Key + 1, 3);
+    else
+        FORMAT_Fixed(pString, Key / 10, 4, 3, ' ');
+}
+
+static void FormatCode(char *pString, const ScanJournalEntry_t *pEntry)
+{
+    switch (pEntry->CodeType) {
+        case CODE_TYPE_CONTINUOUS_TONE:
+            pString[0] = 'C';
+            pString[1] = 'T';
+            FORMAT_Fixed(pString + 2, CTCSS_Options[pEntry->Code], 1, 0, ' ');
+            break;
+        case CODE_TYPE_DIGITAL:
+            pString[0] = 'D';
+            strcpy(FORMAT_Octal(pString + 1, DCS_Options[pEntry->Code], 3), "N");
+            break;
+        case CODE_TYPE_REVERSE_DIGITAL:
+            pString[0] = 'D';
+            strcpy(FORMAT_Octal(pString + 1, DCS_Options[pEntry->Code], 3), "I");
+            break;
+        default:
+            strcpy(pString, "NO TONE");
+            break;
+    }
+}
+
+void UI_DisplayScanJournal(void)
+{
+    char               String[22];
+    char               Name[10];
+    char               Time[8];
+    char               Code[8];
+    ScanJournalEntry_t Entry;
+
+    UI_DisplayClear();
+
+    const uint16_t Count = SCANJOURNAL_GetCount();
+
+    strcpy(String, "JOURNAL ");
+    FORMAT_Unsigned(String + 8, Count, 0, ' ');
+    UI_PrintStringSmallBold(String, 0, 127, 0);
+
+    if (Count == 0) {
+        UI_PrintStringSmallNormal("NO SIGNALS YET", 0, 127, 3);
+        ST7565_BlitFullScreen();
+        return;
+    }
+
+    if (gScanJournalCursor >= Count)
+        gScanJournalCursor = Count - 1;
+
+    // keep the cursor in the window
+    const uint16_t First = (gScanJournalCursor < ROWS) ? 0 : gScanJournalCursor - ROWS + 1;
+
+    for (uint8_t Row = 0; Row < ROWS && First + Row < Count; Row++) {
+        const uint16_t Index  = First + Row;
+        const char     Marker = (Index == gScanJournalCursor) ? '>' : ' ';
+
+        if (!SCANJOURNAL_Get(Index, &Entry)) {
+            String[0] = Marker;
+            strcpy(String + 1, "--");
+        } else {
+            FormatKey(Name, Entry.Key);
+            FORMAT_Duration(Time, Entry.Duration);
+            String[0] = Marker;
+            char *p = FORMAT_String(String + 1, Name, 8);
+            p = FORMAT_Signed(p, Entry.PeakRssi - 160, 4, ' ');
+            *p++ = ' ';
+            strcpy(p, Time);
+        }
+        UI_PrintStringSmallNormal(String, 0, 0, 1 + Row);
+    }
+
+    // details of the selected one
+    if (SCANJOURNAL_Get(gScanJournalCursor, &Entry)) {
+        FormatCode(Code, &Entry);
+        FORMAT_Duration(Time, SCANJOURNAL_GetClock() - Entry.Time);
+        char *p = FORMAT_String(String, Code, 8);
+        *p++ = ' ';
+        strcpy(FORMAT_String(p, Time, 0), " ago");
+        UI_PrintStringSmallNormal(String, 0, 0, FRAME_LINES - 1);
+    }
+
+    ST7565_BlitFullScreen();
+}
@@ -16,6 +16,9 @@
 
 #include <stdbool.h>
 #include <string.h>
+#ifdef ENABLE_FAST_CAPTURE
+    #include "app/capture.h"
+#endif
 #include "app/scanner.h"
 #include "dcs.h"
 #include "driver/st7565.h"
@@ -42,6 +45,14 @@ void UI_DisplayScanner(void)
 
     UI_PrintString(pPrintStr, 2, 0, 1, 8);
 
+#ifdef ENABLE_FAST_CAPTURE
+    if (!gScanSingleFrequency && gScanCssState != SCAN_CSS_STATE_OFF && gScanCssState != SCAN_CSS_STATE_FAILED) {
+        const CaptureResult_t *pLock = CAPTURE_GetLast();
+        snprintf(String, sizeof(String), "LOCK %u%% %lu.%lus", pLock->Confidence, pLock->LockMs / 1000, pLock->LockMs / 100 % 10);
+        UI_PrintStringSmallNormal(String, 2, 0, 0);
+    }
+#endif
+
     if (gScanCssState < SCAN_CSS_STATE_FOUND || !gScanUseCssResult) {
         pPrintStr = "CTC:******";
     } else if (gScanCssResultType == CODE_TYPE_CONTINUOUS_TONE) {
@@ -0,0 +1,84 @@
+/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "app/scanstats.h"
+#include "driver/st7565.h"
+#include "helper/format.h"
+#include "misc.h"
+#include "ui/helper.h"
+#include "ui/scanstats.h"
+
+#define ROWS (FRAME_LINES - 2)
+
+void UI_DisplayScanStats(void)
+{
+    char    String[22];
+    char    Name[10];
+    char    Time[8];
+    uint8_t Order[SCAN_STATS_ENTRIES];
+
+    UI_DisplayClear();
+
+    const uint8_t     Count    = SCANSTATS_Rank(Order);
+    const ScanStat_t *pEntries = SCANSTATS_Get();
+
+    strcpy(String, "ACTIVITY ");
+    char *p = FORMAT_Unsigned(String + 9, Count, 0, ' ');
+    *p++ = '/';
+    FORMAT_Unsigned(p, SCAN_STATS_ENTRIES, 0, ' ');
+    UI_PrintStringSmallBold(String, 0, 127, 0);
+
+    if (Count == 0) {
+        UI_PrintStringSmallNormal("NO SIGNALS YET", 0, 127, 3);
+        ST7565_BlitFullScreen();
+        return;
+    }
+
+    if (gScanStatsCursor >= Count)
+        gScanStatsCursor = Count - 1;
+
+    // keep the cursor in the window
+    const uint8_t First = (gScanStatsCursor < ROWS) ? 0 : gScanStatsCursor - ROWS + 1;
+
+    for (uint8_t Row = 0; Row < ROWS && First + Row < Count; Row++) {
+        const uint8_t     Rank   = First + Row;
+        const ScanStat_t *pEntry = &pEntries[Order[Rank]];
+
+        if (SCAN_STATS_IS_CHANNEL(pEntry->Key))
+            FORMAT_Channel(Name, pEntry->Key + 1, 3);
+        else
+            FORMAT_Fixed(Name, pEntry->Key / 10, 4, 3, ' ');
+
+        FORMAT_Duration(Time, pEntry->OpenTime / 2);
+        String[0] = (Rank == gScanStatsCursor) ? '>' : ' ';
+        p = FORMAT_String(String + 1, Name, 8);
+        p = FORMAT_Unsigned(p, (pEntry->Hits > 9999) ? 9999 : pEntry->Hits, 4, ' ');
+        *p++ = ' ';
+        strcpy(p, Time);
+        UI_PrintStringSmallNormal(String, 0, 0, 1 + Row);
+    }
+
+    // details of the selected one
+    const ScanStat_t *pEntry = &pEntries[Order[gScanStatsCursor]];
+
+    FORMAT_Duration(Time, SCANSTATS_GetClock() - pEntry->LastHeard);
+    p = strcpy(FORMAT_Signed(String, pEntry->PeakRssi - 160, 4, ' '), "dBm ");
+    strcpy(FORMAT_String(p + 4, Time, 0), " ago");
+    UI_PrintStringSmallNormal(String, 0, 0, FRAME_LINES - 1);
+
+    ST7565_BlitFullScreen();
+}
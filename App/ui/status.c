@@ -28,12 +28,16 @@
 #include "external/printf/printf.h"
 #include "functions.h"
 #include "helper/battery.h"
+#include "helper/format.h"
 #include "misc.h"
 #include "settings.h"
 #include "ui/battery.h"
 #include "ui/helper.h"
 #include "ui/ui.h"
 #include "ui/status.h"
+#ifdef ENABLE_UI_PROFILER
+    #include "ui/profiler.h"
+#endif
 
 extern bool gBackLight;
 
@@ -43,26 +47,51 @@ static void convertTime(uint8_t *line, uint8_t type)
 {
     uint16_t t = (type == 0) ? (gTxTimerCountdown_500ms / 2) : (3600 - gRxTimerCountdown_500ms / 2);
 
-    uint8_t m = t / 60;
-    uint8_t s = t - (m * 60); // Replace modulo with subtraction for efficiency
-
     gStatusLine[0] = gStatusLine[7] = gStatusLine[14] = 0x00; // Quick fix on display (on scanning I, II, etc.)
 
     char str[6];
-    sprintf(str, "%02u:%02u", m, s);
+    FORMAT_Time(str, t);
     UI_PrintStringSmallBufferNormal(str, line);
 
+#ifndef ENABLE_UI_WIDGETS
     gUpdateStatus = true;
+#endif
 }
 #endif
 #endif
 
+#ifdef ENABLE_UI_WIDGETS
+void UI_STATUS_TimeSlice500ms(void)
+{
+#if defined(ENABLE_FEAT_N7SIX_RX_TX_TIMER) && !defined(ENABLE_FEAT_N7SIX_DEBUG)
+    // the RX/TX timer moves in 500 ms steps, the status line is rebuilt
+    // for it here instead of on every pass of the main loop
+    if (!SCANNER_IsScanning() && gSetting_set_tmr &&
+        (gCurrentFunction == FUNCTION_TRANSMIT || FUNCTION_IsRx()))
+        gUpdateStatus = true;
+#endif
+}
+#endif
+
 void UI_DisplayStatus()
 {
+#ifdef ENABLE_UI_PROFILER
+    const uint32_t Start = PROFILER_Stamp();
+#endif
     char str[8] = "";
 
     gUpdateStatus = false;
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    // the line is built again whole, only the icons that changed are sent
+    uint8_t Shown[LCD_WIDTH];
+
+    memcpy(Shown, gStatusLine, sizeof(Shown));
     memset(gStatusLine, 0, sizeof(gStatusLine));
+    ST7565_HoldDirty(true);
+#else
+    memset(gStatusLine, 0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
+#endif
 
     uint8_t     *line = gStatusLine;
     unsigned int x    = 0;
@@ -296,5 +325,18 @@ void UI_DisplayStatus()
 
     // **************
 
+#ifdef ENABLE_UI_PROFILER
+    PROFILER_DrawOverlay();
+#endif
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    ST7565_HoldDirty(false);
+    ST7565_MarkChanged(gStatusLine, Shown, sizeof(Shown));
+#endif
+
     ST7565_BlitStatusLine();
+
+#ifdef ENABLE_UI_PROFILER
+    PROFILER_Add(PROFILER_STATUS, Start);
+#endif
 }
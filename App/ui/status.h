@@ -19,5 +19,9 @@
 
 void UI_DisplayStatus();
 
+#ifdef ENABLE_UI_WIDGETS
+    void UI_STATUS_TimeSlice500ms(void);
+#endif
+
 #endif
 
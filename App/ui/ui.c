@@ -37,8 +37,20 @@
 #include "ui/main.h"
 #include "ui/menu.h"
 #include "ui/scanner.h"
+#ifdef ENABLE_SCAN_STATS
+    #include "ui/scanstats.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "ui/scanjournal.h"
+#endif
 #include "ui/ui.h"
 #include "../misc.h"
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    #include "scheduler.h"
+#endif
+#ifdef ENABLE_UI_PROFILER
+    #include "ui/profiler.h"
+#endif
 
 GUI_DisplayType_t gScreenToDisplay;
 GUI_DisplayType_t gRequestDisplayScreen = DISPLAY_INVALID;
@@ -47,6 +59,11 @@ uint8_t           gAskForConfirmation;
 bool              gAskToSave;
 bool              gAskToDelete;
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+static uint32_t   LoadUs;
+static uint32_t   LoadStart;       // 10 ms ticks
+static uint32_t   LoadPerSecond;
+#endif
 
 void (*UI_DisplayFunctions[])(void) = {
     [DISPLAY_MAIN] = &UI_DisplayMain,
@@ -61,6 +78,13 @@ void (*UI_DisplayFunctions[])(void) = {
     [DISPLAY_AIRCOPY] = &UI_DisplayAircopy,
 #endif
 
+#ifdef ENABLE_SCAN_STATS
+    [DISPLAY_SCAN_STATS] = &UI_DisplayScanStats,
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    [DISPLAY_SCAN_JOURNAL] = &UI_DisplayScanJournal,
+#endif
+
 #ifdef ENABLE_REGA
     [DISPLAY_REGA] = &UI_DisplayREGA,
 #endif
@@ -71,7 +95,17 @@ static_assert(ARRAY_SIZE(UI_DisplayFunctions) == DISPLAY_N_ELEM);
 void GUI_DisplayScreen(void)
 {
     if (gScreenToDisplay != DISPLAY_INVALID) {
+#ifdef ENABLE_UI_PROFILER
+        // the screen may hand over to another one, charge the one drawn
+        const GUI_DisplayType_t Screen = gScreenToDisplay;
+        const uint32_t          Start  = PROFILER_Stamp();
+#endif
+
         UI_DisplayFunctions[gScreenToDisplay]();
+
+#ifdef ENABLE_UI_PROFILER
+        PROFILER_Add(PROFILER_SCREEN + Screen, Start);
+#endif
     }
 }
 
@@ -102,3 +136,24 @@ void GUI_SelectNextDisplay(GUI_DisplayType_t Display)
     gScreenToDisplay = Display;
     gUpdateDisplay   = true;
 }
+
+#ifdef ENABLE_LCD_DIRTY_SPANS
+void UI_AddLoad(uint32_t Us)
+{
+    LoadUs += Us;
+}
+
+uint32_t UI_GetLoad(void)
+{
+    const uint32_t Elapsed = gGlobalSysTickCounter - LoadStart;
+
+    if (Elapsed >= 100) {
+        // split so that long gaps between reads can not overflow
+        LoadPerSecond = LoadUs / Elapsed * 100 + LoadUs % Elapsed * 100 / Elapsed;
+        LoadStart     = gGlobalSysTickCounter;
+        LoadUs        = 0;
+    }
+
+    return LoadPerSecond;
+}
+#endif
@@ -34,6 +34,14 @@ enum GUI_DisplayType_t
     DISPLAY_AIRCOPY,
 #endif
 
+#ifdef ENABLE_SCAN_STATS
+    DISPLAY_SCAN_STATS,
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+    DISPLAY_SCAN_JOURNAL,
+#endif
+
 #ifdef ENABLE_REGA
     DISPLAY_REGA,
 #endif
@@ -54,4 +62,12 @@ extern bool              gAskToDelete;
 void GUI_DisplayScreen(void);
 void GUI_SelectNextDisplay(GUI_DisplayType_t Display);
 
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    // Time the main loop spends drawing. UI_GetLoad returns us per second,
+    // averaged over the time since the previous read once that is a second
+    // or more.
+    void     UI_AddLoad(uint32_t Us);
+    uint32_t UI_GetLoad(void);
+#endif
+
 #endif
@@ -35,6 +35,7 @@
 void UI_DisplayReleaseKeys(void)
 {
     memset(gStatusLine,  0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
 #if defined(ENABLE_FEAT_N7SIX_CTR) || defined(ENABLE_FEAT_N7SIX_INV)
         ST7565_ContrastAndInv();
 #endif
@@ -55,6 +56,7 @@ void UI_DisplayWelcome(void)
     char WelcomeString3[20];
 
     memset(gStatusLine,  0, sizeof(gStatusLine));
+    ST7565_MarkDirty(gStatusLine, sizeof(gStatusLine));
 
 #if defined(ENABLE_FEAT_N7SIX_CTR) || defined(ENABLE_FEAT_N7SIX_INV)
         ST7565_ContrastAndInv();
@@ -216,6 +218,8 @@ for (uint8_t i = startX; i < endX; i++)
 #endif
 
         //ST7565_BlitStatusLine();  // blank status line : I think it's useless
+        // the bitmaps and the inverted box above are drawn straight into the buffer
+        ST7565_MarkDirty(gFrameBuffer, sizeof(gFrameBuffer));
         ST7565_BlitFullScreen();
 
         #ifdef ENABLE_FEAT_N7SIX_SCREENSHOT
@@ -93,6 +93,14 @@ static cdc_acm_rx_buf_t client_rx_buf = {0};
 
 volatile bool ep_tx_busy_flag = false;
 
+// The IN endpoint has one owner at a time: ep_tx_busy_flag is set before
+// every write and cleared by the IN complete callback only. A reply sent
+// while it is busy is queued and started from the callback, ahead of any
+// stream frame waiting for cdc_acm_tx_ready().
+static const uint8_t *volatile tx_buf;
+static const uint8_t *volatile tx_queued_buf;
+static volatile uint32_t tx_queued_size;
+
 #ifdef CONFIG_USB_HS
 #define CDC_MAX_MPS 512
 #else
@@ -140,7 +148,14 @@ void usbd_cdc_acm_bulk_in(uint8_t ep, uint32_t nbytes)
     if ((nbytes % CDC_MAX_MPS) == 0 && nbytes) {
         /* send zlp */
         usbd_ep_start_write(CDC_IN_EP, NULL, 0);
+    } else if (tx_queued_size) {
+        /* the endpoint stays busy and goes straight to the queued reply */
+        tx_buf = tx_queued_buf;
+        tx_queued_buf = NULL;
+        usbd_ep_start_write(CDC_IN_EP, tx_buf, tx_queued_size);
+        tx_queued_size = 0;
     } else {
+        tx_buf = NULL;
         ep_tx_busy_flag = false;
     }
 }
@@ -188,17 +203,78 @@ void cdc_acm_data_send_with_dtr(const uint8_t *buf, uint32_t size)
 {
     if (dtr_enable && 0 != size)
     {
+        while (ep_tx_busy_flag)
+            ;
         ep_tx_busy_flag = true;
+        tx_buf = buf;
         usbd_ep_start_write(CDC_IN_EP, buf, size);
         while (ep_tx_busy_flag)
             ;
     }
 }
 
+// Starts the write, or queues it behind the one in flight. There is one
+// queue slot, the caller waits on cdc_acm_tx_holds() before reusing it.
 void cdc_acm_data_send_with_dtr_async(const uint8_t *buf, uint32_t size)
 {
+    if (0 == size)
+    {
+        return;
+    }
+
+    const uint32_t mask = __get_PRIMASK();
+    __disable_irq();
+    const bool busy = ep_tx_busy_flag;
+    if (busy)
+    {
+        tx_queued_buf = buf;
+        tx_queued_size = size;
+    }
+    else
+    {
+        ep_tx_busy_flag = true;
+        tx_buf = buf;
+    }
+    __set_PRIMASK(mask);
+
+    if (!busy)
+    {
+        usbd_ep_start_write(CDC_IN_EP, buf, size);
+    }
+}
+
+bool cdc_acm_dtr_asserted(void)
+{
+    return dtr_enable;
+}
+
+bool cdc_acm_tx_ready(void)
+{
+    return dtr_enable && !ep_tx_busy_flag;
+}
+
+// Non-blocking: returns false (and sends nothing) if the host has not
+// asserted DTR or the previous IN transfer is still in flight.
+// `buf` must stay valid until ep_tx_busy_flag is cleared.
+bool cdc_acm_data_send_with_dtr_try(const uint8_t *buf, uint32_t size)
+{
+    if (!dtr_enable || ep_tx_busy_flag)
+    {
+        return false;
+    }
+
     if (0 != size)
     {
+        ep_tx_busy_flag = true;
+        tx_buf = buf;
         usbd_ep_start_write(CDC_IN_EP, buf, size);
     }
+
+    return true;
+}
+
+// True while buf is queued or being sent.
+bool cdc_acm_tx_holds(const uint8_t *buf)
+{
+    return tx_buf == buf || tx_queued_buf == buf;
 }
@@ -1,15 +0,0 @@
-set(CMAKE_HOST_SYSTEM "Linux-6.8.0-1030-azure")
-set(CMAKE_HOST_SYSTEM_NAME "Linux")
-set(CMAKE_HOST_SYSTEM_VERSION "6.8.0-1030-azure")
-set(CMAKE_HOST_SYSTEM_PROCESSOR "x86_64")
-
-include("/src/cmake/gcc-arm-none-eabi.cmake")
-
-set(CMAKE_SYSTEM "Generic")
-set(CMAKE_SYSTEM_NAME "Generic")
-set(CMAKE_SYSTEM_VERSION "")
-set(CMAKE_SYSTEM_PROCESSOR "arm")
-
-set(CMAKE_CROSSCOMPILING "TRUE")
-
-set(CMAKE_SYSTEM_LOADED 1)
@@ -1,8 +0,0 @@
-# Additional clean files
-cmake_minimum_required(VERSION 3.16)
-
-if("${CONFIG}" STREQUAL "" OR "${CONFIG}" STREQUAL "Release")
-  file(REMOVE_RECURSE
-  "n7six.dx1arm-k1.v7.6.2br4.map"
-  )
-endif()
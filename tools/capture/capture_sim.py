@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# app/scanner.c built for the host twice, once with the legacy frequency
+# capture and once with ENABLE_FAST_CAPTURE and app/capture.c, both run from
+# SCANNER_Start against a model of the BK4819 frequency counter and RSSI on
+# a virtual microsecond clock. The scanner code alone decides when the
+# frequency is locked and what it locks on.
+SOURCES = ['app/scanner.c', 'frequencies.c', 'misc.c']
+
+GATE_MS = 200           # REG_32 <15:14> = 0
+POLL_US = 1000          # main loop period, SCANNER_Poll
+ACCESS_US = 70          # one register access over the bit banged SPI
+
+# Reading model: FM modulation pulls the count around the carrier, now and
+# then a reading is far off, and without a carrier the count is noise
+CARRIER = 43512500      # 10 Hz
+MOD_SIGMA = 30          # 10 Hz
+OUTLIER = 0.1
+NOISE_SPAN = 100000     # 10 Hz, either side
+
+HARNESS = r'''
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "app/scanner.h"
+#ifdef ENABLE_FAST_CAPTURE
+    #include "app/capture.h"
+#endif
+#include "driver/bk4819.h"
+#include "misc.h"
+#include "radio.h"
+#include "ui/ui.h"
+
+static FREQ_Config_t Freq;
+static VFO_Info_t    Vfo = {.pRX = &Freq, .pTX = &Freq};
+VFO_Info_t          *gRxVfo = &Vfo;
+VFO_Info_t          *gTxVfo = &Vfo;
+
+static uint64_t Now;                // virtual microseconds
+static uint32_t GateUs, AccessUs, Carrier, ModSigma, NoiseSpan;
+static double   Outlier;
+static uint64_t KeyUp, KeyDown;     // the burst
+static uint64_t GateStart;
+static bool     Counting;
+static uint32_t Tuned;
+static uint16_t Registers[128];
+static uint64_t Seed = 1;
+
+static double Uniform(void)
+{
+    Seed = Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return ((Seed >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double Gauss(double Sigma)
+{
+    return Sigma * sqrt(-2 * log(Uniform())) * cos(2 * M_PI * Uniform());
+}
+
+static bool Present(void)
+{
+    return Now >= KeyUp && Now < KeyDown;
+}
+
+uint32_t SYSTICK_GetUs(void)           { return (uint32_t)Now; }
+void     SYSTICK_DelayUs(uint32_t Us)  { Now += Us; }
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    Now += AccessUs;
+    return Registers[Register & 0x7F];
+}
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    Now += AccessUs;
+    Registers[Register & 0x7F] = Data;
+}
+
+void BK4819_EnableFrequencyScan(void)
+{
+    Now += AccessUs;
+    GateStart = Now;
+    Counting  = true;
+}
+
+void BK4819_DisableFrequencyScan(void)
+{
+    Now += AccessUs;
+    Counting = false;
+}
+
+void BK4819_StopScan(void)
+{
+    BK4819_DisableFrequencyScan();
+}
+
+// the count of a gate with the carrier there for a share of it
+bool BK4819_GetFrequencyScanResult(uint32_t *pFrequency)
+{
+    Now += AccessUs;
+    if (!Counting || Now < GateStart + GateUs)
+        return false;
+
+    const uint64_t End  = GateStart + GateUs;
+    const uint64_t From = GateStart > KeyUp ? GateStart : KeyUp;
+    const uint64_t To   = End < KeyDown ? End : KeyDown;
+    const double   Covered = To > From ? (double)(To - From) / GateUs : 0;
+
+    int32_t Offset;
+    if (Covered < 0.8 || Uniform() < Outlier)
+        Offset = (int32_t)(Uniform() * 2 * NoiseSpan) - (int32_t)NoiseSpan;
+    else
+        Offset = (int32_t)lround(Gauss(ModSigma / Covered));
+
+    *pFrequency = Carrier + Offset;
+    return true;
+}
+
+void BK4819_SetFrequency(uint32_t Frequency)
+{
+    Now += 2 * AccessUs;
+    Tuned = Frequency;
+}
+
+// narrowest filter, 6dB down 3 kHz off the carrier, 0.5dB steps
+uint16_t BK4819_GetRSSI(void)
+{
+    Now += AccessUs;
+    const double Offset = ((double)Tuned - Carrier) / 300;
+    const double Level  = Present() ? 160 - 12 * Offset * Offset : 80;
+    const long   Rssi   = lround(Level + Gauss(1));
+    return Rssi < 60 ? 60 : Rssi;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 11)
+        return 2;
+
+    const unsigned Bursts = strtoul(argv[1], NULL, 0);
+    const uint64_t Length = strtoull(argv[2], NULL, 0);
+    Seed      = strtoull(argv[3], NULL, 0);
+    GateUs    = strtoul(argv[4], NULL, 0);
+    AccessUs  = strtoul(argv[5], NULL, 0);
+    const uint32_t PollUs = strtoul(argv[6], NULL, 0);
+    Carrier   = strtoul(argv[7], NULL, 0);
+    ModSigma  = strtoul(argv[8], NULL, 0);
+    Outlier   = atof(argv[9]);
+    NoiseSpan = strtoul(argv[10], NULL, 0);
+
+    Freq.Frequency   = Carrier - 50000;
+    gScreenToDisplay = DISPLAY_SCANNER;
+
+    unsigned Locked = 0;
+    int64_t  *Lock  = calloc(Bursts, sizeof(*Lock));   // before key up on noise
+    double   Error  = 0, Confidence = 0;
+
+    for (unsigned Burst = 0; Burst < Bursts; Burst++)
+    {
+        Now     = 0;
+        KeyUp   = (uint64_t)(Uniform() * 2 * GateUs);
+        KeyDown = KeyUp + Length;
+
+        SCANNER_Start(false);
+
+        // the main loop, the 10 ms slice when due
+        uint64_t Tick = 10000;
+        while (gScanCssState == SCAN_CSS_STATE_OFF && Now < KeyDown + 2 * GateUs)
+        {
+            Now += PollUs;
+#ifdef ENABLE_FAST_CAPTURE
+            SCANNER_Poll();
+#endif
+            if (Now >= Tick) {
+                Tick += 10000;
+                SCANNER_TimeSlice10ms();
+            }
+        }
+
+        if (gScanCssState != SCAN_CSS_STATE_SCANNING)
+            continue;
+
+        Lock[Locked++] = (int64_t)(Now - KeyUp);
+        Error += labs((long)gScanFrequency - (long)Carrier) * 10.0;
+#ifdef ENABLE_FAST_CAPTURE
+        Confidence += CAPTURE_GetLast()->Confidence;
+#endif
+    }
+
+#ifndef ENABLE_FAST_CAPTURE
+    Confidence = -1;        // the legacy lock has none
+#endif
+
+    for (unsigned i = 1; i < Locked; i++)
+        for (unsigned j = i; j > 0 && Lock[j - 1] > Lock[j]; j--) {
+            const int64_t t = Lock[j]; Lock[j] = Lock[j - 1]; Lock[j - 1] = t;
+        }
+
+    printf("{\"locked\":%.6f,\"median\":%.1f,\"p90\":%.1f,\"error\":%.1f,\"confidence\":%.1f}\n",
+           (double)Locked / Bursts,
+           Locked ? Lock[Locked / 2] / 1000.0 : 0.0,
+           Locked ? Lock[(unsigned)(0.9 * (Locked - 1))] / 1000.0 : 0.0,
+           Locked ? Error / Locked : 0.0,
+           Confidence < 0 ? -1.0 : Confidence / (Locked ? Locked : 1));
+    return 0;
+}
+'''
+
+
+def build(cc, tmp, fast):
+    variables = hostbuild.preset_flags('Custom')
+    variables['ENABLE_FAST_CAPTURE'] = fast
+    sources = SOURCES + (['app/capture.c'] if fast else [])
+    name = 'capture_sim' if fast else 'legacy_sim'
+    return hostbuild.build(cc, tmp, HARNESS, sources, variables, name=name)[0]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Simulate scanner frequency capture, legacy against ENABLE_FAST_CAPTURE.')
+    parser.add_argument('-bursts', type=int, default=5000, help='transmissions per burst length (default: %(default)s)')
+    parser.add_argument('-lengths', type=float, nargs='+', default=[0.5, 0.8, 1.0, 1.5, 2.0, 5.0],
+                        help='burst lengths in seconds (default: %(default)s)')
+    parser.add_argument('-access-us', type=int, default=ACCESS_US, help='cost of a register access (default: %(default)s)')
+    parser.add_argument('-poll-us', type=int, default=POLL_US, help='main loop period (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.bursts <= 0 or args.poll_us <= 0:
+        print("[!] bursts and poll-us must be positive")
+        sys.exit(1)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binaries = [build(args.cc, tmp, fast) for fast in (False, True)]
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+
+        print(f"[*] {args.bursts} bursts per length, {OUTLIER:.0%} outliers, modulation spread {MOD_SIGMA * 10} Hz")
+        print("    burst    legacy: locked median   p90  error     capture: locked median   p90  error  confidence")
+
+        for length in args.lengths:
+            line = f"    {length:4.1f} s "
+            for binary in binaries:
+                model = [args.bursts, int(length * 1e6), args.seed, GATE_MS * 1000, args.access_us, args.poll_us,
+                         CARRIER, MOD_SIGMA, OUTLIER, NOISE_SPAN]
+                run = subprocess.run([binary, *map(str, model)], capture_output=True, text=True)
+                if run.returncode:
+                    print(f"\n[!] Simulation failed ({run.returncode}): {run.stderr.strip()}")
+                    sys.exit(1)
+                r = json.loads(run.stdout)
+                line += f"         {r['locked']:7.1%} {r['median']:6.0f} {r['p90']:5.0f} {r['error']:4.0f}Hz"
+                if r['confidence'] >= 0:
+                    line += f"  {r['confidence']:5.0f}%"
+            print(line)
+
+
+if __name__ == '__main__':
+    main()
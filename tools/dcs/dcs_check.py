@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# The current dcs.c against the one of the baseline commit, both built with
+# the host compiler into one program. Every 24 bit CDCSS reading and every
+# CTCSS frequency reading from -7000.0 to 7000.0 Hz has to decode the same,
+# and the code words of every option have to match.
+BASELINE = 'f436e67'
+SOURCES = ['dcs.c']
+
+# the baseline file, its symbols renamed so both versions link together
+OLD_NAMES = ['DCS_GetGolayCodeWord', 'DCS_GetCdcssCode', 'DCS_GetCtcssCode', 'CTCSS_Options', 'DCS_Options']
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dcs.h"
+
+uint32_t Old_DCS_GetGolayCodeWord(DCS_CodeType_t CodeType, uint8_t Option);
+uint8_t  Old_DCS_GetCdcssCode(uint32_t Code);
+uint8_t  Old_DCS_GetCtcssCode(int Code);
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    const int CtcssLimit = argc > 1 ? atoi(argv[1]) : 70000;
+
+    for (int Type = CODE_TYPE_DIGITAL; Type <= CODE_TYPE_REVERSE_DIGITAL; Type++)
+        for (unsigned Option = 0; Option < 104; Option++)
+            if (DCS_GetGolayCodeWord(Type, Option) != Old_DCS_GetGolayCodeWord(Type, Option))
+            {
+                fprintf(stderr, "code word type %d option %u differs\n", Type, Option);
+                return 1;
+            }
+
+    unsigned long Found = 0;
+    for (uint32_t Code = 0; Code < (1u << 24); Code++)
+    {
+        const uint8_t Got = DCS_GetCdcssCode(Code), Want = Old_DCS_GetCdcssCode(Code);
+        if (Got != Want)
+        {
+            fprintf(stderr, "CDCSS 0x%06X: %u, was %u\n", Code, Got, Want);
+            return 1;
+        }
+        Found += Got != 0xFF;
+    }
+
+    for (int Code = -CtcssLimit; Code <= CtcssLimit; Code++)
+    {
+        const uint8_t Got = DCS_GetCtcssCode(Code), Want = Old_DCS_GetCtcssCode(Code);
+        if (Got != Want)
+        {
+            fprintf(stderr, "CTCSS %d: %u, was %u\n", Code, Got, Want);
+            return 1;
+        }
+    }
+
+    // timings over the whole input ranges, the sums keep the calls alive
+    volatile unsigned Sink = 0;
+    double t = Now();
+    for (uint32_t Code = 0; Code < (1u << 24); Code++)
+        Sink += Old_DCS_GetCdcssCode(Code);
+    const double OldCdcss = Now() - t;
+
+    t = Now();
+    for (uint32_t Code = 0; Code < (1u << 24); Code++)
+        Sink += DCS_GetCdcssCode(Code);
+    const double NewCdcss = Now() - t;
+
+    t = Now();
+    for (int Code = -CtcssLimit; Code <= CtcssLimit; Code++)
+        Sink += Old_DCS_GetCtcssCode(Code);
+    const double OldCtcss = Now() - t;
+
+    t = Now();
+    for (int Code = -CtcssLimit; Code <= CtcssLimit; Code++)
+        Sink += DCS_GetCtcssCode(Code);
+    const double NewCtcss = Now() - t;
+
+    const double Words = 1u << 24, Tones = 2.0 * CtcssLimit + 1;
+    printf("{\"cdcss_words\":%u,\"cdcss_found\":%lu,\"ctcss_inputs\":%u,"
+           "\"cdcss_old_ns\":%.1f,\"cdcss_new_ns\":%.1f,\"ctcss_old_ns\":%.1f,\"ctcss_new_ns\":%.1f}\n",
+           1u << 24, Found, 2 * CtcssLimit + 1, OldCdcss / Words * 1e9, NewCdcss / Words * 1e9,
+           OldCtcss / Tones * 1e9, NewCtcss / Tones * 1e9);
+    return 0;
+}
+
+'''
+
+
+def baseline():
+    result = subprocess.run(['git', '-C', hostbuild.ROOT, 'show', f'{BASELINE}:App/dcs.c'],
+                            capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    # dcs.h comes in renamed as well, the old file is a unit of its own
+    return ''.join(f'#define {n} Old_{n}\n' for n in OLD_NAMES) + result.stdout
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check the CDCSS/CTCSS decoders of dcs.c against the baseline '
+                                                 'ones over every input, and time both.')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('-ctcss', type=int, default=70000, help='CTCSS readings checked from -N to N '
+                                                                '(default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            old = os.path.join(tmp, 'dcs_old.c')
+            with open(old, 'w') as f:
+                f.write(baseline())
+            binary, _ = hostbuild.build(args.cc, tmp, HARNESS, SOURCES + [old], {}, name='dcs_check')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built dcs.c and the {BASELINE} one")
+
+        run = subprocess.run([binary, str(args.ctcss)], capture_output=True, text=True)
+
+    if run.returncode:
+        print(f"[!] Decoders differ: {run.stderr.strip()}")
+        sys.exit(1)
+
+    r = json.loads(run.stdout)
+    print(f"[*] {r['cdcss_words']} CDCSS readings ({r['cdcss_found']} decode) and "
+          f"{r['ctcss_inputs']} CTCSS readings decode the same")
+    print(f"    CDCSS  old {r['cdcss_old_ns']:7.1f} ns  new {r['cdcss_new_ns']:7.1f} ns  "
+          f"({r['cdcss_old_ns'] / r['cdcss_new_ns']:.1f}x)")
+    print(f"    CTCSS  old {r['ctcss_old_ns']:7.1f} ns  new {r['ctcss_new_ns']:7.1f} ns  "
+          f"({r['ctcss_old_ns'] / r['ctcss_new_ns']:.1f}x)")
+    print("[*] Host timings, the ratio is what carries over to the radio")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,368 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import json
+import random
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# The RX dead time of a VFO swap is measured on the firmware itself:
+# DualwatchAlternate from app/app.c, app/rxdelta.c, radio.c and the BK4819
+# driver are built for the host. The driver's own bit banged SPI runs against
+# memory mapped in place of the GPIO ports, so a register access costs the
+# delays the firmware waits out, and the register contents go to a model.
+# Every delta swap is checked against a full RADIO_SetupRegisters of the
+# same VFO, then the measured swap times feed the traffic model below.
+SOURCES = ['app/rxdelta.c', 'radio.c', 'functions.c', 'dcs.c', 'frequencies.c', 'misc.c']
+DRIVER = 'driver/bk4829.c'
+
+SETTLE_MS = 5           # PLL lock and RSSI filter after the retune
+LOOP_MS = 2             # countdown tick to main loop jitter
+
+# Squelch response of the BK4819, first carrier to SQUELCH_FOUND
+SQUELCH_MIN_MS = 20
+SQUELCH_MAX_MS = 60
+
+# Traffic on the watched VFO: share of short bursts (kerchunks, data) and
+# their length, the rest is voice
+BURST_SHARE = 0.3
+BURST_MS = (150, 500)
+VOICE_MS = (1000, 8000)
+
+# Toggle intervals tried, 10 ms countdown ticks
+INTERVALS = [4, 5, 6, 7, 8, 10, 12, 15, 20]
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "py32f0xx.h"
+#undef  NVIC_SystemReset
+#define NVIC_SystemReset()      // ARM only, app.c resets from a menu
+#include "app/app.c"            // DualwatchAlternate is static
+#undef  printf
+
+static uint64_t Now;            // virtual microseconds
+static uint32_t AccessUs;       // CPU time of one access on top of the SPI delays
+static uint16_t Registers[128];
+static uint32_t Seed = 1;
+
+uint16_t Spi_ReadRegister(BK4819_REGISTER_t Register);
+void     Spi_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data);
+
+void SYSTICK_DelayUs(uint32_t Delay) { Now += Delay; }
+void SYSTEM_DelayMs(uint32_t Delay)  { Now += Delay * 1000; }
+uint32_t SYSTICK_GetUs(void)         { return (uint32_t)Now; }
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    Spi_ReadRegister(Register);
+    Now += AccessUs;
+    // nothing pending, the interrupt drain ends at once
+    return Register == BK4819_REG_0C ? 0 : Registers[Register & 0x7F];
+}
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    Spi_WriteRegister(Register, Data);
+    Now += AccessUs;
+    Registers[Register & 0x7F] = Data;
+}
+
+static uint32_t Random(uint32_t n)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return (Seed >> 8) % n;
+}
+
+static void Randomize(VFO_Info_t *pVfo, bool SameModulation)
+{
+    static const uint32_t Bands[] = {14400000, 43500000, 44600000, 15600000, 2700000};
+    const uint32_t Frequency = Bands[Random(5)] + Random(200) * 1250;
+
+    pVfo->freq_config_RX.Frequency = Frequency;
+    pVfo->freq_config_RX.CodeType  = Random(4);
+    pVfo->freq_config_RX.Code      = pVfo->freq_config_RX.CodeType == CODE_TYPE_CONTINUOUS_TONE ? Random(50) : Random(104);
+    pVfo->freq_config_TX           = pVfo->freq_config_RX;
+    pVfo->pRX                      = &pVfo->freq_config_RX;
+    pVfo->pTX                      = &pVfo->freq_config_TX;
+    pVfo->CHANNEL_SAVE             = FREQ_CHANNEL_FIRST + FREQUENCY_GetBand(Frequency);
+    pVfo->Band                     = FREQUENCY_GetBand(Frequency);
+
+    // squelch levels follow the band calibration, so half the swaps keep them
+    const uint8_t Level = Random(2) ? 70 : 60 + Random(30);
+    pVfo->SquelchOpenRSSIThresh    = Level;
+    pVfo->SquelchCloseRSSIThresh   = Level - 6;
+    pVfo->SquelchOpenNoiseThresh   = 45;
+    pVfo->SquelchCloseNoiseThresh  = 50;
+    pVfo->SquelchOpenGlitchThresh  = 90;
+    pVfo->SquelchCloseGlitchThresh = 100;
+
+    pVfo->CHANNEL_BANDWIDTH = Random(2);
+    pVfo->SCRAMBLING_TYPE   = Random(4) ? 0 : 1 + Random(10);
+    pVfo->Compander         = Random(4);
+    pVfo->Modulation        = SameModulation ? gEeprom.VfoInfo[!(pVfo - gEeprom.VfoInfo)].Modulation
+                                             : (ModulationMode_t)Random(MODULATION_UKNOWN);
+}
+
+// what the power save wakeup in APP_TimeSlice10ms does before a toggle
+static void Wake(void)
+{
+    BK4819_DisableVox();
+    BK4819_Sleep();
+    BK4819_Conditional_RX_TurnOn_and_GPIO6_Enable();
+#ifdef ENABLE_VOX
+    if (gEeprom.VOX_SWITCH)
+        BK4819_EnableVox(gEeprom.VOX1_THRESHOLD, gEeprom.VOX0_THRESHOLD);
+#endif
+}
+
+// the VFO the next toggle leaves, fully set up
+static void Home(uint8_t Vfo)
+{
+    gEeprom.RX_VFO   = Vfo;
+    gRxVfo           = &gEeprom.VfoInfo[Vfo];
+    RADIO_SetupRegisters(false);
+    gCurrentFunction = FUNCTION_FOREGROUND;
+}
+
+static uint64_t Toggle(bool Asleep, bool Full)
+{
+    if (Asleep)
+        Wake();
+    if (Full)
+        RXDELTA_Invalidate();
+
+    const uint64_t Start = Now;
+    DualwatchAlternate();
+    return Now - Start;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+        return 2;
+
+    const unsigned Trials = strtoul(argv[1], NULL, 0);
+    AccessUs = strtoul(argv[2], NULL, 0);
+    Seed = strtoul(argv[3], NULL, 0);
+
+    // GPIO ports at their real address for the SPI lines
+    if (mmap((void *)IOPORT_BASE, 0x2000, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) == MAP_FAILED)
+    {
+        perror("mmap");
+        return 1;
+    }
+
+    gEeprom.DUAL_WATCH     = DUAL_WATCH_CHAN_A;
+    gEeprom.VOLUME_GAIN    = 58;
+    gEeprom.DAC_GAIN       = 8;
+    gEeprom.VOX1_THRESHOLD = 0x50;
+    gEeprom.VOX0_THRESHOLD = 0x40;
+    gCurrentVfo = gTxVfo   = &gEeprom.VfoInfo[0];
+    gScanStateDir          = SCAN_OFF;
+
+    BK4819_Init();
+    Randomize(&gEeprom.VfoInfo[0], false);
+    Randomize(&gEeprom.VfoInfo[1], true);
+
+    uint64_t DeltaUs = 0, FullUs = 0, DeltaMax = 0, FullMax = 0;
+    unsigned Deltas = 0, Fallbacks = 0;
+
+    for (unsigned Trial = 0; Trial < Trials; Trial++)
+    {
+        // one side changes now and then, a third of those to another modulation
+        if (Random(4) == 0)
+            Randomize(&gEeprom.VfoInfo[Random(2)], Random(3) != 0);
+
+        gEeprom.VOX_SWITCH = Random(2);
+        const uint8_t Vfo = Random(2);
+        const bool Asleep = Random(2);
+
+        Home(Vfo);
+        uint16_t Start[128];
+        memcpy(Start, Registers, sizeof(Start));
+
+        const uint64_t Delta = Toggle(Asleep, false);
+        uint16_t Swapped[128];
+        memcpy(Swapped, Registers, sizeof(Swapped));
+
+        memcpy(Registers, Start, sizeof(Registers));
+        Home(Vfo);
+        const uint64_t Full = Toggle(Asleep, true);
+
+        // the interrupt flag clear and the AF mode, which only opens once
+        // the squelch does, are the only registers allowed to differ
+        for (unsigned r = 0; r < 128; r++)
+        {
+            if (r == BK4819_REG_02 || r == BK4819_REG_47)
+                continue;
+            if (Swapped[r] != Registers[r])
+            {
+                fprintf(stderr, "trial %u: REG_%02X 0x%04X after the delta swap, 0x%04X after a full one\n",
+                        Trial, r, Swapped[r], Registers[r]);
+                return 1;
+            }
+        }
+
+        FullUs += Full;
+        if (Full > FullMax)
+            FullMax = Full;
+
+        // the delta path refuses a change of modulation
+        if (gEeprom.VfoInfo[0].Modulation != gEeprom.VfoInfo[1].Modulation)
+        {
+            Fallbacks++;
+            continue;
+        }
+        Deltas++;
+        DeltaUs += Delta;
+        if (Delta > DeltaMax)
+            DeltaMax = Delta;
+    }
+
+    printf("{\"trials\":%u,\"fallbacks\":%u,\"delta_us\":%.1f,\"delta_max_us\":%llu,"
+           "\"full_us\":%.1f,\"full_max_us\":%llu}\n",
+           Trials, Fallbacks, Deltas ? (double)DeltaUs / Deltas : 0.0, (unsigned long long)DeltaMax,
+           Trials ? (double)FullUs / Trials : 0.0, (unsigned long long)FullMax);
+    return 0;
+}
+'''
+
+
+def driver(tmp):
+    """The BK4819 driver with its register access renamed, the harness puts
+    the register model behind it."""
+    with open(os.path.join(hostbuild.APP, DRIVER)) as f:
+        text = f.read()
+    text, n = re.subn(r'^(uint16_t|void) BK4819_(ReadRegister|WriteRegister)\(', r'\1 Spi_\2(', text, flags=re.M)
+    if n != 2:
+        raise RuntimeError(f"register access not found in {DRIVER}")
+    path = os.path.join(tmp, 'bk4829_spi.c')
+    with open(path, 'w') as f:
+        f.write(f'#line 1 "{DRIVER}"\n' + text)
+    return path
+
+
+def transmission(rng):
+    if rng.random() < BURST_SHARE:
+        return rng.uniform(*BURST_MS)
+    return rng.uniform(*VOICE_MS)
+
+
+def detect(start, length, ticks, swap_ms, squelch, rng):
+    """Time from key up to squelch open on the other VFO, None when missed."""
+    dwell = ticks * 10
+    period = 2 * (dwell + swap_ms)
+    end = start + length
+
+    # windows on the watched VFO start every period, half a period in
+    window = (start // period) * period + period / 2 - period
+    while window < end:
+        ready = window + swap_ms + SETTLE_MS + rng.uniform(0, LOOP_MS)
+        leave = window + swap_ms + dwell
+        heard = max(ready, start) + rng.uniform(*squelch)
+        if heard <= min(leave, end):
+            return heard - start
+        window += period
+    return None
+
+
+def run(args, ticks, swap_ms, rng):
+    missed = 0
+    latency = []
+
+    for _ in range(args.transmissions):
+        start = rng.uniform(0, 60000)
+        found = detect(start, transmission(rng), ticks, swap_ms, args.squelch, rng)
+        if found is None:
+            missed += 1
+        else:
+            latency.append(found)
+
+    latency.sort()
+    return {
+        'missed': missed / args.transmissions,
+        'mean': sum(latency) / len(latency) if latency else 0.0,
+        'p95': latency[int(0.95 * (len(latency) - 1))] if latency else 0.0,
+    }
+
+
+def measure(args):
+    variables = hostbuild.preset_flags(args.preset)
+    variables['ENABLE_DUAL_WATCH_SWAP'] = True
+    variables['ENABLE_RX_DELTA'] = True
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            sources = SOURCES + [driver(tmp)]
+            if variables.get('ENABLE_AM_FIX') is True:
+                sources.append('am_fix.c')
+            binary, stubbed = hostbuild.build(args.cc, tmp, HARNESS, sources, variables, extra=['-no-pie'],
+                                              name='dual_watch_sim')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built the dual watch swap for {args.preset}, {stubbed} symbols stubbed")
+
+        run = subprocess.run([binary, str(args.swaps), str(args.access_us), str(args.seed)],
+                             capture_output=True, text=True)
+
+    if run.returncode:
+        print(f"[!] Swap check failed ({run.returncode}): {run.stderr.strip()}")
+        sys.exit(1)
+    return json.loads(run.stdout)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Simulate transmissions missed by dual watch at different VFO toggle '
+                                                 'intervals, with the swap times measured on the firmware.')
+    parser.add_argument('-preset', default='Custom', help='CMake preset for the feature flags (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('-swaps', type=int, default=20000, help='swaps checked and timed (default: %(default)s)')
+    parser.add_argument('-access-us', type=int, default=5, help='CPU time of a register access on top of the SPI '
+                                                               'delays (default: %(default)s)')
+    parser.add_argument('-transmissions', type=int, default=20000, help='transmissions per interval (default: %(default)s)')
+    parser.add_argument('-squelch', type=float, nargs=2, metavar=('MIN', 'MAX'), default=[SQUELCH_MIN_MS, SQUELCH_MAX_MS],
+                        help='squelch response in ms (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.swaps <= 0 or args.transmissions <= 0 or args.squelch[0] > args.squelch[1]:
+        print("[!] swaps and transmissions must be positive and the squelch range ordered")
+        sys.exit(1)
+
+    r = measure(args)
+    full_ms, delta_ms = r['full_us'] / 1000, r['delta_us'] / 1000
+    print(f"[*] {r['trials']} swaps leave the registers of a full setup, "
+          f"{r['fallbacks']} fell back to it (modulation changed)")
+    print(f"    full swap  {full_ms:6.2f} ms  max {r['full_max_us'] / 1000:6.2f} ms")
+    print(f"    delta swap {delta_ms:6.2f} ms  max {r['delta_max_us'] / 1000:6.2f} ms")
+
+    print(f"[*] {args.transmissions} transmissions, {BURST_SHARE:.0%} short bursts, "
+          f"squelch {args.squelch[0]:.0f}-{args.squelch[1]:.0f} ms")
+    print("    interval     full swap: missed  mean   p95     delta swap: missed  mean   p95")
+
+    for ticks in INTERVALS:
+        line = f"    {ticks * 10:5d} ms  "
+        for swap_ms in (full_ms, delta_ms):
+            r = run(args, ticks, swap_ms, random.Random(args.seed))
+            line += f"          {r['missed']:7.2%} {r['mean']:5.0f} {r['p95']:5.0f}"
+        print(line)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,391 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# driver/py25q16.c built for the host against a model of the PY25Q16 on the
+# SPI bus: status registers, page program, sector erase with suspend and
+# resume, on a virtual clock. Random reads, writes and background erases
+# go through the real driver. The model flags any command the chip would
+# not take at that point, and every read is checked against what was
+# written. The time each read takes is reported by where it falls: no
+# erase running, an erase of another sector, or the sector being erased.
+DRIVER = 'driver/py25q16.c'
+
+PRELUDE = r'''
+#include "py32f071_ll_spi.h"
+#include "driver/gpio.h"
+
+void    FLASH_Pin(bool High);
+uint8_t FLASH_Byte(uint8_t Value);
+
+// SPI_Init is never run
+#define LL_GPIO_StructInit(pInit)             do {} while (0)
+#define LL_GPIO_Init(GPIOx, pInit)            0
+#define LL_SPI_StructInit(pInit)              do {} while (0)
+#define LL_SPI_Init(SPIx, pInit)              0
+
+#define GPIO_SetOutputPin(Pin)                FLASH_Pin(true)
+#define GPIO_ResetOutputPin(Pin)              FLASH_Pin(false)
+
+static uint8_t SpiIn;
+#define LL_SPI_IsActiveFlag_TXE(SPIx)         1
+#define LL_SPI_IsActiveFlag_RXNE(SPIx)        1
+#define LL_SPI_TransmitData8(SPIx, Value)     (SpiIn = FLASH_Byte(Value))
+#define LL_SPI_ReceiveData8(SPIx)             SpiIn
+
+static uint8_t SPI_WriteByte(uint8_t Value);
+
+// the DMA transfers go byte by byte on the host
+static void SPI_ReadBuf(uint8_t *Buf, uint32_t Size)
+{
+    for (uint32_t i = 0; i < Size; i++)
+        Buf[i] = SPI_WriteByte(0xff);
+}
+
+static void SPI_WriteBuf(const uint8_t *Buf, uint32_t Size)
+{
+    for (uint32_t i = 0; i < Size; i++)
+        SPI_WriteByte(Buf[i]);
+}
+
+#line 1 "driver/py25q16.c"
+'''
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/py25q16.h"
+
+#define SECTORS     16
+#define SECTOR      0x1000
+#define BYTE_NS     333         // 8 clocks at 24 MHz
+#define ERASE_NS    45000000ull // sector erase, typical
+#define PROGRAM_NS  500000ull   // page program
+#define SUSPEND_NS  20000ull    // tSUS
+#define RESUME_NS   100000ull   // tRS, resume to next suspend
+
+static uint8_t  Memory[SECTORS * SECTOR], Written[SECTORS * SECTOR];
+static uint64_t Now;            // virtual ns
+
+// chip state
+static bool     Selected, Wel;
+static uint8_t  Cmd, Count;
+static uint32_t Addr;
+static uint64_t BusyUntil;      // program, or the suspend taking effect
+static uint64_t EraseLeft;      // erase time still to go
+static uint32_t Erasing = ~0u;
+static bool     Suspended, Suspending;
+static uint64_t ResumedAt;
+
+static unsigned long Violations, Mismatches, Suspends;
+static const char   *Violation;
+static uint64_t      Seed = 1;
+
+static uint32_t Random(uint32_t n)
+{
+    Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(Seed >> 33) % n;
+}
+
+static void Flag(const char *pWhat)
+{
+    Violations++;
+    if (!Violation)
+        Violation = pWhat;
+}
+
+// time passes, the erase goes on unless suspended
+static void Advance(uint64_t Ns)
+{
+    while (Ns) {
+        uint64_t Step = Ns;
+        if (EraseLeft && !Suspended) {
+            if (Suspending && BusyUntil > Now && BusyUntil - Now < Step)
+                Step = BusyUntil - Now;
+            if (EraseLeft < Step)
+                Step = EraseLeft;
+            EraseLeft -= Step;
+            if (!EraseLeft) {
+                memset(&Memory[Erasing], 0xff, SECTOR);
+                Erasing   = ~0u;
+                Suspending = false;
+            }
+        }
+        Now += Step;
+        Ns  -= Step;
+        if (Suspending && Now >= BusyUntil) {
+            Suspending = false;
+            Suspended  = true;
+        }
+    }
+}
+
+static bool Wip(void)
+{
+    return (EraseLeft && !Suspended) || Now < BusyUntil;
+}
+
+void FLASH_Pin(bool High)
+{
+    if (!High) {
+        Selected = true;
+        Count    = 0;
+        return;
+    }
+    if (!Selected)
+        return;
+    Selected = false;
+
+    switch (Count ? Cmd : 0) {
+        case 0x06:
+            if (!Wip())
+                Wel = true;
+            break;
+        case 0x20:
+            if (Count != 4)
+                break;
+            if (Wip() || Suspended || !Wel) {
+                Flag("erase while busy, suspended or not write enabled");
+                break;
+            }
+            Erasing   = Addr & ~(SECTOR - 1u);
+            EraseLeft = ERASE_NS;
+            Wel       = false;
+            break;
+        case 0x02:
+            Wel       = false;
+            BusyUntil = Now + PROGRAM_NS;
+            break;
+        case 0x75:
+            if (!EraseLeft || Suspended || Suspending)
+                break;
+            if (Now - ResumedAt < RESUME_NS)
+                Flag("suspend sooner than tRS after a resume");
+            Suspending = true;
+            BusyUntil  = Now + SUSPEND_NS;
+            Suspends++;
+            break;
+        case 0x7a:
+            if (Suspended) {
+                Suspended = false;
+                ResumedAt = Now;
+            }
+            break;
+    }
+}
+
+uint8_t FLASH_Byte(uint8_t Value)
+{
+    Advance(BYTE_NS);
+    if (!Selected) {
+        Flag("clock without chip select");
+        return 0xff;
+    }
+
+    uint8_t Out = 0xff;
+    if (Count == 0) {
+        Cmd  = Value;
+        Addr = 0;
+        if (Wip() && Cmd != 0x05 && Cmd != 0x35 && Cmd != 0x75)
+            Flag("command while busy");
+        if (Cmd == 0x02 && !Wel)
+            Flag("program while not write enabled");
+    }
+    else if (Cmd == 0x05) {
+        Out = (Wip() ? 1 : 0) | (Wel ? 2 : 0);
+    }
+    else if (Cmd == 0x35) {
+        Out = Suspended ? 0x80 : 0;
+    }
+    else if ((Cmd == 0x03 || Cmd == 0x02 || Cmd == 0x20) && Count <= 3) {
+        Addr = (Addr << 8) | Value;
+        if (Count == 3)
+            Addr %= sizeof(Memory);
+    }
+    else if (Cmd == 0x03) {
+        if (Suspended && (Addr & ~(SECTOR - 1u)) == Erasing)
+            Flag("read of the suspended sector");
+        Out  = Memory[Addr];
+        Addr = (Addr + 1) % sizeof(Memory);
+    }
+    else if (Cmd == 0x02) {
+        Memory[Addr] &= Value;
+        Addr = (Addr & ~0xffu) | ((Addr + 1) & 0xffu);
+    }
+
+    if (Count < 255)
+        Count++;
+    return Out;
+}
+
+void SYSTICK_DelayUs(uint32_t Delay)
+{
+    Advance(Delay * 1000ull);
+}
+
+uint32_t SYSTICK_GetUs(void)
+{
+    Advance(100);
+    return Now / 1000;
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned long Ops = strtoul(argv[1], NULL, 10);
+    Seed = strtoull(argv[2], NULL, 10);
+
+    memset(Memory, 0xff, sizeof(Memory));
+    memset(Written, 0xff, sizeof(Written));
+
+    // reads with no erase running, of another sector, of the erasing one
+    unsigned long Reads[3] = {0};
+    uint64_t      ReadNs[3] = {0}, MaxNs[3] = {0};
+    unsigned long Erases = 0;
+
+    for (unsigned long Op = 0; Op < Ops; Op++) {
+        const uint32_t Kind = Random(100);
+        if (Kind < 3) {
+            const uint32_t Sector = Random(SECTORS);
+            PY25Q16_SectorEraseAsync(Sector * SECTOR);
+            memset(&Written[Sector * SECTOR], 0xff, SECTOR);
+            Erases++;
+        }
+        else if (Kind < 6) {
+            uint8_t  Data[64];
+            const uint32_t Size = 1 + Random(sizeof(Data));
+            const uint32_t At   = Random(sizeof(Memory) - Size);
+            for (uint32_t i = 0; i < Size; i++)
+                Data[i] = Random(256);
+            PY25Q16_WriteBuffer(At, Data, Size, false);
+            memcpy(&Written[At], Data, Size);
+        }
+        else if (Kind < 60) {
+            uint8_t Data[256];
+            const uint32_t Size = 1 + Random(Random(4) ? 16 : sizeof(Data));
+            uint32_t At = Random(sizeof(Memory) - Size);
+            if (Erasing != ~0u && Random(4) == 0)
+                At = Erasing + Random(SECTOR - Size);
+
+            const int Where = Erasing == ~0u ? 0 : (At < Erasing + SECTOR && Erasing < At + Size) ? 2 : 1;
+            const uint64_t Start = Now;
+            PY25Q16_ReadBuffer(At, Data, Size);
+            const uint64_t Took = Now - Start;
+
+            if (memcmp(Data, &Written[At], Size))
+                Mismatches++;
+            Reads[Where]++;
+            ReadNs[Where] += Took;
+            if (Took > MaxNs[Where])
+                MaxNs[Where] = Took;
+        }
+        else {
+            Advance(Random(2000) * 1000ull);   // the rest of the main loop
+        }
+    }
+
+    // the erases all finish once nothing reads any more
+    while (PY25Q16_IsBusy())
+        Advance(1000000);
+    if (memcmp(Memory, Written, sizeof(Memory)))
+        Mismatches++;
+
+    printf("{\"violations\": %lu, \"violation\": \"%s\", \"mismatches\": %lu, \"erases\": %lu, \"suspends\": %lu, "
+           "\"reads\": [%lu, %lu, %lu], \"ns\": [%llu, %llu, %llu], \"max_ns\": [%llu, %llu, %llu]}\n",
+           Violations, Violation ? Violation : "", Mismatches, Erases, Suspends, Reads[0], Reads[1], Reads[2],
+           (unsigned long long)ReadNs[0], (unsigned long long)ReadNs[1], (unsigned long long)ReadNs[2],
+           (unsigned long long)MaxNs[0], (unsigned long long)MaxNs[1], (unsigned long long)MaxNs[2]);
+    return 0;
+}
+'''
+
+# the DMA transfers of the driver make way for the byte loops of the prelude
+DMA_BUFFERS = r'static void SPI_(Read|Write)Buf\('
+
+
+def driver(tmp, path):
+    with open(path) as f:
+        text = f.read()
+    text, count = re.subn(DMA_BUFFERS, r'static void SPI_\1Buf_Dma(', text)
+    if count != 2:
+        raise RuntimeError(f"{DRIVER}: SPI_ReadBuf and SPI_WriteBuf not found")
+    out = os.path.join(tmp, 'py25q16.c')
+    with open(out, 'w') as f:
+        f.write(PRELUDE + text)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check the PY25Q16 driver against a model of the chip, with reads '
+                                                 'suspending a background sector erase.')
+    parser.add_argument('-driver', default=os.path.join(hostbuild.APP, DRIVER), help='driver source (default: %(default)s)')
+    parser.add_argument('-preset', default='Custom', help='CMakePresets.json preset for the options (default: %(default)s)')
+    parser.add_argument('-runs', type=int, default=10, help='random sequences (default: %(default)s)')
+    parser.add_argument('-ops', type=int, default=20000, help='operations per sequence (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed of the first sequence (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.runs <= 0 or args.ops <= 0:
+        print("[!] runs and ops must be positive")
+        sys.exit(1)
+
+    variables = hostbuild.preset_flags(args.preset)
+    variables['ENABLE_UART_DMA_TX'] = False     # the DMA interrupt is not run on the host
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary, stubbed = hostbuild.build(args.cc, tmp, HARNESS, [driver(tmp, args.driver)], variables, name='flash')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built {DRIVER}, {stubbed} symbols stubbed")
+
+        totals = {'violations': 0, 'mismatches': 0, 'erases': 0, 'suspends': 0,
+                  'reads': [0, 0, 0], 'ns': [0, 0, 0], 'max_ns': [0, 0, 0]}
+        for seed in range(args.seed, args.seed + args.runs):
+            result = subprocess.run([binary, str(args.ops), str(seed)], capture_output=True, text=True)
+            if result.returncode:
+                print(f"[!] Sequence {seed} failed ({result.returncode}): {result.stderr.strip()}")
+                sys.exit(1)
+            summary = json.loads(result.stdout)
+            if summary['violations']:
+                print(f"[!] Sequence {seed}: {summary['violations']} commands the chip would not take, "
+                      f"first: {summary['violation']}")
+            for key in ('violations', 'mismatches', 'erases', 'suspends'):
+                totals[key] += summary[key]
+            for i in range(3):
+                totals['reads'][i] += summary['reads'][i]
+                totals['ns'][i] += summary['ns'][i]
+                totals['max_ns'][i] = max(totals['max_ns'][i], summary['max_ns'][i])
+
+    print(f"[*] {args.runs} sequences of {args.ops} operations, {totals['erases']} erases, "
+          f"{totals['suspends']} suspends")
+    print("    reads                      count    mean us     max us")
+    for i, label in enumerate(('no erase running', 'erase of another sector', 'of the erasing sector')):
+        count = totals['reads'][i]
+        mean = totals['ns'][i] / count / 1000 if count else 0
+        print(f"    {label:<24} {count:8d} {mean:10.1f} {totals['max_ns'][i] / 1000:10.1f}")
+
+    if totals['mismatches']:
+        print(f"[!] {totals['mismatches']} reads or final contents differ from what was written")
+    if totals['violations'] or totals['mismatches']:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
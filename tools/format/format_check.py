@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# Formatters under test (App/helper/format.[ch])
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+SOURCE = os.path.join(ROOT, 'App', 'helper', 'format.c')
+INCLUDE = os.path.join(ROOT, 'App')
+
+# Every formatter is run next to the sprintf call it replaces, over the
+# ranges the UI uses, the edges of the types and random values
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "helper/format.h"
+
+static unsigned long Checked, Failed;
+
+static void Compare(const char *pName, const char *pGot, const char *pWant)
+{
+    Checked++;
+    if (strcmp(pGot, pWant) == 0)
+        return;
+    if (Failed++ < 20)
+        printf("    %-10s got \"%s\" want \"%s\"\n", pName, pGot, pWant);
+}
+
+static uint32_t Random(void)
+{
+    static uint32_t State = SEED;
+    State ^= State << 13;
+    State ^= State >> 17;
+    State ^= State << 5;
+    return State;
+}
+
+static void Unsigned(uint32_t Value)
+{
+    char Got[32], Want[32];
+    for (int Width = 0; Width <= 11; Width++) {
+        FORMAT_Unsigned(Got, Value, Width, ' ');
+        sprintf(Want, "%*u", Width, Value);
+        Compare("unsigned", Got, Want);
+        FORMAT_Unsigned(Got, Value, Width, '0');
+        sprintf(Want, "%0*u", Width, Value);
+        Compare("unsigned", Got, Want);
+    }
+}
+
+static void Signed(int32_t Value)
+{
+    char Got[32], Want[32];
+    for (int Width = 0; Width <= 12; Width++) {
+        FORMAT_Signed(Got, Value, Width, ' ');
+        sprintf(Want, "%*d", Width, Value);
+        Compare("signed", Got, Want);
+        FORMAT_Signed(Got, Value, Width, '0');
+        sprintf(Want, "%0*d", Width, Value);
+        Compare("signed", Got, Want);
+    }
+}
+
+static void Frequency(uint32_t Value)
+{
+    char Got[32], Want[32];
+    FORMAT_Frequency(Got, Value, 3, ' ');
+    sprintf(Want, "%3u.%05u", Value / 100000, Value % 100000);
+    Compare("frequency", Got, Want);
+    FORMAT_Frequency(Got, Value, 1, ' ');
+    sprintf(Want, "%u.%05u", Value / 100000, Value % 100000);
+    Compare("frequency", Got, Want);
+    FORMAT_Frequency(Got, Value, 3, '0');
+    sprintf(Want, "%03u.%05u", Value / 100000, Value % 100000);
+    Compare("frequency", Got, Want);
+}
+
+static void Fixed(uint32_t Value)
+{
+    static const uint32_t Scale[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    char Got[32], Want[32];
+    for (int Decimals = 1; Decimals <= 9; Decimals++) {
+        FORMAT_Fixed(Got, Value, Decimals, 0, ' ');
+        sprintf(Want, "%u.%0*u", Value / Scale[Decimals], Decimals, Value % Scale[Decimals]);
+        Compare("fixed", Got, Want);
+    }
+}
+
+static void Duration(uint32_t Seconds)
+{
+    char Got[32], Want[32];
+    FORMAT_Duration(Got, Seconds);
+    if (Seconds < 60)
+        sprintf(Want, "%3us", Seconds);
+    else if (Seconds < 60 * 60)
+        sprintf(Want, "%3um", Seconds / 60);
+    else if (Seconds < 24 * 60 * 60)
+        sprintf(Want, "%3uh", Seconds / (60 * 60));
+    else
+        sprintf(Want, "%3ud", Seconds / (24 * 60 * 60));
+    Compare("duration", Got, Want);
+}
+
+static void Octal(uint32_t Value)
+{
+    char Got[32], Want[32];
+    for (int Width = 0; Width <= 12; Width++) {
+        FORMAT_Octal(Got, Value, Width);
+        sprintf(Want, "%0*o", Width, Value);
+        Compare("octal", Got, Want);
+    }
+}
+
+static void String(uint32_t Value)
+{
+    static const char Source[] = "145.5000 CH-001";
+    char Got[32], Want[32];
+    const char *pSource = &Source[Value % sizeof(Source)];
+    for (int Width = 0; Width <= 20; Width++) {
+        FORMAT_String(Got, pSource, Width);
+        sprintf(Want, "%-*s", Width, pSource);
+        Compare("string", Got, Want);
+    }
+}
+
+int main(void)
+{
+    for (uint32_t Value = 0; Value <= 200000; Value++) {
+        Unsigned(Value);
+        Signed((int32_t)Value - 100000);
+        Fixed(Value);
+        Duration(Value * 7);
+        Octal(Value);
+    }
+    for (uint32_t Value = 0; Value < 10; Value++) {
+        static const uint32_t Edges[] = {60, 60 * 60, 24 * 60 * 60, 1000 * 24 * 60 * 60};
+        for (unsigned int i = 0; i < 4; i++) {
+            Duration(Edges[i] + Value);
+            Duration(Edges[i] - 1 - Value);
+        }
+        Duration(UINT32_MAX - Value);
+        Octal(UINT32_MAX - Value);
+    }
+    for (uint32_t Value = 0; Value < 16; Value++)
+        String(Value);
+    for (uint32_t Value = 0; Value < 10; Value++) {
+        Unsigned(UINT32_MAX - Value);
+        Fixed(UINT32_MAX - Value);
+        Signed(INT32_MAX - Value);
+        Signed(INT32_MIN + Value);
+    }
+
+    // 10 Hz units, the whole tuning range in steps and every value near
+    // the MHz edges, then the rest of the type
+    for (uint32_t Value = 0; Value <= 134000000; Value += 37)
+        Frequency(Value);
+    for (uint32_t MHz = 0; MHz <= 1340; MHz++)
+        for (uint32_t Offset = 0; Offset < 20; Offset++) {
+            Frequency(MHz * 100000 + Offset);
+            if (MHz)
+                Frequency(MHz * 100000 - 1 - Offset);
+        }
+    for (uint32_t Value = 0; Value < 10; Value++)
+        Frequency(UINT32_MAX - Value);
+
+    for (uint32_t Number = 0; Number <= UINT16_MAX; Number++) {
+        char Got[32], Want[32];
+        FORMAT_Channel(Got, Number, 3);
+        sprintf(Want, "CH-%03u", Number);
+        Compare("channel", Got, Want);
+        FORMAT_Channel(Got, Number, 2);
+        sprintf(Want, "CH-%02u", Number);
+        Compare("channel", Got, Want);
+        FORMAT_Time(Got, Number);
+        sprintf(Want, "%02u:%02u", Number / 60, Number % 60);
+        Compare("time", Got, Want);
+    }
+
+    for (unsigned long i = 0; i < RANDOM; i++) {
+        const uint32_t Value = Random();
+        Unsigned(Value);
+        Signed((int32_t)Value);
+        Frequency(Value);
+        Fixed(Value);
+        Duration(Value);
+        Octal(Value);
+    }
+
+    printf("[*] %lu strings compared, %lu differ\n", Checked, Failed);
+    return Failed != 0;
+}
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare the UI formatters with sprintf, byte for byte, on the host.')
+    parser.add_argument('-cc', default=os.environ.get('CC', 'cc'), help='host C compiler (default: %(default)s)')
+    parser.add_argument('-random', type=int, default=1000000, help='random values on top of the fixed ranges (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed, not zero (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.random < 0 or not 0 < args.seed < 2 ** 32:
+        print("[!] random must not be negative and the seed must fit 32 bits and not be zero")
+        sys.exit(1)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        harness = os.path.join(tmp, 'harness.c')
+        binary = os.path.join(tmp, 'harness')
+        with open(harness, 'w') as f:
+            f.write(HARNESS)
+
+        build = [args.cc, '-std=gnu11', '-O2', '-Wall', f'-I{INCLUDE}',
+                 f'-DSEED={args.seed}u', f'-DRANDOM={args.random}ul',
+                 harness, SOURCE, '-o', binary]
+        try:
+            result = subprocess.run(build, capture_output=True, text=True)
+        except OSError as e:
+            print(f"[!] Cannot run {args.cc}: {e}")
+            sys.exit(1)
+        if result.returncode:
+            print(f"[!] Build failed\n{result.stderr}")
+            sys.exit(1)
+
+        sys.exit(subprocess.run([binary]).returncode)
+
+
+if __name__ == '__main__':
+    main()
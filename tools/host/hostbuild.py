@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+
+# Builds App sources for the host, for the tools that run the firmware code
+# against simulated hardware. A tool hands over its harness and the App
+# sources it exercises, everything else the link finds missing gets a
+# zeroed stub generated from its declaration in the App headers.
+
+import os
+import re
+import json
+import glob
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+DEFINES = ['-DPY32F071x8', '-DUSE_FULL_LL_DRIVER', '-DPRINTF_INCLUDE_CONFIG_H', '-DSQL_TONE=550', '-DALERT_TOT=10']
+STRINGS = {'AUTHOR_STRING_1': 'EGZUMER', 'AUTHOR_STRING_2': 'N7SIX', 'VERSION_STRING_1': 'v0.22',
+           'VERSION_STRING_2': 'v7.6.2br4', 'EDITION_STRING': 'Custom'}
+INCLUDES = ['App', 'App/usb', 'Core/Inc', 'Drivers/CMSIS/Include', 'Drivers/CMSIS/Device/PY32F071/Include',
+            'Drivers/PY32F071_HAL_Driver/Inc']
+
+
+def preset_flags(name, root=ROOT):
+    """ENABLE_* options of a preset in CMakePresets.json, inherited ones first."""
+    with open(os.path.join(root, 'CMakePresets.json')) as f:
+        presets = {p['name']: p for p in json.load(f)['configurePresets']}
+    if name not in presets:
+        raise RuntimeError(f"no preset {name}")
+
+    chain = []
+    while name:
+        chain.append(presets[name])
+        name = presets[name].get('inherits')
+        if isinstance(name, list):
+            name = name[0] if name else None
+
+    variables = {}
+    for preset in reversed(chain):
+        variables.update(preset.get('cacheVariables', {}))
+    return variables
+
+
+def feature_sources(variables, prefixes, root=ROOT):
+    """Sources App/CMakeLists.txt adds for the enabled features, those
+    starting with one of prefixes."""
+    with open(os.path.join(root, 'App', 'CMakeLists.txt')) as f:
+        text = f.read()
+    sources = []
+    for flag, files in re.findall(r'enable_feature\((\w+)([^)]*)\)', text):
+        if variables.get(flag) is True:
+            sources += [s for s in files.split() if s.startswith(prefixes)]
+    return sources
+
+
+def defines(variables):
+    """Compiler flags for the enabled options and the version strings."""
+    result = list(DEFINES)
+    result += [f'-D{k}' for k, v in variables.items() if k.startswith('ENABLE_') and v is True]
+    strings = dict(STRINGS)
+    strings.update({k: v for k, v in variables.items() if k in STRINGS})
+    strings['AUTHOR_STRING'] = f"{strings['AUTHOR_STRING_1']}+{strings['AUTHOR_STRING_2']}"
+    strings['VERSION_STRING'] = strings['VERSION_STRING_2']
+    result += [f'-D{k}="{v}"' for k, v in strings.items()]
+    return result
+
+
+def declarations(root=ROOT):
+    """extern data and prototypes of the App headers, by name."""
+    data, functions = {}, {}
+    app = os.path.join(root, 'App')
+    for header in glob.glob(os.path.join(app, '**', '*.h'), recursive=True):
+        relative = os.path.relpath(header, app)
+        with open(header, errors='replace') as f:
+            text = re.sub(r'/\*.*?\*/|//[^\n]*', '', f.read(), flags=re.S)
+        text = re.sub(r'^\s*#(?:.*\\\n)*.*$', '', text, flags=re.M)
+        for statement in re.findall(r'[^;{}]*;', text):
+            statement = ' '.join(statement.split())
+            m = re.match(r'extern\s+[^(]*?\b(\w+)\s*(\[[^;]*)?;$', statement)
+            if m:
+                data.setdefault(m.group(1), (relative, statement))
+                continue
+            m = re.match(r'(?:extern\s+)?([\w\s\*]+?)\s*\b(\w+)\s*\([^;]*\)\s*;$', statement)
+            if m and not statement.startswith(('return', 'typedef')):
+                functions.setdefault(m.group(2), m.group(1))
+    return data, functions
+
+
+def stubs(undefined, root=ROOT):
+    """Zeroed definitions for the data and functions nothing linked provides.
+    Functions return zero, a pointer result needs a stub in the harness."""
+    data, functions = declarations(root)
+    headers, definitions, names = set(), [], []
+    for name in sorted(undefined):
+        if name in data:
+            header, statement = data[name]
+            headers.add(header)
+            definitions.append(re.sub(r'^extern\s+', '', statement))
+        elif name in functions:
+            if '*' in functions[name]:
+                raise RuntimeError(f"{name} returns a pointer, stub it in the harness")
+            names.append(name)
+        else:
+            raise RuntimeError(f"no declaration of {name}")
+
+    data_unit = ''.join(f'#include "{h}"\n' for h in sorted(headers)) + '\n' + '\n'.join(dict.fromkeys(definitions)) + '\n'
+    code_unit = ''.join(f'long {n}(void) {{ return 0; }}\n' for n in names)
+    return data_unit, code_unit, len(definitions), len(names)
+
+
+def compile_unit(cc, flags, source, obj):
+    result = subprocess.run([cc, '-std=gnu11', '-w', *flags, '-c', source, '-o', obj],
+                            capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    return obj
+
+
+def build(cc, tmp, harness, sources, variables, extra=(), name='harness', root=ROOT):
+    """Link the harness with App sources (paths relative to App), stubbing the
+    rest. extra goes to every compile and to the link, -O2 unless it says
+    otherwise. root is the tree the sources and headers come from. Returns
+    the binary and the number of stubbed symbols."""
+    flags = defines(variables) + [f'-I{os.path.join(root, i)}' for i in INCLUDES] + ['-O2', *extra]
+    path = os.path.join(tmp, f'{name}.c')
+    with open(path, 'w') as f:
+        f.write(harness)
+
+    units = [path] + [os.path.join(root, 'App', s) for s in dict.fromkeys(sources)]
+    objects = [compile_unit(cc, flags, s, os.path.join(tmp, f'{name}_{i}.o')) for i, s in enumerate(units)]
+
+    binary = os.path.join(tmp, name)
+    result = subprocess.run([cc, *extra, *objects, '-o', binary, '-lm'], capture_output=True, text=True)
+    undefined = set(re.findall(r"undefined reference to `(\w+)'", result.stderr))
+    if result.returncode and not undefined:
+        raise RuntimeError(result.stderr)
+    if not result.returncode:
+        return binary, 0
+
+    data_unit, code_unit, n_data, n_code = stubs(undefined, root)
+    for unit, text in (('stub_data', data_unit), ('stub_code', code_unit)):
+        with open(os.path.join(tmp, f'{name}_{unit}.c'), 'w') as f:
+            f.write(text)
+        objects.append(compile_unit(cc, flags, os.path.join(tmp, f'{name}_{unit}.c'), os.path.join(tmp, f'{name}_{unit}.o')))
+
+    result = subprocess.run([cc, *extra, *objects, '-o', binary, '-lm'], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    return binary, n_data + n_code
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import json
+import shlex
+import argparse
+import tempfile
+import subprocess
+
+import hostbuild
+
+# Version
+VERSION = '1.0'
+
+# Static RAM of a preset against the last linked firmware of the baseline.
+# Without the ARM toolchain every unit CMake compiles for the preset is built
+# for the host instead, in this tree and in the baseline one, and the RAM
+# sections summed. The difference is added to what the map of the baseline
+# reports. Pointers take 8 bytes on the host against 4 on the radio, so the
+# estimate errs on the high side wherever a buffer holds pointers.
+BASE = 'f436e67'
+BASE_MAP = 'build/DX1ARM/n7six.dx1arm-k1.v7.6.2br4.map'
+RAM_SIZE = 16384
+SECTIONS = ('.data', '.noncacheable', '.bss')
+# newlib provides these at the link, anything else undefined stops it
+LIBC = {'memcmp', 'memcpy', 'memmove', 'memset', 'strcat', 'strchr', 'strcmp', 'strcpy', 'strlen', 'strncmp', 'strncpy'}
+
+TOOLCHAIN = '''set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_C_COMPILER {cc})
+set(CMAKE_ASM_COMPILER {cc})
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+'''
+
+
+def map_usage(text):
+    """Bytes of each RAM output section and the heap and stack reserve in a map."""
+    usage = {}
+    for name in SECTIONS + ('._user_heap_stack',):
+        m = re.search(r'^' + re.escape(name) + r'\s+0x[0-9a-f]+\s+0x([0-9a-f]+)', text, re.M)
+        if not m:
+            m = re.search(r'^' + re.escape(name) + r'\n\s+0x[0-9a-f]+\s+0x([0-9a-f]+)', text, re.M)
+        usage[name] = int(m.group(1), 16) if m else 0
+    return usage
+
+
+def configure(root, build, cc, variables):
+    toolchain = os.path.join(build, 'host.cmake')
+    os.makedirs(build, exist_ok=True)
+    with open(toolchain, 'w') as f:
+        f.write(TOOLCHAIN.format(cc=cc))
+
+    options = []
+    for k, v in variables.items():
+        if k in ('CMAKE_TOOLCHAIN_FILE', 'CMAKE_BUILD_TYPE'):
+            continue
+        options.append(f'-D{k}={("ON" if v else "OFF") if isinstance(v, bool) else v}')
+    result = subprocess.run(['cmake', '-S', root, '-B', build, '-G', 'Unix Makefiles', f'-DCMAKE_TOOLCHAIN_FILE={toolchain}',
+                             '-DCMAKE_BUILD_TYPE=Release', *options], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stdout + result.stderr)
+    with open(os.path.join(build, 'compile_commands.json')) as f:
+        return json.load(f)
+
+
+def unit_ram(entry, obj):
+    """RAM bytes of one unit. The ARM inline assembly is dropped, it
+    carries no data."""
+    args = shlex.split(entry['command'])
+    args[args.index('-o') + 1] = obj + '.s'
+    args[args.index('-c')] = '-S'
+    result = subprocess.run(args + ['-w', '-fno-common', '-fdata-sections'], cwd=entry['directory'], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+
+    with open(obj + '.s') as f:
+        text = re.sub(r'^#APP\n.*?^#NO_APP\n', '', f.read(), flags=re.M | re.S)
+    with open(obj + '.s', 'w') as f:
+        f.write(text)
+    result = subprocess.run([args[0], '-c', obj + '.s', '-o', obj], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+
+    result = subprocess.run(['size', '-A', obj], capture_output=True, text=True, check=True)
+    ram = 0
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0].startswith(SECTIONS):
+            ram += int(fields[1])
+    return ram
+
+
+def unresolved(objects):
+    """Symbols the units use that none of them defines."""
+    defined, used = set(), set()
+    for obj in objects:
+        result = subprocess.run(['nm', obj], capture_output=True, text=True, check=True)
+        for line in result.stdout.splitlines():
+            fields = line.split()
+            if fields[-2] == 'U':
+                used.add(fields[-1])
+            elif fields[-2] in 'BDRTbdrt':
+                defined.add(fields[-1])
+    return sorted(used - defined - LIBC)
+
+
+def tree_ram(root, build, cc, variables):
+    """RAM bytes by source file of the C units the preset builds, and the
+    symbols the link would miss."""
+    usage, objects = {}, []
+    for i, entry in enumerate(configure(root, build, cc, variables)):
+        if entry['file'].endswith('.c'):
+            objects.append(os.path.join(build, f'unit{i}.o'))
+            usage[os.path.relpath(entry['file'], root)] = unit_ram(entry, objects[-1])
+    return usage, unresolved(objects)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Estimate the static RAM of a preset against the linked baseline firmware.')
+    parser.add_argument('-preset', default='DX1ARM', help='CMakePresets.json preset (default: %(default)s)')
+    parser.add_argument('-base', default=BASE, help='baseline commit (default: %(default)s)')
+    parser.add_argument('-base-preset', dest='base_preset', default='DX1ARM', help='preset of the baseline map (default: %(default)s)')
+    parser.add_argument('-map', default=BASE_MAP, help='map of the baseline firmware in the baseline commit (default: %(default)s)')
+    parser.add_argument('-enable', nargs='*', default=[], help='options switched on over the preset')
+    parser.add_argument('-disable', nargs='*', default=[], help='options switched off over the preset')
+    parser.add_argument('-stack', type=int, default=1024, help='free RAM required above the minimum heap and stack (default: %(default)s)')
+    parser.add_argument('-cc', default='cc', help='host C compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    root = hostbuild.ROOT
+    text = subprocess.run(['git', '-C', root, 'show', f'{args.base}:{args.map}'], capture_output=True, text=True, check=True).stdout
+    linked = map_usage(text)
+
+    variables = hostbuild.preset_flags(args.preset)
+    variables.update({k: True for k in args.enable})
+    variables.update({k: False for k in args.disable})
+
+    with tempfile.TemporaryDirectory() as tmp:
+        base = os.path.join(tmp, 'base')
+        subprocess.run(['git', '-C', root, 'worktree', 'add', '--detach', base, args.base], capture_output=True, check=True)
+        try:
+            before, _ = tree_ram(base, os.path.join(tmp, 'build_base'), args.cc, hostbuild.preset_flags(args.base_preset, base))
+        finally:
+            subprocess.run(['git', '-C', root, 'worktree', 'remove', '--force', base], capture_output=True)
+        after, missing = tree_ram(root, os.path.join(tmp, 'build'), args.cc, variables)
+
+    static = sum(linked[s] for s in SECTIONS)
+    delta = sum(after.values()) - sum(before.values())
+    reserve = linked['._user_heap_stack']
+    free = RAM_SIZE - static - delta - reserve
+
+    print(f"[*] {args.base} {args.base_preset}: {static} bytes static RAM linked, {reserve} heap and stack, {RAM_SIZE - static - reserve} free")
+    for name in sorted(set(before) | set(after), key=lambda n: before.get(n, 0) - after.get(n, 0)):
+        change = after.get(name, 0) - before.get(name, 0)
+        if change:
+            print(f"    {change:+6d}  {name}")
+    print(f"[*] {args.preset}: {delta:+d} bytes on the host, {static + delta} static, {free} free above heap and stack")
+
+    if missing:
+        print(f"[!] undefined at the link: {' '.join(missing)}")
+    if free < args.stack:
+        print(f"[!] less than {args.stack} bytes left for the stack")
+    if missing or free < args.stack:
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
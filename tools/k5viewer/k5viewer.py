@@ -3,6 +3,7 @@
 import os
 import sys
 import time
+import struct
 import datetime
 import argparse
 
@@ -28,9 +29,16 @@ FRAME_SIZE = 1024
 HEADER = b'\xAA\x55'
 TYPE_SCREENSHOT = b'\x01'
 TYPE_DIFF = b'\x02'
+TYPE_RLE = b'\x04'    # USB CDC, see App/screenshot.h
+
+# USB pacing (command 0x0550)
+DEFAULT_FPS = 25
+CREDITS = 4             # frames the radio may send ahead of us
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
 
 # Framebuffer
 framebuffer = bytearray([0] * FRAME_SIZE)
+need_refresh = True
 
 
 COLOR_SETS = {  # {key: (name, foreground, background)}
@@ -49,8 +57,65 @@ def send_keepalive(ser: serial.Serial):
     except serial.SerialException:
         pass
 
+def crc16(data: bytes) -> int:
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def send_pacing(ser: serial.Serial, fps: float):
+    # Ask for the next frames over USB, a full one after an error
+    global need_refresh
+    interval = min(255, max(1, round(100 / fps)))  # 10 ms ticks
+    msg = struct.pack('<HHBB?x', 0x0550, 4, interval, CREDITS, need_refresh)
+    body = msg + struct.pack('<H', crc16(msg))
+    body = bytes(b ^ OBFUSCATION[i % 16] for i, b in enumerate(body))
+    try:
+        ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + body + b'\xdc\xba')
+        need_refresh = False
+    except serial.SerialException:
+        pass
+
+
+def unpack_rle(payload: bytes) -> list:
+    """Blocks of a run length coded frame as (index, 8 bytes), None if damaged."""
+    check = 0
+    for b in payload:
+        check ^= b
+    if len(payload) < 2 or check != 0:
+        return None
+
+    blocks = []
+    i = 1                       # skip the sequence number
+    end = len(payload) - 1      # and the check byte
+    while i < end:
+        if i + 2 > end:
+            return None
+        first, count = payload[i], payload[i + 1]
+        i += 2
+        data = bytearray()
+        while len(data) < count * 8:
+            if i >= end:
+                return None
+            control = payload[i]
+            if control < 0x80:
+                data += payload[i + 1:i + 2 + control]
+                i += 2 + control
+            else:
+                data += payload[i + 1:i + 2] * ((control & 0x7F) + 3)
+                i += 2
+        if len(data) != count * 8 or first + count > 128:
+            return None
+        blocks += [(first + n, data[n * 8:n * 8 + 8]) for n in range(count)]
+    return blocks
+
+
 def read_frame(ser: serial.Serial) -> bytearray:
-    global framebuffer
+    global framebuffer, need_refresh
     while True:
         try:
             b = ser.read(1)
@@ -74,6 +139,15 @@ def read_frame(ser: serial.Serial) -> bytearray:
                     payload = ser.read(size)
                     framebuffer = apply_diff(framebuffer, payload)
                     return framebuffer
+                elif t == TYPE_RLE:
+                    payload = ser.read(size)
+                    blocks = unpack_rle(payload) if ser.read(1) == b'\x0A' else None
+                    if blocks is None:
+                        need_refresh = True
+                        return None
+                    for index, data in blocks:
+                        framebuffer[index * 8 : index * 8 + 8] = data
+                    return framebuffer
 
 
 def apply_diff(framebuffer: bytearray, diff_payload: bytes) -> bytearray:
@@ -124,6 +198,9 @@ def run_viewer(args: argparse.Namespace, ser: serial.Serial):
     frame_lost = 0
     last_time = time.monotonic()
 
+    if args.usb:
+        send_pacing(ser, args.fps)
+
     while True:
         for event in pygame.event.get():
             if event.type == pygame.QUIT:
@@ -175,7 +252,10 @@ def run_viewer(args: argparse.Namespace, ser: serial.Serial):
             if frame_lost == 5:
                 pygame.display.set_caption(f"{base_title} – No data")
 
-        send_keepalive(ser)
+        if args.usb:
+            send_pacing(ser, args.fps)
+        else:
+            send_keepalive(ser)
 
 
 def cmd_list_ports(args: argparse.Namespace):
@@ -199,6 +279,8 @@ def main():
     )
     parser.add_argument("--list-ports", action="store_true", help="list available ports and exit")
     parser.add_argument("--port", type=str, help="serial port to use (in place of 'DEFAULT_PORT')")
+    parser.add_argument("--usb", action="store_true", help="the port is the radio's USB CDC port (/dev/ttyACM0, COMx)")
+    parser.add_argument("--fps", type=float, default=DEFAULT_FPS, help="frame rate asked for over USB (default: %(default)s)")
     parser.add_argument("--version", action="version", version=f"%(prog)s {VERSION}", help="show program's version number and exit")
 
     args = parser.parse_args()
@@ -209,6 +291,9 @@ def main():
     if not args.port and not DEFAULT_PORT:
         print("Please specify the serial port to use or set 'DEFAULT_PORT', do 'k5viewer.py --help' for help")
         exit(1)
+    if args.fps <= 0:
+        print("[!] fps must be positive")
+        exit(1)
     serial_port = args.port or DEFAULT_PORT
     try:
         ser = serial.Serial(serial_port, BAUDRATE, timeout=TIMEOUT)
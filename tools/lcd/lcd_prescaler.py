@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+
+import sys
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+# ST7565_Stats_t (App/driver/st7565.h)
+STATS = struct.Struct('<IIIIIB3x')
+
+# SPI1 runs from the 48 MHz system clock, divided by 2^(n + 1)
+SYSCLK = 48000000
+PRESCALERS = range(7, -1, -1)
+
+# ST7565 serial clock cycle at 3.3 V, 50 ns
+PANEL_MAX_HZ = 20000000
+
+
+def clock(prescaler):
+    return SYSCLK / (2 << prescaler)
+
+
+def set_prescaler(ser, timestamp, prescaler):
+    send(ser, 0x054C, timestamp + struct.pack('<B3x', prescaler))
+    reply = receive(ser, 0x054D)
+    return None if reply is None else reply[0]
+
+
+def frame_time(ser, timestamp, wait):
+    # the radio redraws after the change, give it time and take the
+    # longest frame seen since
+    send(ser, 0x054A, timestamp)
+    receive(ser, 0x054B)
+    time.sleep(wait)
+    send(ser, 0x054A, timestamp)
+    reply = receive(ser, 0x054B)
+    return None if reply is None else STATS.unpack_from(reply)[3]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Step the LCD SPI clock up until the picture breaks and report the fastest prescaler the panel takes (LCD_SPI_PRESCALER).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-wait', type=float, default=1.5, help='seconds to let the radio redraw (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    # the panel is write only, whether a frame arrived intact can only be
+    # seen on the screen; the radio sends the whole of it after each change
+    print("[*] The clock goes up one step at a time, check the screen at each")
+    best = None
+    try:
+        for prescaler in PRESCALERS:
+            if set_prescaler(ser, timestamp, prescaler) != prescaler:
+                print("[!] No answer from the radio")
+                break
+            frame = frame_time(ser, timestamp, args.wait)
+            hz = clock(prescaler)
+            note = '  (above the ST7565 rating)' if hz > PANEL_MAX_HZ else ''
+            answer = input(f"    /{2 << prescaler:<3d} {hz / 1000:6.0f} kHz, frame {frame} us{note}. Screen clean? [y/n] ")
+            if not answer.lower().startswith('y'):
+                break
+            best = prescaler
+    except (KeyboardInterrupt, EOFError):
+        print()
+
+    if best is None:
+        print("[!] No clock tested good, back to the slowest")
+        set_prescaler(ser, timestamp, PRESCALERS[0])
+        sys.exit(1)
+
+    # one step slower than the last good one leaves a margin for
+    # temperature and the flex cable
+    safe = min(best + 1, PRESCALERS[0])
+    set_prescaler(ser, timestamp, safe)
+    print(f"[*] Fastest clean: {best} ({clock(best) / 1000:.0f} kHz), build with LCD_SPI_PRESCALER={safe} ({clock(safe) / 1000:.0f} kHz)")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,490 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# driver/st7565.c and ui/helper.c built for the host without
+# ENABLE_LCD_DIRTY_SPANS, with it, and with ENABLE_LCD_DMA on top. All three
+# run the same random drawing through the real helpers against a model of
+# the panel on the SPI bus. After every blit the panel RAM of the dirty span
+# builds has to be the one the full blit build shows.
+SOURCES = ['ui/helper.c', 'font.c', 'helper/format.c']
+DRIVER = 'driver/st7565.c'
+
+# The SPI and DMA registers are not there on the host, the driver talks to
+# the panel model instead. Only the calls the blits and direct draws make
+# are redirected, SPI_Init is never run.
+PRELUDE = r'''
+#include "py32f071_ll_spi.h"
+#include "py32f071_ll_dma.h"
+#include "driver/gpio.h"
+
+void PANEL_Pin(uint32_t Pin, bool High);
+void PANEL_Write(uint8_t Value);
+void PANEL_DmaStart(const uint8_t *pData, uint8_t Size);
+void PANEL_DmaStep(void);
+
+#define LL_GPIO_StructInit(pInit)             do {} while (0)
+#define LL_GPIO_Init(GPIOx, pInit)            0
+#define LL_SPI_StructInit(pInit)              do {} while (0)
+#define LL_SPI_Init(SPIx, pInit)              0
+
+#define GPIO_SetOutputPin(Pin)                PANEL_Pin(Pin, true)
+#define GPIO_ResetOutputPin(Pin)              PANEL_Pin(Pin, false)
+
+#define LL_SPI_IsActiveFlag_TXE(SPIx)         1
+#define LL_SPI_IsActiveFlag_RXNE(SPIx)        1
+#define LL_SPI_IsActiveFlag_BSY(SPIx)         0
+#define LL_SPI_TransmitData8(SPIx, Value)     PANEL_Write(Value)
+#define LL_SPI_ReceiveData8(SPIx)             0
+#define LL_SPI_GetTxFIFOLevel(SPIx)           LL_SPI_TX_FIFO_EMPTY
+#define LL_SPI_GetRxFIFOLevel(SPIx)           LL_SPI_RX_FIFO_EMPTY
+#define LL_SPI_ClearFlag_OVR(SPIx)            do {} while (0)
+#define LL_SPI_Enable(SPIx)                   do {} while (0)
+#define LL_SPI_Disable(SPIx)                  do {} while (0)
+#define LL_SPI_SetBaudRatePrescaler(SPIx, n)  do {} while (0)
+
+// the memory address is cut to 32 bits on the host, take the pointer
+#define LL_DMA_DisableChannel(DMAx, Channel)  do {} while (0)
+#define LL_DMA_SetMemoryAddress(DMAx, Channel, Address) do {} while (0)
+#define LL_DMA_SetDataLength(DMAx, Channel, Size)       do {} while (0)
+#define LL_DMA_EnableChannel(DMAx, Channel)   PANEL_DmaStart(pTransfer->pData, pTransfer->Size)
+#define LL_DMA_IsActiveFlag_TC1(DMAx)         1
+#define LL_DMA_ClearFlag_TC1(DMAx)            do {} while (0)
+
+#line 1 "driver/st7565.c"
+'''
+
+# a queued blit goes on where the driver waits for it
+WAIT_IDLE = (r'while \(Busy\)\s*;', 'while (Busy) PANEL_DmaStep();')
+
+EPILOGUE = r'''
+#ifdef ENABLE_LCD_DMA
+bool PANEL_Busy(void)
+{
+    return Busy;
+}
+#endif
+'''
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/gpio.h"
+#include "driver/st7565.h"
+#include "ui/helper.h"
+
+#define PANEL_COLUMNS 132       // the driver starts 4 columns in
+#define PANEL_PAGES   (1 + FRAME_LINES)
+
+static uint8_t  Ram[PANEL_PAGES][PANEL_COLUMNS];
+static uint8_t  Page, Column;
+static bool     Selected, Data;
+static uint64_t Bytes, Stray, Transfers;
+static uint64_t Seed = 1;
+
+// DMA transfer running and the blit whose image is due when it is done
+static const uint8_t *pDma;
+static uint8_t        DmaSize;
+static long           Due = -1;
+
+void DMA1_Channel1_IRQHandler(void);
+bool PANEL_Busy(void);
+
+void PANEL_Pin(uint32_t Pin, bool High)
+{
+    if (Pin == GPIO_MAKE_PIN(GPIOB, LL_GPIO_PIN_2))
+        Selected = !High;
+    else if (Pin == GPIO_MAKE_PIN(GPIOA, LL_GPIO_PIN_6))
+        Data = High;
+}
+
+// A0 high is display data, written where the column counter is; A0 low is
+// a command, of which only page and column addresses matter here
+void PANEL_Write(uint8_t Value)
+{
+    Bytes++;
+    if (!Selected) {
+        Stray++;
+        return;
+    }
+
+    if (Data) {
+        if (Column < PANEL_COLUMNS)
+            Ram[Page][Column++] = Value;
+    } else if ((Value & 0xF0) == 0xB0) {
+        Page = Value & 0x0F;
+    } else if ((Value & 0xF0) == 0x10) {
+        Column = (Column & 0x0F) | ((Value & 0x0F) << 4);
+    } else if ((Value & 0xF0) == 0x00) {
+        Column = (Column & 0xF0) | Value;
+    }
+}
+
+static void Image(long Op)
+{
+    uint64_t Hash = 14695981039346656037ULL;
+    for (unsigned i = 0; i < sizeof(Ram); i++)
+        Hash = (Hash ^ ((uint8_t *)Ram)[i]) * 1099511628211ULL;
+    printf("%ld %016llx\n", Op, (unsigned long long)Hash);
+}
+
+void PANEL_DmaStart(const uint8_t *pData, uint8_t Size)
+{
+    pDma    = pData;
+    DmaSize = Size;
+    Transfers++;
+}
+
+// one queued transfer goes out, the interrupt queues the next
+void PANEL_DmaStep(void)
+{
+#ifdef ENABLE_LCD_DMA
+    if (!pDma)
+        return;
+
+    const uint8_t *pData = pDma;
+    pDma = NULL;
+    for (unsigned i = 0; i < DmaSize; i++)
+        PANEL_Write(pData[i]);
+    DMA1_Channel1_IRQHandler();
+
+    if (!PANEL_Busy() && Due >= 0) {
+        Image(Due);
+        Due = -1;
+    }
+#endif
+}
+
+static uint32_t Random(uint32_t Range)
+{
+    Seed = Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)(Seed >> 33) % Range;
+}
+
+static int Between(int Low, int High)
+{
+    return Low + (int)Random(High - Low + 1);
+}
+
+static void Text(char *pString, unsigned Length, const char *pCharset)
+{
+    const unsigned Size = strlen(pCharset);
+    for (unsigned i = 0; i < Length; i++)
+        pString[i] = pCharset[Random(Size)];
+    pString[Length] = '\0';
+}
+
+static const char Printable[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789.,:-+/%#*<>";
+
+// Drawing the UI code does between blits, weighted towards the small
+// updates of the RSSI and audio bars, the status line and the values
+static void Draw(void)
+{
+    char    String[24];
+    uint8_t Pixels[LCD_WIDTH];
+    uint8_t *pBuffer;
+    int16_t Corners[4];
+    int     Line, X, Size;
+
+    switch (Random(100))
+    {
+        case 0 ... 17:      // values in the small fonts
+            Text(String, Between(1, 12), Printable);
+            Line = Between(0, FRAME_LINES - 1);
+            X    = Between(0, LCD_WIDTH - 1);
+            switch (Random(4)) {
+                case 0:  Size = Random(2) ? 0 : Between(X, LCD_WIDTH - 1);
+                         UI_PrintStringSmallNormal(String, X, Size, Line); break;
+                case 1:  UI_PrintStringSmallBold(String, X, 0, Line); break;
+#ifdef ENABLE_PROPORTIONAL_FONT
+                case 2:  UI_PrintStringSmallProp(String, X, Between(X, LCD_WIDTH - 1), Line); break;
+                default: UI_PrintStringSmallPropBold(String, X, 0, Line); break;
+#else
+                default: UI_PrintStringSmallNormal(String, X, 0, Line); break;
+#endif
+            }
+            break;
+
+        case 18 ... 25:     // names and the menu in the big font, two pages
+            Text(String, Between(1, 10), Printable);
+            X    = Between(0, LCD_WIDTH - 8);
+            Size = Random(2) ? 0 : Between(X, LCD_WIDTH - 1);
+            Line = Between(0, FRAME_LINES - 2);
+            UI_PrintString(String, X, Size, Line, Between(7, 10));
+            break;
+
+        case 26 ... 37:     // the status line icons and text
+            if (Random(2)) {
+                Text(String, Between(1, 8), Printable);
+                UI_PrintStringSmallBufferNormal(String, gStatusLine + Between(0, LCD_WIDTH - 8));
+            } else {
+                X    = Between(0, LCD_WIDTH - 1);
+                Size = Between(1, LCD_WIDTH - X);
+                memset(gStatusLine + X, Random(256), Size);
+                ST7565_MarkDirty(gStatusLine + X, Size);
+            }
+            break;
+
+        case 38 ... 42:     // the big frequency digits
+            Text(String, 3, "0123456789");
+            String[3] = '.';
+            Text(String + 4, 3, "0123456789 -");
+            X    = Between(0, 40);
+            Line = Between(0, FRAME_LINES - 2);
+            UI_DisplayFrequency(String, X, Line, Random(2));
+            break;
+
+        case 43 ... 56:     // bars, filled and drawn with the primitives, corners off the screen too
+            for (int i = 0; i < 4; i++)
+                Corners[i] = (i & 1) ? Between(-10, 8 * FRAME_LINES + 10) : Between(-10, LCD_WIDTH + 10);
+            if (Random(2))
+                UI_FillRectangleBuffer(gFrameBuffer, Corners[0], Corners[1], Corners[2], Corners[3], Random(2));
+            else
+                UI_DrawLineBuffer(gFrameBuffer, Corners[0], Corners[1], Corners[2], Corners[3], Random(2));
+            break;
+
+        case 57 ... 60:
+            X    = Random(LCD_WIDTH);
+            Line = Random(8 * FRAME_LINES);
+            UI_DrawPixelBuffer(gFrameBuffer, X, Line, Random(2));
+            break;
+
+        case 61 ... 70:     // the screens that write gFrameBuffer and mark it themselves
+            Line = Random(FRAME_LINES);
+            X    = Between(0, LCD_WIDTH - 1);
+            Size = Between(1, sizeof(gFrameBuffer) - Line * LCD_WIDTH - X);
+            for (int i = 0; i < Size && i < LCD_WIDTH; i++)
+                Pixels[i] = Random(256);
+            pBuffer = &((uint8_t *)gFrameBuffer)[Line * LCD_WIDTH + X];
+            for (int i = 0; i < Size; i++)
+                pBuffer[i] = Pixels[i % LCD_WIDTH];
+            ST7565_MarkDirty(pBuffer, Size);
+            break;
+
+#ifdef ENABLE_FEAT_N7SIX
+        case 71 ... 72:
+            Line = Random(FRAME_LINES);
+            ST7565_Gauge(Line, 0, 100, Random(101));
+            break;
+#endif
+
+        case 73 ... 74:
+            if (Random(4))
+                UI_DisplayClear();
+            else {
+                Text(String, Between(1, 10), Printable);
+                UI_DisplayPopup(String);
+            }
+            break;
+
+        case 75 ... 77:     // straight to the panel, the spectrum and the boot screen
+            Line = Random(PANEL_PAGES);
+            X    = Random(LCD_WIDTH);
+            Size = Between(1, LCD_WIDTH - X);
+            for (int i = 0; i < Size; i++)
+                Pixels[i] = Random(256);
+            ST7565_DrawLine(X, Line, Pixels, Size);
+            break;
+
+        case 78:
+            ST7565_FillScreen(Random(2) ? 0x00 : 0xFF);
+            break;
+
+        case 79:            // the prescaler a UART command can change
+            X = Random(8);
+#ifdef ENABLE_LCD_DIRTY_SPANS
+            if (Random(10) == 0)
+                ST7565_SetPrescaler(X);
+#else
+            (void)Random(10);
+#endif
+            break;
+
+        case 80 ... 84:     // a widget drawn again over the copy it kept, mostly as it was
+            Line = Random(FRAME_LINES);
+            X    = Between(0, LCD_WIDTH - 1);
+            Size = Between(1, LCD_WIDTH - X);
+            pBuffer = gFrameBuffer[Line] + X;
+            memcpy(Pixels, pBuffer, Size);
+            memset(pBuffer, 0, Size);
+            ST7565_HoldDirty(true);
+            for (int i = 0; i < Size; i++)
+                pBuffer[i] = Random(8) ? Pixels[i] : Random(256);
+            ST7565_MarkDirty(pBuffer, Size);
+            ST7565_HoldDirty(false);
+            ST7565_MarkChanged(pBuffer, Pixels, Size);
+            break;
+
+        default:
+            break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+        return 2;
+
+    const long Ops = atol(argv[1]);
+    Seed = strtoull(argv[2], NULL, 0);
+
+    ST7565_FillScreen(0x00);
+
+    long Blits = 0;
+    for (long Op = 0; Op < Ops; Op++)
+    {
+        // the DMA runs alongside the drawing, a transfer per operation
+        PANEL_DmaStep();
+
+        const uint32_t Kind = Random(4);
+        if (Kind) {
+            Draw();
+            continue;
+        }
+
+        const uint32_t Which = Random(1 + FRAME_LINES + 4);
+        if (Which == 0)
+            ST7565_BlitStatusLine();
+        else if (Which <= FRAME_LINES)
+            ST7565_BlitLine(Which - 1);
+        else
+            ST7565_BlitFullScreen();
+        Blits++;
+
+#ifdef ENABLE_LCD_DMA
+        if (PANEL_Busy()) {
+            Due = Op;
+            continue;
+        }
+#endif
+        Image(Op);
+    }
+
+    // the last blit still going out
+    while (Due >= 0)
+        PANEL_DmaStep();
+
+    long long Counted = -1;
+#ifdef ENABLE_LCD_DIRTY_SPANS
+    ST7565_Stats_t Stats;
+    ST7565_GetStats(&Stats);
+    Counted = Stats.BytesSent;
+#endif
+
+    printf("{\"blits\":%ld,\"bytes\":%llu,\"counted\":%lld,\"stray\":%llu,\"transfers\":%llu}\n",
+           Blits, (unsigned long long)Bytes, Counted, (unsigned long long)Stray, (unsigned long long)Transfers);
+    return 0;
+}
+'''
+
+BUILDS = [('full blits', {'ENABLE_LCD_DIRTY_SPANS': False, 'ENABLE_LCD_DMA': False}),
+          ('dirty spans', {'ENABLE_LCD_DIRTY_SPANS': True, 'ENABLE_LCD_DMA': False}),
+          ('dirty spans by DMA', {'ENABLE_LCD_DIRTY_SPANS': True, 'ENABLE_LCD_DMA': True})]
+
+
+def driver(tmp, name):
+    """st7565.c with the SPI and DMA pointed at the panel model."""
+    with open(os.path.join(hostbuild.APP, DRIVER)) as f:
+        text = f.read()
+    text, count = re.subn(WAIT_IDLE[0], WAIT_IDLE[1], text)
+    if count != 1:
+        raise RuntimeError(f"{DRIVER}: WaitIdle not found")
+    path = os.path.join(tmp, f'{name}_st7565.c')
+    with open(path, 'w') as f:
+        f.write(PRELUDE + text + EPILOGUE)
+    return path
+
+
+def build(cc, tmp, preset, index, options):
+    variables = hostbuild.preset_flags(preset)
+    variables.update(options)
+    name = f'spans_{index}'
+    sources = SOURCES + hostbuild.feature_sources(variables, ('font_',)) + [driver(tmp, name)]
+    return hostbuild.build(cc, tmp, HARNESS, sources, variables, name=name)[0]
+
+
+def run(binary, ops, seed):
+    result = subprocess.run([binary, str(ops), str(seed)], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(f"failed ({result.returncode}): {result.stderr.strip()}")
+    *lines, summary = result.stdout.split('\n')[:-1]
+    return [line.split() for line in lines], json.loads(summary)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check that blitting only the dirty spans (ENABLE_LCD_DIRTY_SPANS), '
+                                                 'by DMA or not, leaves the LCD showing what a full blit would.')
+    parser.add_argument('-preset', default='Custom', help='CMakePresets.json preset for the other options (default: %(default)s)')
+    parser.add_argument('-runs', type=int, default=20, help='random drawing sequences (default: %(default)s)')
+    parser.add_argument('-ops', type=int, default=20000, help='operations per sequence (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed of the first sequence (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.runs <= 0 or args.ops <= 0:
+        print("[!] runs and ops must be positive")
+        sys.exit(1)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binaries = [build(args.cc, tmp, args.preset, i, options) for i, (_, options) in enumerate(BUILDS)]
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built {DRIVER} and ui/helper.c {len(BUILDS)} ways, preset {args.preset}")
+
+        totals = [[0, 0, 0] for _ in BUILDS]
+        for seed in range(args.seed, args.seed + args.runs):
+            try:
+                results = [run(binary, args.ops, seed) for binary in binaries]
+            except RuntimeError as e:
+                print(f"[!] Sequence {seed} {e}")
+                sys.exit(1)
+
+            reference, _ = results[0]
+            for (label, _), (images, summary), total in zip(BUILDS, results, totals):
+                if summary['stray']:
+                    print(f"[!] Sequence {seed}, {label}: {summary['stray']} bytes sent without chip select")
+                    sys.exit(1)
+                if summary['counted'] >= 0 and summary['counted'] != summary['bytes']:
+                    print(f"[!] Sequence {seed}, {label}: driver counted {summary['counted']} bytes, "
+                          f"{summary['bytes']} went out")
+                    sys.exit(1)
+                for want, got in zip(reference, images):
+                    if want != got:
+                        print(f"[!] Sequence {seed}, {label}: LCD differs from a full blit after the blit "
+                              f"at operation {got[0]}")
+                        sys.exit(1)
+                if len(images) != len(reference):
+                    print(f"[!] Sequence {seed}, {label}: {len(images)} blits, {len(reference)} expected")
+                    sys.exit(1)
+                total[0] += summary['blits']
+                total[1] += summary['bytes']
+                total[2] += summary['transfers']
+
+    print(f"[*] {args.runs} sequences of {args.ops} operations, {totals[0][0]} blits, "
+          f"LCD matches a full blit after every one")
+    for (label, _), (_, sent, _) in zip(BUILDS, totals):
+        print(f"    {label:<20} {sent:10d} SPI bytes  ({sent / totals[0][1]:6.1%})")
+    # the interrupt waits for the SPI to drain once per DMA transfer
+    transfers = totals[-1][2]
+    print(f"    {transfers} DMA transfers, {transfers / totals[-1][0]:.2f} per blit")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+
+import sys
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+# ST7565_Stats_t (App/driver/st7565.h), then the main loop's drawing time
+# (App/ui/ui.c UI_GetLoad)
+STATS = struct.Struct('<IIIIIB3xI')
+
+# SPI1 runs from the 48 MHz system clock
+SYSCLK = 48000000
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Watch the LCD transfer counters, frame times and UI load (ENABLE_LCD_DIRTY_SPANS, ENABLE_LCD_DMA).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-interval', type=float, default=2.0, help='seconds between reads (default: %(default)s)')
+    parser.add_argument('-count', type=int, default=0, help='reads to take, 0 until interrupted (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.interval < 1:
+        print("[!] interval must be at least a second, the radio averages over that")
+        sys.exit(1)
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    print("    total bytes   bytes/s   frame us    max us   call us  SPI clock   UI us/s")
+    reads = 0
+    try:
+        while not args.count or reads < args.count:
+            send(ser, 0x054A, timestamp)
+            reply = receive(ser, 0x054B)
+            if reply is None:
+                print("[!] No answer from the radio")
+                sys.exit(1)
+
+            # the first read only starts the radio's averaging window
+            sent, rate, frame, frame_max, call, prescaler, ui = STATS.unpack_from(reply)
+            if reads:
+                clock = SYSCLK / (2 << prescaler) / 1000
+                print(f"    {sent:11d} {rate:9d} {frame:10d} {frame_max:9d} {call:9d} {clock:6.0f} kHz {ui:9d}")
+            reads += 1
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
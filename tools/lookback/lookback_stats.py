@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+
+import sys
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+# LookbackStats_t (App/app/lookback.h)
+STATS = struct.Struct('<IIIIII')
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Read the priority lookback counters and audio gaps (ENABLE_PRIORITY_LOOKBACK).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-clear', action='store_true', help='clear the counters after reading them')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    send(ser, 0x0546, timestamp + struct.pack('<B3x', args.clear))
+    reply = receive(ser, 0x0547)
+    if reply is None or len(reply) < STATS.size:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    looks, switches, skipped, last_us, max_us, total_us = STATS.unpack_from(reply)
+
+    print(f"[*] {looks} lookbacks, {switches} switched to a priority channel, {skipped} channels skipped")
+    if looks:
+        print(f"    audio gap  last {last_us / 1000:6.1f} ms  mean {total_us / looks / 1000:6.1f} ms  max {max_us / 1000:6.1f} ms")
+
+
+if __name__ == '__main__':
+    main()
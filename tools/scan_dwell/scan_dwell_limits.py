@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+
+import sys
+import json
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+# Band order of BAND_Type_t (App/frequencies.h), lower edge in MHz
+BANDS = ['50', '108', '137', '174', '350', '400', '470']
+FIELDS = ['rssi_below', 'noise_above', 'glitch_above']
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+def to_json(payload):
+    return {band: dict(zip(FIELDS, payload[i * 3:i * 3 + 3])) for i, band in enumerate(BANDS)}
+
+
+def from_json(limits, current):
+    """Bands missing from limits keep their current values."""
+    data = b''
+    for band in BANDS:
+        merged = dict(current[band])
+        merged.update(limits.get(band, {}))
+        if merged['noise_above'] > 127 or any(not 0 <= merged[k] <= 255 for k in FIELDS):
+            raise ValueError(f"band {band}: limits out of range")
+        data += bytes(merged[k] for k in FIELDS)
+    unknown = set(limits) - set(BANDS)
+    if unknown:
+        raise ValueError(f"unknown bands {sorted(unknown)}")
+    return data + b'\x00'
+
+
+def read(ser, timestamp):
+    send(ser, 0x0554, timestamp)
+    reply = receive(ser, 0x0555)
+    if reply is None or len(reply) < 3 * len(BANDS):
+        print("[!] No answer from the radio")
+        sys.exit(1)
+    return to_json(reply)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Read or write the adaptive scan dwell limits (ENABLE_SCAN_DWELL).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-write', metavar='FILE', help='JSON limits by band to store, printed back afterwards')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    if args.write:
+        try:
+            with open(args.write) as f:
+                payload = from_json(json.load(f), read(ser, timestamp))
+        except (OSError, ValueError, KeyError, TypeError) as e:
+            print(f"[!] {args.write}: {e}")
+            sys.exit(1)
+
+        send(ser, 0x0556, timestamp + payload)
+        reply = receive(ser, 0x0557)
+        if reply is None or not reply[0]:
+            print("[!] Limits rejected by the radio")
+            sys.exit(1)
+        print("[*] Limits stored")
+
+    print(json.dumps(read(ser, timestamp), indent=2))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# app/scandwell.c built for the host and run hop by hop against a model of
+# the BK4819 indicators on a virtual microsecond clock. The model decides
+# what the radio reads, scandwell.c alone decides when a channel is left.
+SOURCES = ['app/scandwell.c', 'frequencies.c']
+
+# Scanner timings (App/app/chFrScanner.c)
+DWELL_MS = 90           # ENABLE_FASTER_CHANNEL_SCAN pause
+HOP_MS = 2              # register writes, main loop latency
+
+# A frequency inside each band, 10 Hz units
+BANDS = {
+    '50':  5100000,
+    '108': 12000000,
+    '137': 14500000,
+    '174': 22000000,
+    '350': 38000000,
+    '400': 43500000,
+    '470': 48000000,
+}
+
+# Squelch open thresholds of a typical level 3 calibration (rssi, noise, glitch)
+SQUELCH_OPEN = (86, 40, 70)
+
+HARNESS = r'''
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/chFrScanner.h"
+#include "app/scandwell.h"
+#include "driver/bk4819.h"
+#include "driver/systick.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+
+static FREQ_Config_t Freq;
+static VFO_Info_t    Vfo = {.pRX = &Freq, .pTX = &Freq};
+VFO_Info_t          *gRxVfo = &Vfo;
+
+static uint32_t Now;            // virtual microseconds
+static uint32_t HopStart;
+static uint64_t Seed = 1;
+
+// channel being dwelled on
+static double Floor, Carrier, LockMs;
+static int    Busy;
+
+static double Uniform(void)
+{
+    Seed = Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return ((Seed >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double Gauss(double Sigma)
+{
+    return Sigma * sqrt(-2 * log(Uniform())) * cos(2 * M_PI * Uniform());
+}
+
+static int Clamp(double v, int Max)
+{
+    return v < 0 ? 0 : (v > Max ? Max : (int)v);
+}
+
+// indicator readings At ms after the hop
+static void Read(double At, int *pRssi, int *pNoise, int *pGlitch)
+{
+    const double Level = (Busy && At >= LockMs && Carrier > Floor) ? Carrier : Floor;
+    const double Snr = Level - Floor;
+
+    *pRssi   = (int)(2 * (Level + 160) + Gauss(3));
+    *pNoise  = Clamp(75 - 4 * Snr + Gauss(6), 127);
+    *pGlitch = Clamp(140 - 8 * Snr + Gauss(15), 255);
+}
+
+static int Reading(int Which)
+{
+    int v[3];
+    Read((Now - HopStart) / 1000.0, &v[0], &v[1], &v[2]);
+    return v[Which];
+}
+
+uint32_t SYSTICK_GetUs(void)               { return Now; }
+uint16_t BK4819_GetRSSI(void)              { return Reading(0); }
+uint8_t  BK4819_GetExNoiceIndicator(void)  { return Reading(1); }
+uint8_t  BK4819_GetGlitchIndicator(void)   { return Reading(2); }
+
+int main(int argc, char *argv[])
+{
+    if (argc < 15)
+        return 2;
+
+    Freq.Frequency     = strtoul(argv[1], NULL, 0);
+    const int Channels = atoi(argv[2]);
+    const int Cycles   = atoi(argv[3]);
+    const double BusyChance = atof(argv[4]);
+    const double FloorDbm = atof(argv[5]);
+    const double Weakest = atof(argv[6]);
+    const double Lock  = atof(argv[7]);
+    Seed               = strtoull(argv[8], NULL, 0);
+    const uint32_t PollUs = strtoul(argv[9], NULL, 0);
+    const int DwellMs  = atoi(argv[10]);
+    const int HopMs    = atoi(argv[11]);
+
+    Vfo.Modulation              = MODULATION_FM;
+    Vfo.SquelchOpenRSSIThresh   = atoi(argv[12]);
+    Vfo.SquelchOpenNoiseThresh  = atoi(argv[13]);
+    Vfo.SquelchOpenGlitchThresh = atoi(argv[14]);
+
+    SCANDWELL_Init();
+
+    // limits for the band under test: rssi,noise,glitch
+    if (argc > 15)
+    {
+        DwellThresholds_t Bands[BAND_N_ELEM];
+        unsigned r, n, g;
+        memcpy(Bands, SCANDWELL_GetThresholds(), sizeof(Bands));
+        if (sscanf(argv[15], "%u,%u,%u", &r, &n, &g) != 3)
+            return 2;
+        const FREQUENCY_Band_t Band = FREQUENCY_GetBand(Freq.Frequency);
+        Bands[Band] = (DwellThresholds_t){r, n, g};
+        if (!SCANDWELL_SetThresholds(Bands))
+        {
+            fprintf(stderr, "limits rejected\n");
+            return 1;
+        }
+    }
+
+    const DwellThresholds_t *t = &SCANDWELL_GetThresholds()[FREQUENCY_GetBand(Freq.Frequency)];
+
+    double FixedMs = 0, AdaptiveMs = 0;
+    long   Opened = 0, Missed = 0, Aborted = 0;
+
+    gScanStateDir    = SCAN_FWD;
+    gCurrentFunction = FUNCTION_FOREGROUND;
+
+    for (int Cycle = 0; Cycle < Cycles; Cycle++)
+    {
+        for (int Channel = 0; Channel < Channels; Channel++)
+        {
+            Floor   = FloorDbm + Gauss(2);
+            Busy    = Uniform() < BusyChance;
+            Carrier = Weakest + Uniform() * (-60 - Weakest);
+            LockMs  = 3 + Uniform() * (Lock - 3);   // PLL and RSSI filter settling
+
+            int r, n, g;
+            Read(DwellMs, &r, &n, &g);
+            const int Opens = r >= Vfo.SquelchOpenRSSIThresh && n <= Vfo.SquelchOpenNoiseThresh &&
+                              g <= Vfo.SquelchOpenGlitchThresh;
+            Opened += Opens;
+
+            FixedMs += HopMs + DwellMs;
+
+            // the scanner hops, then polls until the dwell runs out
+            Now += HopMs * 1000;
+            HopStart = Now;
+            gScheduleScanListen = false;
+            gScanPauseDelayIn_10ms = DwellMs / 10;
+            SCANDWELL_Start();
+
+            while (Now - HopStart < (uint32_t)DwellMs * 1000 && !gScheduleScanListen)
+            {
+                Now += PollUs;
+                SCANDWELL_Poll();
+            }
+
+            if (gScheduleScanListen)
+            {
+                Aborted++;
+                Missed += Opens;
+            }
+            AdaptiveMs += HopMs + (Now - HopStart) / 1000.0;
+        }
+    }
+
+    const long Hops = (long)Cycles * Channels;
+    printf("{\"fixed_cycle_ms\":%.3f,\"adaptive_cycle_ms\":%.3f,\"aborted\":%.6f,\"missed\":%.6f,"
+           "\"limits\":[%u,%u,%u]}\n",
+           FixedMs / Cycles, AdaptiveMs / Cycles, (double)Aborted / Hops,
+           Opened ? (double)Missed / Opened : 0.0, t->RssiBelow, t->NoiseAbove, t->GlitchAbove);
+    return 0;
+}
+'''
+
+
+def parse_limits(text):
+    try:
+        values = [int(v) for v in text.split(',')]
+    except ValueError:
+        values = []
+    if len(values) != 3:
+        raise argparse.ArgumentTypeError(f"limits {text} are not rssi,noise,glitch")
+    return ','.join(map(str, values))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Simulate the adaptive scan dwell (ENABLE_SCAN_DWELL).')
+    parser.add_argument('-band', default='400', choices=BANDS.keys(), help='band to scan (default: %(default)s)')
+    parser.add_argument('-limits', type=parse_limits, help='rssi,noise,glitch limits for the band, stored as '
+                                                           'over UART (default: the firmware ones)')
+    parser.add_argument('-channels', type=int, default=50, help='channels per scan cycle (default: %(default)s)')
+    parser.add_argument('-cycles', type=int, default=2000, help='scan cycles to simulate (default: %(default)s)')
+    parser.add_argument('-busy', type=float, default=0.05, help='chance a channel carries a signal (default: %(default)s)')
+    parser.add_argument('-floor', type=float, default=-125, help='noise floor in dBm (default: %(default)s)')
+    parser.add_argument('-weakest', type=float, default=-120, help='weakest signal in dBm (default: %(default)s)')
+    parser.add_argument('-lock', type=float, default=12, help='worst settling time in ms (default: %(default)s)')
+    parser.add_argument('-poll-us', type=int, default=1000, help='main loop period (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.channels <= 0 or args.cycles <= 0 or args.poll_us <= 0:
+        print("[!] channels, cycles and poll-us must be positive")
+        sys.exit(1)
+
+    variables = hostbuild.preset_flags('Custom')
+    variables['ENABLE_SCAN_DWELL'] = True
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary, _ = hostbuild.build(args.cc, tmp, HARNESS, SOURCES, variables, name='scan_dwell_sim')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+
+        model = [BANDS[args.band], args.channels, args.cycles, args.busy, args.floor, args.weakest, args.lock,
+                 args.seed, args.poll_us, DWELL_MS, HOP_MS, *SQUELCH_OPEN]
+        if args.limits:
+            model.append(args.limits)
+        run = subprocess.run([binary, *map(str, model)], capture_output=True, text=True)
+
+    if run.returncode:
+        print(f"[!] Simulation failed ({run.returncode}): {run.stderr.strip()}")
+        sys.exit(1)
+
+    r = json.loads(run.stdout)
+
+    print(f"[*] band {args.band} MHz, limits {'/'.join(map(str, r['limits']))}, "
+          f"{args.channels} channels, {args.busy:.0%} busy")
+    print(f"    cycle time fixed    {r['fixed_cycle_ms']:8.1f} ms")
+    print(f"    cycle time adaptive {r['adaptive_cycle_ms']:8.1f} ms  ({r['fixed_cycle_ms'] / r['adaptive_cycle_ms']:.1f}x)")
+    print(f"    channels left early {r['aborted']:8.1%}")
+    print(f"    missed signals      {r['missed']:8.2%}")
+
+
+if __name__ == '__main__':
+    main()
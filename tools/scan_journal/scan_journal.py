@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+
+import sys
+import csv
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+# Firmware layout (App/app/scanjournal.h, App/misc.h)
+MR_CHANNEL_LAST = 199
+NO_CODE = 0xFF
+
+# CODE_TYPE_* and the tables they index (App/dcs.h, App/dcs.c)
+CTCSS = [
+     670,  693,  719,  744,  770,  797,  825,  854,  885,  915,
+     948,  974, 1000, 1035, 1072, 1109, 1148, 1188, 1230, 1273,
+    1318, 1365, 1413, 1462, 1514, 1567, 1598, 1622, 1655, 1679,
+    1713, 1738, 1773, 1799, 1835, 1862, 1899, 1928, 1966, 1995,
+    2035, 2065, 2107, 2181, 2257, 2291, 2336, 2418, 2503, 2541,
+]
+
+DCS = [
+    0x0013, 0x0015, 0x0016, 0x0019, 0x001A, 0x001E, 0x0023, 0x0027,
+    0x0029, 0x002B, 0x002C, 0x0035, 0x0039, 0x003A, 0x003B, 0x003C,
+    0x004C, 0x004D, 0x004E, 0x0052, 0x0055, 0x0059, 0x005A, 0x005C,
+    0x0063, 0x0065, 0x006A, 0x006D, 0x006E, 0x0072, 0x0075, 0x007A,
+    0x007C, 0x0085, 0x008A, 0x0093, 0x0095, 0x0096, 0x00A3, 0x00A4,
+    0x00A5, 0x00A6, 0x00A9, 0x00AA, 0x00AD, 0x00B1, 0x00B3, 0x00B5,
+    0x00B6, 0x00B9, 0x00BC, 0x00C6, 0x00C9, 0x00CD, 0x00D5, 0x00D9,
+    0x00DA, 0x00E3, 0x00E6, 0x00E9, 0x00EE, 0x00F4, 0x00F5, 0x00F9,
+    0x0109, 0x010A, 0x010B, 0x0113, 0x0119, 0x011A, 0x0125, 0x0126,
+    0x012A, 0x012C, 0x012D, 0x0132, 0x0134, 0x0135, 0x0136, 0x0143,
+    0x0146, 0x014E, 0x0153, 0x0156, 0x015A, 0x0166, 0x0175, 0x0186,
+    0x018A, 0x0194, 0x0197, 0x0199, 0x019A, 0x01AC, 0x01B2, 0x01B4,
+    0x01C3, 0x01CA, 0x01D3, 0x01D9, 0x01DA, 0x01DC, 0x01E3, 0x01EC,
+]
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+ENTRY = struct.Struct('<IIHBBBxBB')
+
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+def code_string(code_type, code):
+    if code_type == 1 and code < len(CTCSS):
+        return f"{CTCSS[code] / 10:.1f}"
+    if code_type in (2, 3) and code < len(DCS):
+        return f"D{DCS[code]:03o}{'N' if code_type == 2 else 'I'}"
+    return ''
+
+
+def key_string(key):
+    if key <= MR_CHANNEL_LAST:
+        return f"CH-{key + 1:03d}"
+    return f"{key / 100000:.5f}"
+
+
+def read_journal(ser, timestamp):
+    """All entries, newest first, 8 per request."""
+    entries = []
+    clock = 0
+    index = 0
+    while True:
+        send(ser, 0x0548, timestamp + struct.pack('<HBx', index, False))
+        reply = receive(ser, 0x0549)
+        if reply is None:
+            return None, None
+        clock, count, _ = struct.unpack_from('<IHH', reply)
+        page = (len(reply) - 8) // ENTRY.size
+        for i in range(page):
+            entries.append(ENTRY.unpack_from(reply, 8 + i * ENTRY.size))
+        index += page
+        if page == 0 or index >= count:
+            return clock, entries
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Download the scan journal (ENABLE_SCAN_JOURNAL), newest first.')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-csv', metavar='FILE', help='write the entries to a CSV file as well')
+    parser.add_argument('-clear', action='store_true', help='clear the journal once it has been read')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    clock, entries = read_journal(ser, timestamp)
+    if clock is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    # the journal clock counts seconds the radio has been on, so ages are
+    # only wall clock time for entries since the last power on
+    rows = []
+    for stamp, key, duration, rssi, code_type, code, tag, _ in entries:
+        if not tag:
+            continue
+        rows.append({
+            'age_s': clock - stamp,
+            'channel': key_string(key),
+            'duration_s': duration,
+            'rssi_dbm': rssi - 160,
+            'code': code_string(code_type, code) if code_type != NO_CODE else '',
+        })
+
+    print(f"[*] {len(rows)} entries, journal clock {clock} s")
+    print("      age  channel      time   rssi  code")
+    for r in rows:
+        print(f"    {r['age_s']:5d}  {r['channel']:<11} {r['duration_s']:5d}s {r['rssi_dbm']:4d}  {r['code']}")
+
+    if args.csv:
+        try:
+            with open(args.csv, 'w', newline='') as f:
+                writer = csv.DictWriter(f, fieldnames=['age_s', 'channel', 'duration_s', 'rssi_dbm', 'code'])
+                writer.writeheader()
+                writer.writerows(rows)
+        except OSError as e:
+            print(f"[!] {args.csv}: {e}")
+            sys.exit(1)
+
+    if args.clear:
+        send(ser, 0x0548, timestamp + struct.pack('<HBx', 0, True))
+        if receive(ser, 0x0549) is None:
+            print("[!] Journal not cleared")
+            sys.exit(1)
+        print("[*] Journal cleared")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# app/scanplan.c against the memory channel walk it replaced. The old
+# NextMemChannel and the radio.c helpers it used are taken from the baseline
+# commit and built next to the current scanplan.c and radio.c, both walks
+# run in lockstep over random channel attributes, scan lists, exclusions
+# and priority channels, with exclusions changing halfway through a scan.
+BASELINE = 'f436e67'
+SOURCES = ['app/scanplan.c', 'radio.c']
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "app/chFrScanner.h"
+#include "app/scanplan.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+
+void        Base_Start(uint8_t Channel);
+static void Base_NextMemChannel(void);
+
+static uint32_t Seed;
+
+static uint32_t Random(uint32_t n)
+{
+    Seed = Seed * 1103515245 + 12345;
+    return (Seed >> 8) % n;
+}
+
+static void Randomize(void)
+{
+    // from an empty list to all channels, a quarter of them out of band
+    const uint32_t Density = Random(101);
+
+    for (unsigned i = 0; i < 207; i++)
+    {
+        gMR_ChannelAttributes[i].__val = Random(256);
+        if (Random(100) >= Density)
+            gMR_ChannelAttributes[i].band = 7;
+        gMR_ChannelExclude[i] = Random(8) == 0;
+    }
+
+    gEeprom.SCAN_LIST_DEFAULT = Random(6);
+    for (unsigned i = 0; i < 3; i++)
+    {
+        gEeprom.SCAN_LIST_ENABLED[i] = Random(4) != 0;
+        gEeprom.SCANLIST_PRIORITY_CH1[i] = Random(3) ? Random(200) : 0xFF;
+        gEeprom.SCANLIST_PRIORITY_CH2[i] = Random(3) ? Random(200) : 0xFF;
+    }
+}
+
+static void Describe(unsigned Trial, uint8_t Start, int8_t Dir)
+{
+    const uint8_t List = gEeprom.SCAN_LIST_DEFAULT;
+    fprintf(stderr, "trial %u: list %u start %u dir %d", Trial, List, Start, Dir);
+    if (List > 0 && List < 4)
+        fprintf(stderr, " enabled %u prio %u %u", gEeprom.SCAN_LIST_ENABLED[List - 1],
+                gEeprom.SCANLIST_PRIORITY_CH1[List - 1], gEeprom.SCANLIST_PRIORITY_CH2[List - 1]);
+    fprintf(stderr, "\n");
+}
+
+static int Compare(unsigned Trials, unsigned Hops)
+{
+    unsigned long long Total = 0;
+
+    for (unsigned Trial = 0; Trial < Trials; Trial++)
+    {
+        Randomize();
+        const uint8_t Start = Random(200);
+        const int8_t  Dir = Random(2) ? 1 : -1;
+        const unsigned Change = Random(Hops);
+
+        gScanStateDir = Dir;
+        Base_Start(Start);
+        SCANPLAN_Reset(Start);
+
+        for (unsigned Hop = 0; Hop < Hops; Hop++)
+        {
+            if (Hop == Change)
+            {   // the exclude key in the middle of a scan
+                const unsigned Channel = Random(200);
+                gMR_ChannelExclude[Channel] = !gMR_ChannelExclude[Channel];
+                SCANPLAN_Invalidate();
+            }
+
+            Base_NextMemChannel();
+            const uint8_t Want = gNextMrChannel;
+            const uint8_t Got = SCANPLAN_Next(Dir);
+            if (Got != Want)
+            {
+                Describe(Trial, Start, Dir);
+                fprintf(stderr, "hop %u: plan %u, old walk %u\n", Hop, Got, Want);
+                return 1;
+            }
+        }
+        Total += Hops;
+    }
+
+    printf("{\"trials\":%u,\"hops\":%llu}\n", Trials, Total);
+    return 0;
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// one scan list holding Members channels spread over the memory,
+// both priority channels set
+static void Setup(unsigned Members)
+{
+    memset(gMR_ChannelExclude, 0, sizeof(gMR_ChannelExclude));
+    for (unsigned i = 0; i < 207; i++)
+    {
+        gMR_ChannelAttributes[i].__val = 0;
+        gMR_ChannelAttributes[i].scanlist1 = Members && i < 200 && i % (200 / Members) == 0;
+    }
+    gEeprom.SCAN_LIST_DEFAULT = 1;
+    gEeprom.SCAN_LIST_ENABLED[0] = true;
+    gEeprom.SCANLIST_PRIORITY_CH1[0] = 3;
+    gEeprom.SCANLIST_PRIORITY_CH2[0] = 7;
+}
+
+static void Time(unsigned Members, unsigned Hops)
+{
+    Setup(Members);
+    gScanStateDir = 1;
+
+    Base_Start(0);
+    double t = Now();
+    for (unsigned i = 0; i < Hops; i++)
+        Base_NextMemChannel();
+    const double Old = (Now() - t) / Hops;
+
+    SCANPLAN_Reset(0);
+    t = Now();
+    for (unsigned i = 0; i < Hops; i++)
+        SCANPLAN_Next(1);
+    const double New = (Now() - t) / Hops;
+
+    t = Now();
+    for (unsigned i = 0; i < Hops / 100; i++)
+    {
+        SCANPLAN_Invalidate();
+        SCANPLAN_Next(1);
+    }
+    const double Rebuild = (Now() - t) / (Hops / 100);
+
+    printf("{\"members\":%u,\"old_ns\":%.1f,\"plan_ns\":%.1f,\"rebuild_ns\":%.1f}\n", Members, Old, New, Rebuild);
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned Trials = argc > 1 ? strtoul(argv[1], NULL, 0) : 20000;
+    Seed = argc > 2 ? strtoul(argv[2], NULL, 0) : 1;
+    const unsigned Hops = argc > 3 ? strtoul(argv[3], NULL, 0) : 1000000;
+
+    if (Compare(Trials, 3 * 203))
+        return 1;
+
+    if (Hops)
+    {
+        const unsigned Members[] = {1, 5, 20, 50, 100, 200};
+        for (unsigned i = 0; i < sizeof(Members) / sizeof(Members[0]); i++)
+            Time(Members[i], Hops);
+    }
+    return 0;
+}
+
+// the baseline walk, its channel configuration left out
+#define RADIO_CheckValidChannel     Base_CheckValidChannel
+#define RADIO_FindNextChannel       Base_FindNextChannel
+#define RADIO_ConfigureChannel(...) ((void)0)
+#define RADIO_SetupRegisters(...)   ((void)0)
+#define NextMemChannel              Base_NextMemChannel
+'''
+
+
+def function(text, signature):
+    """The function starting with signature, up to its closing brace."""
+    m = re.search(r'^' + re.escape(signature) + r'.*?^}\n', text, flags=re.S | re.M)
+    if not m:
+        raise RuntimeError(f"{signature} not found in {BASELINE}")
+    return m.group(0)
+
+
+def baseline():
+    def show(path):
+        return subprocess.run(['git', '-C', hostbuild.ROOT, 'show', f'{BASELINE}:{path}'],
+                              capture_output=True, text=True, check=True).stdout
+
+    radio, scanner = show('App/radio.c'), show('App/app/chFrScanner.c')
+    enum = re.search(r'typedef enum \{\s*SCAN_NEXT_CHAN_SCANLIST1.*?\} scan_next_chan_t;', scanner, flags=re.S)
+    code = '\n'.join([
+        function(radio, 'bool RADIO_CheckValidChannel('),
+        function(radio, 'uint8_t RADIO_FindNextChannel('),
+        enum.group(0),
+        'static scan_next_chan_t currentScanList;',
+        function(scanner, 'static void NextMemChannel(void)\n{'),
+        'void Base_Start(uint8_t Channel)\n{\n    gNextMrChannel = Channel;\n'
+        '    currentScanList = SCAN_NEXT_CHAN_SCANLIST1;\n}\n',
+    ])
+    return code.replace('[[fallthrough]]', '__attribute__((fallthrough))')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check the scan plan (ENABLE_SCAN_PLAN) against the memory '
+                                                 'channel walk it replaced, and time both.')
+    parser.add_argument('-preset', default='Custom', help='CMake preset for the feature flags (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('-trials', type=int, default=20000, help='random configurations (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('-hops', type=int, default=1000000, help='hops timed per list size, 0 skips (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    variables = hostbuild.preset_flags(args.preset)
+    variables['ENABLE_SCAN_PLAN'] = True
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary, stubbed = hostbuild.build(args.cc, tmp, HARNESS + baseline(), SOURCES, variables,
+                                              name='scan_plan_check')
+        except (RuntimeError, subprocess.CalledProcessError) as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built app/scanplan.c and the {BASELINE} walk, {stubbed} symbols stubbed")
+
+        run = subprocess.run([binary, str(args.trials), str(args.seed), str(args.hops)],
+                             capture_output=True, text=True)
+
+    if run.returncode:
+        print(f"[!] Orders differ\n{run.stderr.strip()}")
+        sys.exit(1)
+
+    lines = run.stdout.splitlines()
+    print(f"[*] Same order in {args.trials} configurations, {lines[0]}")
+    if args.hops:
+        print(f"{'members':>7} {'old ns':>8} {'plan ns':>8} {'rebuild ns':>10}")
+        for line in lines[1:]:
+            r = dict(re.findall(r'"(\w+)":([\d.]+)', line))
+            print(f"{r['members']:>7} {float(r['old_ns']):>8.1f} {float(r['plan_ns']):>8.1f} {float(r['rebuild_ns']):>10.1f}")
+        print("[*] Host timings, the ratio is what carries over to the radio")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+
+import sys
+import json
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+# Firmware limits (App/app/scanranges.h)
+SCAN_RANGES_MAX = 8
+
+# BYP and RAW only with ENABLE_BYP_RAW_DEMODULATORS
+MODULATIONS = ['FM', 'AM', 'USB', 'BYP', 'RAW']
+BANDWIDTHS = ['wide', 'narrow']
+
+# STEP_Setting_t order, kHz (App/frequencies.c gStepFrequencyTable)
+STEPS = [2.5, 5, 6.25, 10, 12.5, 25, 8.33, 0.01, 0.05, 0.1, 0.25, 0.5, 1, 1.25,
+         9, 15, 20, 30, 50, 100, 125, 200, 250, 500]
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+RANGE = struct.Struct('<IIBBBB')
+
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+def parse_step(khz):
+    for i, s in enumerate(STEPS):
+        if abs(s - khz) < 1e-6:
+            return i
+    raise ValueError(f"unsupported step {khz} kHz")
+
+
+def to_json(payload):
+    count = payload[0]
+    ranges = []
+    for i in range(count):
+        start, stop, step, mod, bw, weight = RANGE.unpack_from(payload, 4 + i * RANGE.size)
+        ranges.append({
+            'start_mhz': start / 100000,
+            'stop_mhz': stop / 100000,
+            'step_khz': STEPS[step],
+            'modulation': MODULATIONS[mod] if mod < len(MODULATIONS) else mod,
+            'bandwidth': BANDWIDTHS[bw],
+            'weight': weight,
+        })
+    return ranges
+
+
+def from_json(ranges):
+    if len(ranges) > SCAN_RANGES_MAX:
+        raise ValueError(f"at most {SCAN_RANGES_MAX} ranges")
+    data = b''
+    for r in ranges:
+        data += RANGE.pack(round(r['start_mhz'] * 100000),
+                           round(r['stop_mhz'] * 100000),
+                           parse_step(r.get('step_khz', 12.5)),
+                           MODULATIONS.index(r.get('modulation', 'FM')),
+                           BANDWIDTHS.index(r.get('bandwidth', 'wide')),
+                           r.get('weight', 1))
+    return struct.pack('<B3x', len(ranges)) + data
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Read or write the stored scan ranges (ENABLE_MULTI_SCAN_RANGES).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-write', metavar='FILE', help='JSON list of ranges to store, printed back afterwards')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    if args.write:
+        try:
+            with open(args.write) as f:
+                payload = from_json(json.load(f))
+        except (OSError, ValueError, KeyError) as e:
+            print(f"[!] {args.write}: {e}")
+            sys.exit(1)
+
+        send(ser, 0x0542, timestamp + payload)
+        reply = receive(ser, 0x0543)
+        if reply is None or not reply[0]:
+            print("[!] Ranges rejected by the radio")
+            sys.exit(1)
+        print(f"[*] {reply[1]} ranges stored")
+
+    send(ser, 0x0540, timestamp)
+    reply = receive(ser, 0x0541)
+    if reply is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    print(json.dumps(to_json(reply), indent=2))
+
+
+if __name__ == '__main__':
+    main()
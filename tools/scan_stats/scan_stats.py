@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+import sys
+import csv
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+# Firmware layout (App/app/scanstats.h)
+MR_CHANNEL_LAST = 199
+ENTRY = struct.Struct('<IIIHBx')
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+def fetch_page(ser, timestamp, index, clear=False):
+    send(ser, 0x0544, timestamp + struct.pack('<BB2x', index, clear))
+    reply = receive(ser, 0x0545)
+    if reply is None:
+        return None
+    clock, count = struct.unpack_from('<IB3x', reply)
+    entries = [ENTRY.unpack_from(reply, 8 + i * ENTRY.size) for i in range((len(reply) - 8) // ENTRY.size)]
+    return clock, count, entries
+
+
+def name(key):
+    if key <= MR_CHANNEL_LAST:
+        return f"CH-{key + 1:03}"
+    return f"{key / 100000:.4f}"
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Dump the channel activity statistics (ENABLE_SCAN_STATS).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-csv', metavar='FILE', help='also write the table as CSV')
+    parser.add_argument('-clear', action='store_true', help='clear the statistics after reading them')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    rows = []
+    clock = count = 0
+    while True:
+        page = fetch_page(ser, timestamp, len(rows))
+        if page is None:
+            print("[!] No answer from the radio")
+            sys.exit(1)
+        clock, count, entries = page
+        rows += entries
+        if not entries or len(rows) >= count:
+            break
+
+    if args.clear:
+        fetch_page(ser, timestamp, 0, clear=True)
+
+    rows.sort(key=lambda r: (r[3], r[2]), reverse=True)
+
+    print(f"[*] {len(rows)} entries, recorder clock {clock // 3600}h{clock // 60 % 60:02}m")
+    print(f"{'channel':>9} {'hits':>6} {'open s':>8} {'peak dBm':>8} {'last heard':>10}")
+    table = []
+    for key, last, open_time, hits, peak in rows:
+        table.append([name(key), hits, open_time / 2, peak - 160, clock - last])
+        print(f"{table[-1][0]:>9} {hits:>6} {open_time / 2:>8.1f} {peak - 160:>8} {clock - last:>8} s")
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            w = csv.writer(f)
+            w.writerow(['channel', 'hits', 'open_s', 'peak_dbm', 'last_heard_s_ago'])
+            w.writerows(table)
+        print(f"[*] Written to {args.csv}")
+
+
+if __name__ == '__main__':
+    main()
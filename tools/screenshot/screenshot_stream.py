@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import struct
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# Screenshot encoder under test (App/screenshot.c, ENABLE_SCREENSHOT_USB)
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+SOURCE = os.path.join(APP, 'screenshot.c')
+DEFINES = ['-DPY32F071x8', '-DUSE_FULL_LL_DRIVER', '-DPRINTF_INCLUDE_CONFIG_H',
+           '-DENABLE_UART', '-DENABLE_USB', '-DENABLE_FEAT_N7SIX', '-DENABLE_FEAT_N7SIX_SCREENSHOT', '-DENABLE_SCREENSHOT_USB']
+INCLUDES = ['App', 'App/usb', 'Core/Inc', 'Drivers/CMSIS/Include', 'Drivers/CMSIS/Device/PY32F071/Include',
+            'Drivers/PY32F071_HAL_Driver/Inc']
+
+UART_BAUDRATE = 38400
+USB_PACKET = 64         # full speed bulk, one packet per 1 ms frame at worst
+
+# The harness plays a UI on the 10 ms time slice the way APP_TimeSlice10ms
+# calls getScreenShot, and a viewer that asks for the next frames once it
+# has read one. Every frame the endpoint takes is written out with the
+# buffers it was built from: u32 tick, status line, frame buffer, u16 size.
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/st7565.h"
+#include "screenshot.h"
+
+uint8_t gStatusLine[LCD_WIDTH];
+uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+volatile uint8_t  gUART_LockScreenshot;
+volatile uint32_t gGlobalSysTickCounter;
+
+static FILE    *Out;
+static uint32_t Busy;           // ticks the IN endpoint stays busy
+static uint32_t UartBytes;
+
+void UART_Send(const void *pBuffer, uint32_t Size) { (void)pBuffer; UartBytes += Size; }
+bool UART_IsCableConnected(void) { return true; }
+
+bool cdc_acm_dtr_asserted(void) { return true; }
+bool cdc_acm_tx_ready(void) { return Busy == 0; }
+void cdc_acm_data_send_with_dtr(const uint8_t *buf, uint32_t size) { (void)buf; (void)size; }
+void cdc_acm_data_send_with_dtr_async(const uint8_t *buf, uint32_t size) { (void)buf; (void)size; }
+
+bool cdc_acm_data_send_with_dtr_try(const uint8_t *buf, uint32_t size)
+{
+    if (Busy)
+        return false;
+    Busy = 1;
+
+    const uint32_t tick = gGlobalSysTickCounter;
+    const uint16_t len = size;
+    fwrite(&tick, sizeof(tick), 1, Out);
+    fwrite(gStatusLine, sizeof(gStatusLine), 1, Out);
+    fwrite(gFrameBuffer, sizeof(gFrameBuffer), 1, Out);
+    fwrite(&len, sizeof(len), 1, Out);
+    fwrite(buf, size, 1, Out);
+    return true;
+}
+
+static uint32_t Seed;
+
+static uint32_t Random(uint32_t n)
+{
+    Seed = Seed * 1103515245u + 12345u;
+    return (Seed >> 8) % n;
+}
+
+// Glyph-like columns: a few lit pixels, gaps between the characters
+static void Text(uint8_t *p, uint8_t Columns)
+{
+    for (uint8_t i = 0; i < Columns; i++)
+        p[i] = (i % 6 == 5) ? 0 : (uint8_t)Random(256) & 0x7E;
+}
+
+static bool Ui(uint32_t Tick, bool Noise)
+{
+    bool changed = false;
+
+    if (Tick % 300 == 0) {      // another screen
+        memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+        for (uint8_t line = 0; line < FRAME_LINES; line++)
+            if (Random(3))
+                Text(&gFrameBuffer[line][Random(40)], 60 + Random(28));
+        changed = true;
+    }
+    if (Noise && Tick % 100 == 50) {
+        for (uint8_t *p = &gFrameBuffer[0][0]; p < &gFrameBuffer[0][0] + sizeof(gFrameBuffer); p++)
+            *p = Random(256);
+        changed = true;
+    }
+    if (Tick % 50 == 0) {       // frequency digits
+        Text(&gFrameBuffer[1][20], 90);
+        Text(&gFrameBuffer[2][20], 90);
+        changed = true;
+    }
+    if (Tick % 5 == 0) {        // status icons
+        Text(&gStatusLine[100], 6);
+        changed = true;
+    }
+    if (Tick % 3 == 0) {        // RSSI bar
+        const uint8_t length = Random(100);
+        memset(&gFrameBuffer[5][10], 0, 110);
+        memset(&gFrameBuffer[5][10], 0x3C, length);
+        changed = true;
+    }
+    return changed;
+}
+
+int main(int argc, char **argv)
+{
+    const uint32_t Ticks    = strtoul(argv[1], NULL, 0);
+    const uint8_t  Interval = strtoul(argv[2], NULL, 0);
+    const uint8_t  Credits  = strtoul(argv[3], NULL, 0);
+    const uint32_t Latency  = strtoul(argv[4], NULL, 0);
+    const bool     Noise    = strtoul(argv[5], NULL, 0);
+    Seed = strtoul(argv[6], NULL, 0);
+    Out = fopen(argv[7], "wb");
+    if (!Out)
+        return 1;
+
+    uint32_t grantAt = 0;
+    uint32_t frames = 0;
+    bool     first = true;
+
+    // The tail lets the last changes drain with the screen standing still
+    for (uint32_t tick = 0; tick < Ticks + 200; tick++) {
+        gGlobalSysTickCounter = tick;
+        if (Busy)
+            Busy--;
+
+        if (tick == grantAt) {
+            SCREENSHOT_SetPacing(Interval, Credits, first);
+            first = false;
+        }
+
+        const bool changed = tick < Ticks && Ui(tick, Noise);
+        const long before = ftell(Out);
+        if (changed || SCREENSHOT_IsPending())
+            getScreenShot(false);
+
+        if (ftell(Out) != before) {
+            frames++;
+            grantAt = tick + Latency;   // the viewer reads it and asks again
+        }
+    }
+
+    fclose(Out);
+    printf("%u %u\n", frames, UartBytes);
+    return 0;
+}
+'''
+
+
+def unpack_rle(payload):
+    """Blocks of a run length coded frame as (index, 8 bytes), None if damaged.
+    Same decoder as tools/k5viewer/k5viewer.py."""
+    check = 0
+    for b in payload:
+        check ^= b
+    if len(payload) < 2 or check != 0:
+        return None
+
+    blocks = []
+    i = 1
+    end = len(payload) - 1
+    while i < end:
+        if i + 2 > end:
+            return None
+        first, count = payload[i], payload[i + 1]
+        i += 2
+        data = bytearray()
+        while len(data) < count * 8:
+            if i >= end:
+                return None
+            control = payload[i]
+            if control < 0x80:
+                data += payload[i + 1:i + 2 + control]
+                i += 2 + control
+            else:
+                data += payload[i + 1:i + 2] * ((control & 0x7F) + 3)
+                i += 2
+        if len(data) != count * 8 or first + count > 128:
+            return None
+        blocks += [(first + n, bytes(data[n * 8:n * 8 + 8])) for n in range(count)]
+    return blocks
+
+
+def transpose(lines):
+    """The 1024 byte screenshot image of the LCD pages, as getScreenShot builds it."""
+    image = bytearray()
+    for page in lines:
+        for b in range(8):
+            for i in range(0, 128, 8):
+                image.append(sum(((page[i + k] >> b) & 1) << k for k in range(8)))
+    return image
+
+
+def build(cc, tmp):
+    harness = os.path.join(tmp, 'harness.c')
+    with open(harness, 'w') as f:
+        f.write(HARNESS)
+    binary = os.path.join(tmp, 'stream')
+    flags = ['-std=gnu11', '-O1', '-g', '-fsanitize=address,undefined', '-w', *DEFINES,
+             *[f'-I{os.path.join(ROOT, i)}' for i in INCLUDES]]
+    result = subprocess.run([cc, *flags, harness, SOURCE, '-o', binary], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    return binary
+
+
+def check(path):
+    screen = bytearray(1024)
+    frames = []
+    errors = []
+    seq = None
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    pos = 0
+    while pos < len(data):
+        tick = struct.unpack_from('<I', data, pos)[0]
+        lines = [data[pos + 4 + n * 128:pos + 4 + (n + 1) * 128] for n in range(8)]
+        size = struct.unpack_from('<H', data, pos + 4 + 1024)[0]
+        frame = data[pos + 4 + 1024 + 2:pos + 4 + 1024 + 2 + size]
+        pos += 4 + 1024 + 2 + size
+
+        if frame[:3] != b'\xAA\x55\x04' or frame[-1] != 0x0A or int.from_bytes(frame[3:5], 'big') != size - 6:
+            errors.append(f"tick {tick}: bad framing")
+            continue
+        payload = frame[5:-1]
+        if seq is not None and payload[0] != (seq + 1) & 0xFF:
+            errors.append(f"tick {tick}: sequence {payload[0]} after {seq}")
+        seq = payload[0]
+
+        blocks = unpack_rle(payload)
+        if blocks is None:
+            errors.append(f"tick {tick}: frame does not decode")
+            continue
+
+        image = transpose(lines)
+        for index, block in blocks:
+            if block != image[index * 8:index * 8 + 8]:
+                errors.append(f"tick {tick}: block {index} is not what was on screen")
+            screen[index * 8:index * 8 + 8] = block
+        frames.append((tick, size, len(blocks), image))
+
+    if frames and screen != frames[-1][3]:
+        errors.append("the viewer does not end up with the last screen")
+    return frames, errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Stream screenshots over a simulated USB CDC port and check what the viewer decodes.')
+    parser.add_argument('-seconds', type=float, default=60, help='UI time simulated (default: %(default)s)')
+    parser.add_argument('-fps', type=float, default=25, help='frame rate the viewer asks for (default: %(default)s)')
+    parser.add_argument('-credits', type=int, default=4, help='frames granted per request (default: %(default)s)')
+    parser.add_argument('-latency', type=int, default=1, help='10 ms ticks until the viewer asks again (default: %(default)s)')
+    parser.add_argument('-noise', action='store_true', help='fill the screen with noise now and then, worst case for the RLE')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('-cc', default='cc', help='host C compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.seconds <= 0 or args.fps <= 0 or not 1 <= args.credits <= 255 or args.latency < 1:
+        print("[!] seconds and fps must be positive, credits 1..255 and latency at least 1")
+        sys.exit(1)
+
+    ticks = int(args.seconds * 100)
+    interval = min(255, max(1, round(100 / args.fps)))
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary = build(args.cc, tmp)
+        except RuntimeError as e:
+            print(f"[!] build failed\n{e}")
+            sys.exit(1)
+        out = os.path.join(tmp, 'frames.bin')
+        result = subprocess.run([binary, str(ticks), str(interval), str(args.credits), str(args.latency),
+                                 str(int(args.noise)), str(args.seed), out], capture_output=True, text=True)
+        if result.returncode:
+            print(f"[!] harness failed\n{result.stderr}")
+            sys.exit(1)
+        uart_bytes = int(result.stdout.split()[1])
+        frames, errors = check(out)
+
+    for e in errors[:10]:
+        print(f"[!] {e}")
+    live = [f for f in frames if f[0] < ticks]
+    if not live:
+        print("[!] no frames decoded")
+        sys.exit(1)
+
+    sizes = [f[1] for f in live]
+    blocks = sum(f[2] for f in live)
+    raw = blocks * 9 + 6 * len(live)    # the same blocks as UART delta frames
+    fps = len(live) / args.seconds
+    print(f"[*] {len(frames)} frames, {fps:.1f} fps asked {args.fps:g} (interval {interval * 10} ms)")
+    print(f"    {sum(sizes) / len(sizes):.0f} bytes per frame on average, {max(sizes)} at most, "
+          f"{-(-max(sizes) // USB_PACKET)} USB packets")
+    print(f"    {sum(sizes)} bytes against {raw} as UART delta frames, {raw / sum(sizes):.1f}x smaller")
+    print(f"    {sum(sizes) / args.seconds / 1000:.1f} kB/s, the UART at {UART_BAUDRATE} baud would take "
+          f"{raw * 10 / UART_BAUDRATE / args.seconds:.0%} of the time")
+    if uart_bytes:
+        errors.append(f"{uart_bytes} bytes went to the UART with DTR up")
+        print(f"[!] {errors[-1]}")
+    if errors:
+        print(f"[!] {len(errors)} errors")
+        sys.exit(1)
+    print("[*] every block decoded to what was on screen")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+
+import sys
+import json
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 5
+
+# stepsCount values walked by the firmware (STEPS_128 .. STEPS_16)
+STEPS_COUNT_N = 4
+SCAN_STEP_N = 15
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Collect spectrum benchmark results (ENABLE_SPECTRUM_BENCH).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-out', default='spectrum_bench.jsonl', help='JSON lines output (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=TIMEOUT)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    print("[*] Open the spectrum analyzer on the radio, the run starts by itself")
+    print(f"{'steps':>5} {'step':>4} {'bins':>4} {'sweep/s':>8} {'tune':>6} {'settle':>6} {'meas':>6} {'render':>7}")
+
+    expected = STEPS_COUNT_N * SCAN_STEP_N
+    results = []
+    with open(args.out, 'a') as f:
+        while len(results) < expected:
+            line = ser.readline()
+            if not line:
+                continue
+            try:
+                r = json.loads(line.decode('ascii', 'ignore'))
+            except ValueError:
+                continue
+            if r.get('bench') != 'spectrum':
+                continue
+
+            results.append(r)
+            f.write(json.dumps(r) + '\n')
+            f.flush()
+
+            rate = 1e6 / r['sweep_us'] if r['sweep_us'] else 0
+            print(f"{128 >> r['steps_count']:>5} {r['scan_step']:>4} {r['bins']:>4} {rate:>8.2f} "
+                  f"{r['tune_us']:>6} {r['settle_us']:>6} {r['measure_us']:>6} {r['render_us']:>7}")
+
+    print(f"[*] {len(results)} results appended to {args.out}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,314 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# app/spectrum.c and the benchmark built for the host and run against a
+# BK4819 register model on a virtual microsecond clock. Every register
+# access costs a fixed latency, the glitch indicator in REG_63 reads 255
+# until the settle time after a REG_30 write has passed, and RSSI comes
+# from a noise floor with carriers on top. The display blits cost a fixed
+# time each, the screens themselves are drawn into the real frame buffer.
+SOURCES = ['app/spectrum.c', 'app/spectrum_bench.c', 'helper/format.c', 'ui/helper.c', 'font.c',
+           'external/printf/printf.c', 'version.c', 'frequencies.c', 'bitmaps.c']
+
+# stepsCount / scanStepIndex pairs walked by the benchmark
+STEPS_COUNT_N = 4
+SCAN_STEP_N = 15
+
+# The register model, the clock and the GPIO ports, shared with the tools
+# that run the spectrum for its screens. The harness adds the blits, the
+# keyboard and main(), ModelStart reads the model from the command line.
+MODEL = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "app/spectrum.h"
+#include "app/spectrum_bench.h"
+#include "driver/bk4819.h"
+#include "driver/gpio.h"
+#include "driver/keyboard.h"
+#include "driver/st7565.h"
+#include "driver/system.h"
+#include "driver/systick.h"
+#include "driver/uart.h"
+#include "helper/battery.h"
+#include "radio.h"
+
+typedef struct
+{
+    uint32_t Frequency;
+    uint32_t Width;
+    int      dBm;
+} Carrier_t;
+
+static uint32_t  RegisterUs, SettleUs, BlitUs, StatusUs;
+static double    CpuScale;
+static int       NoiseDbm;
+static Carrier_t Carriers[16];
+static unsigned  CarrierCount;
+
+static uint64_t  Now;               // virtual microseconds
+static uint64_t  Limit;
+static uint64_t  SettledAt;
+static uint32_t  Tuned;
+static uint32_t  Seed = 1;
+static uint16_t  Registers[128];
+static double    CpuStart;
+
+static FREQ_Config_t Freq;
+static VFO_Info_t    Vfo = {.pRX = &Freq, .pTX = &Freq};
+VFO_Info_t          *gTxVfo = &Vfo;
+VFO_Info_t          *gRxVfo = &Vfo;
+uint16_t             gBatteryCalibration[6] = {1900, 2000, 2000, 2000, 2000, 2300};
+
+static double Cpu(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void Advance(uint32_t Us)
+{
+    Now += Us;
+    if (Now > Limit)
+    {
+        fprintf(stderr, "virtual time limit reached\n");
+        exit(1);
+    }
+}
+
+uint32_t SYSTICK_GetUs(void)
+{
+    return (uint32_t)(Now + (uint64_t)((Cpu() - CpuStart) * CpuScale));
+}
+
+void SYSTICK_DelayUs(uint32_t Delay) { Advance(Delay); }
+void SYSTEM_DelayMs(uint32_t Delay)  { Advance(Delay * 1000); }
+
+uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
+{
+    Advance(RegisterUs);
+    if (Register == BK4819_REG_63)
+        return Now < SettledAt ? 0x00FF : 0x0010;
+    return Registers[Register & 0x7F];
+}
+
+void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    Advance(RegisterUs);
+    // spectrum.c toggles REG_30 after every retune, the glitch counter
+    // restarts with it
+    if (Register == BK4819_REG_30)
+        SettledAt = Now + SettleUs;
+    Registers[Register & 0x7F] = Data;
+}
+
+void BK4819_SetFrequency(uint32_t Frequency)
+{
+    BK4819_WriteRegister(BK4819_REG_38, Frequency & 0xFFFF);
+    BK4819_WriteRegister(BK4819_REG_39, Frequency >> 16);
+    Tuned = Frequency;
+}
+
+uint16_t BK4819_GetRSSI(void)
+{
+    Advance(RegisterUs);
+
+    int dBm = NoiseDbm;
+    for (unsigned i = 0; i < CarrierCount; i++)
+    {
+        const uint32_t Offset = Tuned > Carriers[i].Frequency ? Tuned - Carriers[i].Frequency : Carriers[i].Frequency - Tuned;
+        if (Offset <= Carriers[i].Width / 2 && Carriers[i].dBm > dBm)
+            dBm = Carriers[i].dBm;
+    }
+
+    Seed = Seed * 1103515245 + 12345;
+    return (dBm + 160) * 2 + ((Seed >> 16) % 5);
+}
+
+void UART_Send(const void *pBuffer, uint32_t Size)
+{
+    fwrite(pBuffer, 1, Size, stdout);
+    fflush(stdout);
+}
+
+void _putchar(char c) { (void)c; }
+
+// argv[1] to argv[8] and the carriers after them as model_argv lays them
+// out, arguments of the harness go last and are left out of argc. Returns
+// false when the arguments are short or the GPIO ports can not be mapped.
+static bool ModelStart(int argc, char *argv[])
+{
+    if (argc < 9)
+        return false;
+
+    Freq.Frequency = strtoul(argv[1], NULL, 0);
+    RegisterUs = strtoul(argv[2], NULL, 0);
+    SettleUs = strtoul(argv[3], NULL, 0);
+    BlitUs = strtoul(argv[4], NULL, 0);
+    StatusUs = strtoul(argv[5], NULL, 0);
+    NoiseDbm = atoi(argv[6]);
+    CpuScale = atof(argv[7]);
+    Limit = strtoull(argv[8], NULL, 0) * 1000000ULL;
+
+    for (int i = 9; i < argc && CarrierCount < 16; i++)
+    {
+        Carrier_t *c = &Carriers[CarrierCount];
+        if (sscanf(argv[i], "%u:%u:%d", &c->Frequency, &c->Width, &c->dBm) == 3)
+            CarrierCount++;
+    }
+
+    // GPIO ports at their real address, PTT reads released
+    if (mmap((void *)IOPORT_BASE, 0x2000, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) == MAP_FAILED)
+    {
+        perror("mmap");
+        return false;
+    }
+    GPIOB->IDR = LL_GPIO_PIN_10;
+
+    CpuStart = Cpu();
+    return true;
+}
+'''
+
+HARNESS = MODEL + r'''
+void ST7565_BlitFullScreen(void) { Advance(BlitUs); }
+void ST7565_BlitStatusLine(void) { Advance(StatusUs); }
+
+KEY_Code_t KEYBOARD_Poll(void)
+{
+    // leave the spectrum once every combination was measured
+    return SPECBENCH_IsRunning() ? KEY_INVALID : KEY_EXIT;
+}
+
+int main(int argc, char *argv[])
+{
+    if (!ModelStart(argc, argv))
+        return 2;
+
+    APP_RunSpectrum();
+
+    fprintf(stderr, "virtual_us %llu\n", (unsigned long long)Now);
+    return 0;
+}
+'''
+
+
+def model_argv(freq, reg_us, settle_us, blit_us, status_us, noise, cpu_scale, limit, carriers):
+    """Command line of the model, the frequency in Hz and the carriers as
+    parse_carrier gives them."""
+    return [str(int(freq) // 10), str(reg_us), str(settle_us), str(blit_us), str(status_us), str(noise),
+            str(cpu_scale), str(limit), *carriers]
+
+
+def parse_carrier(text):
+    """freq_hz:width_hz:dbm, kept in the firmware's 10 Hz units."""
+    try:
+        freq, width, dbm = text.split(':')
+        return f'{int(float(freq)) // 10}:{int(float(width)) // 10}:{int(dbm)}'
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"carrier {text} is not freq_hz:width_hz:dbm")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Run the spectrum benchmark (ENABLE_SPECTRUM_BENCH) on the host '
+                                                 'against a BK4819 register model.')
+    parser.add_argument('-preset', default='Bandscope', help='CMake preset for the feature flags (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('-freq', type=float, default=434e6, help='VFO frequency in Hz (default: %(default).0f)')
+    parser.add_argument('-reg-us', type=int, default=30, help='cost of one register access (default: %(default)s)')
+    parser.add_argument('-settle-us', type=int, default=900, help='glitch settle time after a retune (default: %(default)s)')
+    parser.add_argument('-blit-us', type=int, default=2600, help='cost of a full screen blit (default: %(default)s)')
+    parser.add_argument('-status-us', type=int, default=330, help='cost of a status line blit (default: %(default)s)')
+    parser.add_argument('-noise', type=int, default=-125, help='noise floor in dBm (default: %(default)s)')
+    parser.add_argument('-carrier', type=parse_carrier, action='append', default=[],
+                        help='freq_hz:width_hz:dbm, may be given more than once')
+    parser.add_argument('-cpu-scale', type=float, default=0.0,
+                        help='add host CPU time times this factor to the clock, 0 keeps the run '
+                             'deterministic (default: %(default)s)')
+    parser.add_argument('-limit', type=int, default=3600, help='virtual seconds before giving up (default: %(default)s)')
+    parser.add_argument('-out', default=None, help='write the results as JSON to this file')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    variables = hostbuild.preset_flags(args.preset)
+    if variables.get('ENABLE_SPECTRUM') is not True:
+        print(f"[!] Preset {args.preset} does not build the spectrum")
+        sys.exit(1)
+    variables['ENABLE_SPECTRUM_BENCH'] = True
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            sources = SOURCES + hostbuild.feature_sources(variables, ('font_',))
+            binary, stubbed = hostbuild.build(args.cc, tmp, HARNESS, sources, variables, extra=['-no-pie'],
+                                              name='spectrum_host')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built app/spectrum.c for {args.preset}, {stubbed} symbols stubbed")
+
+        model = model_argv(args.freq, args.reg_us, args.settle_us, args.blit_us, args.status_us, args.noise,
+                           args.cpu_scale, args.limit, args.carrier)
+        run = subprocess.run([binary, *model], capture_output=True, text=True)
+
+    if run.returncode:
+        print(f"[!] Harness failed ({run.returncode}): {run.stderr.strip()}")
+        sys.exit(1)
+
+    results = []
+    for line in run.stdout.splitlines():
+        try:
+            r = json.loads(line)
+        except ValueError:
+            continue
+        if r.get('bench') == 'spectrum':
+            r['sweeps_per_s'] = round(1e6 / r['sweep_us'], 3) if r['sweep_us'] else 0
+            results.append(r)
+
+    print(f"{'steps':>5} {'step':>4} {'bins':>4} {'sweep/s':>8} {'tune':>6} {'settle':>6} {'meas':>6} {'render':>7}")
+    for r in results:
+        print(f"{128 >> r['steps_count']:>5} {r['scan_step']:>4} {r['bins']:>4} {r['sweeps_per_s']:>8.2f} "
+              f"{r['tune_us']:>6} {r['settle_us']:>6} {r['measure_us']:>6} {r['render_us']:>7}")
+
+    if args.out:
+        report = {'preset': args.preset, 'model': {k: getattr(args, k) for k in
+                  ('freq', 'reg_us', 'settle_us', 'blit_us', 'status_us', 'noise', 'carrier', 'cpu_scale')},
+                  'results': results}
+        with open(args.out, 'w') as f:
+            json.dump(report, f, indent=2)
+        print(f"[*] Results written to {args.out}")
+
+    expected = STEPS_COUNT_N * SCAN_STEP_N
+    if len(results) != expected:
+        print(f"[!] {len(results)} results, expected {expected}")
+        sys.exit(1)
+
+    # without CPU time every bin waits out the settle time plus at most one
+    # poll, a sample taken outside a sweep would pull the average off
+    if not args.cpu_scale:
+        bad = [r for r in results if not args.settle_us <= r['settle_us'] <= args.settle_us + 100 + 2 * args.reg_us]
+        if bad:
+            print(f"[!] {len(bad)} results with a settle time off the model")
+            sys.exit(1)
+
+    print(f"[*] {len(results)} results")
+
+
+if __name__ == '__main__':
+    main()
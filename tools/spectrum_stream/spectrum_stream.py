@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+
+import sys
+import time
+import argparse
+
+import serial
+from serial.tools import list_ports
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration (USB CDC, baudrate is ignored by the radio)
+DEFAULT_PORT = '/dev/ttyACM0'
+BAUDRATE = 115200
+TIMEOUT = 0.5
+
+# Protocol
+HEADER = b'\xAA\x55'
+TYPE_SWEEP = 0x03
+TRAILER = 0x0A
+DELTA_ESCAPE = 0x80
+MAX_PAYLOAD = 2 + 4 + 4 + 4 + 1 + 2 + 127 * 3 + 1
+
+
+def decode_sweep(payload: bytes):
+    """Decode one sweep payload, returns a dict or None if it is corrupt."""
+    if len(payload) < 18:
+        return None
+
+    check = 0
+    for b in payload[:-1]:
+        check ^= b
+    if check != payload[-1]:
+        return None
+
+    seq = int.from_bytes(payload[0:2], 'big')
+    t_ms = int.from_bytes(payload[2:6], 'big')
+    f_start = int.from_bytes(payload[6:10], 'big')
+    step = int.from_bytes(payload[10:14], 'big')
+    count = payload[14]
+    value = int.from_bytes(payload[15:17], 'big')
+
+    bins = [value]
+    i = 17
+    end = len(payload) - 1
+    while len(bins) < count and i < end:
+        b = payload[i]
+        if b == DELTA_ESCAPE:
+            value = int.from_bytes(payload[i + 1:i + 3], 'big')
+            i += 3
+        else:
+            value = (value + (b - 256 if b > 127 else b)) & 0xFFFF
+            i += 1
+        bins.append(value)
+
+    if len(bins) != count or i != end:
+        return None
+
+    return {'seq': seq, 't_ms': t_ms, 'f_start': f_start, 'step': step, 'bins': bins}
+
+
+def read_sweep(ser: serial.Serial):
+    """Resynchronise on the frame header and return the next valid sweep."""
+    while True:
+        b = ser.read(1)
+        if not b:
+            return None
+        if b != HEADER[0:1] or ser.read(1) != HEADER[1:2]:
+            continue
+        t = ser.read(1)
+        size = int.from_bytes(ser.read(2), 'big')
+        if not t or t[0] != TYPE_SWEEP or size > MAX_PAYLOAD:
+            continue
+        payload = ser.read(size)
+        trailer = ser.read(1)
+        if len(payload) != size or not trailer or trailer[0] != TRAILER:
+            continue
+        sweep = decode_sweep(payload)
+        if sweep:
+            return sweep
+
+
+def rssi_to_dbm(rssi: int) -> float:
+    return rssi / 2 - 160
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Log spectrum sweeps streamed by the radio over USB.')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-out', default=None, help='CSV output file (default: spectrum_YYYYMMDD_HHMMSS.csv)')
+    parser.add_argument('--dbm', action='store_true', help='write dBm instead of raw RSSI')
+    parser.add_argument('--list-ports', action='store_true', help='list available serial ports and exit')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.list_ports:
+        for p in list_ports.comports():
+            print(f"{p.device}\t{p.description}")
+        return
+
+    out = args.out or time.strftime('spectrum_%Y%m%d_%H%M%S.csv')
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=TIMEOUT)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # the radio only streams while DTR is asserted
+    ser.dtr = True
+
+    last_seq = None
+    sweeps = dropped = 0
+
+    print(f"[*] Logging sweeps from {args.port} to {out}, Ctrl+C to stop")
+    with open(out, 'w') as f:
+        f.write('host_time,device_ms,seq,f_start_hz,step_hz,bins...\n')
+        try:
+            while True:
+                sweep = read_sweep(ser)
+                if sweep is None:
+                    continue
+
+                if last_seq is not None:
+                    dropped += (sweep['seq'] - last_seq - 1) & 0xFFFF
+                last_seq = sweep['seq']
+                sweeps += 1
+
+                if args.dbm:
+                    values = ('%.1f' % rssi_to_dbm(v) for v in sweep['bins'])
+                else:
+                    values = (str(v) for v in sweep['bins'])
+
+                f.write('%.3f,%d,%d,%d,%d,%s\n' % (
+                    time.time(), sweep['t_ms'], sweep['seq'],
+                    sweep['f_start'] * 10, sweep['step'] * 10, ','.join(values)))
+
+                if sweeps % 50 == 0:
+                    f.flush()
+                    print(f"\r[*] {sweeps} sweeps, {dropped} dropped", end='', flush=True)
+        except KeyboardInterrupt:
+            pass
+
+    print(f"\n[*] {sweeps} sweeps written, {dropped} dropped")
+
+
+if __name__ == '__main__':
+    main()
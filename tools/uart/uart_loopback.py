@@ -0,0 +1,400 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# UART driver under test (App/driver/uart.c, ENABLE_UART_DMA_TX)
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+SOURCE = os.path.join(APP, 'driver', 'uart.c')
+LL_HEADERS = ['py32f071_ll_bus.h', 'py32f071_ll_system.h', 'py32f071_ll_dma.h',
+              'py32f071_ll_gpio.h', 'py32f071_ll_usart.h']
+
+# Stand-ins for the LL headers uart.c includes. Channel 6 is a thread that
+# reads the ring at the programmed address and writes to a sink, the
+# interrupt mask is a lock the thread takes around the handler. The binary
+# is linked without PIE so that the ring's address fits the 32 bit DMA
+# address register.
+SIM = r'''
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+typedef struct { int Unused; } DMA_TypeDef;
+typedef struct { int Unused; } USART_TypeDef;
+typedef struct { int Unused; } GPIO_TypeDef;
+
+extern DMA_TypeDef   SimDma;
+extern USART_TypeDef SimUsart;
+extern GPIO_TypeDef  SimGpio;
+
+#define DMA1   (&SimDma)
+#define USART1 (&SimUsart)
+#define GPIOA  (&SimGpio)
+
+#define DMA1_Channel4_5_6_7_IRQn 11
+
+#define LL_DMA_CHANNEL_2 2
+#define LL_DMA_CHANNEL_6 6
+
+enum {
+    LL_AHB1_GRP1_PERIPH_DMA1, LL_APB1_GRP2_PERIPH_SYSCFG, LL_APB1_GRP2_PERIPH_USART1, LL_IOP_GRP1_PERIPH_GPIOA,
+    LL_DMA_DIRECTION_MEMORY_TO_PERIPH, LL_DMA_DIRECTION_PERIPH_TO_MEMORY, LL_DMA_MODE_CIRCULAR, LL_DMA_MODE_NORMAL,
+    LL_DMA_MDATAALIGN_BYTE, LL_DMA_MEMORY_INCREMENT, LL_DMA_PDATAALIGN_BYTE, LL_DMA_PERIPH_NOINCREMENT,
+    LL_DMA_PRIORITY_HIGH, LL_DMA_PRIORITY_LOW, LL_GPIO_AF1_USART1, LL_GPIO_MODE_ALTERNATE, LL_GPIO_OUTPUT_PUSHPULL,
+    LL_GPIO_PIN_9, LL_GPIO_PIN_10, LL_GPIO_PULL_UP, LL_GPIO_SPEED_FREQ_VERY_HIGH, LL_SYSCFG_DMA_MAP_USART1_RD,
+    LL_SYSCFG_DMA_MAP_USART1_WR, LL_USART_DIRECTION_TX_RX,
+};
+
+typedef struct {
+    uint32_t Pin, Mode, Alternate, Speed, OutputType, Pull;
+} LL_GPIO_InitTypeDef;
+
+typedef struct {
+    uint32_t PeriphOrM2MSrcAddress, MemoryOrM2MDstAddress, Direction, Mode, PeriphOrM2MSrcIncMode,
+             MemoryOrM2MDstIncMode, PeriphOrM2MSrcDataSize, MemoryOrM2MDstDataSize, NbData, Priority;
+} LL_DMA_InitTypeDef;
+
+typedef struct {
+    uint32_t BaudRate, TransferDirection;
+} LL_USART_InitTypeDef;
+
+#define LL_AHB1_GRP1_EnableClock(...)   ((void)0)
+#define LL_APB1_GRP2_EnableClock(...)   ((void)0)
+#define LL_APB1_GRP2_ForceReset(...)    ((void)0)
+#define LL_APB1_GRP2_ReleaseReset(...)  ((void)0)
+#define LL_IOP_GRP1_EnableClock(...)    ((void)0)
+#define LL_GPIO_StructInit(...)         ((void)0)
+#define LL_GPIO_Init(...)               ((void)0)
+#define LL_DMA_StructInit(...)          ((void)0)
+#define LL_DMA_Init(...)                ((void)0)
+#define LL_SYSCFG_SetDMARemap(...)      ((void)0)
+#define LL_USART_StructInit(...)        ((void)0)
+#define LL_USART_Init(...)              ((void)0)
+#define LL_USART_Enable(...)            ((void)0)
+#define LL_USART_Disable(...)           ((void)0)
+#define LL_USART_EnableDMAReq_RX(...)   ((void)0)
+#define LL_USART_EnableDMAReq_TX(...)   ((void)0)
+#define LL_USART_TransmitData8(...)     ((void)0)
+#define LL_USART_DMA_GetRegAddr(...)    0u
+#define LL_USART_IsActiveFlag_TXE(...)  1u
+#define LL_USART_IsActiveFlag_TC(...)   1u
+#define LL_DMA_SetPeriphAddress(...)    ((void)0)
+#define LL_DMA_ConfigTransfer(...)      ((void)0)
+#define NVIC_EnableIRQ(...)             ((void)0)
+
+void     LL_DMA_EnableChannel(DMA_TypeDef *DMAx, uint32_t Channel);
+void     LL_DMA_DisableChannel(DMA_TypeDef *DMAx, uint32_t Channel);
+void     LL_DMA_SetMemoryAddress(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Address);
+void     LL_DMA_SetDataLength(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Length);
+void     LL_DMA_EnableIT_TC(DMA_TypeDef *DMAx, uint32_t Channel);
+uint32_t LL_DMA_IsActiveFlag_TC6(DMA_TypeDef *DMAx);
+void     LL_DMA_ClearFlag_TC6(DMA_TypeDef *DMAx);
+
+uint32_t __get_PRIMASK(void);
+void     __set_PRIMASK(uint32_t Mask);
+void     __disable_irq(void);
+
+#endif
+'''
+
+HARNESS = r'''
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sim.h"
+#include "driver/uart.h"
+
+DMA_TypeDef   SimDma;
+USART_TypeDef SimUsart;
+GPIO_TypeDef  SimGpio;
+
+static pthread_mutex_t Irq = PTHREAD_MUTEX_INITIALIZER;
+static int             Masked;
+
+static volatile int      Stop;
+static volatile uint32_t Enabled;
+static uint32_t          Address;
+static uint32_t          Length;
+static uint32_t          Tc;
+static uint32_t          ItTc;
+static uint32_t          LowAddress = UINT32_MAX;
+static uint32_t          HighAddress;
+static uint32_t          Errors;
+static uint32_t          Transfers;
+
+static uint8_t *Sink;
+static size_t   SinkLength;
+
+// ---- channel 6 and the interrupt mask ----
+
+void LL_DMA_EnableChannel(DMA_TypeDef *DMAx, uint32_t Channel)
+{
+    (void)DMAx;
+    if (Channel != 6)
+        return;
+    if (!Length || Address + Length < Address)
+        Errors++;
+    if (Address < LowAddress)
+        LowAddress = Address;
+    if (Address + Length > HighAddress)
+        HighAddress = Address + Length;
+    Transfers++;
+    Enabled = 1;
+}
+
+void LL_DMA_DisableChannel(DMA_TypeDef *DMAx, uint32_t Channel)
+{
+    (void)DMAx;
+    if (Channel != 6)
+        return;
+    // a transfer cut off before its end would lose bytes
+    if (Enabled && Length)
+        Errors++;
+    Enabled = 0;
+}
+
+void LL_DMA_SetMemoryAddress(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Value)
+{
+    (void)DMAx;
+    if (Channel == 6) {
+        if (Enabled)
+            Errors++;
+        Address = Value;
+    }
+}
+
+void LL_DMA_SetDataLength(DMA_TypeDef *DMAx, uint32_t Channel, uint32_t Value)
+{
+    (void)DMAx;
+    if (Channel == 6) {
+        if (Enabled)
+            Errors++;
+        Length = Value;
+    }
+}
+
+void LL_DMA_EnableIT_TC(DMA_TypeDef *DMAx, uint32_t Channel)
+{
+    (void)DMAx;
+    if (Channel == 6)
+        ItTc = 1;
+}
+
+uint32_t LL_DMA_IsActiveFlag_TC6(DMA_TypeDef *DMAx)
+{
+    (void)DMAx;
+    return Tc;
+}
+
+void LL_DMA_ClearFlag_TC6(DMA_TypeDef *DMAx)
+{
+    (void)DMAx;
+    Tc = 0;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return Masked;
+}
+
+void __disable_irq(void)
+{
+    if (!Masked)
+        pthread_mutex_lock(&Irq);
+    Masked = 1;
+}
+
+void __set_PRIMASK(uint32_t Mask)
+{
+    if (!Mask && Masked) {
+        Masked = 0;
+        pthread_mutex_unlock(&Irq);
+    }
+}
+
+// one byte a step, the interrupt runs with the mask taken
+static void *Channel(void *pArg)
+{
+    const long Burst = *(const long *)pArg;
+    long       Step  = 0;
+
+    while (!Stop) {
+        pthread_mutex_lock(&Irq);
+        if (Enabled && Length) {
+            Sink[SinkLength++] = *(const uint8_t *)(uintptr_t)Address;
+            Address++;
+            if (--Length == 0) {
+                Tc = 1;
+                if (ItTc)
+                    UART_TxIRQHandler();
+            }
+        }
+        pthread_mutex_unlock(&Irq);
+        if (++Step % Burst == 0)
+            sched_yield();
+    }
+    return NULL;
+}
+
+// ---- main loop side ----
+
+static double Now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4)
+        return 2;
+
+    const long Messages = atol(argv[1]);
+    long       Burst    = atol(argv[2]);
+    srand(atoi(argv[3]));
+
+    uint8_t *pExpected = malloc(Messages * 512);
+    size_t   Expected  = 0;
+    Sink = malloc(Messages * 512);
+
+    uint32_t Replies = 0, Streams = 0, Dropped = 0, DroppedBytes = 0, Refused = 0;
+    double   ReplyWait = 0, StreamWait = 0;
+    uint8_t  Message[512];
+
+    UART_Init();
+
+    pthread_t Thread;
+    pthread_create(&Thread, NULL, Channel, &Burst);
+
+    for (long i = 0; i < Messages; i++) {
+        const bool     Stream = rand() % 2;
+        const uint32_t Size   = Stream ? 10 + rand() % 400 : 1 + rand() % UART_TX_REPLY_ROOM;
+
+        for (uint32_t j = 0; j < Size; j++)
+            Message[j] = (uint8_t)(i * 7 + j);
+
+        const double Start = Now();
+        if (Stream) {
+            const uint32_t Room = UART_GetTxRoom(UART_TX_STREAM);
+            if (UART_SendAsync(Message, Size, UART_TX_STREAM)) {
+                memcpy(pExpected + Expected, Message, Size);
+                Expected += Size;
+                Streams++;
+            } else {
+                // the room only grows while the main loop is not sending
+                if (Room >= Size)
+                    Refused++;
+                Dropped++;
+                DroppedBytes += Size;
+            }
+            StreamWait += Now() - Start;
+        } else {
+            UART_Send(Message, Size);
+            memcpy(pExpected + Expected, Message, Size);
+            Expected += Size;
+            Replies++;
+            const double Wait = Now() - Start;
+            if (Wait > ReplyWait)
+                ReplyWait = Wait;
+        }
+
+        // now and then the main loop has other work and the ring drains
+        if (rand() % 4 == 0)
+            sched_yield();
+    }
+
+    UART_Flush();
+    Stop = 1;
+    pthread_join(Thread, NULL);
+
+    int Failed = 0;
+    if (SinkLength != Expected || memcmp(Sink, pExpected, Expected)) {
+        size_t At = 0;
+        while (At < SinkLength && At < Expected && Sink[At] == pExpected[At])
+            At++;
+        printf("[!] sent %zu bytes, %zu expected, first difference at %zu\n", SinkLength, Expected, At);
+        Failed = 1;
+    }
+    if (HighAddress - LowAddress > UART_TX_RING_SIZE) {
+        printf("[!] transfers span %u bytes, the ring has %u\n", HighAddress - LowAddress, UART_TX_RING_SIZE);
+        Failed = 1;
+    }
+    if (Errors || Refused) {
+        printf("[!] %u channel misuses, %u streams refused with room for them\n", Errors, Refused);
+        Failed = 1;
+    }
+    if (UART_GetTxDropped() != DroppedBytes) {
+        printf("[!] driver counted %u dropped bytes, %u were\n", UART_GetTxDropped(), DroppedBytes);
+        Failed = 1;
+    }
+
+    printf("[*] %u replies and %u streams in order, %zu bytes in %u transfers, within the %u byte ring\n",
+           Replies, Streams, Expected, Transfers, UART_TX_RING_SIZE);
+    printf("    %u streams dropped (%u bytes), stream sends took %.2f us on average, longest reply wait %.0f us\n",
+           Dropped, DroppedBytes, StreamWait / (Streams + Dropped ? Streams + Dropped : 1), ReplyWait);
+
+    free(pExpected);
+    free(Sink);
+    return Failed;
+}
+'''
+
+
+def build(cc, tmp, ring):
+    for name in LL_HEADERS:
+        with open(os.path.join(tmp, name), 'w') as f:
+            f.write('#include "sim.h"\n')
+    with open(os.path.join(tmp, 'sim.h'), 'w') as f:
+        f.write(SIM)
+    harness = os.path.join(tmp, 'harness.c')
+    with open(harness, 'w') as f:
+        f.write(HARNESS)
+
+    binary = os.path.join(tmp, 'loopback')
+    flags = ['-std=gnu11', '-O1', '-g', '-fsanitize=address,undefined', '-fno-pie', '-no-pie', '-pthread',
+             '-DENABLE_UART_DMA_TX', f'-DUART_TX_RING_SIZE={ring}', f'-I{tmp}', f'-I{APP}']
+    result = subprocess.run([cc, *flags, harness, SOURCE, '-o', binary], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    return binary
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Send replies and streams through the DMA UART TX ring on the host and check what comes out.')
+    parser.add_argument('-messages', type=int, default=5000, help='messages sent (default: %(default)s)')
+    parser.add_argument('-ring', type=int, default=512, help='UART_TX_RING_SIZE (default: %(default)s)')
+    parser.add_argument('-burst', type=int, default=64, help='bytes the channel sends before it yields (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed (default: %(default)s)')
+    parser.add_argument('-cc', default='cc', help='host C compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.messages <= 0 or args.burst <= 0 or args.ring <= 160:
+        print("[!] messages and burst must be positive, the ring larger than a reply")
+        sys.exit(1)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary = build(args.cc, tmp, args.ring)
+        except RuntimeError as e:
+            print(f"[!] build failed\n{e}")
+            sys.exit(1)
+        result = subprocess.run([binary, str(args.messages), str(args.burst), str(args.seed)])
+    sys.exit(result.returncode)
+
+
+if __name__ == '__main__':
+    main()
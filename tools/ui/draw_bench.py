@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# Graphics core under test (App/ui/helper.c) and what it links against
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+SOURCES = [os.path.join(APP, f) for f in ('ui/helper.c', 'font.c', 'helper/format.c')]
+DEFINES = ['-DENABLE_FEAT_N7SIX', '-DENABLE_SMALL_BOLD']
+
+# The pixel at a time primitives the page spans replaced are kept here as the
+# reference. Each workload is drawn with both, the buffers compared and the
+# pixel rate of both measured.
+HARNESS = r'''
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "driver/st7565.h"
+#include "ui/helper.h"
+
+uint8_t gStatusLine[LCD_WIDTH];
+uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+char    gInputBox[8];
+uint8_t gInputBoxIndex;
+
+int sprintf_(char *buffer, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int n = vsprintf(buffer, format, args);
+    va_end(args);
+    return n;
+}
+
+#define ROWS (FRAME_LINES * 8)
+
+// ---- reference, a read-modify-write of the page byte per pixel ----
+
+__attribute__((noinline)) static void OldPixel(int x, int y, bool black)
+{
+    if (x < 0 || x >= LCD_WIDTH || y < 0 || y >= ROWS)
+        return;
+    const uint8_t pattern = 1 << (y % 8);
+    if (black)
+        gFrameBuffer[y / 8][x] |= pattern;
+    else
+        gFrameBuffer[y / 8][x] &= ~pattern;
+}
+
+static void OldFill(int x1, int y1, int x2, int y2, bool black)
+{
+    for (int x = x1; x <= x2; x++)
+        for (int y = y1; y <= y2; y++)
+            OldPixel(x, y, black);
+}
+
+static void OldRect(int x1, int y1, int x2, int y2, bool black)
+{
+    for (int x = x1; x <= x2; x++) {
+        OldPixel(x, y1, black);
+        OldPixel(x, y2, black);
+    }
+    for (int y = y1; y <= y2; y++) {
+        OldPixel(x1, y, black);
+        OldPixel(x2, y, black);
+    }
+}
+
+// ---- workloads, each with the pixels it covers ----
+
+static uint8_t Tops[LCD_WIDTH];
+
+// spectrum bar graph, one bar per column down to DrawingEndY
+static long OldBars(void)
+{
+    long n = 0;
+    for (int x = 0; x < LCD_WIDTH; x++) {
+        OldFill(x, Tops[x], x, 24, true);
+        n += 25 - Tops[x];
+    }
+    return n;
+}
+
+static long NewBars(void)
+{
+    long n = 0;
+    for (int x = 0; x < LCD_WIDTH; x++) {
+        UI_DrawVLineBuffer(gFrameBuffer, x, Tops[x], 24, true);
+        n += 25 - Tops[x];
+    }
+    return n;
+}
+
+// spectrum with fewer steps, bars four columns wide
+static long OldWideBars(void)
+{
+    long n = 0;
+    for (int x = 0; x < LCD_WIDTH; x += 4) {
+        OldFill(x, Tops[x], x + 3, 24, true);
+        n += 4 * (25 - Tops[x]);
+    }
+    return n;
+}
+
+static long NewWideBars(void)
+{
+    long n = 0;
+    for (int x = 0; x < LCD_WIDTH; x += 4) {
+        UI_FillRectangleBuffer(gFrameBuffer, x, Tops[x], x + 3, 24, true);
+        n += 4 * (25 - Tops[x]);
+    }
+    return n;
+}
+
+// horizontal rules at every row
+static long OldHLines(void)
+{
+    for (int y = 0; y < ROWS; y++)
+        OldFill(0, y, LCD_WIDTH - 1, y, y & 1);
+    return (long)ROWS * LCD_WIDTH;
+}
+
+static long NewHLines(void)
+{
+    for (int y = 0; y < ROWS; y++)
+        UI_DrawHLineBuffer(gFrameBuffer, 0, LCD_WIDTH - 1, y, y & 1);
+    return (long)ROWS * LCD_WIDTH;
+}
+
+// menu divider and friends, full height columns
+static long OldVLines(void)
+{
+    for (int x = 0; x < LCD_WIDTH; x += 3)
+        OldFill(x, 0, x, ROWS - 1, true);
+    return (long)((LCD_WIDTH + 2) / 3) * ROWS;
+}
+
+static long NewVLines(void)
+{
+    for (int x = 0; x < LCD_WIDTH; x += 3)
+        UI_DrawVLineBuffer(gFrameBuffer, x, 0, ROWS - 1, true);
+    return (long)((LCD_WIDTH + 2) / 3) * ROWS;
+}
+
+// nested outlines off the page boundaries
+static long OldRects(void)
+{
+    long n = 0;
+    for (int i = 0; i < 26; i += 2) {
+        OldRect(i + 1, i + 3, LCD_WIDTH - 2 - i, ROWS - 2 - i, true);
+        n += 2 * (LCD_WIDTH - 2 - 2 * i) + 2 * (ROWS - 4 - 2 * i);
+    }
+    return n;
+}
+
+static long NewRects(void)
+{
+    long n = 0;
+    for (int i = 0; i < 26; i += 2) {
+        UI_DrawRectangleBuffer(gFrameBuffer, i + 1, i + 3, LCD_WIDTH - 2 - i, ROWS - 2 - i, true);
+        n += 2 * (LCD_WIDTH - 2 - 2 * i) + 2 * (ROWS - 4 - 2 * i);
+    }
+    return n;
+}
+
+// breakout pause box cleared out of a lit screen
+static long OldClear(void)
+{
+    memset(gFrameBuffer, 0xFF, sizeof(gFrameBuffer));
+    OldFill(32, 30, 96, 41, false);
+    return 65 * 12;
+}
+
+static long NewClear(void)
+{
+    memset(gFrameBuffer, 0xFF, sizeof(gFrameBuffer));
+    UI_FillRectangleBuffer(gFrameBuffer, 32, 30, 96, 41, false);
+    return 65 * 12;
+}
+
+typedef struct {
+    const char *pName;
+    long      (*pOld)(void);
+    long      (*pNew)(void);
+} Workload_t;
+
+static const Workload_t Workloads[] = {
+    { "spectrum bars",   OldBars,     NewBars     },
+    { "wide bars",       OldWideBars, NewWideBars },
+    { "horizontal",      OldHLines,   NewHLines   },
+    { "vertical",        OldVLines,   NewVLines   },
+    { "rectangles",      OldRects,    NewRects    },
+    { "clear box",       OldClear,    NewClear    },
+};
+
+// best of a few batches, the host is shared and the first batches are noisy
+static double Rate(long (*pDraw)(void), long Rounds)
+{
+    double Best = 0;
+    for (int Batch = 0; Batch < 8; Batch++) {
+        struct timespec Start, End;
+        long            Pixels = 0;
+        clock_gettime(CLOCK_MONOTONIC, &Start);
+        for (long i = 0; i < Rounds; i++)
+            Pixels += pDraw();
+        clock_gettime(CLOCK_MONOTONIC, &End);
+        const double Us = ((End.tv_sec - Start.tv_sec) * 1e9 + (End.tv_nsec - Start.tv_nsec)) / 1e3;
+        if (Pixels / Us > Best)
+            Best = Pixels / Us;
+    }
+    return Best;
+}
+
+static int Lit(void)
+{
+    int n = 0;
+    for (int i = 0; i < FRAME_LINES * LCD_WIDTH; i++)
+        n += __builtin_popcount(((uint8_t *)gFrameBuffer)[i]);
+    return n;
+}
+
+int main(void)
+{
+    uint8_t Frame[FRAME_LINES][LCD_WIDTH];
+    int     Failed = 0;
+
+    srand(1);
+    for (int x = 0; x < LCD_WIDTH; x++)
+        Tops[x] = rand() % 25;
+
+    for (unsigned int i = 0; i < sizeof(Workloads) / sizeof(Workloads[0]); i++) {
+        memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+        Workloads[i].pOld();
+        memcpy(Frame, gFrameBuffer, sizeof(Frame));
+        memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+        Workloads[i].pNew();
+        if (memcmp(Frame, gFrameBuffer, sizeof(Frame))) {
+            printf("[!] %s differs from the reference\n", Workloads[i].pName);
+            Failed = 1;
+        }
+    }
+
+    // spans half off the screen are clipped, not wrapped into other lines
+    memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+    UI_FillRectangleBuffer(gFrameBuffer, -20, -5, 10, 3, true);
+    UI_FillRectangleBuffer(gFrameBuffer, 120, 50, 300, 90, true);
+    if (Lit() != 11 * 4 + 8 * 6) {
+        printf("[!] clipped fills lit %d pixels, want %d\n", Lit(), 11 * 4 + 8 * 6);
+        Failed = 1;
+    }
+
+    // sloped lines are 8-connected, one pixel per step of the longer axis
+    for (int dx = -40; dx <= 40; dx += 7) {
+        for (int dy = -25; dy <= 25; dy += 5) {
+            memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+            UI_DrawLineBuffer(gFrameBuffer, 64, 28, 64 + dx, 28 + dy, true);
+            const int Want = (abs(dx) > abs(dy) ? abs(dx) : abs(dy)) + 1;
+            const int y2   = 28 + dy;
+            if (Lit() != Want || !(gFrameBuffer[y2 / 8][64 + dx] & (1 << (y2 % 8)))) {
+                printf("[!] line to %+d,%+d lit %d pixels, want %d\n", dx, dy, Lit(), Want);
+                Failed = 1;
+            }
+        }
+    }
+
+    printf("[*] %s\n", Failed ? "output differs" : "output matches the reference, clipping and sloped lines hold");
+
+    const long Rounds = ROUNDS;
+    printf("[*] pixels per microsecond, best of 8 batches of %ld on the host\n", Rounds);
+    printf("    workload          per pixel   page spans\n");
+    for (unsigned int i = 0; i < sizeof(Workloads) / sizeof(Workloads[0]); i++) {
+        const double Old = Rate(Workloads[i].pOld, Rounds);
+        const double New = Rate(Workloads[i].pNew, Rounds);
+        printf("    %-16s %10.0f %12.0f  (%.1fx)\n", Workloads[i].pName, Old, New, New / Old);
+    }
+    return Failed;
+}
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check the page span line, rectangle and fill primitives on the host and measure their pixel rate.')
+    parser.add_argument('-cc', default=os.environ.get('CC', 'cc'), help='host C compiler (default: %(default)s)')
+    parser.add_argument('-rounds', type=int, default=2000, help='workloads drawn per timing batch (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.rounds <= 0:
+        print("[!] rounds must be positive")
+        sys.exit(1)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        harness = os.path.join(tmp, 'harness.c')
+        binary = os.path.join(tmp, 'harness')
+        with open(harness, 'w') as f:
+            f.write(HARNESS)
+
+        build = [args.cc, '-std=gnu11', '-O2', f'-I{APP}', f'-DROUNDS={args.rounds}L',
+                 *DEFINES, harness, *SOURCES, '-o', binary]
+        try:
+            result = subprocess.run(build, capture_output=True, text=True)
+        except OSError as e:
+            print(f"[!] Cannot run {args.cc}: {e}")
+            sys.exit(1)
+        if result.returncode:
+            print(f"[!] Build failed\n{result.stderr}")
+            sys.exit(1)
+
+        sys.exit(subprocess.run([binary]).returncode)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import struct
+import argparse
+import subprocess
+
+from font_pack import APP, HEADER, dump, c_bytes
+
+# Version
+VERSION = '1.0'
+
+# Ink extents of the small fonts for ENABLE_PROPORTIONAL_FONT, measured on
+# the Windows fonts in tools/misc and checked against the tables in font.c
+MISC = os.path.join(APP, '..', 'tools', 'misc')
+OUTPUT = os.path.join(APP, 'font_metrics.c')
+
+# table, source, index into the font_pack dump, guard
+FONTS = [
+    ('gFontSmall',     'uv-k5_small.fon',      2, None),
+    ('gFontSmallBold', 'uv-k5_small_bold.fon', 3, 'ENABLE_SMALL_BOLD'),
+]
+
+FIRST = ord('!')
+GLYPHS = 94
+WIDTH = 6
+
+RT_FONT = 0x8008
+
+
+def fnt_resource(data):
+    """The first font resource of an NE executable."""
+    if data[:2] != b'MZ':
+        raise ValueError('not an MZ executable')
+    ne = struct.unpack_from('<I', data, 0x3C)[0]
+    if data[ne:ne + 2] != b'NE':
+        raise ValueError('not an NE executable')
+
+    table = ne + struct.unpack_from('<H', data, ne + 0x24)[0]
+    shift = struct.unpack_from('<H', data, table)[0]
+    offset = table + 2
+    while True:
+        kind, count = struct.unpack_from('<HH', data, offset)
+        if kind == 0:
+            raise ValueError('no font resource')
+        offset += 8
+        if kind == RT_FONT:
+            start, length = struct.unpack_from('<HH', data, offset)
+            return data[start << shift:(start + length) << shift]
+        offset += 12 * count
+
+
+def fnt_glyphs(fnt):
+    """Bitmaps of a FNT 2.0 or 3.0 font as lists of column bits, top row in
+    bit 0 like the glyph bytes of font.c."""
+    version = struct.unpack_from('<H', fnt, 0)[0]
+    height = struct.unpack_from('<H', fnt, 88)[0]
+    first, last = fnt[95], fnt[96]
+    table, entry = (148, 6) if version >= 0x300 else (118, 4)
+    if height > 8:
+        raise ValueError(f'{height} rows do not fit a page')
+
+    glyphs = {}
+    for code in range(first, last + 1):
+        at = table + (code - first) * entry
+        width = struct.unpack_from('<H', fnt, at)[0]
+        bitmap = struct.unpack_from('<I' if entry == 6 else '<H', fnt, at + 2)[0]
+        columns = []
+        for x in range(width):
+            column = 0
+            for y in range(height):
+                if fnt[bitmap + (x // 8) * height + y] >> (7 - x % 8) & 1:
+                    column |= 1 << y
+            columns.append(column)
+        glyphs[code] = columns
+    return glyphs
+
+
+def ink(columns):
+    """First lit column and the span up to the last one, 0 and 0 for a blank."""
+    lit = [x for x, c in enumerate(columns) if c]
+    if not lit:
+        return 0, 0
+    return lit[0], lit[-1] - lit[0] + 1
+
+
+def measure(path, firmware):
+    """Metrics bytes, first ink column in the low nibble and ink width in the
+    high one, and the characters whose extents disagree with font.c."""
+    with open(path, 'rb') as f:
+        glyphs = fnt_glyphs(fnt_resource(f.read()))
+
+    metrics = []
+    differ = []
+    for i in range(GLYPHS):
+        columns = glyphs.get(FIRST + i)
+        if columns is None:
+            raise ValueError(f'{chr(FIRST + i)!r} is missing')
+        # the Windows cells carry the gap as a leading blank column
+        if columns[0]:
+            raise ValueError(f'{chr(FIRST + i)!r} has ink in its leading column')
+        start, width = ink(columns[1:WIDTH + 1])
+        if not width:
+            raise ValueError(f'{chr(FIRST + i)!r} has no ink')
+        if ink(firmware[i * WIDTH:(i + 1) * WIDTH]) != (start, width) or any(columns[WIDTH + 1:]):
+            differ.append(chr(FIRST + i))
+        metrics.append(width << 4 | start)
+    return metrics, differ
+
+
+def generate(cc):
+    tables = dump(cc)
+    out = [HEADER.replace('font_pack.py from the tables in font.c', 'font_metrics.py from tools/misc/*.fon')
+                 .replace('#include <stddef.h>\n\n', '')]
+    report = []
+
+    for table, source, index, guard in FONTS:
+        metrics, differ = measure(os.path.join(MISC, source), tables[index])
+        report.append((table, source, metrics, differ))
+
+        text = (f'// {table}: first ink column in the low nibble, ink width in the high one\n'
+                f'const uint8_t {table}Metrics[{GLYPHS}] =\n{{\n{c_bytes(bytes(metrics))}\n}};')
+        if guard:
+            text = f'#ifdef {guard}\n{text}\n#endif'
+        out.append(text)
+
+    return '\n\n'.join(out) + '\n', report
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Measure the small fonts of tools/misc into App/font_metrics.c.')
+    parser.add_argument('-cc', default=os.environ.get('CC', 'cc'), help='host C compiler (default: %(default)s)')
+    parser.add_argument('-o', dest='output', default=OUTPUT, help='output file (default: App/font_metrics.c)')
+    parser.add_argument('-check', action='store_true', help='only check that the output is up to date')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        text, report = generate(args.cc)
+    except (OSError, ValueError, struct.error, RuntimeError, subprocess.CalledProcessError) as e:
+        print(f"[!] Cannot measure the fonts: {e}")
+        sys.exit(1)
+
+    failed = False
+    for table, source, metrics, differ in report:
+        widths = [m >> 4 for m in metrics]
+        print(f"[*] {source}: ink 1 to {max(widths)} columns, {sum(widths) / len(widths):.2f} on average")
+        if differ:
+            print(f"[!] {table} in font.c has other extents for {' '.join(differ)}")
+            failed = True
+    if failed:
+        sys.exit(1)
+
+    if args.check:
+        try:
+            with open(args.output) as f:
+                current = f.read()
+        except OSError:
+            current = None
+        if current != text:
+            print(f"[!] {args.output} is out of date")
+            sys.exit(1)
+        print(f"[*] {args.output} is up to date")
+        return
+
+    with open(args.output, 'w') as f:
+        f.write(text)
+    print(f"[*] Wrote {args.output}")
+
+
+if __name__ == '__main__':
+    main()
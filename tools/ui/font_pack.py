@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# Text fonts in App/font.c, packed into App/font_packed.c for ENABLE_PACKED_FONTS
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+OUTPUT = os.path.join(APP, 'font_packed.c')
+
+# name, table, glyphs, pages, columns, guard
+FONTS = [
+    ('Big',       'gFontBig',       94, 2, 7, None),
+    ('3x5',       'gFont3x5',       96, 1, 3, None),
+    ('Small',     'gFontSmall',     94, 1, 6, None),
+    ('SmallBold', 'gFontSmallBold', 94, 1, 6, 'ENABLE_SMALL_BOLD'),
+]
+
+# The unpacker reads three bytes for every column
+PADDING = 2
+
+HEADER = '''/* Copyright 2026 N7SIX
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+// Generated by tools/ui/font_pack.py from the tables in font.c, do not edit
+
+#include <stddef.h>
+
+#include "font.h"'''
+
+
+def dump(cc):
+    """Raw tables of App/font.c, built with the host compiler."""
+    lines = ['#include <stdio.h>', '#include "font.h"']
+    lines.append('static void Dump(const uint8_t *p, unsigned int n) { while (n--) printf("%u ", *p++); printf("\\n"); }')
+    lines.append('int main(void) {')
+    for _, table, glyphs, pages, columns, _ in FONTS:
+        lines.append(f'    Dump(&{table}[0][0], {glyphs * pages * columns});')
+    lines.append('    return 0;\n}')
+
+    with tempfile.TemporaryDirectory() as tmp:
+        source = os.path.join(tmp, 'dump.c')
+        binary = os.path.join(tmp, 'dump')
+        with open(source, 'w') as f:
+            f.write('\n'.join(lines) + '\n')
+        build = [cc, f'-I{APP}', '-DENABLE_SMALL_BOLD', source, os.path.join(APP, 'font.c'), '-o', binary]
+        result = subprocess.run(build, capture_output=True, text=True)
+        if result.returncode:
+            raise RuntimeError(result.stderr)
+        output = subprocess.run([binary], capture_output=True, text=True, check=True).stdout
+
+    return [list(map(int, line.split())) for line in output.splitlines()]
+
+
+def columns(data, glyphs, pages, width):
+    """Column values in character order, page 0 in the low byte."""
+    size = pages * width
+    return [sum(data[g * size + p * width + x] << (8 * p) for p in range(pages))
+            for g in range(glyphs) for x in range(width)]
+
+
+def pack(values, bits):
+    stream = bytearray((len(values) * bits + 7) // 8 + PADDING)
+    offset = 0
+    for value in values:
+        for i in range(bits):
+            if value >> i & 1:
+                stream[(offset + i) // 8] |= 1 << ((offset + i) % 8)
+        offset += bits
+    return bytes(stream)
+
+
+def encode(values, pages):
+    """Columns as they are, or as indices into a table of the distinct ones,
+    whichever is smaller."""
+    direct = max(1, max(values).bit_length())
+    table = sorted(set(values))
+    index = max(1, (len(table) - 1).bit_length())
+
+    plain = pack(values, direct)
+    indexed = pack([table.index(v) for v in values], index)
+    entries = bytes(v >> (8 * p) & 0xFF for v in table for p in range(pages))
+
+    if len(indexed) + len(entries) < len(plain):
+        return indexed, entries, index
+    return plain, None, direct
+
+
+def c_bytes(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append('    ' + ', '.join(f'0x{b:02X}' for b in data[i:i + 16]) + ',')
+    return '\n'.join(rows)
+
+
+def generate(cc):
+    tables = dump(cc)
+    out = [HEADER]
+    report = []
+
+    for (name, table, glyphs, pages, width, guard), data in zip(FONTS, tables):
+        values = columns(data, glyphs, pages, width)
+        stream, entries, bits = encode(values, pages)
+        packed = len(stream) + (len(entries) if entries else 0)
+        report.append((table, len(data), packed, bits, len(entries) // pages if entries else 0))
+
+        if entries:
+            note = f'{len(values)} columns as {bits} bit indices into {len(entries) // pages} distinct ones'
+        else:
+            note = f'{len(values)} columns of {bits} bits'
+
+        block = [f'// {table}: {note}']
+        block.append(f'static const uint8_t Font{name}Stream[] =\n{{\n{c_bytes(stream)}\n}};')
+        if entries:
+            block.append(f'\nstatic const uint8_t Font{name}Columns[] =\n{{\n{c_bytes(entries)}\n}};')
+        block.append(f'\nconst FontPacked_t {table}Packed = {{ Font{name}Stream, '
+                     f'{f"Font{name}Columns" if entries else "NULL"}, {bits} }};')
+
+        text = '\n'.join(block)
+        if guard:
+            text = f'#ifdef {guard}\n{text}\n#endif'
+        out.append(text)
+
+    return '\n\n'.join(out) + '\n', report
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack the text fonts of App/font.c into App/font_packed.c.')
+    parser.add_argument('-cc', default=os.environ.get('CC', 'cc'), help='host C compiler (default: %(default)s)')
+    parser.add_argument('-o', dest='output', default=OUTPUT, help='output file (default: App/font_packed.c)')
+    parser.add_argument('-check', action='store_true', help='only check that the output is up to date')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        text, report = generate(args.cc)
+    except (OSError, RuntimeError, subprocess.CalledProcessError) as e:
+        print(f"[!] Cannot dump the font tables: {e}")
+        sys.exit(1)
+
+    print("    font              raw  packed  bits  columns")
+    for table, raw, packed, bits, distinct in report:
+        print(f"    {table:<16} {raw:4d}  {packed:6d}  {bits:4d}  {distinct if distinct else '-':>7}")
+    raw = sum(r[1] for r in report)
+    packed = sum(r[2] for r in report)
+    print(f"[*] {raw} bytes of glyphs packed into {packed}, {raw - packed} bytes saved")
+
+    if args.check:
+        try:
+            with open(args.output) as f:
+                current = f.read()
+        except OSError:
+            current = None
+        if current != text:
+            print(f"[!] {args.output} is out of date")
+            sys.exit(1)
+        print(f"[*] {args.output} is up to date")
+        return
+
+    with open(args.output, 'w') as f:
+        f.write(text)
+    print(f"[*] Wrote {args.output}")
+
+
+if __name__ == '__main__':
+    main()
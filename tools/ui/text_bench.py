@@ -0,0 +1,444 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import argparse
+import tempfile
+import subprocess
+
+# Version
+VERSION = '1.0'
+
+# Text renderer under test (App/ui/helper.c) and what it links against
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+APP = os.path.join(ROOT, 'App')
+SOURCES = [os.path.join(APP, f) for f in ('ui/helper.c', 'font.c', 'helper/format.c')]
+DEFINES = ['-DENABLE_FEAT_N7SIX', '-DENABLE_SMALL_BOLD']
+
+# The per character renderer the glyph runs replaced is kept here as the
+# reference. The main screen's strings are drawn with both, the frame
+# buffers compared byte for byte and both timed.
+HARNESS = r'''
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "driver/st7565.h"
+#include "font.h"
+#include "ui/helper.h"
+
+#ifdef ENABLE_PACKED_FONTS
+    // font.c is built without the flag, its plain tables feed the reference
+    extern const uint8_t gFontBig[95 - 1][16 - 2];
+    extern const uint8_t gFont3x5[96][3];
+    extern const uint8_t gFontSmall[95 - 1][6];
+    extern const uint8_t gFontSmallBold[95 - 1][6];
+#endif
+
+uint8_t gStatusLine[LCD_WIDTH];
+uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+char    gInputBox[8];
+uint8_t gInputBoxIndex;
+
+int sprintf_(char *buffer, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const int n = vsprintf(buffer, format, args);
+    va_end(args);
+    return n;
+}
+
+// ---- reference, one memcpy per character and no clipping ----
+
+__attribute__((noinline)) static void OldPrintStringBuffer(const char *pString, uint8_t *buffer, uint32_t char_width, const uint8_t *font)
+{
+    const size_t Length = strlen(pString);
+    const unsigned int char_spacing = char_width + 1;
+    for (size_t i = 0; i < Length; i++) {
+        const unsigned int index = pString[i] - ' ' - 1;
+        if (pString[i] > ' ' && pString[i] < 127)
+            memcpy(buffer + i * char_spacing + 1, font + index * char_width, char_width);
+    }
+}
+
+__attribute__((noinline)) static void OldPrintString(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, uint8_t Width)
+{
+    size_t Length = strlen(pString);
+    if (End > Start)
+        Start += (((End - Start) - (Length * Width)) + 1) / 2;
+    for (size_t i = 0; i < Length; i++) {
+        const unsigned int ofs = (unsigned int)Start + (i * Width);
+        if (pString[i] > ' ' && pString[i] < 127) {
+            const unsigned int index = pString[i] - ' ' - 1;
+            memcpy(gFrameBuffer[Line + 0] + ofs, &gFontBig[index][0], 7);
+            memcpy(gFrameBuffer[Line + 1] + ofs, &gFontBig[index][7], 7);
+        }
+    }
+}
+
+__attribute__((noinline)) static void OldPrintStringSmall(const char *pString, uint8_t Start, uint8_t End, uint8_t Line, const uint8_t *font)
+{
+    const size_t Length = strlen(pString);
+    if (End > Start)
+        Start += (((End - Start) - Length * 7) + 1) / 2;
+    OldPrintStringBuffer(pString, gFrameBuffer[Line] + Start, 6, font);
+}
+
+__attribute__((noinline)) static void OldDisplaySmallest(const char *pString, uint8_t x, uint8_t y, bool statusbar, bool fill)
+{
+    uint8_t c;
+    const uint8_t *p = (const uint8_t *)pString;
+    while ((c = *p++)) {
+        c -= 0x20;
+        for (int i = 0; i < 3; ++i) {
+            uint8_t pixels = gFont3x5[c][i];
+            for (int j = 0; j < 6; ++j) {
+                if (pixels & 1) {
+                    uint8_t *pByte = statusbar ? &gStatusLine[x + i] : &gFrameBuffer[(y + j) / 8][x + i];
+                    const uint8_t bit = 1 << ((y + j) % 8);
+                    *pByte = fill ? (*pByte | bit) : (*pByte & ~bit);
+                }
+                pixels >>= 1;
+            }
+        }
+        x += 4;
+    }
+}
+
+// ---- the main screen, both VFOs, the center line and the status line ----
+
+#define SCREEN(PRINT, SMALL, BOLD, BUFFER, SMALLEST)                         \
+    PRINT("145.50000", 32, 0, 0, 8);                                         \
+    PRINT("CH-012", 32, 0, 4, 8);                                            \
+    SMALL("M12", 2, 0, 1);                                                   \
+    SMALL("F2", 2, 0, 5);                                                    \
+    SMALL("433.00000", 36, 0, 5);                                            \
+    SMALL("FM", LCD_WIDTH + 22, 0, 1);                                       \
+    SMALL("88.5", LCD_WIDTH + 2, 0, 1);                                      \
+    SMALL("H", LCD_WIDTH + 42, 0, 1);                                        \
+    SMALL("+", LCD_WIDTH + 60, 0, 1);                                        \
+    SMALL("W", LCD_WIDTH + 80, 0, 1);                                        \
+    SMALL("SQL5", LCD_WIDTH + 98, 0, 1);                                     \
+    SMALL("NFM", LCD_WIDTH + 22, 0, 5);                                      \
+    SMALL("D023N", LCD_WIDTH + 2, 0, 5);                                     \
+    SMALL("DTMF 1234*#", 2, 0, 3);                                           \
+    BOLD("VFO A", 92, 0, 6);                                                 \
+    BUFFER("12:34", gStatusLine + 44);                                       \
+    BUFFER("7.9v", gStatusLine + 100);                                       \
+    SMALLEST("-123 dBm", 2, 25, false, true);                                \
+    SMALLEST("88.5", 58, 17, false, true);                                   \
+    SMALLEST("SQL5", 110, 49, false, true);                                  \
+    SMALLEST("2.50K", 2, 1, true, true);                                     \
+    PRINT("Long press #", 0, LCD_WIDTH, 1, 8);
+
+#define OLD_SMALL(S, A, B, L)   OldPrintStringSmall(S, A, B, L, (const uint8_t *)gFontSmall)
+#define OLD_BOLD(S, A, B, L)    OldPrintStringSmall(S, A, B, L, (const uint8_t *)gFontSmallBold)
+#define OLD_BUFFER(S, P)        OldPrintStringBuffer(S, P, 6, (const uint8_t *)gFontSmall)
+
+static void OldScreen(void)
+{
+    SCREEN(OldPrintString, OLD_SMALL, OLD_BOLD, OLD_BUFFER, OldDisplaySmallest)
+}
+
+static void NewScreen(void)
+{
+    SCREEN(UI_PrintString, UI_PrintStringSmallNormal, UI_PrintStringSmallBold,
+           UI_PrintStringSmallBufferNormal, GUI_DisplaySmallest)
+}
+
+static void Clear(void)
+{
+    memset(gStatusLine, 0, sizeof(gStatusLine));
+    memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+}
+
+static double Batch(void (*pScreen)(void), long Rounds)
+{
+    struct timespec Start, End;
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    for (long i = 0; i < Rounds; i++) {
+        Clear();
+        pScreen();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &End);
+    return ((End.tv_sec - Start.tv_sec) * 1e9 + (End.tv_nsec - Start.tv_nsec)) / Rounds;
+}
+
+// best of a few batches, the host is shared and the first batches are
+// noisy. The two take turns, so that a slow spell of the host hits both.
+static void Time(void (*pOld)(void), void (*pNew)(void), long Rounds, double *pOldNs, double *pNewNs)
+{
+    for (int i = 0; i < BATCHES; i++) {
+        const double Old = Batch(pOld, Rounds);
+        const double New = Batch(pNew, Rounds);
+        if (i == 0 || Old < *pOldNs)
+            *pOldNs = Old;
+        if (i == 0 || New < *pNewNs)
+            *pNewNs = New;
+    }
+}
+
+#ifdef ENABLE_PACKED_FONTS
+    #define PACKED ", packed fonts"
+#else
+    #define PACKED ""
+#endif
+
+#ifdef ENABLE_PROPORTIONAL_FONT
+// Channel names as the main screen shows them, fixed and proportional
+static const char *const Names[] = {
+    "CH-012", "REPEATER 1", "Marine 16", "PMR 8", "WX NOAA 3",
+    "Airband", "MLK Tower", "Simplex", "W1AW/R", "iiiillll",
+};
+
+#define NAME_COUNT (sizeof(Names) / sizeof(Names[0]))
+
+// the ink columns of each glyph one after the other, a gap between them
+// and half a cell for a space
+__attribute__((noinline)) static int PropReference(const char *pString, int X, uint8_t Line, const uint8_t (*pGlyphs)[6], const uint8_t *pMetrics)
+{
+    for (; *pString; pString++) {
+        const unsigned int c = (uint8_t)*pString;
+        if (c <= ' ' || c > '~') {
+            X += 3;
+            continue;
+        }
+        const uint8_t m = pMetrics[c - '!'];
+        for (unsigned int i = 0; i < m >> 4u; i++)
+            if (X + i < LCD_WIDTH)
+                gFrameBuffer[Line][X + i] = pGlyphs[c - '!'][(m & 15) + i];
+        X += (m >> 4) + 1;
+    }
+    return X;
+}
+
+static void FixedNames(void)
+{
+    for (unsigned int i = 0; i < NAME_COUNT; i++)
+        UI_PrintStringSmallNormal(Names[i], 32 + 4, 0, i % FRAME_LINES);
+}
+
+static void PropNames(void)
+{
+    for (unsigned int i = 0; i < NAME_COUNT; i++)
+        UI_PrintStringSmallProp(Names[i], 32 + 4, 0, i % FRAME_LINES);
+}
+
+static int CheckProportional(long Rounds)
+{
+    uint8_t      Frame[FRAME_LINES][LCD_WIDTH];
+    int          Failed = 0;
+    unsigned int Fixed  = 0;
+    unsigned int Prop   = 0;
+
+    for (unsigned int i = 0; i < NAME_COUNT; i++) {
+        const unsigned int Width = UI_GetTextWidth(&gTextFontSmallProp, Names[i], 7);
+
+        Clear();
+        const int End = PropReference(Names[i], 37, 3, gFontSmall, gFontSmallMetrics);
+        memcpy(Frame, gFrameBuffer, sizeof(Frame));
+        Clear();
+        const int Got = UI_DrawText(gFrameBuffer, FRAME_LINES, &gTextFontSmallProp, Names[i], 37, 3 * 8, 7, UI_TEXT_SET);
+
+        if (memcmp(Frame, gFrameBuffer, sizeof(Frame)) || Got != End || Got - 37 != (int)Width) {
+            printf("[!] proportional \"%s\" differs from the reference\n", Names[i]);
+            Failed = 1;
+        }
+
+        // shifted and clipped at the right edge the columns stay the same
+        Clear();
+        UI_DrawText(gFrameBuffer, FRAME_LINES, &gTextFontSmallProp, Names[i], 100, 21, 7, UI_TEXT_OR);
+        for (int x = 100; x < LCD_WIDTH; x++) {
+            const unsigned int Column = (gFrameBuffer[2][x] | gFrameBuffer[3][x] << 8) >> 5;
+            if (Column != Frame[3][x - 63]) {
+                printf("[!] shifted proportional \"%s\" differs at column %d\n", Names[i], x);
+                Failed = 1;
+                break;
+            }
+        }
+
+        Fixed += UI_GetTextWidth(&gTextFontSmall, Names[i], 7);
+        Prop  += Width;
+    }
+
+    printf("[*] proportional names %s, %u columns against %u fixed (%.0f%%)\n",
+           Failed ? "differ" : "match the reference", Prop, Fixed, 100.0 * Prop / Fixed);
+
+    double Old, New;
+    Time(FixedNames, PropNames, Rounds, &Old, &New);
+    printf("    fixed names     %8.0f ns\n", Old);
+    printf("    proportional    %8.0f ns  (%.2fx)%s\n", New, Old / New, PACKED);
+    return Failed;
+}
+#endif
+
+int main(void)
+{
+    uint8_t Status[LCD_WIDTH], Frame[FRAME_LINES][LCD_WIDTH];
+    int     Failed = 0;
+
+    Clear();
+    OldScreen();
+    memcpy(Status, gStatusLine, sizeof(Status));
+    memcpy(Frame, gFrameBuffer, sizeof(Frame));
+    Clear();
+    NewScreen();
+
+    if (memcmp(Status, gStatusLine, sizeof(Status))) {
+        printf("[!] status line differs from the reference\n");
+        Failed = 1;
+    }
+    for (int Line = 0; Line < FRAME_LINES; Line++) {
+        if (memcmp(Frame[Line], gFrameBuffer[Line], LCD_WIDTH)) {
+            printf("[!] line %d differs from the reference\n", Line);
+            Failed = 1;
+        }
+    }
+
+    // a run past the right edge stops there instead of going on into the
+    // next line, and shifted text lands across two pages
+    Clear();
+    UI_PrintStringSmallNormal("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 100, 0, 2);
+    UI_PrintString("WIDE TEXT", 100, 0, 5, 8);
+    for (int i = 0; i < LCD_WIDTH; i++) {
+        if (gFrameBuffer[3][i] || gFrameBuffer[0][i]) {
+            printf("[!] text past the right edge reached the next line\n");
+            Failed = 1;
+            break;
+        }
+    }
+
+    Clear();
+    UI_DrawText(gFrameBuffer, FRAME_LINES, &gTextFontSmall, "8", 10, 19, 7, UI_TEXT_SET);
+    for (int Column = 0; Column < 6; Column++) {
+        const unsigned int Glyph = gFontSmall['8' - '!'][Column];
+        const unsigned int Got   = gFrameBuffer[2][10 + Column] | gFrameBuffer[3][10 + Column] << 8;
+        if (Got != Glyph << 3) {
+            printf("[!] shifted glyph column %d is %04x, want %04x\n", Column, Got, Glyph << 3);
+            Failed = 1;
+        }
+    }
+
+    printf("[*] %s\n", Failed ? "output differs" : "output matches the reference, clipped runs stay on their line");
+
+#ifdef ENABLE_PACKED_FONTS
+    // main screen while scanning. Only the widgets that change are drawn
+    // again: every frame the VFO with its new frequency and RSSI, every
+    // tenth the status line timer, now and then the other VFO
+    uint32_t Hits, Misses, ColdHits, ColdMisses;
+    char     Frequency[16], Rssi[16], Timer[8];
+
+    UI_GetGlyphCacheStats(&ColdHits, &ColdMisses);
+    srand(1);
+    for (int Frame = 0; Frame < 1000; Frame++) {
+        const unsigned int f = 43000000 + (rand() % 400) * 1250;
+        sprintf(Frequency, "%u.%05u", f / 100000, f % 100000);
+        sprintf(Rssi, "%d", -60 - rand() % 70);
+        UI_PrintString(Frequency, 32, 0, 0, 8);
+        UI_PrintStringSmallNormal("M12", 2, 0, 1);
+        UI_PrintStringSmallNormal("FM", LCD_WIDTH + 22, 0, 1);
+        UI_PrintStringSmallNormal("SQL5", LCD_WIDTH + 98, 0, 1);
+        UI_PrintStringSmallNormal(Rssi, LCD_WIDTH + 2, 0, 2);
+        if (Frame % 10 == 0) {
+            sprintf(Timer, "%02u:%02u", Frame / 600 % 60, Frame / 10 % 60);
+            UI_PrintStringSmallBufferNormal(Timer, gStatusLine + 44);
+        }
+        if (Frame % 50 == 0) {
+            UI_PrintString("CH-012", 32, 0, 4, 8);
+            UI_PrintStringSmallNormal("NFM", LCD_WIDTH + 22, 0, 5);
+            UI_PrintStringSmallBold("SCAN", 92, 0, 6);
+        }
+    }
+    UI_GetGlyphCacheStats(&Hits, &Misses);
+    Hits -= ColdHits;
+    Misses -= ColdMisses;
+    printf("[*] glyph cache, %d slots: %.1f%% hits over 1000 scan frames (%u hits, %u misses)\n",
+           UI_GLYPH_CACHE_SIZE, 100.0 * Hits / (Hits + Misses), Hits, Misses);
+#endif
+
+    const long Rounds = ROUNDS;
+    double Old, New;
+    Time(OldScreen, NewScreen, Rounds, &Old, &New);
+    printf("[*] main screen text, best of %d batches of %ld on the host\n", BATCHES, Rounds);
+    printf("    per character   %8.0f ns\n", Old);
+    printf("    glyph runs      %8.0f ns  (%.2fx)%s\n", New, Old / New, PACKED);
+#ifdef ENABLE_PROPORTIONAL_FONT
+    Failed |= CheckProportional(Rounds);
+#endif
+    return Failed;
+}
+'''
+
+
+def build(cc, tmp, rounds, batches, packed, cache, proportional):
+    """Harness binary. font.c always keeps its plain tables for the reference,
+    the renderer reads the packed ones when asked to."""
+    defines = DEFINES + [f'-DROUNDS={rounds}L', f'-DBATCHES={batches}']
+    if packed:
+        defines += ['-DENABLE_PACKED_FONTS', f'-DUI_GLYPH_CACHE_SIZE={cache}']
+    if proportional:
+        defines += ['-DENABLE_PROPORTIONAL_FONT']
+
+    harness = os.path.join(tmp, 'harness.c')
+    binary = os.path.join(tmp, f'harness{cache if packed else ""}')
+    with open(harness, 'w') as f:
+        f.write(HARNESS)
+
+    units = [(harness, defines), (os.path.join(APP, 'font.c'), DEFINES)]
+    units += [(source, defines) for source in SOURCES if not source.endswith('font.c')]
+    if packed:
+        units.append((os.path.join(APP, 'font_packed.c'), defines))
+    if proportional:
+        units.append((os.path.join(APP, 'font_metrics.c'), defines))
+
+    objects = []
+    for i, (source, flags) in enumerate(units):
+        obj = os.path.join(tmp, f'{i}.o')
+        result = subprocess.run([cc, '-std=gnu11', '-O2', f'-I{APP}', *flags, '-c', source, '-o', obj],
+                                capture_output=True, text=True)
+        if result.returncode:
+            raise RuntimeError(result.stderr)
+        objects.append(obj)
+
+    result = subprocess.run([cc, *objects, '-o', binary], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(result.stderr)
+    return binary
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Render the main screen text with the glyph run renderer on the host, check and time it.')
+    parser.add_argument('-cc', default=os.environ.get('CC', 'cc'), help='host C compiler (default: %(default)s)')
+    parser.add_argument('-rounds', type=int, default=50000, help='screens drawn per timing batch (default: %(default)s)')
+    parser.add_argument('-batches', type=int, default=16, help='timing batches of each renderer, the best counts (default: %(default)s)')
+    parser.add_argument('-packed', action='store_true', help='render from the packed fonts through the glyph cache')
+    parser.add_argument('-proportional', action='store_true', help='also check and time the proportional small font')
+    parser.add_argument('-cache', type=int, nargs='+', default=[16], help='glyph cache sizes tried with -packed (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.rounds <= 0 or args.batches <= 0 or any(c <= 0 or c & (c - 1) for c in args.cache):
+        print("[!] rounds and batches must be positive and cache sizes powers of two")
+        sys.exit(1)
+
+    failed = 0
+    with tempfile.TemporaryDirectory() as tmp:
+        for cache in (args.cache if args.packed else [0]):
+            try:
+                binary = build(args.cc, tmp, args.rounds, args.batches, args.packed, cache, args.proportional)
+            except OSError as e:
+                print(f"[!] Cannot run {args.cc}: {e}")
+                sys.exit(1)
+            except RuntimeError as e:
+                print(f"[!] Build failed\n{e}")
+                sys.exit(1)
+            failed |= subprocess.run([binary]).returncode
+
+    sys.exit(failed)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+import sys
+import time
+import struct
+import argparse
+
+import serial
+
+# Version
+VERSION = '1.0'
+
+# Serial configuration
+DEFAULT_PORT = '/dev/ttyUSB0'
+BAUDRATE = 38400
+TIMEOUT = 2
+
+OBFUSCATION = bytes([0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40,
+                     0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80])
+
+def crc16(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def obfuscate(data):
+    return bytes(b ^ OBFUSCATION[i % len(OBFUSCATION)] for i, b in enumerate(data))
+
+
+def send(ser, msg_id, payload):
+    msg = struct.pack('<HH', msg_id, len(payload)) + payload
+    if len(msg) % 2:
+        msg += b'\x00'
+    body = msg + struct.pack('<H', crc16(msg))
+    ser.write(b'\xab\xcd' + struct.pack('<H', len(msg)) + obfuscate(body) + b'\xdc\xba')
+
+
+def receive(ser, msg_id):
+    buf = b''
+    deadline = time.time() + TIMEOUT
+    while time.time() < deadline:
+        buf += ser.read(ser.in_waiting or 1)
+        start = buf.find(b'\xab\xcd')
+        if start < 0 or len(buf) - start < 8:
+            continue
+        size = struct.unpack_from('<H', buf, start + 2)[0]
+        end = start + 4 + size + 2
+        if len(buf) < end + 2:
+            continue
+        msg = obfuscate(buf[start + 4:end])[:size]
+        buf = buf[end + 2:]
+        if struct.unpack_from('<H', msg)[0] == msg_id:
+            return msg[4:]
+    return None
+
+
+# ProfilerSlot_t (App/ui/profiler.h) after its 4 character name
+BUCKETS = 12
+FIRST_BOUND = 1024
+SLOT = struct.Struct(f'<4sIIII{BUCKETS}H')
+
+# SysTick counts the 48 MHz core clock
+CYCLES_PER_US = 48
+
+# 0 off, 1 on, anything else leaves it
+OVERLAY = {'on': 1, 'off': 0, None: 0xFF}
+
+
+def read(ser, timestamp):
+    """All slots, 3 per reply."""
+    slots = []
+    count = 1
+    shown = False
+    while len(slots) < count:
+        send(ser, 0x054E, timestamp + struct.pack('<BBBx', len(slots), 0, OVERLAY[None]))
+        reply = receive(ser, 0x054F)
+        if reply is None or len(reply) < 4:
+            return None, None
+        count, index, shown = struct.unpack_from('<BB?', reply)
+        entries = (len(reply) - 4) // SLOT.size
+        if index != len(slots) or (not entries and len(slots) < count):
+            return None, None
+        for i in range(entries):
+            name, calls, last, avg, worst, *buckets = SLOT.unpack_from(reply, 4 + i * SLOT.size)
+            slots.append((name.rstrip(b'\0').decode('ascii', 'replace'), calls, last, avg, worst, buckets))
+    return slots, shown
+
+
+def percentile(buckets, share):
+    """Upper bound in us of the bucket the share of calls falls in."""
+    total = sum(buckets)
+    seen = 0
+    for b, n in enumerate(buckets):
+        seen += n
+        if seen >= share * total:
+            return (FIRST_BOUND << b) / CYCLES_PER_US if b < BUCKETS - 1 else float('inf')
+    return 0.0
+
+
+def bar(buckets):
+    """One character per bucket, blank to full."""
+    shades = ' .:-=+*#'
+    top = max(buckets) or 1
+    return ''.join(shades[min(len(shades) - 1, (n * (len(shades) - 1) + top - 1) // top)] for n in buckets)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Read the UI frame time histograms (ENABLE_UI_PROFILER).')
+    parser.add_argument('-port', default=DEFAULT_PORT, help='serial port (default: %(default)s)')
+    parser.add_argument('-clear', action='store_true', help='clear the histograms after reading them')
+    parser.add_argument('-overlay', choices=['on', 'off'], help='show or hide the slowest screen in the status line')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    try:
+        ser = serial.Serial(args.port, BAUDRATE, timeout=0.1)
+    except serial.SerialException as e:
+        print(f"[!] Cannot open {args.port}: {e}")
+        sys.exit(1)
+
+    # session handshake, later commands must carry the same timestamp
+    timestamp = struct.pack('<I', int(time.time()) & 0xFFFFFFFF)
+    send(ser, 0x0514, timestamp)
+    if receive(ser, 0x0515) is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    slots, shown = read(ser, timestamp)
+    if slots is None:
+        print("[!] No answer from the radio")
+        sys.exit(1)
+
+    # past the last slot, nothing comes back but the clear and the overlay
+    if args.clear or args.overlay:
+        send(ser, 0x054E, timestamp + struct.pack('<BBBx', len(slots), args.clear, OVERLAY[args.overlay]))
+        reply = receive(ser, 0x054F)
+        if reply is None:
+            print("[!] No answer from the radio")
+            sys.exit(1)
+        shown = struct.unpack_from('<BB?', reply)[2]
+
+    print(f"[*] {len(slots)} slots, overlay {'on' if shown else 'off'}, us per call")
+    print(f"    slot       calls      last       avg       max    p50 <=    p90 <=  {FIRST_BOUND // CYCLES_PER_US}us..")
+    for name, calls, last, avg, worst, buckets in slots:
+        if not calls:
+            continue
+        print(f"    {name:<6} {calls:9d} {last / CYCLES_PER_US:9.0f} {avg / CYCLES_PER_US:9.0f} {worst / CYCLES_PER_US:9.0f}"
+              f" {percentile(buckets, 0.5):9.0f} {percentile(buckets, 0.9):9.0f}  |{bar(buckets)}|")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,762 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import sys
+import zlib
+import struct
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'spectrum_bench'))
+import hostbuild  # noqa: E402
+import spectrum_host  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# The UI modules and the state behind them, built for the host. Drivers and
+# the app modules the screens read from are stubbed, the SPI flash is a RAM
+# image so that settings.c loads its defaults and stores channels as usual.
+CORE = ['ui/battery.c', 'ui/helper.c', 'ui/inputbox.c', 'ui/main.c', 'ui/menu.c', 'ui/scanner.c',
+        'ui/status.c', 'ui/ui.c', 'ui/welcome.c', 'misc.c', 'settings.c', 'radio.c', 'functions.c',
+        'font.c', 'bitmaps.c', 'frequencies.c', 'dcs.c', 'version.c', 'helper/format.c',
+        'helper/battery.c', 'app/dtmf.c', 'external/printf/printf.c']
+
+# Golden images of the Custom preset live with the tool. Timings depend on
+# the host, their baseline stays in the build directory. -base checks the
+# renderer itself: the states the upstream tree can render come out the
+# same here when both are built with the options of its preset.
+BASE = 'f436e67'
+GOLDEN = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'goldens')
+TIMINGS = os.path.join(hostbuild.ROOT, 'build', 'ui_timings.txt')
+
+WIDTH = 128
+HEIGHT = 64
+
+# The image of a screen, written by both harnesses
+PBM = r'''
+#include <stdio.h>
+
+#include "driver/st7565.h"
+
+// status line on top, the frame buffer pages below, one bit per pixel
+static int WritePbm(const char *pDir, const char *pName)
+{
+    char  Path[512];
+    snprintf(Path, sizeof(Path), "%s/%s.pbm", pDir, pName);
+    FILE *f = fopen(Path, "wb");
+    if (!f)
+        return 1;
+
+    fprintf(f, "P4\n%d %d\n", LCD_WIDTH, 8 * (FRAME_LINES + 1));
+    for (int y = 0; y < 8 * (FRAME_LINES + 1); y++) {
+        const uint8_t *pPage = y < 8 ? gStatusLine : gFrameBuffer[y / 8 - 1];
+        for (int x = 0; x < LCD_WIDTH; x += 8) {
+            uint8_t Byte = 0;
+            for (int i = 0; i < 8; i++)
+                Byte |= ((pPage[x + i] >> (y % 8)) & 1u) << (7 - i);
+            fputc(Byte, f);
+        }
+    }
+    return fclose(f) != 0;
+}
+'''
+
+# Scripted states. Each one boots from a blank flash image, sets its state
+# and draws the screen and the status line once for the image, then again
+# in batches for the timing. The main screen states also make the change
+# the radio draws in part, a frequency step of the scanner, a channel step
+# or an S-meter tick. Drawn in part it has to match a full redraw, and it
+# is timed on its own.
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "app/scanner.h"
+#ifdef ENABLE_FAST_CAPTURE
+    #include "app/capture.h"
+#endif
+#ifdef ENABLE_SCAN_STATS
+    #include "app/scanstats.h"
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    #include "app/scanjournal.h"
+#endif
+#include "dcs.h"
+#include "driver/bk4819.h"
+#include "driver/py25q16.h"
+#include "driver/st7565.h"
+#include "functions.h"
+#include "helper/battery.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+#include "ui/main.h"
+#include "ui/menu.h"
+#include "ui/status.h"
+#include "ui/ui.h"
+
+uint8_t gStatusLine[LCD_WIDTH];
+uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
+
+// ---- drivers the screens read back ----
+
+static uint8_t Flash[0x200000];
+static int16_t StubRssi = -130;
+
+void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
+{
+    memcpy(pBuffer, Flash + Address, Size);
+}
+
+void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append)
+{
+    (void)Append;
+    memcpy(Flash + Address, pBuffer, Size);
+}
+
+void PY25Q16_SectorErase(uint32_t Address)
+{
+    memset(Flash + (Address & ~0xFFFu), 0xFF, 0x1000);
+}
+
+int16_t BK4819_GetRSSI_dBm(void)
+{
+    return StubRssi;
+}
+
+uint16_t BK4819_GetRSSI(void)
+{
+    return (StubRssi + 160) * 2;
+}
+
+int16_t map(int16_t x, int16_t in_min, int16_t in_max, int16_t out_min, int16_t out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ---- app modules behind the scanner screens ----
+
+#ifdef ENABLE_FAST_CAPTURE
+static const CaptureResult_t Lock = {14652000, 1400, 87};
+
+const CaptureResult_t *CAPTURE_GetLast(void)
+{
+    return &Lock;
+}
+#endif
+
+#ifdef ENABLE_SCAN_STATS
+static const ScanStat_t Stats[] = {
+    {11,                 3500, 1220, 48, 92,  0},
+    {14652000 / 250 * 250, 3580, 96,   7, 71,  0},
+    {2,                  2900, 3400, 31, 104, 0},
+    {44600625 / 250 * 250, 3595, 12,   2, 58,  0},
+    {40,                 1200, 40,    1, 66,  0},
+};
+
+#define STATS_COUNT (sizeof(Stats) / sizeof(Stats[0]))
+
+uint32_t SCANSTATS_GetClock(void)
+{
+    return 3600;
+}
+
+const ScanStat_t *SCANSTATS_Get(void)
+{
+    return Stats;
+}
+
+uint8_t SCANSTATS_GetCount(void)
+{
+    return STATS_COUNT;
+}
+
+uint8_t SCANSTATS_Rank(uint8_t *pOrder)
+{
+    static const uint8_t Order[] = {0, 2, 1, 3, 4};
+    memcpy(pOrder, Order, STATS_COUNT);
+    return STATS_COUNT;
+}
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+static const ScanJournalEntry_t Journal[] = {
+    {3590, 11,       14, 92,  CODE_TYPE_CONTINUOUS_TONE, 8, 0, 0, 0},
+    {3420, 14652000, 3,  71,  SCAN_JOURNAL_NO_CODE,      0, 0, 0, 0},
+    {2900, 2,        62, 104, CODE_TYPE_DIGITAL,         19, 0, 0, 0},
+    {1200, 44600625, 1,  58,  SCAN_JOURNAL_NO_CODE,      0, 0, 0, 0},
+};
+
+#define JOURNAL_COUNT (sizeof(Journal) / sizeof(Journal[0]))
+
+uint32_t SCANJOURNAL_GetClock(void)
+{
+    return 3600;
+}
+
+uint16_t SCANJOURNAL_GetCount(void)
+{
+    return JOURNAL_COUNT;
+}
+
+bool SCANJOURNAL_Get(uint16_t Index, ScanJournalEntry_t *pEntry)
+{
+    if (Index >= JOURNAL_COUNT)
+        return false;
+    *pEntry = Journal[Index];
+    return true;
+}
+#endif
+
+// ---- states ----
+
+static void Boot(void)
+{
+    memset(Flash, 0xFF, sizeof(Flash));
+    SETTINGS_InitEEPROM();
+
+    // as main.c counts them, hidden items left out
+    gMenuListCount = 0;
+    while (MenuList[gMenuListCount].name[0] != '\0' && MenuList[gMenuListCount].menu_id != FIRST_HIDDEN_MENU_ITEM)
+        gMenuListCount++;
+
+    gBatteryVoltageAverage = 780;
+    gBatteryDisplayLevel   = 5;
+    gCurrentFunction       = FUNCTION_FOREGROUND;
+    gScreenToDisplay       = DISPLAY_MAIN;
+    gIsInSubMenu           = false;
+    StubRssi               = -130;
+
+    RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
+    RADIO_ConfigureChannel(1, VFO_CONFIGURE_RELOAD);
+    RADIO_SelectVfos();
+}
+
+static void MainDual(void)
+{
+}
+
+static void MainSingle(void)
+{
+    gEeprom.DUAL_WATCH       = DUAL_WATCH_OFF;
+    gEeprom.CROSS_BAND_RX_TX = CROSS_BAND_OFF;
+}
+
+static void StoreChannel(uint8_t Channel, uint32_t Frequency, const char *pName)
+{
+    VFO_Info_t Vfo = gEeprom.VfoInfo[0];
+
+    Vfo.freq_config_RX.Frequency = Frequency;
+    Vfo.freq_config_TX.Frequency = Frequency;
+    SETTINGS_SaveChannel(Channel, 0, &Vfo, 2);
+    SETTINGS_SaveChannelName(Channel, pName);
+}
+
+static void MainNames(void)
+{
+    StoreChannel(11, 14652000, "REPEATER 1");
+    StoreChannel(12, 14662500, "REPEATER 2");
+    StoreChannel(40, 44600625, "PMR 8");
+
+    gEeprom.CHANNEL_DISPLAY_MODE = MDF_NAME_FREQ;
+    for (unsigned int Vfo = 0; Vfo < 2; Vfo++) {
+        gEeprom.ScreenChannel[Vfo] = Vfo ? 40 : 11;
+        gEeprom.MrChannel[Vfo]     = Vfo ? 40 : 11;
+        RADIO_ConfigureChannel(Vfo, VFO_CONFIGURE_RELOAD);
+    }
+    RADIO_SelectVfos();
+}
+
+static void MainRx(void)
+{
+    gCurrentFunction = FUNCTION_RECEIVE;
+    gRxVfoIsActive   = true;
+    StubRssi         = -87;
+}
+
+#ifdef ENABLE_UI_WIDGETS
+// ---- changes drawn in part ----
+
+static void StepFrequency(void)
+{
+    static int Step = 1250;
+
+    gEeprom.VfoInfo[0].freq_config_RX.Frequency += Step;
+    Step = -Step;
+
+    // what the scanner asks for on a frequency step
+    UI_MAIN_Invalidate(MAIN_WIDGET_FREQ(0) | MAIN_WIDGET_CHANNEL(0));
+    UI_MAIN_UpdateWidgets();
+}
+
+static void StepChannel(void)
+{
+    const uint16_t Channel = (gEeprom.ScreenChannel[0] == 11) ? 12 : 11;
+
+    gEeprom.ScreenChannel[0] = Channel;
+    gEeprom.MrChannel[0]     = Channel;
+    RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
+
+    UI_MAIN_Invalidate(MAIN_WIDGET_VFO(0));
+    UI_MAIN_UpdateWidgets();
+}
+
+static void TickMeter(void)
+{
+    StubRssi = (StubRssi == -87) ? -85 : -87;
+    UI_MAIN_TimeSlice500ms();
+}
+#else
+    #define StepFrequency NULL
+    #define StepChannel   NULL
+    #define TickMeter     NULL
+#endif
+
+static void Menu(void)
+{
+    gScreenToDisplay  = DISPLAY_MENU;
+    gMenuCursor       = UI_MENU_GetMenuIdx(MENU_SQL);
+    gSubMenuSelection = gEeprom.SQUELCH_LEVEL;
+}
+
+static void MenuEdit(void)
+{
+    Menu();
+    gIsInSubMenu      = true;
+    gSubMenuSelection = 6;
+}
+
+static void Scanner(void)
+{
+    gScreenToDisplay       = DISPLAY_SCANNER;
+    gScanSingleFrequency   = false;
+    gScanCssState          = SCAN_CSS_STATE_FOUND;
+    gScanUseCssResult      = true;
+    gScanFrequency         = 14652000;
+    gScanCssResultType     = CODE_TYPE_CONTINUOUS_TONE;
+    gScanCssResultCode     = 8;
+    gScannerSaveState      = SCAN_SAVE_NO_PROMPT;
+}
+
+#ifdef ENABLE_SCAN_STATS
+static void ScanStats(void)
+{
+    gScreenToDisplay = DISPLAY_SCAN_STATS;
+    gScanStatsCursor = 1;
+}
+#endif
+
+#ifdef ENABLE_SCAN_JOURNAL
+static void ScanJournal(void)
+{
+    gScreenToDisplay   = DISPLAY_SCAN_JOURNAL;
+    gScanJournalCursor = 2;
+}
+#endif
+
+static const struct {
+    const char *pName;
+    void      (*pSetup)(void);
+    void      (*pUpdate)(void);
+} States[] = {
+    {"main_dual",    MainDual,    StepFrequency},
+    {"main_single",  MainSingle,  StepFrequency},
+    {"main_names",   MainNames,   StepChannel},
+    {"main_rx",      MainRx,      TickMeter},
+    {"menu",         Menu,        NULL},
+    {"menu_edit",    MenuEdit,    NULL},
+    {"scanner",      Scanner,     NULL},
+#ifdef ENABLE_SCAN_STATS
+    {"scan_stats",   ScanStats,   NULL},
+#endif
+#ifdef ENABLE_SCAN_JOURNAL
+    {"scan_journal", ScanJournal, NULL},
+#endif
+};
+
+static void Clear(void)
+{
+    memset(gStatusLine, 0, sizeof(gStatusLine));
+    memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
+}
+
+// best of a few batches, the host is shared and the first batches are noisy
+static double Time(void (*pDraw)(void), long Rounds)
+{
+    double Best = 0;
+    for (int Batch = 0; Batch < 8; Batch++) {
+        struct timespec Start, End;
+        clock_gettime(CLOCK_MONOTONIC, &Start);
+        for (long i = 0; i < Rounds; i++)
+            pDraw();
+        clock_gettime(CLOCK_MONOTONIC, &End);
+        const double Ns = ((End.tv_sec - Start.tv_sec) * 1e9 + (End.tv_nsec - Start.tv_nsec)) / Rounds;
+        if (Batch == 0 || Ns < Best)
+            Best = Ns;
+    }
+    return Best;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+        return 2;
+
+    const long Rounds = atol(argv[2]);
+
+    for (unsigned int i = 0; i < sizeof(States) / sizeof(States[0]); i++) {
+        Boot();
+        States[i].pSetup();
+
+        Clear();
+        GUI_DisplayScreen();
+        UI_DisplayStatus();
+        if (WritePbm(argv[1], States[i].pName)) {
+            printf("[!] can not write %s\n", States[i].pName);
+            return 1;
+        }
+
+        const double Screen = Time(GUI_DisplayScreen, Rounds);
+        const double Status = Time(UI_DisplayStatus, Rounds);
+
+        char Update[16] = "-";
+        if (States[i].pUpdate) {
+            static uint8_t Drawn[FRAME_LINES][LCD_WIDTH];
+
+            States[i].pUpdate();
+            memcpy(Drawn, gFrameBuffer, sizeof(Drawn));
+            Clear();
+            GUI_DisplayScreen();
+            if (memcmp(Drawn, gFrameBuffer, sizeof(Drawn)))
+                strcpy(Update, "differs");
+            else
+                snprintf(Update, sizeof(Update), "%.0f", Time(States[i].pUpdate, Rounds));
+        }
+        printf("%s %.0f %.0f %s\n", States[i].pName, Screen, Status, Update);
+    }
+    return 0;
+}
+'''
+
+# The spectrum runs on the BK4819 register model of spectrum_host, with the
+# carriers below, until the frame of a state is blitted. A state may hold a
+# key from a given frame on, then the image is written and EXIT held until
+# the spectrum returns. It is not timed, spectrum_host measures the sweeps.
+SPECTRUM_PRESET = 'Bandscope'
+SPECTRUM_MODEL = spectrum_host.model_argv(434e6, 30, 900, 2600, 330, -125, 0, 60,
+                                          [spectrum_host.parse_carrier(c) for c in
+                                           ('434e6:12500:-80', '434.4e6:25000:-100')])
+
+SPECTRUM = spectrum_host.MODEL + r'''
+static const struct {
+    const char *pName;
+    KEY_Code_t  Key;
+    long        KeyFrame;
+    long        Frame;
+} States[] = {
+    {"spectrum",       KEY_INVALID, 0, 4},
+    {"spectrum_still", KEY_PTT,     2, 6},
+};
+
+static unsigned int Shown;
+static long         Frames;
+static int          Held;
+static const char  *pDir;
+static bool         Failed;
+
+void ST7565_BlitFullScreen(void)
+{
+    Advance(BlitUs);
+    if (++Frames == States[Shown].Frame)
+        Failed = WritePbm(pDir, States[Shown].pName);
+}
+
+void ST7565_BlitStatusLine(void)
+{
+    Advance(StatusUs);
+}
+
+// the spectrum takes a key once it read the same on four polls in a row
+KEY_Code_t KEYBOARD_Poll(void)
+{
+    if (Frames >= States[Shown].Frame)
+        return KEY_EXIT;
+    if (States[Shown].Key != KEY_INVALID && Frames >= States[Shown].KeyFrame && Held < 4) {
+        Held++;
+        return States[Shown].Key;
+    }
+    return KEY_INVALID;
+}
+
+// the model arguments, then the image directory and the state
+int main(int argc, char *argv[])
+{
+    if (argc < 3 || !ModelStart(argc - 2, argv))
+        return 2;
+
+    pDir  = argv[argc - 2];
+    Shown = atoi(argv[argc - 1]);
+    if (Shown >= sizeof(States) / sizeof(States[0]))
+        return 0;
+
+    APP_RunSpectrum();
+    if (Failed || Frames < States[Shown].Frame) {
+        fprintf(stdout, "[!] can not write %s\n", States[Shown].pName);
+        return 1;
+    }
+    // printf is the firmware one here, it goes to _putchar
+    fprintf(stdout, "%s - - -\n", States[Shown].pName);
+    return 0;
+}
+'''
+
+
+def build(cc, tmp, variables, root=hostbuild.ROOT, name='render'):
+    """The renderer of the tree at root, less the core sources that tree
+    does not have yet."""
+    sources = [s for s in CORE if os.path.exists(os.path.join(root, 'App', s))]
+    sources += hostbuild.feature_sources(variables, ('ui/', 'font_'), root)
+    binary, stubbed = hostbuild.build(cc, tmp, PBM + HARNESS, sources, variables, name=name, root=root)
+    return binary, len(dict.fromkeys(sources)), stubbed
+
+
+def build_spectrum(cc, tmp, variables):
+    sources = [s for s in spectrum_host.SOURCES if s != 'app/spectrum_bench.c']
+    sources += hostbuild.feature_sources(variables, ('font_',))
+    binary, _ = hostbuild.build(cc, tmp, PBM + SPECTRUM, sources, variables, extra=['-no-pie'], name='spectrum')
+    return binary
+
+
+def render(binary, directory, rounds):
+    result = subprocess.run([binary, directory, str(rounds)], capture_output=True, text=True)
+    if result.returncode:
+        raise RuntimeError(f"renderer failed ({result.returncode})\n{result.stdout}{result.stderr}")
+    return result.stdout
+
+
+def render_spectrum(binary, directory):
+    """The spectrum states one run each, the harness prints nothing past
+    the last one."""
+    output = ''
+    while True:
+        state = str(output.count('\n'))
+        result = subprocess.run([binary, *SPECTRUM_MODEL, directory, state], capture_output=True, text=True)
+        if result.returncode:
+            raise RuntimeError(f"spectrum failed ({result.returncode})\n{result.stdout}{result.stderr}")
+        if not result.stdout:
+            return output
+        output += result.stdout
+
+
+def read_pbm(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    m = re.match(rb'P4\s+(\d+)\s+(\d+)\s', data)
+    if not m or (int(m.group(1)), int(m.group(2))) != (WIDTH, HEIGHT):
+        raise RuntimeError(f"{path} is not a {WIDTH}x{HEIGHT} PBM")
+    bits = data[m.end():]
+    return [[(bits[y * WIDTH // 8 + x // 8] >> (7 - x % 8)) & 1 for x in range(WIDTH)] for y in range(HEIGHT)]
+
+
+def write_png(path, pixels, scale):
+    """Dark pixels on a light LCD, each pixel scale by scale."""
+    raw = b''
+    for row in pixels:
+        line = b'\0' + bytes(0x20 if p else 0xC8 for p in row for _ in range(scale))
+        raw += line * scale
+
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body))
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', WIDTH * scale, HEIGHT * scale, 8, 0, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def compare(got, want):
+    """Count and bounding box of the pixels that differ."""
+    diff = [(x, y) for y in range(HEIGHT) for x in range(WIDTH) if got[y][x] != want[y][x]]
+    if not diff:
+        return 0, None
+    xs, ys = [d[0] for d in diff], [d[1] for d in diff]
+    return len(diff), (min(xs), min(ys), max(xs), max(ys))
+
+
+def number(text):
+    return None if text == '-' else float(text)
+
+
+def shown(ns):
+    return '-' if ns is None else f'{ns:.0f}'
+
+
+def parse_timings(text):
+    """Screen, status and update ns of each state, None where it is not
+    timed. A part drawn update that did not match reads 'differs'."""
+    timings = {}
+    for line in text.split('\n'):
+        if line:
+            name, screen, status, update = (line.split() + ['-'])[:4]
+            timings[name] = (number(screen), number(status), update if update == 'differs' else number(update))
+    return timings
+
+
+def read_timings(path):
+    if not os.path.exists(path):
+        return {}
+    with open(path) as f:
+        return parse_timings(f.read())
+
+
+def cross_check(cc, base, preset, directory, golden):
+    """Render the states with the options of preset in the base tree, in
+    this tree and in base, and compare the two. The goldens are held
+    against the base renders too, they differ where the options the preset
+    gained since draw differently. Returns True when every state base
+    renders comes out the same here."""
+    with tempfile.TemporaryDirectory() as tmp:
+        tree = os.path.join(tmp, 'tree')
+        subprocess.run(['git', '-C', hostbuild.ROOT, 'worktree', 'add', '--detach', tree, base], capture_output=True, check=True)
+        try:
+            variables = hostbuild.preset_flags(preset, tree)
+            old = build(cc, tmp, variables, tree, name='render_base')[0]
+            new = build(cc, tmp, variables)[0]
+            for name, binary in (('base', old), ('tree', new)):
+                os.makedirs(os.path.join(directory, name), exist_ok=True)
+                render(binary, os.path.join(directory, name), 1)
+        finally:
+            subprocess.run(['git', '-C', hostbuild.ROOT, 'worktree', 'remove', '--force', tree], capture_output=True)
+
+    states = sorted(f[:-4] for f in os.listdir(os.path.join(directory, 'base')) if f.endswith('.pbm'))
+    print(f"[*] {base} against this tree, {preset} preset of {base}: {len(states)} states")
+    same = True
+    print("    state            this tree                     golden")
+    for name in states:
+        pixels = read_pbm(os.path.join(directory, 'base', f'{name}.pbm'))
+        count, box = compare(read_pbm(os.path.join(directory, 'tree', f'{name}.pbm')), pixels)
+        verdict = 'matches' if not count else f'{count} pixels differ in {box}'
+        if os.path.exists(os.path.join(golden, f'{name}.pbm')):
+            off, box = compare(read_pbm(os.path.join(golden, f'{name}.pbm')), pixels)
+            verdict = f"{verdict:<29} {'matches' if not off else f'{off} pixels differ in {box}'}"
+        print(f"    {name:<16} {verdict}")
+        same &= count == 0
+    return same
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Render the UI screens on the host for scripted states and compare them against golden images.')
+    parser.add_argument('-preset', default='Custom', help='CMakePresets.json preset for the ENABLE_* options (default: %(default)s)')
+    parser.add_argument('-spectrum-preset', dest='spectrum_preset', default=SPECTRUM_PRESET, help='preset the spectrum states are built with (default: %(default)s)')
+    parser.add_argument('-golden', default=GOLDEN, help='golden images (default: %(default)s)')
+    parser.add_argument('-timings', default=TIMINGS, help='golden timings of this host (default: %(default)s)')
+    parser.add_argument('-o', dest='output', default=os.path.join(hostbuild.ROOT, 'build', 'ui_render'), help='rendered images (default: %(default)s)')
+    parser.add_argument('-update', action='store_true', help='record the renders and timings as the new goldens')
+    parser.add_argument('-base', nargs='?', const=BASE, metavar='COMMIT', help='instead render the states of the preset in COMMIT and in this tree and compare them (default COMMIT: %(const)s)')
+    parser.add_argument('-png', type=int, nargs='?', const=4, default=0, metavar='SCALE', help='also write PNG images, scaled (default scale: 4)')
+    parser.add_argument('-rounds', type=int, default=2000, help='draws per timing batch (default: %(default)s)')
+    parser.add_argument('-tolerance', type=float, default=50, help='slowdown against the golden timings flagged, percent (default: %(default)s)')
+    parser.add_argument('-cc', default='cc', help='host C compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.rounds <= 0 or args.png < 0:
+        print("[!] rounds must be positive and the scale not negative")
+        sys.exit(1)
+
+    if args.base:
+        try:
+            same = cross_check(args.cc, args.base, args.preset, os.path.join(args.output, 'base'), args.golden)
+        except (OSError, RuntimeError, subprocess.CalledProcessError) as e:
+            print(f"[!] {e}")
+            sys.exit(1)
+        if not same:
+            print(f"[!] renders differ from {args.base}")
+            sys.exit(1)
+        print(f"[*] images in {os.path.join(args.output, 'base')}")
+        return
+
+    try:
+        variables = hostbuild.preset_flags(args.preset)
+        spectrum_variables = hostbuild.preset_flags(args.spectrum_preset)
+    except (OSError, RuntimeError) as e:
+        print(f"[!] {e}")
+        sys.exit(1)
+    if spectrum_variables.get('ENABLE_SPECTRUM') is not True:
+        print(f"[!] preset {args.spectrum_preset} does not build the spectrum")
+        sys.exit(1)
+
+    directory = args.golden if args.update else args.output
+    os.makedirs(directory, exist_ok=True)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary, units, stubbed = build(args.cc, tmp, variables)
+            spectrum = build_spectrum(args.cc, tmp, spectrum_variables)
+        except RuntimeError as e:
+            print(f"[!] build failed\n{e}")
+            sys.exit(1)
+        print(f"[*] preset {args.preset}: {units} units, {stubbed} symbols stubbed, spectrum of {args.spectrum_preset}")
+
+        try:
+            output = render(binary, directory, args.rounds) + render_spectrum(spectrum, directory)
+        except RuntimeError as e:
+            print(f"[!] {e}")
+            sys.exit(1)
+
+    timings = parse_timings(output)
+    golden_timings = read_timings(args.timings)
+    failed = False
+
+    print(f"[*] best of 8 batches of {args.rounds} on the host")
+    print("    state            screen ns  status ns  update ns   image")
+    for name, (screen, status, update) in timings.items():
+        pixels = read_pbm(os.path.join(directory, f'{name}.pbm'))
+        if args.png:
+            write_png(os.path.join(directory, f'{name}.png'), pixels, args.png)
+
+        if args.update:
+            verdict = 'recorded'
+        elif not os.path.exists(os.path.join(args.golden, f'{name}.pbm')):
+            verdict = 'no golden'
+        else:
+            count, box = compare(pixels, read_pbm(os.path.join(args.golden, f'{name}.pbm')))
+            verdict = 'matches' if not count else f'{count} pixels differ in {box}'
+            failed |= count > 0
+
+        if update == 'differs':
+            verdict += ', drawn in part it differs from a full redraw'
+            failed = True
+            update = None
+
+        if not args.update and name in golden_timings:
+            for label, now, then in zip(('screen', 'status', 'update'), (screen, status, update), golden_timings[name]):
+                if now is not None and then is not None and now > then * (1 + args.tolerance / 100):
+                    verdict += f', {label} {100 * (now / then - 1):.0f}% slower'
+                    failed = True
+
+        timings[name] = (screen, status, update)
+        print(f"    {name:<16} {shown(screen):>9} {shown(status):>10} {shown(update):>10}   {verdict}")
+
+    if args.update:
+        os.makedirs(os.path.dirname(os.path.abspath(args.timings)), exist_ok=True)
+        with open(args.timings, 'w') as f:
+            for name, (screen, status, update) in timings.items():
+                f.write(f'{name} {shown(screen)} {shown(status)} {shown(update)}\n')
+        print(f"[*] goldens written to {args.golden}, timings to {args.timings}")
+    elif failed:
+        print("[!] renders or timings differ from the goldens")
+        sys.exit(1)
+    else:
+        print(f"[*] images in {directory}")
+
+
+if __name__ == '__main__':
+    main()
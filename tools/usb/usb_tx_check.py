@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import json
+import argparse
+import tempfile
+import subprocess
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'host'))
+import hostbuild  # noqa: E402
+
+# Version
+VERSION = '1.0'
+
+# usb/usbd_cdc_if.c built for the host against a model of the CDC IN
+# endpoint, with the writers that share it: the protocol replies of
+# app/uart.c, the sweep frames of app/spectrum_stream.c and the screenshot
+# frames of screenshot.c. They run in a random order, and the host finishes
+# the transfer on the wire at random points in between, the way the IN
+# complete interrupt would come. The model counts every write started while
+# the endpoint is busy, and every buffer that changes while the endpoint
+# still owns it. The host side decodes the screenshot frames, and once the
+# stream has settled its screen has to be the one the radio thinks it sent.
+SOURCES = ['app/spectrum_stream.c']
+DRIVER = 'usb/usbd_cdc_if.c'
+# uart.c commands of these are never sent, they only need more stubs
+COMMANDS_OFF = ['ENABLE_FAST_CAPTURE', 'ENABLE_PRIORITY_LOOKBACK', 'ENABLE_SCAN_DWELL', 'ENABLE_SCAN_FASTHOP', 'ENABLE_SCAN_PLAN',
+                'ENABLE_SCAN_RANGES', 'ENABLE_MULTI_SCAN_RANGES', 'ENABLE_SCAN_STATS', 'ENABLE_SCAN_JOURNAL', 'ENABLE_UI_PROFILER']
+INCLUDES = ['Middlewares/CherryUSB/core', 'Middlewares/CherryUSB/class/cdc', 'Middlewares/CherryUSB/common']
+
+# The host has no PRIMASK, the interrupt never runs inside the driver there
+PRELUDE = r'''
+#include "usb_config.h"
+
+#undef __get_PRIMASK
+#undef __set_PRIMASK
+#undef __disable_irq
+#define __get_PRIMASK()     0u
+#define __set_PRIMASK(Mask) ((void)(Mask))
+#define __disable_irq()     do {} while (0)
+
+#line 1 "usb/usbd_cdc_if.c"
+'''
+
+HARNESS = r'''
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/spectrum_stream.h"
+#include "driver/vcp.h"
+
+#include "py32f0xx.h"
+#undef  NVIC_SystemReset
+#define NVIC_SystemReset()      // ARM only, uart.c resets on a command
+#include "app/uart.c"           // SendReply_VCP is static
+#include "screenshot.c"         // and previousFrame
+#undef  printf
+
+struct usbd_interface;
+struct usbd_endpoint;
+
+extern volatile bool ep_tx_busy_flag;
+void usbd_cdc_acm_bulk_in(uint8_t ep, uint32_t nbytes);
+void usbd_cdc_acm_set_dtr(uint8_t intf, bool dtr);
+
+void usbd_desc_register(const uint8_t *desc) { (void)desc; }
+void usbd_add_interface(struct usbd_interface *intf) { (void)intf; }
+void usbd_add_endpoint(struct usbd_endpoint *ep) { (void)ep; }
+int usbd_initialize(void) { return 0; }
+int usbd_ep_start_read(const uint8_t ep, uint8_t *data, uint32_t data_len) { return 0; }
+struct usbd_interface *usbd_cdc_acm_init_intf(struct usbd_interface *intf) { return intf; }
+
+#define MAX_TRANSFER 1024
+
+// the transfer on the wire and the bytes it started with
+static const uint8_t *pWire;
+static uint32_t       WireSize;
+static bool           Wire;
+static uint8_t        Started[MAX_TRANSFER];
+
+static unsigned long Collisions, Unflagged, Overwritten, Replies, Sweeps, Shots, Garbled;
+static uint8_t       Screen[1024];  // what the host has put together
+static uint8_t       ShotSeq;
+static uint64_t      Seed = 1;
+
+// replies sent and not seen on the wire yet, oldest first
+static uint8_t  Expected[64][MAX_REPLY_SIZE + 8];
+static uint16_t ExpectedSize[64];
+static unsigned Head, Tail;
+
+static uint32_t Random(uint32_t n)
+{
+    Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(Seed >> 33) % n;
+}
+
+int usbd_ep_start_write(const uint8_t ep, const uint8_t *data, uint32_t data_len)
+{
+    if (Wire)
+        Collisions++;
+    if (!ep_tx_busy_flag)
+        Unflagged++;
+
+    Wire     = true;
+    pWire    = data;
+    WireSize = data_len;
+    memcpy(Started, data, data_len);
+    return 0;
+}
+
+// runs of RLE blocks into the screen, false when they do not add up
+static bool Unpack(const uint8_t *p, const uint8_t *pEnd)
+{
+    while (p < pEnd) {
+        if (pEnd - p < 2 || p[0] + p[1] > 128)
+            return false;
+        uint8_t *pOut = &Screen[p[0] * 8];
+        const uint8_t *pOutEnd = pOut + p[1] * 8;
+        for (p += 2; pOut < pOutEnd; ) {
+            const uint8_t n = (*p & 0x80) ? (*p & 0x7F) + 3 : *p + 1;
+            if (pOut + n > pOutEnd || p + ((*p & 0x80) ? 2 : 1 + n) > pEnd)
+                return false;
+            if (*p & 0x80)
+                memset(pOut, p[1], n), p += 2;
+            else
+                memcpy(pOut, p + 1, n), p += 1 + n;
+            pOut += n;
+        }
+    }
+    return true;
+}
+
+static void Received(const uint8_t *p, uint32_t Size)
+{
+    if (Size >= 6 && p[0] == 0xAA && p[1] == 0x55) {
+        uint8_t check = 0;
+        const uint32_t len = (p[3] << 8) | p[4];
+        for (uint32_t i = 0; i < len; i++)
+            check ^= p[5 + i];
+        if (Size != len + 6 || check != 0 || p[Size - 1] != 0x0A)
+            Garbled++;
+        else if (p[2] == SPECSTREAM_TYPE_SWEEP)
+            Sweeps++;
+        else if (p[2] != SCREENSHOT_TYPE_RLE || p[5] != ShotSeq++ || !Unpack(p + 6, p + 5 + len - 1))
+            Garbled++;
+        else
+            Shots++;
+        return;
+    }
+
+    if (Head == Tail || Size != ExpectedSize[Tail % 64] || memcmp(p, Expected[Tail % 64], Size))
+        Garbled++;
+    else
+        Tail++;
+}
+
+// the host has read the transfer, the IN complete interrupt
+static void Complete(void)
+{
+    if (!Wire)
+        return;
+
+    Wire = false;
+    if (WireSize) {
+        if (memcmp(Started, pWire, WireSize))
+            Overwritten++;
+        Received(Started, WireSize);
+    }
+    usbd_cdc_acm_bulk_in(0x81, WireSize);
+}
+
+void SYSTICK_DelayUs(uint32_t Delay)
+{
+    (void)Delay;
+    if (Random(4) == 0)
+        Complete();
+}
+
+static void Reply(void)
+{
+    uint8_t  Payload[MAX_REPLY_SIZE];
+    uint16_t Size = 1 + Random(MAX_REPLY_SIZE);
+
+    for (uint16_t i = 0; i < Size; i++)
+        Payload[i] = Random(256);
+
+    uint8_t *pWant = Expected[Head % 64];
+    pWant[0] = 0xAB;
+    pWant[1] = 0xCD;
+    pWant[2] = Size;
+    pWant[3] = Size >> 8;
+    for (uint16_t i = 0; i < Size; i++)
+        pWant[4 + i] = Payload[i] ^ Obfuscation[i % 16];
+    pWant[4 + Size] = Obfuscation[(Size + 0) % 16] ^ 0xFF;
+    pWant[5 + Size] = Obfuscation[(Size + 1) % 16] ^ 0xFF;
+    pWant[6 + Size] = 0xDC;
+    pWant[7 + Size] = 0xBA;
+
+    ExpectedSize[Head % 64] = Size + 8;
+    Head++;
+    Replies++;
+
+    SendReply_VCP(Payload, Size);
+}
+
+static void Sweep(void)
+{
+    uint16_t Rssi[128];
+    uint8_t  Count = 1 + Random(128);
+
+    Rssi[0] = Random(512);
+    for (uint8_t i = 1; i < Count; i++)
+        Rssi[i] = Random(4) ? Rssi[i - 1] + Random(61) - 30 : Random(512);
+
+    SPECSTREAM_SendSweep(Rssi, Count, 14400000 + Random(100000), 1250);
+}
+
+static void Shot(void)
+{
+    for (uint8_t n = Random(8); n > 0; n--) {
+        const uint16_t At = Random(sizeof(gFrameBuffer));
+        ((uint8_t *)gFrameBuffer)[At] = Random(256);
+    }
+    if (Random(8) == 0)
+        SCREENSHOT_SetPacing(0, 1 + Random(20), Random(16) == 0);
+
+    getScreenShot(false);
+}
+
+int main(int argc, char *argv[])
+{
+    const unsigned long Ops = strtoul(argv[1], NULL, 10);
+    Seed = strtoull(argv[2], NULL, 10);
+
+    usbd_cdc_acm_set_dtr(0, true);
+
+    for (unsigned long Op = 0; Op < Ops; Op++) {
+        switch (Random(10)) {
+            case 0:
+            case 1:
+                Reply();
+                break;
+            case 2:
+            case 3:
+                Sweep();
+                break;
+            case 4:
+            case 5:
+            case 6:
+                Shot();
+                break;
+            default:
+                Complete();
+                break;
+        }
+    }
+
+    // let the screenshot catch up, then the host has what the radio sent
+    for (unsigned i = 0; i < 1000; i++) {
+        SCREENSHOT_SetPacing(0, 1, false);
+        getScreenShot(false);
+        Complete();
+    }
+    while (Wire)
+        Complete();
+    const bool Settled = memcmp(Screen, previousFrame, sizeof(Screen)) == 0;
+
+    printf("{\"collisions\": %lu, \"unflagged\": %lu, \"overwritten\": %lu, \"garbled\": %lu, "
+           "\"replies\": %lu, \"delivered\": %u, \"sweeps\": %lu, \"dropped\": %u, \"shots\": %lu, "
+           "\"unsettled\": %d}\n",
+           Collisions, Unflagged, Overwritten, Garbled, Replies, Tail, Sweeps, SPECSTREAM_GetDropped(), Shots,
+           !Settled);
+    return 0;
+}
+'''
+
+
+def driver(tmp):
+    """usbd_cdc_if.c with the interrupt mask taken out."""
+    with open(os.path.join(hostbuild.APP, DRIVER)) as f:
+        text = f.read()
+    path = os.path.join(tmp, 'usbd_cdc_if.c')
+    with open(path, 'w') as f:
+        f.write(PRELUDE + text)
+    return path
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check that the writers sharing the USB CDC IN endpoint never start '
+                                                 'a transfer on it while it is busy, nor touch a buffer it still owns.')
+    parser.add_argument('-preset', default='Custom', help='CMakePresets.json preset for the other options (default: %(default)s)')
+    parser.add_argument('-runs', type=int, default=20, help='random sequences (default: %(default)s)')
+    parser.add_argument('-ops', type=int, default=20000, help='operations per sequence (default: %(default)s)')
+    parser.add_argument('-seed', type=int, default=1, help='random seed of the first sequence (default: %(default)s)')
+    parser.add_argument('-cc', default='gcc', help='host compiler (default: %(default)s)')
+    parser.add_argument('--version', action='version', version=VERSION)
+    args = parser.parse_args()
+
+    if args.runs <= 0 or args.ops <= 0:
+        print("[!] runs and ops must be positive")
+        sys.exit(1)
+
+    variables = hostbuild.preset_flags(args.preset)
+    variables.update({k: False for k in COMMANDS_OFF})
+    variables.update({'ENABLE_USB': True, 'ENABLE_FEAT_N7SIX_SCREENSHOT': True, 'ENABLE_SCREENSHOT_USB': True})
+    extra = [f'-I{os.path.join(hostbuild.ROOT, i)}' for i in INCLUDES]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        try:
+            binary, stubbed = hostbuild.build(args.cc, tmp, HARNESS, SOURCES + [driver(tmp)], variables, extra, name='usb_tx')
+        except RuntimeError as e:
+            print(f"[!] Build failed:\n{e}")
+            sys.exit(1)
+        print(f"[*] Built {DRIVER}, app/uart.c, screenshot.c and {' '.join(SOURCES)}, {stubbed} symbols stubbed")
+
+        totals = {}
+        for seed in range(args.seed, args.seed + args.runs):
+            result = subprocess.run([binary, str(args.ops), str(seed)], capture_output=True, text=True)
+            if result.returncode:
+                print(f"[!] Sequence {seed} failed ({result.returncode}): {result.stderr.strip()}")
+                sys.exit(1)
+            summary = json.loads(result.stdout)
+            for key, value in summary.items():
+                totals[key] = totals.get(key, 0) + value
+
+    print(f"[*] {args.runs} sequences of {args.ops} operations")
+    print(f"    replies     {totals['replies']:8d} sent, {totals['delivered']} delivered intact")
+    print(f"    sweeps      {totals['sweeps']:8d} on the wire, {totals['dropped']} dropped on a busy endpoint")
+    print(f"    screenshots {totals['shots']:8d} frames decoded")
+    failed = False
+    for key, text in (('collisions', 'writes started on a busy endpoint'),
+                      ('unflagged', 'writes started without the busy flag'),
+                      ('overwritten', 'buffers changed while the endpoint owned them'),
+                      ('garbled', 'transfers the host could not match'),
+                      ('unsettled', 'sequences where the host screen differs from what the radio sent')):
+        if totals[key]:
+            print(f"[!] {totals[key]} {text}")
+            failed = True
+    if totals['replies'] != totals['delivered']:
+        print(f"[!] {totals['replies'] - totals['delivered']} replies lost")
+        failed = True
+    if failed:
+        sys.exit(1)
+    print("[*] No write on a busy endpoint, no buffer changed while it owned it, the host screens match")
+
+
+if __name__ == '__main__':
+    main()